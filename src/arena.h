@@ -0,0 +1,301 @@
+/*******************************************************************************************
+*
+*   Arena - Bump allocator for transient strings and buffers
+*
+*   MODULE USAGE:
+*       #define ARENA_IMPLEMENTATION
+*       #include "arena.h"
+*
+*       INIT:  Arena arena = { 0 };                         // Lazy initialized on first allocation
+*       ALLOC: char *text = ArenaFormat(&arena, "%s/%s", path, name);
+*       SCOPE: ArenaMark mark = ArenaGetMark(&arena); ... ArenaRestore(&arena, mark);
+*       RESET: ArenaReset(&arena);                          // O(1), memory blocks are kept for reuse
+*       FREE:  ArenaFree(&arena);
+*
+*   NOTES:
+*       Memory is requested in blocks (ARENA_BLOCK_SIZE by default) and allocations just move
+*       an offset forward; allocations are never freed individually. Resetting or restoring
+*       a mark rewinds the offset, blocks are kept chained and reused by next allocations,
+*       so memory usage stays flat once the arena reached its working size
+*
+*   LICENSE: GPLv3, check LICENSE file for details
+*
+**********************************************************************************************/
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>         // Required for: size_t
+#include <stdarg.h>         // Required for: va_list
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#ifndef ARENA_BLOCK_SIZE
+    #define ARENA_BLOCK_SIZE        (64*1024)   // Default arena memory block size
+#endif
+
+#define ARENA_ALIGNMENT             16          // Allocations alignment
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Arena memory block, blocks are chained in allocation order
+typedef struct ArenaBlock {
+    struct ArenaBlock *next;    // Next block (kept after reset for reuse)
+    size_t capacity;            // Block data capacity
+    size_t used;                // Block data used
+    unsigned char *data;        // Block data
+} ArenaBlock;
+
+// Arena allocator
+typedef struct Arena {
+    ArenaBlock *first;          // First block
+    ArenaBlock *current;        // Current block, allocations are done here
+    size_t blockSize;           // Default block size (ARENA_BLOCK_SIZE if 0)
+
+    // Usage stats
+    size_t used;                // Bytes currently allocated
+    size_t peak;                // Max bytes allocated at same time
+    size_t reserved;            // Bytes reserved in blocks
+    int allocCount;             // Allocations since last reset
+    int blockCount;             // Memory blocks reserved
+} Arena;
+
+// Arena position, used to define allocation scopes
+typedef struct ArenaMark {
+    ArenaBlock *block;
+    size_t used;
+    size_t totalUsed;
+    int allocCount;
+} ArenaMark;
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+void *ArenaAlloc(Arena *arena, size_t size);                    // Allocate zero initialized memory from arena
+char *ArenaStrdup(Arena *arena, const char *text);              // Copy string into arena
+char *ArenaFormat(Arena *arena, const char *format, ...);       // Format string into arena (no length limit)
+char *ArenaFormatV(Arena *arena, const char *format, va_list args); // Format string into arena, va_list version
+ArenaMark ArenaGetMark(Arena *arena);                           // Get current arena position
+void ArenaRestore(Arena *arena, ArenaMark mark);                // Restore arena position, releasing later allocations
+void ArenaReset(Arena *arena);                                  // Release all allocations, blocks are kept (O(1))
+void ArenaFree(Arena *arena);                                   // Free all arena memory blocks
+
+size_t GetProcessMemoryUsage(void);                             // Get process resident memory (RSS) in bytes, 0 if not available
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ARENA_H
+
+/***********************************************************************************
+*
+*   ARENA IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(ARENA_IMPLEMENTATION)
+
+#include <stdio.h>          // Required for: vsnprintf(), FILE, fopen(), fscanf()
+#include <stdlib.h>         // Required for: malloc(), free()
+#include <string.h>         // Required for: memset(), memcpy(), strlen()
+
+#if defined(__linux__)
+    #include <unistd.h>     // Required for: sysconf()
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+// Reserve a new memory block with required capacity
+static ArenaBlock *ArenaReserveBlock(Arena *arena, size_t capacity)
+{
+    ArenaBlock *block = (ArenaBlock *)malloc(sizeof(ArenaBlock) + capacity);
+    if (block == NULL) return NULL;
+
+    block->next = NULL;
+    block->capacity = capacity;
+    block->used = 0;
+    block->data = (unsigned char *)(block + 1);
+
+    arena->reserved += capacity;
+    arena->blockCount++;
+
+    return block;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Allocate zero initialized memory from arena
+// NOTE: When current block is full, next chained block is reused if big enough,
+// otherwise a new block is inserted after current one
+void *ArenaAlloc(Arena *arena, size_t size)
+{
+    if (arena->blockSize == 0) arena->blockSize = ARENA_BLOCK_SIZE;
+
+    size = (size + ARENA_ALIGNMENT - 1) & ~((size_t)ARENA_ALIGNMENT - 1);
+    if (size == 0) size = ARENA_ALIGNMENT;
+
+    if (arena->current == NULL)
+    {
+        arena->first = ArenaReserveBlock(arena, (size > arena->blockSize)? size : arena->blockSize);
+        arena->current = arena->first;
+        if (arena->current == NULL) return NULL;
+    }
+
+    ArenaBlock *block = arena->current;
+
+    if ((block->used + size) > block->capacity)
+    {
+        if ((block->next != NULL) && (block->next->capacity >= size))
+        {
+            block = block->next;
+            block->used = 0;
+        }
+        else
+        {
+            ArenaBlock *newBlock = ArenaReserveBlock(arena, (size > arena->blockSize)? size : arena->blockSize);
+            if (newBlock == NULL) return NULL;
+
+            newBlock->next = block->next;
+            block->next = newBlock;
+            block = newBlock;
+        }
+
+        arena->current = block;
+    }
+
+    void *ptr = block->data + block->used;
+    block->used += size;
+
+    arena->used += size;
+    if (arena->used > arena->peak) arena->peak = arena->used;
+    arena->allocCount++;
+
+    memset(ptr, 0, size);
+
+    return ptr;
+}
+
+// Copy string into arena
+char *ArenaStrdup(Arena *arena, const char *text)
+{
+    if (text == NULL) return NULL;
+
+    size_t length = strlen(text);
+    char *copy = (char *)ArenaAlloc(arena, length + 1);
+    if (copy != NULL) memcpy(copy, text, length + 1);
+
+    return copy;
+}
+
+// Format string into arena, va_list version
+char *ArenaFormatV(Arena *arena, const char *format, va_list args)
+{
+    va_list argsCopy;
+    va_copy(argsCopy, args);
+    int length = vsnprintf(NULL, 0, format, argsCopy);
+    va_end(argsCopy);
+
+    if (length < 0) return NULL;
+
+    char *text = (char *)ArenaAlloc(arena, (size_t)length + 1);
+    if (text != NULL) vsnprintf(text, (size_t)length + 1, format, args);
+
+    return text;
+}
+
+// Format string into arena
+char *ArenaFormat(Arena *arena, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    char *text = ArenaFormatV(arena, format, args);
+    va_end(args);
+
+    return text;
+}
+
+// Get current arena position
+ArenaMark ArenaGetMark(Arena *arena)
+{
+    ArenaMark mark = { 0 };
+
+    mark.block = arena->current;
+    mark.used = (arena->current != NULL)? arena->current->used : 0;
+    mark.totalUsed = arena->used;
+    mark.allocCount = arena->allocCount;
+
+    return mark;
+}
+
+// Restore arena position, all allocations done after mark are released
+void ArenaRestore(Arena *arena, ArenaMark mark)
+{
+    if (mark.block == NULL)
+    {
+        ArenaReset(arena);
+        return;
+    }
+
+    arena->current = mark.block;
+    arena->current->used = mark.used;
+    arena->used = mark.totalUsed;
+    arena->allocCount = mark.allocCount;
+}
+
+// Release all allocations, memory blocks are kept for reuse
+void ArenaReset(Arena *arena)
+{
+    arena->current = arena->first;
+    if (arena->current != NULL) arena->current->used = 0;
+
+    arena->used = 0;
+    arena->allocCount = 0;
+}
+
+// Free all arena memory blocks
+void ArenaFree(Arena *arena)
+{
+    ArenaBlock *block = arena->first;
+
+    while (block != NULL)
+    {
+        ArenaBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+
+    size_t blockSize = arena->blockSize;
+    memset(arena, 0, sizeof(Arena));
+    arena->blockSize = blockSize;
+}
+
+// Get process resident memory (RSS) in bytes
+// NOTE: Only supported on Linux (/proc), returns 0 on other platforms
+size_t GetProcessMemoryUsage(void)
+{
+    size_t rss = 0;
+
+#if defined(__linux__)
+    FILE *statm = fopen("/proc/self/statm", "r");
+    if (statm != NULL)
+    {
+        unsigned long pages = 0;
+        unsigned long residentPages = 0;
+        if (fscanf(statm, "%lu %lu", &pages, &residentPages) == 2) rss = (size_t)residentPages*(size_t)sysconf(_SC_PAGESIZE);
+        fclose(statm);
+    }
+#endif
+
+    return rss;
+}
+
+#endif // ARENA_IMPLEMENTATION
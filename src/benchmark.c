@@ -0,0 +1,502 @@
+/*******************************************************************************************
+*
+*   StatiqPress benchmark - Performance benchmarks of publishing pipeline modules
+*
+*   COMMAND LINE:
+*       statiqpress_benchmark deflate <file> [--level <1..10>]
+*           Measure compression throughput: single-threaded vs chunked parallel deflate
+*       statiqpress_benchmark frontmatter <folder> [--generate <count>]
+*           Measure front matter parsing throughput over all markdown files of folder (memory mapped),
+*           --generate writes a synthetic content tree (TOML and YAML posts) into folder first
+*       statiqpress_benchmark png <folder|file.png>
+*           Measure lossless PNG recompression (as banners are published) over all PNG files of folder:
+*           single-threaded vs parallel filter strategies, size saved and winning strategies
+*       statiqpress_benchmark markdown <folder>
+*           Measure markdown to HTML rendering (as in preview pages) over all markdown files of folder:
+*           single-threaded vs parallel posts/s, output of both runs is compared
+*
+*   NOTES:
+*       Benchmarks are a separate tool (make benchmark), not part of StatiqPress executable:
+*       modules are measured as used by StatiqPress, parallel runs use a worker pool of all CPU cores
+*
+*   DEPENDENCIES:
+*       raylib 5.5-dev          - File loading (no window is initialized)
+*       miniz 2.2.0             - Reference single-threaded deflate, output verification
+*
+*   LICENSE: GPLv3, check LICENSE file for details
+*
+**********************************************************************************************/
+
+#include "raylib.h"
+
+// miniz: Single C source file zlib-replacement library
+// https://github.com/richgel999/miniz
+#include "external/miniz.h"         // Deflate functions definition
+#include "external/miniz.c"         // Deflate implementation
+
+// C standard library
+#include <stdlib.h>                 // Required for: atoi()
+#include <string.h>                 // Required for: strcmp(), memcmp()
+#include <stdio.h>                  // Required for: printf(), fprintf()
+#include <time.h>                   // Required for: clock_gettime(), clock()
+
+#define ARENA_IMPLEMENTATION
+#include "arena.h"                  // Arena: Bump allocator for transient strings and buffers
+#undef ARENA_IMPLEMENTATION         // Avoid including arena implementation again
+
+#define WORKER_POOL_IMPLEMENTATION
+#include "worker_pool.h"            // Worker pool: Run jobs in parallel on CPU cores
+#undef WORKER_POOL_IMPLEMENTATION   // Avoid including worker pool implementation again
+
+#define PARALLEL_DEFLATE_IMPLEMENTATION
+#include "parallel_deflate.h"       // Parallel deflate: Chunked multi-threaded compression for large assets
+#undef PARALLEL_DEFLATE_IMPLEMENTATION  // Avoid including parallel deflate implementation again
+
+#define FRONT_MATTER_IMPLEMENTATION
+#include "front_matter.h"           // Front matter: Front matter parsing and site-wide rewriting
+#undef FRONT_MATTER_IMPLEMENTATION  // Avoid including front matter implementation again
+
+#define PNG_OPTIMIZER_IMPLEMENTATION
+#include "png_optimizer.h"          // PNG optimizer: Lossless PNG recompression, filter strategies tried in parallel
+#undef PNG_OPTIMIZER_IMPLEMENTATION // Avoid including PNG optimizer implementation again
+
+#define MARKDOWN_HTML_IMPLEMENTATION
+#include "markdown_html.h"          // Markdown HTML: Markdown to HTML renderer for offline previews (streamed output)
+#undef MARKDOWN_HTML_IMPLEMENTATION // Avoid including markdown HTML implementation again
+
+//----------------------------------------------------------------------------------
+// Global Variables Definition
+//----------------------------------------------------------------------------------
+static WorkerPool *workerPool = NULL;           // Worker threads, parallel runs of benchmarks
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static void showCommandLineInfo(void);                  // Show command line usage info
+static double getBenchmarkTime(void);                   // Get monotonic time in seconds
+static int benchmarkDeflate(const char *fileName, int level); // Benchmark single-threaded vs chunked parallel deflate
+static int benchmarkFrontMatter(const char *folderPath, int generateCount); // Benchmark front matter parsing over a content tree
+static int benchmarkPng(const char *path);              // Benchmark lossless PNG recompression over a corpus
+static int benchmarkMarkdown(const char *folderPath);   // Benchmark markdown to HTML rendering over a content tree
+
+//------------------------------------------------------------------------------------
+// Program main entry point
+//------------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    SetTraceLogLevel(LOG_WARNING);
+
+    workerPool = LoadWorkerPool(0);
+    int result = 1;
+
+    if ((argc >= 3) && (strcmp(argv[1], "deflate") == 0)) {
+        int level = 6;
+        if ((argc >= 5) && (strcmp(argv[3], "--level") == 0)) level = atoi(argv[4]);
+        if ((level < 1) || (level > 10)) level = 6;
+
+        result = benchmarkDeflate(argv[2], level);
+    }
+    else if ((argc >= 3) && (strcmp(argv[1], "frontmatter") == 0)) {
+        int generateCount = 0;
+        if ((argc >= 5) && (strcmp(argv[3], "--generate") == 0)) generateCount = atoi(argv[4]);
+
+        result = benchmarkFrontMatter(argv[2], generateCount);
+    }
+    else if ((argc >= 3) && (strcmp(argv[1], "png") == 0)) result = benchmarkPng(argv[2]);
+    else if ((argc >= 3) && (strcmp(argv[1], "markdown") == 0)) result = benchmarkMarkdown(argv[2]);
+    else showCommandLineInfo();
+
+    UnloadWorkerPool(workerPool);
+
+    return result;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Show command line usage info
+static void showCommandLineInfo(void) {
+    printf("\nUSAGE:\n\n");
+    printf("    > statiqpress_benchmark deflate <file> [--level <1..10>]\n");
+    printf("    > statiqpress_benchmark frontmatter <folder> [--generate <count>]\n");
+    printf("    > statiqpress_benchmark png <folder|file.png>\n");
+    printf("    > statiqpress_benchmark markdown <folder>\n");
+
+    printf("\nEXAMPLES:\n\n");
+    printf("    > statiqpress_benchmark deflate recording.gif\n");
+    printf("        Compare single-threaded and parallel compression throughput\n");
+    printf("    > statiqpress_benchmark frontmatter bench --generate 50000\n");
+    printf("        Generate 50000 synthetic posts into bench folder and measure front matter parsing\n");
+    printf("    > statiqpress_benchmark png static/images\n");
+    printf("        Measure lossless recompression of all PNG files in static/images\n");
+    printf("    > statiqpress_benchmark markdown content\n");
+    printf("        Measure markdown to HTML rendering of all posts in content folder (posts/s)\n\n");
+}
+
+// Get monotonic time in seconds
+// NOTE: Window is not initialized, so raylib GetTime() is not available
+static double getBenchmarkTime(void) {
+#if defined(_WIN32)
+    return (double)clock()/CLOCKS_PER_SEC;      // NOTE: Windows clock() measures wall time
+#else
+    struct timespec now = { 0 };
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec*1e-9;
+#endif
+}
+
+// Benchmark: Single-threaded vs chunked parallel deflate, output is verified
+static int benchmarkDeflate(const char *fileName, int level) {
+    int dataSize = 0;
+    unsigned char *data = LoadFileData(fileName, &dataSize);
+    if ((data == NULL) || (dataSize <= 0)) {
+        fprintf(stderr, "ERROR: Benchmark file could not be loaded: %s\n", fileName);
+        return 1;
+    }
+
+    printf("BENCHMARK: deflate %s (%.2f MB), level %i, %i thread(s)\n", fileName, dataSize/(1024.0*1024.0), level, GetWorkerPoolThreadCount(workerPool));
+
+    int result = 0;
+    for (int i = 0; i < 2; i++) {
+        bool parallel = (i == 1);
+        size_t compSize = 0;
+
+        double startTime = getBenchmarkTime();
+        void *compData = parallel? CompressDataParallel(data, dataSize, &compSize, level, workerPool) :
+            tdefl_compress_mem_to_heap(data, dataSize, &compSize, tdefl_create_comp_flags_from_zip_params(level, -MZ_DEFAULT_WINDOW_BITS, MZ_DEFAULT_STRATEGY));
+        double elapsedTime = getBenchmarkTime() - startTime;
+
+        // Verify output is a valid deflate stream for original data
+        size_t decompSize = 0;
+        void *decompData = (compData != NULL)? tinfl_decompress_mem_to_heap(compData, compSize, &decompSize, 0) : NULL;
+        bool valid = (decompData != NULL) && (decompSize == (size_t)dataSize) && (memcmp(decompData, data, dataSize) == 0);
+        if (!valid) result = 1;
+
+        printf("BENCHMARK: %-15s %8.2f ms %9.2f MB/s  ratio %6.2f%%  %s\n", parallel? "parallel" : "single-threaded",
+            elapsedTime*1000.0, (elapsedTime > 0.0)? dataSize/(1024.0*1024.0)/elapsedTime : 0.0, 100.0*compSize/dataSize, valid? "OK" : "INVALID");
+
+        mz_free(decompData);
+        mz_free(compData);
+    }
+
+    UnloadFileData(data);
+
+    return result;
+}
+
+// Front matter benchmark data, parse results per file
+typedef struct FrontMatterBenchmark {
+    const FrontMatterFiles *files;
+    int *fieldCounts;               // Fields and list values parsed per file
+    int *regionSizes;               // Front matter size per file (body offset)
+} FrontMatterBenchmark;
+
+// Benchmark job: Parse front matter of a group of files (memory mapped)
+static void parseFrontMatterFiles(void *data, int index) {
+    FrontMatterBenchmark *benchmark = (FrontMatterBenchmark *)data;
+
+    int start = index*FRONT_MATTER_FILES_PER_JOB;
+    int end = ((start + FRONT_MATTER_FILES_PER_JOB) < benchmark->files->count)? (start + FRONT_MATTER_FILES_PER_JOB) : benchmark->files->count;
+
+    for (int i = start; i < end; i++) {
+        FrontMatterFile file = LoadFrontMatterFile(benchmark->files->names + benchmark->files->offsets[i]);
+        FrontMatterParser parser = InitFrontMatterParser(file.data, file.dataSize);
+        FrontMatterField field = { 0 };
+        FrontMatterSlice value = { 0 };
+        int count = 0;
+
+        while (NextFrontMatterField(&parser, &field)) {
+            count++;
+            while (NextFrontMatterValue(&field, &value)) count++;
+        }
+
+        benchmark->fieldCounts[i] = count;
+        benchmark->regionSizes[i] = parser.bodyOffset;
+        UnloadFrontMatterFile(&file);
+    }
+}
+
+// Generate synthetic content tree: posts with TOML and YAML front matter (inline arrays, block lists, tables)
+static bool generateFrontMatterTree(const char *folderPath, int count) {
+    const char *body = "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore.\n";
+    bool success = true;
+
+    for (int i = 0; (i < count) && success; i++) {
+        char fileName[512] = { 0 };
+        snprintf(fileName, sizeof(fileName), "%s/section-%03i", folderPath, i/100);
+        if ((i%100) == 0) MakeDirectory(fileName);
+        snprintf(fileName + strlen(fileName), sizeof(fileName) - strlen(fileName), "/post-%06i.md", i);
+
+        FILE *file = fopen(fileName, "wb");
+        if (file == NULL) { success = false; break; }
+
+        if ((i%2) == 0) {
+            fprintf(file, "+++\ntitle = \"Synthetic post %i\"\ndate = \"2024-%02i-%02iT10:00:00+0000\"\n"
+                "tags = [\"tag%i\", \"tag%i\", \"common\"]\ncategories = [\"category%i\"]\n"
+                "description = \"Post %i, generated for front matter benchmark\"\nauthors = [\"Author %i\"]\n"
+                "[taxonomies]\nseries = [\"series%i\"]\n+++\n\n", i, 1 + i%12, 1 + i%28, i%50, i%7, i%10, i, i%20, i%5);
+        }
+        else {
+            fprintf(file, "---\ntitle: \"Synthetic post %i\"\ndate: 2024-%02i-%02i\ntags:\n  - tag%i\n  - tag%i\n  - common\n"
+                "categories: [category%i]\ndescription: Post %i, generated for front matter benchmark # comment\n"
+                "author: Author %i\nsocial:\n  image: /img/post%i.png\n---\n\n", i, 1 + i%12, 1 + i%28, i%50, i%7, i%10, i, i%20, i);
+        }
+
+        for (int k = 0; k < 40; k++) fputs(body, file);     // ~4KB body, never read by parser
+
+        if (fclose(file) != 0) success = false;
+    }
+
+    return success;
+}
+
+// Benchmark: Front matter parsing over a content tree, single-threaded vs parallel
+static int benchmarkFrontMatter(const char *folderPath, int generateCount) {
+    if (generateCount > 0) {
+        MakeDirectory(folderPath);
+        double startTime = getBenchmarkTime();
+        if (!generateFrontMatterTree(folderPath, generateCount)) {
+            fprintf(stderr, "ERROR: Synthetic content tree could not be generated: %s\n", folderPath);
+            return 1;
+        }
+        printf("BENCHMARK: %i synthetic posts generated in %s (%.2f ms)\n", generateCount, folderPath, (getBenchmarkTime() - startTime)*1000.0);
+    }
+
+    double startTime = getBenchmarkTime();
+    FrontMatterFiles files = LoadFrontMatterFiles(folderPath);
+    double scanTime = getBenchmarkTime() - startTime;
+
+    if (files.count == 0) {
+        fprintf(stderr, "ERROR: No markdown files found in %s\n", folderPath);
+        UnloadFrontMatterFiles(&files);
+        return 1;
+    }
+
+    printf("BENCHMARK: frontmatter %s, %i files (scanned in %.2f ms), %i thread(s)\n", folderPath, files.count, scanTime*1000.0, GetWorkerPoolThreadCount(workerPool));
+
+    FrontMatterBenchmark benchmark = { 0 };
+    benchmark.files = &files;
+    benchmark.fieldCounts = (int *)calloc(files.count, sizeof(int));
+    benchmark.regionSizes = (int *)calloc(files.count, sizeof(int));
+    int jobCount = (files.count + FRONT_MATTER_FILES_PER_JOB - 1)/FRONT_MATTER_FILES_PER_JOB;
+
+    for (int i = 0; (i < 2) && (benchmark.fieldCounts != NULL) && (benchmark.regionSizes != NULL); i++) {
+        bool parallel = (i == 1);
+
+        startTime = getBenchmarkTime();
+        RunWorkerPoolJobs(parallel? workerPool : NULL, parseFrontMatterFiles, &benchmark, jobCount);
+        double elapsedTime = getBenchmarkTime() - startTime;
+
+        long long fieldCount = 0, regionSize = 0;
+        int parsedCount = 0;
+        for (int k = 0; k < files.count; k++) {
+            fieldCount += benchmark.fieldCounts[k];
+            regionSize += benchmark.regionSizes[k];
+            if (benchmark.regionSizes[k] > 0) parsedCount++;
+        }
+
+        printf("BENCHMARK: %-15s %8.2f ms %10.0f files/s  %i with front matter, %lld fields/values, %.2f MB front matter\n",
+            parallel? "parallel" : "single-threaded", elapsedTime*1000.0, (elapsedTime > 0.0)? files.count/elapsedTime : 0.0,
+            parsedCount, fieldCount, regionSize/(1024.0*1024.0));
+    }
+
+    free(benchmark.fieldCounts);
+    free(benchmark.regionSizes);
+    UnloadFrontMatterFiles(&files);
+
+    return 0;
+}
+
+// Check if PNG files decode to same pixels (as RGBA 8-bit)
+static bool isSamePngImage(const unsigned char *data, int dataSize, const unsigned char *otherData, int otherDataSize) {
+    Image image = LoadImageFromMemory(".png", data, dataSize);
+    Image other = LoadImageFromMemory(".png", otherData, otherDataSize);
+    bool same = (image.data != NULL) && (other.data != NULL) && (image.width == other.width) && (image.height == other.height);
+
+    if (same) {
+        ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        ImageFormat(&other, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        same = (memcmp(image.data, other.data, (size_t)image.width*image.height*4) == 0);
+    }
+
+    UnloadImage(image);
+    UnloadImage(other);
+
+    return same;
+}
+
+// Benchmark: Lossless PNG recompression over a corpus, single-threaded vs parallel strategies, output is verified
+static int benchmarkPng(const char *path) {
+    char *singlePath[1] = { (char *)path };
+    bool folder = DirectoryExists(path);
+    FilePathList files = folder? LoadDirectoryFilesEx(path, ".png", true) : (FilePathList){ 1, 1, singlePath };
+
+    if (files.count == 0) {
+        fprintf(stderr, "ERROR: No PNG files found in %s\n", path);
+        if (folder) UnloadDirectoryFiles(files);
+        return 1;
+    }
+
+    double times[2] = { 0 };
+    long long inputSize = 0, outputSize = 0;
+    int strategyCounts[PNG_OPTIMIZER_STRATEGY_COUNT] = { 0 };
+    int smallerCount = 0, skippedCount = 0, invalidCount = 0;
+
+    for (unsigned int i = 0; i < files.count; i++) {
+        int dataSize = 0;
+        unsigned char *data = LoadFileData(files.paths[i], &dataSize);
+        if (!IsPngData(data, dataSize)) {
+            skippedCount++;
+            UnloadFileData(data);
+            continue;
+        }
+
+        inputSize += dataSize;
+
+        for (int k = 0; k < 2; k++) {
+            bool parallel = (k == 1);
+            int optimizedSize = 0, strategy = -1;
+
+            double startTime = getBenchmarkTime();
+            unsigned char *optimized = OptimizePngData(data, dataSize, &optimizedSize, &strategy, parallel? workerPool : NULL);
+            times[k] += getBenchmarkTime() - startTime;
+
+            if (parallel) {
+                if (optimized != NULL) {
+                    smallerCount++;
+                    strategyCounts[strategy]++;
+                    if (!isSamePngImage(data, dataSize, optimized, optimizedSize)) {
+                        printf("BENCHMARK: %s: optimized image pixels differ\n", files.paths[i]);
+                        invalidCount++;
+                    }
+                }
+                outputSize += (optimized != NULL)? optimizedSize : dataSize;
+            }
+
+            free(optimized);
+        }
+
+        UnloadFileData(data);
+    }
+
+    printf("BENCHMARK: png %s, %i files (%.2f MB), %i thread(s)\n", path, files.count - skippedCount, inputSize/(1024.0*1024.0), GetWorkerPoolThreadCount(workerPool));
+    for (int k = 0; k < 2; k++) {
+        printf("BENCHMARK: %-15s %8.2f ms %9.2f MB/s\n", (k == 1)? "parallel" : "single-threaded",
+            times[k]*1000.0, (times[k] > 0.0)? inputSize/(1024.0*1024.0)/times[k] : 0.0);
+    }
+
+    printf("BENCHMARK: size %.2f MB -> %.2f MB (%.2f%% saved), %i files smaller, %i not PNG, %s\n", inputSize/(1024.0*1024.0),
+        outputSize/(1024.0*1024.0), (inputSize > 0)? 100.0 - 100.0*outputSize/inputSize : 0.0, smallerCount, skippedCount,
+        (invalidCount == 0)? "OK" : TextFormat("%i INVALID", invalidCount));
+
+    printf("BENCHMARK: strategies:");
+    for (int k = 0; k < PNG_OPTIMIZER_STRATEGY_COUNT; k++) printf(" %s %i", GetPngStrategyName(k), strategyCounts[k]);
+    printf("\n");
+
+    if (folder) UnloadDirectoryFiles(files);
+
+    return (invalidCount == 0)? 0 : 1;
+}
+
+// Markdown benchmark data, rendered HTML size and hash per file
+typedef struct MarkdownBenchmark {
+    const FrontMatterFiles *files;
+    long long *htmlSizes;
+    unsigned int *htmlHashes;       // FNV-1a of rendered HTML, single-threaded and parallel outputs are compared
+} MarkdownBenchmark;
+
+// Rendered HTML output: measured and hashed, not stored
+typedef struct MarkdownBenchmarkOutput {
+    long long size;
+    unsigned int hash;
+} MarkdownBenchmarkOutput;
+
+static void hashMarkdownData(const char *data, int size, void *userData) {
+    MarkdownBenchmarkOutput *output = (MarkdownBenchmarkOutput *)userData;
+
+    for (int i = 0; i < size; i++) output->hash = (output->hash ^ (unsigned char)data[i])*16777619u;
+    output->size += size;
+}
+
+// Benchmark job: Render markdown of a group of files (memory mapped)
+static void renderMarkdownFiles(void *data, int index) {
+    MarkdownBenchmark *benchmark = (MarkdownBenchmark *)data;
+    Arena arena = { 0 };
+
+    int start = index*FRONT_MATTER_FILES_PER_JOB;
+    int end = ((start + FRONT_MATTER_FILES_PER_JOB) < benchmark->files->count)? (start + FRONT_MATTER_FILES_PER_JOB) : benchmark->files->count;
+
+    for (int i = start; i < end; i++) {
+        FrontMatterFile file = LoadFrontMatterFile(benchmark->files->names + benchmark->files->offsets[i]);
+        MarkdownBenchmarkOutput output = { 0, 2166136261u };
+
+        // Front matter is skipped, markdown body is rendered as in preview pages
+        FrontMatterParser parser = InitFrontMatterParser(file.data, file.dataSize);
+        FrontMatterField field = { 0 };
+        while (NextFrontMatterField(&parser, &field)) { }
+
+        MarkdownDocument *document = LoadMarkdownDocument(&arena, file.data + parser.bodyOffset, file.dataSize - parser.bodyOffset);
+        RenderMarkdownHtml(document, hashMarkdownData, &output);
+
+        benchmark->htmlSizes[i] = output.size;
+        benchmark->htmlHashes[i] = output.hash;
+        UnloadFrontMatterFile(&file);
+        ArenaReset(&arena);
+    }
+
+    ArenaFree(&arena);
+}
+
+// Benchmark: Markdown to HTML over a content tree, single-threaded vs parallel, outputs compared
+static int benchmarkMarkdown(const char *folderPath) {
+    FrontMatterFiles files = LoadFrontMatterFiles(folderPath);
+
+    if (files.count == 0) {
+        fprintf(stderr, "ERROR: No markdown files found in %s\n", folderPath);
+        UnloadFrontMatterFiles(&files);
+        return 1;
+    }
+
+    long long markdownSize = 0;
+    for (int i = 0; i < files.count; i++) markdownSize += GetFileLength(files.names + files.offsets[i]);
+
+    printf("BENCHMARK: markdown %s, %i files (%.2f MB), %i thread(s)\n", folderPath, files.count, markdownSize/(1024.0*1024.0), GetWorkerPoolThreadCount(workerPool));
+
+    MarkdownBenchmark benchmarks[2] = { 0 };
+    int jobCount = (files.count + FRONT_MATTER_FILES_PER_JOB - 1)/FRONT_MATTER_FILES_PER_JOB;
+    bool valid = true;
+
+    for (int i = 0; i < 2; i++) {
+        bool parallel = (i == 1);
+        MarkdownBenchmark *benchmark = &benchmarks[i];
+        benchmark->files = &files;
+        benchmark->htmlSizes = (long long *)calloc(files.count, sizeof(long long));
+        benchmark->htmlHashes = (unsigned int *)calloc(files.count, sizeof(unsigned int));
+        if ((benchmark->htmlSizes == NULL) || (benchmark->htmlHashes == NULL)) { valid = false; break; }
+
+        double startTime = getBenchmarkTime();
+        RunWorkerPoolJobs(parallel? workerPool : NULL, renderMarkdownFiles, benchmark, jobCount);
+        double elapsedTime = getBenchmarkTime() - startTime;
+
+        long long htmlSize = 0;
+        for (int k = 0; k < files.count; k++) htmlSize += benchmark->htmlSizes[k];
+
+        printf("BENCHMARK: %-15s %8.2f ms %10.0f posts/s %9.2f MB/s  %.2f MB HTML\n", parallel? "parallel" : "single-threaded", elapsedTime*1000.0,
+            (elapsedTime > 0.0)? files.count/elapsedTime : 0.0, (elapsedTime > 0.0)? markdownSize/(1024.0*1024.0)/elapsedTime : 0.0, htmlSize/(1024.0*1024.0));
+    }
+
+    int differentCount = 0;
+    for (int k = 0; valid && (k < files.count); k++) {
+        if ((benchmarks[0].htmlSizes[k] != benchmarks[1].htmlSizes[k]) || (benchmarks[0].htmlHashes[k] != benchmarks[1].htmlHashes[k])) differentCount++;
+    }
+
+    printf("BENCHMARK: output %s\n", !valid? "INVALID" : ((differentCount == 0)? "OK" : TextFormat("%i page(s) DIFFERENT", differentCount)));
+
+    for (int i = 0; i < 2; i++) {
+        free(benchmarks[i].htmlSizes);
+        free(benchmarks[i].htmlHashes);
+    }
+    UnloadFrontMatterFiles(&files);
+
+    return (valid && (differentCount == 0))? 0 : 1;
+}
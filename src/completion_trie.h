@@ -0,0 +1,465 @@
+/*******************************************************************************************
+*
+*   Completion Trie - Compressed prefix trie for text completion, ranked by frequency
+*
+*   MODULE USAGE:
+*       #define COMPLETION_TRIE_IMPLEMENTATION
+*       #include "completion_trie.h"
+*
+*       CompletionTrie *trie = LoadCompletionTrie(values, counts, valueCount); // Values are copied
+*       const char *results[COMPLETION_TRIE_MAX_RESULTS] = { 0 };
+*       int resultCount = GetCompletions(trie, "go", results, COMPLETION_TRIE_MAX_RESULTS);
+*       UnloadCompletionTrie(trie);
+*
+*       // Tries built on a background thread, available once done (NULL until then)
+*       CompletionTask *task = StartCompletionTask(LoadTries, userData, 3);
+*       CompletionTrie *tags = GetCompletionTaskTrie(task, 0);
+*       UnloadCompletionTask(task);
+*
+*   NOTES:
+*       Trie is compressed (radix): every node edge is a label (chain of single child nodes merged),
+*       so nodes count is at most twice values count. Matching is ASCII case-insensitive, so values
+*       only differing in case ("Go", "go") are suggested together, original values are returned
+*
+*       Best COMPLETION_TRIE_MAX_RESULTS values (most frequent first, then alphabetical) are stored
+*       in every node when trie is built: a lookup just walks prefix characters and returns node
+*       results, no subtree traversal or sorting, so it is fast enough to run on every frame
+*
+*       Threads are not available on PLATFORM_WEB, task function is run on calling thread
+*
+*   LICENSE: GPLv3, check LICENSE file for details
+*
+**********************************************************************************************/
+
+#ifndef COMPLETION_TRIE_H
+#define COMPLETION_TRIE_H
+
+#include <stdbool.h>        // Required for: bool
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define COMPLETION_TRIE_MAX_RESULTS     8       // Max completions per prefix
+#define COMPLETION_TASK_MAX_TRIES       8       // Max tries built by a completion task
+
+#if defined(__EMSCRIPTEN__) && !defined(COMPLETION_TRIE_NO_THREADS)
+    #define COMPLETION_TRIE_NO_THREADS
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Completion trie, opaque type
+typedef struct CompletionTrie CompletionTrie;
+
+// Completion task (tries built on background thread), opaque type
+typedef struct CompletionTask CompletionTask;
+
+// Completion task function, called on background thread to build tries (LoadCompletionTrie())
+// NOTE: Tries not built can be left NULL, they are unloaded with task
+typedef void (*CompletionTaskFunc)(CompletionTrie **tries, int trieCount, void *userData);
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+CompletionTrie *LoadCompletionTrie(const char *const *values, const int *counts, int count); // Load completion trie from values and frequencies (counts can be NULL)
+void UnloadCompletionTrie(CompletionTrie *trie);                        // Unload completion trie
+int GetCompletions(const CompletionTrie *trie, const char *prefix, const char **results, int maxCount); // Get values starting with prefix, most frequent first
+int GetCompletionTrieValueCount(const CompletionTrie *trie);           // Get values count of trie
+
+CompletionTask *StartCompletionTask(CompletionTaskFunc func, void *userData, int trieCount); // Start building tries on background thread
+bool IsCompletionTaskDone(CompletionTask *task);                        // Check if task function returned
+CompletionTrie *GetCompletionTaskTrie(CompletionTask *task, int index); // Get trie built by task, NULL if task not done
+void UnloadCompletionTask(CompletionTask *task);                        // Unload task (waits for thread) and its tries
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // COMPLETION_TRIE_H
+
+/***********************************************************************************
+*
+*   COMPLETION_TRIE IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(COMPLETION_TRIE_IMPLEMENTATION)
+
+#include <stdlib.h>         // Required for: malloc(), calloc(), realloc(), free()
+#include <string.h>         // Required for: memcpy(), strlen(), strcmp()
+
+#if !defined(COMPLETION_TRIE_NO_THREADS)
+    #include <pthread.h>    // Required for: pthread_create(), pthread_join(), pthread_mutex_*()
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Trie node, edge label is a range of keys data
+typedef struct CompletionTrieNode {
+    int labelOffset;                // Edge label offset in keys data
+    int labelLength;
+    int firstChild;                 // -1 if none
+    int nextSibling;                // -1 if none
+    int value;                      // First value ending at node, -1 if none (values with same key are chained)
+    int resultCount;                // Best values of subtree, stored in trie results
+} CompletionTrieNode;
+
+struct CompletionTrie {
+    CompletionTrieNode *nodes;      // Node 0 is root (empty label)
+    int nodeCount;
+    int nodeCapacity;
+    int *results;                   // Best values per node: COMPLETION_TRIE_MAX_RESULTS per node
+
+    char *keys;                     // Lowercase values, NULL terminated, labels point into it
+    char *texts;                    // Original values, NULL terminated
+    int *textOffsets;               // Original value offset per value
+    int *counts;                    // Frequency per value
+    int *nextValue;                 // Next value with same key, -1 if none
+    int valueCount;
+};
+
+struct CompletionTask {
+    CompletionTaskFunc func;
+    void *userData;
+    CompletionTrie *tries[COMPLETION_TASK_MAX_TRIES];
+    int trieCount;
+    bool done;
+#if !defined(COMPLETION_TRIE_NO_THREADS)
+    pthread_mutex_t mutex;          // Protects done flag
+    pthread_t thread;
+    bool threadRunning;
+#endif
+};
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+static char ToLowerCompletionChar(char c) { return ((c >= 'A') && (c <= 'Z'))? (c + 32) : c; }
+
+// Add trie node, returns node index (-1 on allocation failure)
+static int AddCompletionTrieNode(CompletionTrie *trie, int labelOffset, int labelLength)
+{
+    if (trie->nodeCount >= trie->nodeCapacity)
+    {
+        int capacity = (trie->nodeCapacity > 0)? trie->nodeCapacity*2 : 64;
+        CompletionTrieNode *nodes = (CompletionTrieNode *)realloc(trie->nodes, capacity*sizeof(CompletionTrieNode));
+        if (nodes == NULL) return -1;
+
+        trie->nodes = nodes;
+        trie->nodeCapacity = capacity;
+    }
+
+    trie->nodes[trie->nodeCount] = (CompletionTrieNode){ labelOffset, labelLength, -1, -1, -1, 0 };
+
+    return trie->nodeCount++;
+}
+
+// Insert value key into trie, edges are split where keys diverge
+static bool InsertCompletionTrieValue(CompletionTrie *trie, int value, int keyOffset)
+{
+    const char *key = trie->keys + keyOffset;
+    int length = (int)strlen(key);
+    int node = 0;
+    int position = 0;
+
+    while (position < length)
+    {
+        int child = trie->nodes[node].firstChild;
+        while ((child >= 0) && (trie->keys[trie->nodes[child].labelOffset] != key[position])) child = trie->nodes[child].nextSibling;
+
+        if (child < 0)
+        {
+            // No edge starts with next character: new leaf with remaining key as label
+            int leaf = AddCompletionTrieNode(trie, keyOffset + position, length - position);
+            if (leaf < 0) return false;
+
+            trie->nodes[leaf].nextSibling = trie->nodes[node].firstChild;
+            trie->nodes[node].firstChild = leaf;
+            node = leaf;
+            break;
+        }
+
+        const char *label = trie->keys + trie->nodes[child].labelOffset;
+        int common = 0;
+        while ((common < trie->nodes[child].labelLength) && ((position + common) < length) && (label[common] == key[position + common])) common++;
+
+        if (common < trie->nodes[child].labelLength)
+        {
+            // Key diverges inside edge label: edge is split, new node keeps label end and children
+            int split = AddCompletionTrieNode(trie, trie->nodes[child].labelOffset + common, trie->nodes[child].labelLength - common);
+            if (split < 0) return false;
+
+            trie->nodes[split].firstChild = trie->nodes[child].firstChild;
+            trie->nodes[split].value = trie->nodes[child].value;
+            trie->nodes[child].labelLength = common;
+            trie->nodes[child].firstChild = split;
+            trie->nodes[child].value = -1;
+        }
+
+        node = child;
+        position += common;
+    }
+
+    trie->nextValue[value] = trie->nodes[node].value;
+    trie->nodes[node].value = value;
+
+    return true;
+}
+
+// Check if value a ranks before value b: most frequent first, then alphabetical
+static bool IsCompletionRankedBefore(const CompletionTrie *trie, int a, int b)
+{
+    if (trie->counts[a] != trie->counts[b]) return (trie->counts[a] > trie->counts[b]);
+
+    return (strcmp(trie->texts + trie->textOffsets[a], trie->texts + trie->textOffsets[b]) < 0);
+}
+
+// Add value to node results, kept sorted by rank (insertion into small fixed size array)
+static void AddCompletionResult(CompletionTrie *trie, int node, int value)
+{
+    int *results = trie->results + node*COMPLETION_TRIE_MAX_RESULTS;
+    int count = trie->nodes[node].resultCount;
+    int position = count;
+
+    while ((position > 0) && IsCompletionRankedBefore(trie, value, results[position - 1])) position--;
+    if (position >= COMPLETION_TRIE_MAX_RESULTS) return;
+
+    if (count < COMPLETION_TRIE_MAX_RESULTS) count++;
+    for (int i = count - 1; i > position; i--) results[i] = results[i - 1];
+    results[position] = value;
+
+    trie->nodes[node].resultCount = count;
+}
+
+// Compute best values of every node subtree: own values merged with children results
+// NOTE: Nodes are visited in reverse preorder, so children are always computed before parent
+static bool ComputeCompletionResults(CompletionTrie *trie)
+{
+    int *order = (int *)malloc(trie->nodeCount*sizeof(int));
+    int *stack = (int *)malloc(trie->nodeCount*sizeof(int));
+    int orderCount = 0, stackCount = 0;
+
+    if ((order == NULL) || (stack == NULL))
+    {
+        free(order);
+        free(stack);
+        return false;
+    }
+
+    stack[stackCount++] = 0;
+    while (stackCount > 0)
+    {
+        int node = stack[--stackCount];
+        order[orderCount++] = node;
+        for (int child = trie->nodes[node].firstChild; child >= 0; child = trie->nodes[child].nextSibling) stack[stackCount++] = child;
+    }
+
+    for (int i = orderCount - 1; i >= 0; i--)
+    {
+        int node = order[i];
+        for (int value = trie->nodes[node].value; value >= 0; value = trie->nextValue[value]) AddCompletionResult(trie, node, value);
+
+        for (int child = trie->nodes[node].firstChild; child >= 0; child = trie->nodes[child].nextSibling)
+        {
+            const int *results = trie->results + child*COMPLETION_TRIE_MAX_RESULTS;
+            for (int k = 0; k < trie->nodes[child].resultCount; k++) AddCompletionResult(trie, node, results[k]);
+        }
+    }
+
+    free(order);
+    free(stack);
+
+    return true;
+}
+
+#if !defined(COMPLETION_TRIE_NO_THREADS)
+// Completion task thread: tries are built and task marked done
+static void *CompletionTaskThread(void *data)
+{
+    CompletionTask *task = (CompletionTask *)data;
+
+    task->func(task->tries, task->trieCount, task->userData);
+
+    pthread_mutex_lock(&task->mutex);
+    task->done = true;
+    pthread_mutex_unlock(&task->mutex);
+
+    return NULL;
+}
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Load completion trie from values and their frequencies (i.e. number of posts using a tag)
+// NOTE: Empty values are ignored, values are copied
+CompletionTrie *LoadCompletionTrie(const char *const *values, const int *counts, int count)
+{
+    CompletionTrie *trie = (CompletionTrie *)calloc(1, sizeof(CompletionTrie));
+    if (trie == NULL) return NULL;
+
+    size_t textsSize = 1;
+    for (int i = 0; i < count; i++) textsSize += strlen(values[i]) + 1;
+
+    trie->keys = (char *)calloc(textsSize, 1);
+    trie->texts = (char *)calloc(textsSize, 1);
+    trie->textOffsets = (int *)calloc(count + 1, sizeof(int));
+    trie->counts = (int *)calloc(count + 1, sizeof(int));
+    trie->nextValue = (int *)calloc(count + 1, sizeof(int));
+    bool success = (trie->keys != NULL) && (trie->texts != NULL) && (trie->textOffsets != NULL) && (trie->counts != NULL) && (trie->nextValue != NULL);
+    success = success && (AddCompletionTrieNode(trie, 0, 0) == 0);
+
+    int offset = 1;     // Offset 0 is empty string, root label
+    for (int i = 0; success && (i < count); i++)
+    {
+        int length = (int)strlen(values[i]);
+        if (length == 0) continue;
+
+        int value = trie->valueCount++;
+        memcpy(trie->texts + offset, values[i], length);
+        for (int k = 0; k < length; k++) trie->keys[offset + k] = ToLowerCompletionChar(values[i][k]);
+        trie->textOffsets[value] = offset;
+        trie->counts[value] = (counts != NULL)? counts[i] : 1;
+
+        success = InsertCompletionTrieValue(trie, value, offset);
+        offset += length + 1;
+    }
+
+    if (success)
+    {
+        trie->results = (int *)calloc((size_t)trie->nodeCount*COMPLETION_TRIE_MAX_RESULTS, sizeof(int));
+        success = (trie->results != NULL) && ComputeCompletionResults(trie);
+    }
+
+    if (!success)
+    {
+        UnloadCompletionTrie(trie);
+        return NULL;
+    }
+
+    return trie;
+}
+
+// Unload completion trie
+void UnloadCompletionTrie(CompletionTrie *trie)
+{
+    if (trie == NULL) return;
+
+    free(trie->nodes);
+    free(trie->results);
+    free(trie->keys);
+    free(trie->texts);
+    free(trie->textOffsets);
+    free(trie->counts);
+    free(trie->nextValue);
+    free(trie);
+}
+
+// Get values starting with prefix (case-insensitive), most frequent first
+// NOTE: Returned strings are owned by trie, valid until trie is unloaded
+int GetCompletions(const CompletionTrie *trie, const char *prefix, const char **results, int maxCount)
+{
+    if ((trie == NULL) || (prefix == NULL)) return 0;
+
+    int length = (int)strlen(prefix);
+    int node = 0;
+    int position = 0;
+
+    while (position < length)
+    {
+        int child = trie->nodes[node].firstChild;
+        while ((child >= 0) && (trie->keys[trie->nodes[child].labelOffset] != ToLowerCompletionChar(prefix[position]))) child = trie->nodes[child].nextSibling;
+        if (child < 0) return 0;
+
+        // Prefix can end inside edge label, node results are still valid
+        const char *label = trie->keys + trie->nodes[child].labelOffset;
+        for (int i = 0; (i < trie->nodes[child].labelLength) && (position < length); i++, position++)
+        {
+            if (label[i] != ToLowerCompletionChar(prefix[position])) return 0;
+        }
+
+        node = child;
+    }
+
+    int count = trie->nodes[node].resultCount;
+    if (count > maxCount) count = maxCount;
+    for (int i = 0; i < count; i++) results[i] = trie->texts + trie->textOffsets[trie->results[node*COMPLETION_TRIE_MAX_RESULTS + i]];
+
+    return count;
+}
+
+// Get values count of trie
+int GetCompletionTrieValueCount(const CompletionTrie *trie)
+{
+    return (trie != NULL)? trie->valueCount : 0;
+}
+
+// Start building tries on background thread, task function fills tries array
+CompletionTask *StartCompletionTask(CompletionTaskFunc func, void *userData, int trieCount)
+{
+    CompletionTask *task = (CompletionTask *)calloc(1, sizeof(CompletionTask));
+    if (task == NULL) return NULL;
+
+    task->func = func;
+    task->userData = userData;
+    task->trieCount = (trieCount < COMPLETION_TASK_MAX_TRIES)? trieCount : COMPLETION_TASK_MAX_TRIES;
+
+#if !defined(COMPLETION_TRIE_NO_THREADS)
+    pthread_mutex_init(&task->mutex, NULL);
+    task->threadRunning = (pthread_create(&task->thread, NULL, CompletionTaskThread, task) == 0);
+    if (task->threadRunning) return task;
+#endif
+
+    // No threads available, task is run on calling thread
+    func(task->tries, task->trieCount, userData);
+    task->done = true;
+
+    return task;
+}
+
+// Check if task function returned, tries are available
+bool IsCompletionTaskDone(CompletionTask *task)
+{
+    if (task == NULL) return false;
+
+#if !defined(COMPLETION_TRIE_NO_THREADS)
+    pthread_mutex_lock(&task->mutex);
+    bool done = task->done;
+    pthread_mutex_unlock(&task->mutex);
+
+    return done;
+#else
+    return task->done;
+#endif
+}
+
+// Get trie built by task, NULL if task is not done or trie not built
+CompletionTrie *GetCompletionTaskTrie(CompletionTask *task, int index)
+{
+    if (!IsCompletionTaskDone(task) || (index < 0) || (index >= task->trieCount)) return NULL;
+
+    return task->tries[index];
+}
+
+// Unload task and its tries
+// NOTE: If task is still running, calling thread waits for it
+void UnloadCompletionTask(CompletionTask *task)
+{
+    if (task == NULL) return;
+
+#if !defined(COMPLETION_TRIE_NO_THREADS)
+    if (task->threadRunning) pthread_join(task->thread, NULL);
+    pthread_mutex_destroy(&task->mutex);
+#endif
+
+    for (int i = 0; i < task->trieCount; i++) UnloadCompletionTrie(task->tries[i]);
+    free(task);
+}
+
+#endif // COMPLETION_TRIE_IMPLEMENTATION
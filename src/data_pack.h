@@ -0,0 +1,391 @@
+/*******************************************************************************************
+*
+*   Data Pack - Directory files packed as indexed deflated entries, attachable to executable
+*
+*   MODULE USAGE:
+*       #define DATA_PACK_IMPLEMENTATION
+*       #include "data_pack.h"
+*
+*       PACK:   char *packData = PackDirectoryData("template", &packDataSize);  // Append to exe file
+*       LOAD:   DataPack pack = LoadDataPack(exeFileName);                       // Empty pack if not found
+*       ENTRY:  unsigned char *data = LoadDataPackFile(&pack, "src/main.c", &dataSize);
+*       UNLOAD: UnloadDataPack(&pack);
+*
+*   PACK FORMAT:
+*       [entries data]  Deflated (raw) file data, entry is stored if compression does not shrink it
+*       [index]         PackFileEntry array, sorted by filePath (relative to packed directory, '/' separator)
+*       [footer]        PackFooter, fourcc "rpch" on last 4 bytes, so pack is found from file end
+*
+*       NOTE: Values are written in native byte order, pack is read by the same executable it is attached to
+*
+*   NOTES:
+*       Pack is read by memory-mapping the file (executable), only footer and index are read on load;
+*       entries data is decompressed when requested, so the executable is never fully loaded in RAM.
+*       On Windows, pack data is read instead (only the attached pack, not the executable)
+*
+*   DEPENDENCIES:
+*       raylib              - Directory scanning and file data loading (packing)
+*       miniz               - Deflate compression/decompression
+*       parallel_deflate.h  - Large files compression on all CPU cores (packing)
+*
+*   LICENSE: GPLv3, check LICENSE file for details
+*
+**********************************************************************************************/
+
+#ifndef DATA_PACK_H
+#define DATA_PACK_H
+
+#include <stdbool.h>
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define DATA_PACK_VERSION           100     // Pack format version
+#define DATA_PACK_COMPRESSION_LEVEL   9     // Deflate compression level (1..10), pack is generated once
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Packed file entry
+// NOTE: Used for template packing and attach to executable
+typedef struct PackFileEntry {
+    int fileSize;               // File size (uncompressed)
+    int compFileSize;           // File data size in pack (equal to fileSize if stored)
+    int offset;                 // File data offset from pack start
+    char filePath[256];         // File path, relative to packed directory
+} PackFileEntry;
+
+// Pack footer, placed at the end of pack data
+typedef struct PackFooter {
+    int version;                // Pack format version
+    int entryCount;             // Number of entries in index
+    int indexOffset;            // Index offset from pack start
+    int packSize;               // Pack size, including footer
+    char fourcc[4];             // Pack identifier: "rpch"
+} PackFooter;
+
+// Data pack, mapped from file
+typedef struct DataPack {
+    int count;                  // Entries count
+    PackFileEntry *entries;     // Entries index (copy), sorted by file path
+    const unsigned char *pack;  // Pack data start (inside file data)
+    unsigned char *data;        // File data (memory mapped if supported, only pack data if loaded)
+    long dataSize;              // File data size
+    bool mapped;                // File data is memory mapped (or loaded)
+} DataPack;
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+char *PackDirectoryData(const char *baseDirPath, int *packDataSize);    // Pack directory files (recursive), memory must be freed (RL_FREE)
+DataPack LoadDataPack(const char *fileName);                            // Load data pack attached at file end, empty pack if not found
+void UnloadDataPack(DataPack *pack);                                    // Unload data pack
+int GetDataPackFileIndex(const DataPack *pack, const char *filePath);   // Get entry index by file path, -1 if not found
+unsigned char *LoadDataPackFile(const DataPack *pack, const char *filePath, int *dataSize); // Load (decompress) file data from pack, free with UnloadFileData()
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DATA_PACK_H
+
+/***********************************************************************************
+*
+*   DATA_PACK IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(DATA_PACK_IMPLEMENTATION)
+
+#include "raylib.h"                 // Required for: LoadDirectoryFilesEx(), LoadFileData(), RL_CALLOC(), RL_FREE()
+#include "external/miniz.h"         // Required for: tdefl_compress_mem_to_heap(), tinfl_decompress_mem_to_mem()
+#include "parallel_deflate.h"       // Required for: CompressDataParallel()
+
+#include <stdio.h>                  // Required for: FILE, fopen(), fread(), fseek()
+#include <stdlib.h>                 // Required for: calloc(), free(), qsort(), bsearch()
+#include <string.h>                 // Required for: memcpy(), strcmp(), strlen()
+
+#if !defined(_WIN32)
+    #include <fcntl.h>              // Required for: open()
+    #include <unistd.h>             // Required for: close()
+    #include <sys/mman.h>           // Required for: mmap(), munmap()
+    #include <sys/stat.h>           // Required for: fstat()
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Pack entry being built
+typedef struct PackBuildEntry {
+    PackFileEntry entry;
+    unsigned char *data;        // Entry data (deflated or stored)
+    bool compressed;            // Entry data is allocated by miniz
+} PackBuildEntry;
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+// Compare pack build entries by file path (qsort)
+static int ComparePackBuildEntries(const void *a, const void *b)
+{
+    return strcmp(((const PackBuildEntry *)a)->entry.filePath, ((const PackBuildEntry *)b)->entry.filePath);
+}
+
+// Compare file path with pack entry (bsearch)
+static int ComparePackFileEntry(const void *key, const void *entry)
+{
+    return strcmp((const char *)key, ((const PackFileEntry *)entry)->filePath);
+}
+
+// Get pack footer from file data end, validating it
+static bool GetPackFooter(const unsigned char *fileEnd, long fileSize, PackFooter *footer)
+{
+    if (fileSize < (long)sizeof(PackFooter)) return false;
+
+    memcpy(footer, fileEnd - sizeof(PackFooter), sizeof(PackFooter));
+
+    if (memcmp(footer->fourcc, "rpch", 4) != 0) return false;
+    if (footer->version != DATA_PACK_VERSION) return false;
+    if ((footer->packSize < (int)sizeof(PackFooter)) || (footer->packSize > fileSize)) return false;
+    if ((footer->entryCount < 0) || (footer->indexOffset < 0)) return false;
+    if (((long)footer->indexOffset + (long)footer->entryCount*(long)sizeof(PackFileEntry)) > (long)(footer->packSize - sizeof(PackFooter))) return false;
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Pack directory files (recursive) into a data pack
+// NOTE: Large files are compressed in chunks on a temporary worker pool
+char *PackDirectoryData(const char *baseDirPath, int *packDataSize)
+{
+    *packDataSize = 0;
+
+    WorkerPool *pool = LoadWorkerPool(0);
+
+    FilePathList files = LoadDirectoryFilesEx(baseDirPath, NULL, true);
+    PackBuildEntry *buildEntries = (PackBuildEntry *)RL_CALLOC((files.count > 0)? files.count : 1, sizeof(PackBuildEntry));
+    int count = 0;
+    int dataSize = 0;
+
+    int baseLength = (int)strlen(baseDirPath);
+
+    for (unsigned int i = 0; i < files.count; i++)
+    {
+        // Entry path relative to packed directory, using '/' separator
+        const char *filePath = files.paths[i] + baseLength;
+        while ((*filePath == '/') || (*filePath == '\\')) filePath++;
+
+        if (strlen(filePath) >= sizeof(buildEntries[count].entry.filePath))
+        {
+            TraceLog(LOG_WARNING, "PACK: [%s] File path too long, not packed", filePath);
+            continue;
+        }
+
+        PackBuildEntry *build = &buildEntries[count];
+        strcpy(build->entry.filePath, filePath);
+        for (char *c = build->entry.filePath; *c != '\0'; c++) if (*c == '\\') *c = '/';
+
+        int fileSize = 0;
+        unsigned char *fileData = LoadFileData(files.paths[i], &fileSize);
+        if ((fileData == NULL) && (fileSize != 0)) continue;
+
+        size_t compSize = 0;
+        void *compData = NULL;
+
+        if (fileSize >= PARALLEL_DEFLATE_MIN_SIZE) compData = CompressDataParallel(fileData, fileSize, &compSize, DATA_PACK_COMPRESSION_LEVEL, pool);
+        else if (fileSize > 0) compData = tdefl_compress_mem_to_heap(fileData, fileSize, &compSize,
+            tdefl_create_comp_flags_from_zip_params(DATA_PACK_COMPRESSION_LEVEL, -MZ_DEFAULT_WINDOW_BITS, MZ_DEFAULT_STRATEGY));
+
+        build->entry.fileSize = fileSize;
+
+        if ((compData != NULL) && ((int)compSize < fileSize))
+        {
+            UnloadFileData(fileData);
+            build->data = (unsigned char *)compData;
+            build->entry.compFileSize = (int)compSize;
+            build->compressed = true;
+        }
+        else
+        {
+            mz_free(compData);
+            build->data = fileData;
+            build->entry.compFileSize = fileSize;
+        }
+
+        dataSize += build->entry.compFileSize;
+        count++;
+    }
+
+    UnloadDirectoryFiles(files);
+    UnloadWorkerPool(pool);
+
+    // Index is sorted by path, entries are found with a binary search
+    qsort(buildEntries, count, sizeof(PackBuildEntry), ComparePackBuildEntries);
+
+    int packSize = dataSize + count*(int)sizeof(PackFileEntry) + (int)sizeof(PackFooter);
+    char *packData = (char *)RL_CALLOC(packSize, 1);
+
+    int offset = 0;
+    for (int i = 0; i < count; i++)
+    {
+        PackBuildEntry *build = &buildEntries[i];
+        build->entry.offset = offset;
+        if (build->entry.compFileSize > 0) memcpy(packData + offset, build->data, build->entry.compFileSize);
+        offset += build->entry.compFileSize;
+
+        if (build->compressed) mz_free(build->data);
+        else UnloadFileData(build->data);
+
+        memcpy(packData + dataSize + i*sizeof(PackFileEntry), &build->entry, sizeof(PackFileEntry));
+    }
+
+    PackFooter footer = { DATA_PACK_VERSION, count, dataSize, packSize, { 'r', 'p', 'c', 'h' } };
+    memcpy(packData + packSize - sizeof(PackFooter), &footer, sizeof(PackFooter));
+
+    RL_FREE(buildEntries);
+
+    *packDataSize = packSize;
+
+    return packData;
+}
+
+// Load data pack attached at file end
+// NOTE: File is memory mapped (read-only), only index is copied
+DataPack LoadDataPack(const char *fileName)
+{
+    DataPack pack = { 0 };
+    PackFooter footer = { 0 };
+
+#if defined(_WIN32)
+    FILE *file = fopen(fileName, "rb");
+    if (file == NULL) return pack;
+
+    fseek(file, 0, SEEK_END);
+    long fileSize = ftell(file);
+
+    // Only footer is read to check for a pack, then pack data
+    unsigned char footerData[sizeof(PackFooter)] = { 0 };
+    if ((fileSize >= (long)sizeof(PackFooter)) && (fseek(file, fileSize - (long)sizeof(PackFooter), SEEK_SET) == 0) &&
+        (fread(footerData, 1, sizeof(PackFooter), file) == sizeof(PackFooter)) &&
+        GetPackFooter(footerData + sizeof(PackFooter), fileSize, &footer))
+    {
+        pack.data = (unsigned char *)calloc(footer.packSize, 1);
+        fseek(file, fileSize - footer.packSize, SEEK_SET);
+
+        if ((pack.data != NULL) && (fread(pack.data, 1, footer.packSize, file) == (size_t)footer.packSize))
+        {
+            pack.dataSize = footer.packSize;
+            pack.pack = pack.data;
+        }
+    }
+    fclose(file);
+#else
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0) return pack;
+
+    struct stat fileInfo = { 0 };
+    if ((fstat(fd, &fileInfo) == 0) && (fileInfo.st_size > 0))
+    {
+        void *data = mmap(NULL, fileInfo.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED)
+        {
+            pack.data = (unsigned char *)data;
+            pack.dataSize = (long)fileInfo.st_size;
+            pack.mapped = true;
+
+            if (GetPackFooter(pack.data + pack.dataSize, pack.dataSize, &footer)) pack.pack = pack.data + pack.dataSize - footer.packSize;
+        }
+    }
+    close(fd);      // NOTE: Mapping is kept after closing file descriptor
+#endif
+
+    if (pack.pack == NULL)
+    {
+        UnloadDataPack(&pack);
+        return pack;
+    }
+
+    // Index is copied, mapped data has no alignment guarantees
+    pack.entries = (PackFileEntry *)calloc((footer.entryCount > 0)? footer.entryCount : 1, sizeof(PackFileEntry));
+    memcpy(pack.entries, pack.pack + footer.indexOffset, footer.entryCount*sizeof(PackFileEntry));
+    pack.count = footer.entryCount;
+
+    // Entries must be inside pack data
+    for (int i = 0; i < pack.count; i++)
+    {
+        PackFileEntry *entry = &pack.entries[i];
+        entry->filePath[sizeof(entry->filePath) - 1] = '\0';
+
+        if ((entry->offset < 0) || (entry->compFileSize < 0) || (entry->fileSize < 0) ||
+            ((long)entry->offset + entry->compFileSize > footer.indexOffset))
+        {
+            TraceLog(LOG_WARNING, "PACK: [%s] Pack data not valid", fileName);
+            UnloadDataPack(&pack);
+            break;
+        }
+    }
+
+    return pack;
+}
+
+// Unload data pack
+void UnloadDataPack(DataPack *pack)
+{
+#if !defined(_WIN32)
+    if (pack->mapped) munmap(pack->data, pack->dataSize);
+    else
+#endif
+    free(pack->data);
+
+    free(pack->entries);
+
+    *pack = (DataPack){ 0 };
+}
+
+// Get entry index by file path, -1 if not found
+int GetDataPackFileIndex(const DataPack *pack, const char *filePath)
+{
+    if (pack->count == 0) return -1;
+
+    const PackFileEntry *entry = (const PackFileEntry *)bsearch(filePath, pack->entries, pack->count, sizeof(PackFileEntry), ComparePackFileEntry);
+
+    return (entry != NULL)? (int)(entry - pack->entries) : -1;
+}
+
+// Load (decompress) file data from pack
+// NOTE: Only requested entry data is accessed (paged in from mapped file)
+unsigned char *LoadDataPackFile(const DataPack *pack, const char *filePath, int *dataSize)
+{
+    *dataSize = 0;
+
+    int index = GetDataPackFileIndex(pack, filePath);
+    if (index < 0)
+    {
+        TraceLog(LOG_WARNING, "PACK: [%s] File not found in pack", filePath);
+        return NULL;
+    }
+
+    const PackFileEntry *entry = &pack->entries[index];
+    unsigned char *data = (unsigned char *)RL_MALLOC((entry->fileSize > 0)? entry->fileSize : 1);
+    if (data == NULL) return NULL;
+
+    if (entry->compFileSize == entry->fileSize) memcpy(data, pack->pack + entry->offset, entry->fileSize);
+    else if (tinfl_decompress_mem_to_mem(data, entry->fileSize, pack->pack + entry->offset, entry->compFileSize, 0) != (size_t)entry->fileSize)
+    {
+        TraceLog(LOG_WARNING, "PACK: [%s] File data could not be decompressed", filePath);
+        RL_FREE(data);
+        return NULL;
+    }
+
+    *dataSize = entry->fileSize;
+
+    return data;
+}
+
+#endif // DATA_PACK_IMPLEMENTATION
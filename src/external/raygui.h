@@ -100,7 +100,11 @@
 *       Every icon is codified in binary form, using 1 bit per pixel, so, every 16x16 icon
 *       requires 8 integers (16*16/32) to be stored in memory.
 *
-*       When the icon is draw, actually one quad per pixel is drawn if the bit for that pixel is set.
+*       When the icon is draw, icons are rasterized once into an atlas texture per pixel scale
+*       (lazy loaded on first use) and a single textured quad is drawn per icon; if atlas is not
+*       available (standalone mode or bigger scale), one quad per pixel is drawn if the bit for that pixel is set.
+*       Icons data can be edited through GuiGetIcons() pointer: every GuiGetIcons() call marks atlas textures
+*       to be rasterized again on next icon draw, so call it again after editing through a kept pointer.
 *
 *       The global icons array size is fixed and depends on the number of icons and size:
 *
@@ -134,6 +138,18 @@
 *           Includes custom ricons.h header defining a set of custom icons,
 *           this file can be generated using rGuiIcons tool
 *
+*       #define RAYGUI_NO_ICONS_ATLAS
+*           Avoid rasterizing icons into atlas textures, icons are drawn pixel-by-pixel with rectangles
+*
+*       #define RAYGUI_ICONS_ATLAS_MAX_SCALE
+*           Maximum icon pixel scale rasterized into an atlas texture (default: 4),
+*           icons drawn at bigger scales fallback to pixel-by-pixel drawing
+*
+*       #define RAYGUI_TEXT_CACHE_SIZE
+*           Number of entries of the measured text cache (default: 128, power of 2), entries are keyed
+*           by text pointer, text content hash, font and size; every entry also keeps the glyph run
+*           (codepoints and glyph indices) for texts up to RAYGUI_TEXT_CACHE_MAX_GLYPHS
+*
 *       #define RAYGUI_DEBUG_RECS_BOUNDS
 *           Draw control bounds rectangles for debug
 *
@@ -142,6 +158,8 @@
 *
 *   VERSIONS HISTORY:
 *       4.5-dev (Sep-2024)    Current dev version...
+*                         ADDED: Icons atlas textures, one textured quad per icon drawn
+*                         ADDED: GuiClearTextCache(), measured text widths and glyph runs cache
 *                         ADDED: guiControlExclusiveMode and guiControlExclusiveRec for exclusive modes
 *                         ADDED: GuiValueBoxFloat()
 *                         ADDED: GuiDropdonwBox() properties: DROPDOWN_ARROW_HIDDEN, DROPDOWN_ROLL_UP
@@ -708,6 +726,9 @@ RAYGUIAPI void GuiEnableTooltip(void);                          // Enable gui to
 RAYGUIAPI void GuiDisableTooltip(void);                         // Disable gui tooltips (global state)
 RAYGUIAPI void GuiSetTooltip(const char *tooltip);              // Set tooltip string
 
+// Text cache functionality
+RAYGUIAPI void GuiClearTextCache(void);                         // Clear measured text cache (required on font/style change)
+
 // Icons functionality
 RAYGUIAPI const char *GuiIconText(int iconId, const char *text); // Get text with icon id prepended (if supported)
 #if !defined(RAYGUI_NO_ICONS)
@@ -1355,18 +1376,52 @@ static unsigned int *guiIconsPtr = guiIcons;
     #define RAYGUI_ICON_SIZE             0
 #endif
 
+#if defined(RAYGUI_NO_ICONS) || defined(RAYGUI_STANDALONE)
+    #define RAYGUI_NO_ICONS_ATLAS               // Icons atlas requires icons and raylib textures
+#endif
+
+#ifndef RAYGUI_ICONS_ATLAS_MAX_SCALE
+    #define RAYGUI_ICONS_ATLAS_MAX_SCALE     4      // Maximum icon pixel scale rasterized into atlas
+#endif
+
 // WARNING: Those values define the total size of the style data array,
 // if changed, previous saved styles could become incompatible
 #define RAYGUI_MAX_CONTROLS             16      // Maximum number of controls
 #define RAYGUI_MAX_PROPS_BASE           16      // Maximum number of base properties
 #define RAYGUI_MAX_PROPS_EXTENDED        8      // Maximum number of extended properties
 
+#ifndef RAYGUI_TEXT_CACHE_SIZE
+    #define RAYGUI_TEXT_CACHE_SIZE         128      // Maximum number of measured texts cached (power of 2)
+#endif
+#ifndef RAYGUI_TEXT_CACHE_MAX_GLYPHS
+    #define RAYGUI_TEXT_CACHE_MAX_GLYPHS    64      // Maximum number of glyphs cached per text run
+#endif
+
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
 // Gui control property style color element
 typedef enum { BORDER = 0, BASE, TEXT, OTHER } GuiPropertyElement;
 
+// Gui measured text cache entry
+// NOTE: Key is text pointer + content hash + font + text size and spacing,
+// glyph run is only valid if glyphCount >= 0 (text fits RAYGUI_TEXT_CACHE_MAX_GLYPHS)
+typedef struct GuiTextCacheEntry {
+    const char *text;               // Text pointer (key)
+    unsigned int hash;              // Text content hash (key)
+    int length;                     // Text length in bytes, up to end of line (key)
+    unsigned int fontId;            // Font texture id (key)
+    int fontBaseSize;               // Font base size (key)
+    int textSize;                   // Text size style (key)
+    int textSpacing;                // Text spacing style (key)
+
+    float width;                    // Measured text width (no icon)
+    int glyphCount;                 // Glyph run count, -1 if text too long to be cached
+    int codepoints[RAYGUI_TEXT_CACHE_MAX_GLYPHS];       // Glyph run codepoints
+    unsigned short glyphs[RAYGUI_TEXT_CACHE_MAX_GLYPHS]; // Glyph run font glyph indices
+    unsigned char sizes[RAYGUI_TEXT_CACHE_MAX_GLYPHS];  // Glyph run codepoints size in bytes
+} GuiTextCacheEntry;
+
 //----------------------------------------------------------------------------------
 // Global Variables Definition
 //----------------------------------------------------------------------------------
@@ -1377,6 +1432,10 @@ static bool guiLocked = false;                  // Gui lock state (no inputs pro
 static float guiAlpha = 1.0f;                   // Gui controls transparency
 
 static unsigned int guiIconScale = 1;           // Gui icon default scale (if icons enabled)
+#if !defined(RAYGUI_NO_ICONS_ATLAS)
+static Texture2D guiIconsAtlas[RAYGUI_ICONS_ATLAS_MAX_SCALE] = { 0 }; // Gui icons atlas textures, one per pixel scale (lazy loaded)
+static bool guiIconsAtlasDirty = false;         // Gui icons data could be edited (GuiGetIcons()), atlas rasterized again on next draw
+#endif
 
 static bool guiTooltip = false;                 // Tooltip enabled/disabled
 static const char *guiTooltipPtr = NULL;        // Tooltip string pointer (string provided by user)
@@ -1384,6 +1443,8 @@ static const char *guiTooltipPtr = NULL;        // Tooltip string pointer (strin
 static bool guiControlExclusiveMode = false;    // Gui control exclusive mode (no inputs processed except current control)
 static Rectangle guiControlExclusiveRec = { 0 }; // Gui control exclusive bounds rectangle, used as an unique identifier
 
+static GuiTextCacheEntry guiTextCache[RAYGUI_TEXT_CACHE_SIZE] = { 0 };    // Measured text cache (widths and glyph runs)
+
 static int textBoxCursorIndex = 0;              // Cursor index, shared by all GuiTextBox*()
 //static int blinkCursorFrameCounter = 0;       // Frame counter for cursor blinking
 static int autoCursorCooldownCounter = 0;       // Cooldown frame counter for automatic cursor movement on key-down
@@ -1484,10 +1545,16 @@ static void DrawRectangleGradientV(int posX, int posY, int width, int height, Co
 static void GuiLoadStyleFromMemory(const unsigned char *fileData, int dataSize);    // Load style from memory (binary only)
 
 static int GetTextWidth(const char *text);                      // Gui get text width using gui font and style
+static const GuiTextCacheEntry *GetTextCacheEntry(const char *text); // Gui get measured text from cache (measured on miss)
 static Rectangle GetTextBounds(int control, Rectangle bounds);  // Get text bounds considering control bounds
 static const char *GetTextIcon(const char *text, int *iconId);  // Get text icon if provided and move text cursor
+#if !defined(RAYGUI_NO_ICONS_ATLAS)
+static Texture2D GuiLoadIconsAtlas(int pixelSize);              // Get icons atlas texture for pixel size, rasterized on first request
+static void GuiUnloadIconsAtlas(void);                          // Unload all icons atlas textures (required on icons data change)
+#endif
 
 static void GuiDrawText(const char *text, Rectangle textBounds, int alignment, Color tint);     // Gui draw text using default font
+static void GuiDrawTextGlyph(int index, Vector2 position, float fontSize, Color tint);        // Gui draw font glyph by index (no codepoint lookup)
 static void GuiDrawRectangle(Rectangle rec, int borderWidth, Color borderColor, Color color);   // Gui draw rectangle using default raygui style
 
 static const char **GuiTextSplit(const char *text, char delimiter, int *count, int *textRow);   // Split controls text into multiple strings
@@ -1546,6 +1613,9 @@ void GuiSetFont(Font font)
         if (!guiStyleLoaded) GuiLoadStyleDefault();
 
         guiFont = font;
+
+        // Cached measures could match a new font reusing same texture id
+        GuiClearTextCache();
     }
 }
 
@@ -4293,6 +4363,7 @@ void GuiLoadStyleDefault(void)
 
         // Setup default raylib font
         guiFont = GetFontDefault();
+        GuiClearTextCache();
 
         // NOTE: Default raylib font character 95 is a white square
         Rectangle whiteChar = guiFont.recs[95];
@@ -4302,6 +4373,14 @@ void GuiLoadStyleDefault(void)
     }
 }
 
+// Clear measured text cache
+// NOTE: Entries are keyed by font and style, but clearing is required when a font
+// is unloaded (texture id could be reused) or when styles are reloaded
+void GuiClearTextCache(void)
+{
+    memset(guiTextCache, 0, sizeof(guiTextCache));
+}
+
 // Get text with icon id prepended
 // NOTE: Useful to add icons by name id (enum) instead of
 // a number that can change between ricon versions
@@ -4337,7 +4416,14 @@ const char *GuiIconText(int iconId, const char *text)
 
 #if !defined(RAYGUI_NO_ICONS)
 // Get full icons data pointer
-unsigned int *GuiGetIcons(void) { return guiIconsPtr; }
+// NOTE: Icons data can be edited through returned pointer, atlas textures are rasterized again on next draw
+unsigned int *GuiGetIcons(void)
+{
+#if !defined(RAYGUI_NO_ICONS_ATLAS)
+    guiIconsAtlasDirty = true;
+#endif
+    return guiIconsPtr;
+}
 
 // Load raygui icons file (.rgi)
 // NOTE: In case nameIds are required, they can be requested with loadIconsName,
@@ -4405,6 +4491,11 @@ char **GuiLoadIcons(const char *fileName, bool loadIconsName)
 
             // Read icons data directly over internal icons array
             fread(guiIconsPtr, sizeof(unsigned int), iconCount*(iconSize*iconSize/32), rgiFile);
+
+        #if !defined(RAYGUI_NO_ICONS_ATLAS)
+            // Icons data changed, atlas textures must be rasterized again
+            GuiUnloadIconsAtlas();
+        #endif
         }
 
         fclose(rgiFile);
@@ -4413,11 +4504,39 @@ char **GuiLoadIcons(const char *fileName, bool loadIconsName)
     return guiIconsName;
 }
 
-// Draw selected icon using rectangles pixel-by-pixel
+// Draw selected icon using one textured quad from icons atlas
+// NOTE: If atlas is not available for pixelSize, icon is drawn using rectangles pixel-by-pixel
 void GuiDrawIcon(int iconId, int posX, int posY, int pixelSize, Color color)
 {
     #define BIT_CHECK(a,b) ((a) & (1u<<(b)))
 
+    if ((iconId < 0) || (iconId >= RAYGUI_ICON_MAX_ICONS)) return;
+
+#if !defined(RAYGUI_NO_ICONS_ATLAS)
+    if (guiIconsAtlasDirty)
+    {
+        // Icons data could be edited through GuiGetIcons() pointer, atlas textures must be rasterized again
+        GuiUnloadIconsAtlas();
+        guiIconsAtlasDirty = false;
+    }
+
+    if ((pixelSize >= 1) && (pixelSize <= RAYGUI_ICONS_ATLAS_MAX_SCALE))
+    {
+        Texture2D atlas = GuiLoadIconsAtlas(pixelSize);
+
+        if (atlas.id > 0)
+        {
+            int iconSize = RAYGUI_ICON_SIZE*pixelSize;
+            int columns = atlas.width/iconSize;
+
+            if (color.a > 0) DrawTextureRec(atlas, RAYGUI_CLITERAL(Rectangle){ (float)((iconId%columns)*iconSize), (float)((iconId/columns)*iconSize), (float)iconSize, (float)iconSize },
+                RAYGUI_CLITERAL(Vector2){ (float)posX, (float)posY }, GuiFade(color, guiAlpha));
+
+            return;
+        }
+    }
+#endif
+
     for (int i = 0, y = 0; i < RAYGUI_ICON_SIZE*RAYGUI_ICON_SIZE/32; i++)
     {
         for (int k = 0; k < 32; k++)
@@ -4445,6 +4564,73 @@ void GuiSetIconScale(int scale)
 //----------------------------------------------------------------------------------
 // Module specific Functions Definition
 //----------------------------------------------------------------------------------
+#if !defined(RAYGUI_NO_ICONS_ATLAS)
+// Get icons atlas texture for required pixel size
+// NOTE: Atlas is rasterized on first request (requires graphic context) as a grid of
+// 16 icons per row, white pixels where icon bit is set, tint is applied on drawing
+static Texture2D GuiLoadIconsAtlas(int pixelSize)
+{
+    Texture2D *atlas = &guiIconsAtlas[pixelSize - 1];
+
+    if (atlas->id == 0)
+    {
+        int columns = 16;
+        int rows = (RAYGUI_ICON_MAX_ICONS + columns - 1)/columns;
+        int iconSize = RAYGUI_ICON_SIZE*pixelSize;
+
+        Image image = { 0 };
+        image.width = columns*iconSize;
+        image.height = rows*iconSize;
+        image.mipmaps = 1;
+        image.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+        image.data = RAYGUI_CALLOC(image.width*image.height, 4);
+
+        if (image.data == NULL) return *atlas;
+
+        unsigned int *pixels = (unsigned int *)image.data;
+
+        for (int icon = 0; icon < RAYGUI_ICON_MAX_ICONS; icon++)
+        {
+            int iconX = (icon%columns)*iconSize;
+            int iconY = (icon/columns)*iconSize;
+
+            for (int i = 0, y = 0; i < RAYGUI_ICON_DATA_ELEMENTS; i++)
+            {
+                for (int k = 0; k < 32; k++)
+                {
+                    if (BIT_CHECK(guiIconsPtr[icon*RAYGUI_ICON_DATA_ELEMENTS + i], k))
+                    {
+                        for (int py = 0; py < pixelSize; py++)
+                        {
+                            for (int px = 0; px < pixelSize; px++)
+                            {
+                                pixels[(iconY + y*pixelSize + py)*image.width + iconX + (k%RAYGUI_ICON_SIZE)*pixelSize + px] = 0xffffffff;
+                            }
+                        }
+                    }
+
+                    if ((k == 15) || (k == 31)) y++;
+                }
+            }
+        }
+
+        *atlas = LoadTextureFromImage(image);
+        RAYGUI_FREE(image.data);
+    }
+
+    return *atlas;
+}
+
+// Unload all icons atlas textures, they will be rasterized again on next draw
+static void GuiUnloadIconsAtlas(void)
+{
+    for (int i = 0; i < RAYGUI_ICONS_ATLAS_MAX_SCALE; i++)
+    {
+        if (guiIconsAtlas[i].id > 0) UnloadTexture(guiIconsAtlas[i]);
+        guiIconsAtlas[i] = RAYGUI_CLITERAL(Texture2D){ 0 };
+    }
+}
+#endif
 
 // Load style from memory
 // WARNING: Binary files only
@@ -4668,6 +4854,73 @@ static void GuiLoadStyleFromMemory(const unsigned char *fileData, int dataSize)
     }
 }
 
+// Gui get measured text from cache, text is measured (and cached) on cache miss
+// NOTE: Text is measured up to end of line or line break, text icon is not processed
+static const GuiTextCacheEntry *GetTextCacheEntry(const char *text)
+{
+    // Make sure guiFont is set, GuiGetStyle() initializes it lazynessly
+    int textSize = GuiGetStyle(DEFAULT, TEXT_SIZE);
+    int textSpacing = GuiGetStyle(DEFAULT, TEXT_SPACING);
+
+    if ((text == NULL) || (guiFont.texture.id == 0)) return NULL;
+
+    // Get size in bytes of text and its hash (FNV-1a), considering end of line and line break
+    int length = 0;
+    unsigned int hash = 2166136261u;
+    for (int i = 0; i < MAX_LINE_BUFFER_SIZE; i++)
+    {
+        if ((text[i] != '\0') && (text[i] != '\n'))
+        {
+            hash = (hash ^ (unsigned char)text[i])*16777619u;
+            length++;
+        }
+        else break;
+    }
+
+    unsigned int slot = (hash ^ (unsigned int)(((size_t)text) >> 3))&(RAYGUI_TEXT_CACHE_SIZE - 1);
+    GuiTextCacheEntry *entry = &guiTextCache[slot];
+
+    if ((entry->text == text) && (entry->hash == hash) && (entry->length == length) &&
+        (entry->fontId == guiFont.texture.id) && (entry->fontBaseSize == guiFont.baseSize) &&
+        (entry->textSize == textSize) && (entry->textSpacing == textSpacing)) return entry;
+
+    // Cache miss: measure text and store its glyph run (if it fits)
+    entry->text = text;
+    entry->hash = hash;
+    entry->length = length;
+    entry->fontId = guiFont.texture.id;
+    entry->fontBaseSize = guiFont.baseSize;
+    entry->textSize = textSize;
+    entry->textSpacing = textSpacing;
+    entry->width = 0.0f;
+    entry->glyphCount = 0;
+
+    float scaleFactor = (float)textSize/(float)guiFont.baseSize;
+    float glyphWidth = 0.0f;
+
+    for (int i = 0, codepointSize = 0; i < length; i += codepointSize)
+    {
+        int codepoint = GetCodepointNext(&text[i], &codepointSize);
+        int codepointIndex = GetGlyphIndex(guiFont, codepoint);
+
+        if (guiFont.glyphs[codepointIndex].advanceX == 0) glyphWidth = ((float)guiFont.recs[codepointIndex].width*scaleFactor);
+        else glyphWidth = ((float)guiFont.glyphs[codepointIndex].advanceX*scaleFactor);
+
+        entry->width += (glyphWidth + (float)textSpacing);
+
+        if ((entry->glyphCount >= 0) && (entry->glyphCount < RAYGUI_TEXT_CACHE_MAX_GLYPHS))
+        {
+            entry->codepoints[entry->glyphCount] = codepoint;
+            entry->glyphs[entry->glyphCount] = (unsigned short)codepointIndex;
+            entry->sizes[entry->glyphCount] = (unsigned char)((codepoint == 0x3f)? 1 : codepointSize);
+            entry->glyphCount++;
+        }
+        else entry->glyphCount = -1;
+    }
+
+    return entry;
+}
+
 // Gui get text width considering icon
 static int GetTextWidth(const char *text)
 {
@@ -4694,35 +4947,9 @@ static int GetTextWidth(const char *text)
 
         text += textIconOffset;
 
-        // Make sure guiFont is set, GuiGetStyle() initializes it lazynessly
-        float fontSize = (float)GuiGetStyle(DEFAULT, TEXT_SIZE);
-
-        // Custom MeasureText() implementation
-        if ((guiFont.texture.id > 0) && (text != NULL))
-        {
-            // Get size in bytes of text, considering end of line and line break
-            int size = 0;
-            for (int i = 0; i < MAX_LINE_BUFFER_SIZE; i++)
-            {
-                if ((text[i] != '\0') && (text[i] != '\n')) size++;
-                else break;
-            }
-
-            float scaleFactor = fontSize/(float)guiFont.baseSize;
-            textSize.y = (float)guiFont.baseSize*scaleFactor;
-            float glyphWidth = 0.0f;
-
-            for (int i = 0, codepointSize = 0; i < size; i += codepointSize)
-            {
-                int codepoint = GetCodepointNext(&text[i], &codepointSize);
-                int codepointIndex = GetGlyphIndex(guiFont, codepoint);
-
-                if (guiFont.glyphs[codepointIndex].advanceX == 0) glyphWidth = ((float)guiFont.recs[codepointIndex].width*scaleFactor);
-                else glyphWidth = ((float)guiFont.glyphs[codepointIndex].advanceX*scaleFactor);
-
-                textSize.x += (glyphWidth + (float)GuiGetStyle(DEFAULT, TEXT_SPACING));
-            }
-        }
+        // Custom MeasureText() implementation, measures are cached
+        const GuiTextCacheEntry *entry = GetTextCacheEntry(text);
+        if (entry != NULL) textSize.x = entry->width;
 
         if (textIconOffset > 0) textSize.x += (RAYGUI_ICON_SIZE + ICON_TEXT_PADDING);
     }
@@ -4966,14 +5193,31 @@ static void GuiDrawText(const char *text, Rectangle textBounds, int alignment, C
 
         int ellipsisWidth = GetTextWidth("...");
         bool textOverflow = false;
-        for (int c = 0, codepointSize = 0; c < lineSize; c += codepointSize)
+
+        // Use cached glyph run if available, avoiding codepoints decoding and glyphs lookup
+        const GuiTextCacheEntry *textRun = GetTextCacheEntry(lines[i]);
+        if ((textRun != NULL) && (textRun->glyphCount < 0)) textRun = NULL;
+
+        for (int c = 0, g = 0, codepointSize = 0; c < lineSize; c += codepointSize, g++)
         {
-            int codepoint = GetCodepointNext(&lines[i][c], &codepointSize);
-            int index = GetGlyphIndex(guiFont, codepoint);
+            int codepoint = 0;
+            int index = 0;
 
-            // NOTE: Normally we exit the decoding sequence as soon as a bad byte is found (and return 0x3f)
-            // but we need to draw all of the bad bytes using the '?' symbol moving one byte
-            if (codepoint == 0x3f) codepointSize = 1; // TODO: Review not recognized codepoints size
+            if ((textRun != NULL) && (g < textRun->glyphCount))
+            {
+                codepoint = textRun->codepoints[g];
+                index = textRun->glyphs[g];
+                codepointSize = textRun->sizes[g];
+            }
+            else
+            {
+                codepoint = GetCodepointNext(&lines[i][c], &codepointSize);
+                index = GetGlyphIndex(guiFont, codepoint);
+
+                // NOTE: Normally we exit the decoding sequence as soon as a bad byte is found (and return 0x3f)
+                // but we need to draw all of the bad bytes using the '?' symbol moving one byte
+                if (codepoint == 0x3f) codepointSize = 1; // TODO: Review not recognized codepoints size
+            }
 
             // Get glyph width to check if it goes out of bounds
             if (guiFont.glyphs[index].advanceX == 0) glyphWidth = ((float)guiFont.recs[index].width*scaleFactor);
@@ -5034,7 +5278,7 @@ static void GuiDrawText(const char *text, Rectangle textBounds, int alignment, C
                         {
                             if (textOffsetX <= (textBounds.width - glyphWidth - textBoundsWidthOffset - ellipsisWidth))
                             {
-                                DrawTextCodepoint(guiFont, codepoint, RAYGUI_CLITERAL(Vector2){ textBoundsPosition.x + textOffsetX, textBoundsPosition.y + textOffsetY }, (float)GuiGetStyle(DEFAULT, TEXT_SIZE), GuiFade(tint, guiAlpha));
+                                GuiDrawTextGlyph(index, RAYGUI_CLITERAL(Vector2){ textBoundsPosition.x + textOffsetX, textBoundsPosition.y + textOffsetY }, (float)GuiGetStyle(DEFAULT, TEXT_SIZE), GuiFade(tint, guiAlpha));
                             }
                             else if (!textOverflow)
                             {
@@ -5048,7 +5292,7 @@ static void GuiDrawText(const char *text, Rectangle textBounds, int alignment, C
                         }
                         else
                         {
-                            DrawTextCodepoint(guiFont, codepoint, RAYGUI_CLITERAL(Vector2){ textBoundsPosition.x + textOffsetX, textBoundsPosition.y + textOffsetY }, (float)GuiGetStyle(DEFAULT, TEXT_SIZE), GuiFade(tint, guiAlpha));
+                            GuiDrawTextGlyph(index, RAYGUI_CLITERAL(Vector2){ textBoundsPosition.x + textOffsetX, textBoundsPosition.y + textOffsetY }, (float)GuiGetStyle(DEFAULT, TEXT_SIZE), GuiFade(tint, guiAlpha));
                         }
                     }
                     else if ((wrapMode == TEXT_WRAP_CHAR) || (wrapMode == TEXT_WRAP_WORD))
@@ -5056,7 +5300,7 @@ static void GuiDrawText(const char *text, Rectangle textBounds, int alignment, C
                         // Draw only glyphs inside the bounds
                         if ((textBoundsPosition.y + textOffsetY) <= (textBounds.y + textBounds.height - GuiGetStyle(DEFAULT, TEXT_SIZE)))
                         {
-                            DrawTextCodepoint(guiFont, codepoint, RAYGUI_CLITERAL(Vector2){ textBoundsPosition.x + textOffsetX, textBoundsPosition.y + textOffsetY }, (float)GuiGetStyle(DEFAULT, TEXT_SIZE), GuiFade(tint, guiAlpha));
+                            GuiDrawTextGlyph(index, RAYGUI_CLITERAL(Vector2){ textBoundsPosition.x + textOffsetX, textBoundsPosition.y + textOffsetY }, (float)GuiGetStyle(DEFAULT, TEXT_SIZE), GuiFade(tint, guiAlpha));
                         }
                     }
                 }
@@ -5076,6 +5320,28 @@ static void GuiDrawText(const char *text, Rectangle textBounds, int alignment, C
 #endif
 }
 
+// Gui draw font glyph by glyph index
+// NOTE: Same as DrawTextCodepoint() but glyph index is already resolved (cached glyph runs)
+static void GuiDrawTextGlyph(int index, Vector2 position, float fontSize, Color tint)
+{
+#if defined(RAYGUI_STANDALONE)
+    DrawTextCodepoint(guiFont, guiFont.glyphs[index].value, position, fontSize, tint);
+#else
+    float scaleFactor = fontSize/guiFont.baseSize;
+    float padding = (float)guiFont.glyphPadding;
+
+    Rectangle srcRec = { guiFont.recs[index].x - padding, guiFont.recs[index].y - padding,
+                         guiFont.recs[index].width + 2.0f*padding, guiFont.recs[index].height + 2.0f*padding };
+
+    Rectangle dstRec = { position.x + guiFont.glyphs[index].offsetX*scaleFactor - padding*scaleFactor,
+                         position.y + guiFont.glyphs[index].offsetY*scaleFactor - padding*scaleFactor,
+                         (guiFont.recs[index].width + 2.0f*padding)*scaleFactor,
+                         (guiFont.recs[index].height + 2.0f*padding)*scaleFactor };
+
+    DrawTexturePro(guiFont.texture, srcRec, dstRec, RAYGUI_CLITERAL(Vector2){ 0, 0 }, 0.0f, tint);
+#endif
+}
+
 // Gui draw rectangle using default raygui plain style with borders
 static void GuiDrawRectangle(Rectangle rec, int borderWidth, Color borderColor, Color color)
 {
@@ -5104,7 +5370,10 @@ static void GuiTooltip(Rectangle controlRec)
 {
     if (!guiLocked && guiTooltip && (guiTooltipPtr != NULL) && !guiControlExclusiveMode)
     {
-        Vector2 textSize = MeasureTextEx(GuiGetFont(), guiTooltipPtr, (float)GuiGetStyle(DEFAULT, TEXT_SIZE), (float)GuiGetStyle(DEFAULT, TEXT_SPACING));
+        // NOTE: Tooltip is measured from text cache, last glyph spacing is not considered (as MeasureTextEx())
+        const GuiTextCacheEntry *entry = GetTextCacheEntry(guiTooltipPtr);
+        Vector2 textSize = { 0 };
+        if (entry != NULL) textSize.x = entry->width - (float)GuiGetStyle(DEFAULT, TEXT_SPACING);
 
         if ((controlRec.x + textSize.x + 16) > GetScreenWidth()) controlRec.x -= (textSize.x + 16 - controlRec.width);
 
@@ -0,0 +1,327 @@
+/*******************************************************************************************
+*
+*   File Batch - Crash-safe output files: temp files synced at batch end, renamed into place
+*
+*   MODULE USAGE:
+*       #define FILE_BATCH_IMPLEMENTATION
+*       #include "file_batch.h"
+*
+*       FileBatch *batch = BeginFileBatch();
+*       FILE *file = OpenBatchFile(batch, "posts/new/index.md");   // Written as "posts/new/index.md.tmp"
+*       fputs(text, file);
+*       CloseBatchFile(batch, file);
+*       SaveBatchFileData(batch, "posts/new/banner.png", data, dataSize);
+*       if (!EndFileBatch(batch)) ...                                // Files are synced and renamed into place
+*
+*   NOTES:
+*       Files of a batch are written to temp files (<fileName>.tmp), previous files are not touched
+*       until EndFileBatch(): temp files are flushed to disk, renamed over final files and their
+*       folders are synced, so a crash or a full disk never leaves a truncated file in place
+*
+*       Disk sync is the expensive part, it is deferred to batch end instead of after every write:
+*       every temp file is synced once (fdatasync() on Linux, data must be on disk before rename
+*       or a crash can leave an empty file in place) and then every folder once. A single sync per
+*       batch (syncfs()) is not used, it flushes all dirty data of the filesystem, not only batch files.
+*       Every file is replaced atomically, but a batch is not: a crash in the middle of the renames
+*       can leave some files replaced and others not
+*
+*       Any write error (CloseBatchFile() or Save*() failure) makes EndFileBatch() discard all
+*       batch temp files and return false
+*
+*   LICENSE: GPLv3, check LICENSE file for details
+*
+**********************************************************************************************/
+
+#ifndef FILE_BATCH_H
+#define FILE_BATCH_H
+
+#include <stdio.h>          // Required for: FILE
+#include <stdbool.h>        // Required for: bool
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define FILE_BATCH_TEMP_EXTENSION   ".tmp"  // Temp file name: <fileName>.tmp
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// File batch, opaque type
+typedef struct FileBatch FileBatch;
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+FileBatch *BeginFileBatch(void);                                // Begin file batch
+bool EndFileBatch(FileBatch *batch);                            // End file batch: sync and rename files into place (batch is freed)
+void AbortFileBatch(FileBatch *batch);                          // Abort file batch: temp files are removed (batch is freed)
+
+const char *AddBatchFile(FileBatch *batch, const char *fileName); // Add file to batch, returns temp file name to be written by caller
+FILE *OpenBatchFile(FileBatch *batch, const char *fileName);    // Add file to batch and open its temp file for writing (binary)
+bool CloseBatchFile(FileBatch *batch, FILE *file);              // Close batch file, write errors make batch fail
+bool SaveBatchFileData(FileBatch *batch, const char *fileName, const void *data, int dataSize); // Save data as batch file
+bool SaveBatchFileText(FileBatch *batch, const char *fileName, const char *text); // Save text as batch file
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FILE_BATCH_H
+
+/***********************************************************************************
+*
+*   FILE BATCH IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(FILE_BATCH_IMPLEMENTATION)
+
+#include <stdlib.h>         // Required for: calloc(), realloc(), free()
+#include <string.h>         // Required for: strlen(), strcmp(), strrchr()
+
+#if defined(_WIN32)
+    #include <io.h>         // Required for: _open(), _commit(), _close()
+    #include <fcntl.h>      // Required for: _O_RDWR, _O_BINARY
+
+    // NOTE: windows.h is not included to avoid conflicts with raylib symbols
+    #define FILE_BATCH_MOVEFILE_REPLACE_EXISTING    0x00000001
+    #define FILE_BATCH_MOVEFILE_WRITE_THROUGH       0x00000008
+    __declspec(dllimport) int __stdcall MoveFileExA(const char *existingFileName, const char *newFileName, unsigned long flags);
+#else
+    #include <fcntl.h>      // Required for: open(), O_RDONLY
+    #include <unistd.h>     // Required for: fsync(), fdatasync(), close()
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Batch file
+typedef struct BatchFile {
+    char fileName[512];             // Final file name
+    char tempFileName[520];         // Temp file name, written until batch end
+} BatchFile;
+
+struct FileBatch {
+    BatchFile *files;
+    int count;
+    int capacity;
+    bool failed;                    // Write error, batch is discarded on end
+};
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+// Get file folder, "." for file names without path
+static void GetBatchFileFolder(const char *fileName, char *folder, int size)
+{
+    snprintf(folder, size, "%s", fileName);
+
+    char *separator = strrchr(folder, '/');
+#if defined(_WIN32)
+    char *backslash = strrchr(folder, '\\');
+    if ((backslash != NULL) && ((separator == NULL) || (backslash > separator))) separator = backslash;
+#endif
+
+    if (separator == NULL) snprintf(folder, size, ".");
+    else if (separator == folder) separator[1] = '\0';
+    else separator[0] = '\0';
+}
+
+// Flush batch temp files to disk, one sync per file in a single pass at batch end
+static bool SyncBatchFiles(FileBatch *batch)
+{
+    bool success = true;
+
+#if defined(_WIN32)
+    for (int i = 0; (i < batch->count) && success; i++)
+    {
+        int fd = _open(batch->files[i].tempFileName, _O_RDWR | _O_BINARY);
+        success = (fd >= 0) && (_commit(fd) == 0);
+        if (fd >= 0) _close(fd);
+    }
+#else
+    for (int i = 0; (i < batch->count) && success; i++)
+    {
+        int fd = open(batch->files[i].tempFileName, O_RDONLY);
+    #if defined(__linux__)
+        success = (fd >= 0) && (fdatasync(fd) == 0);    // File data and size, metadata (times) not required
+    #else
+        success = (fd >= 0) && (fsync(fd) == 0);
+    #endif
+        if (fd >= 0) close(fd);
+    }
+#endif
+
+    return success;
+}
+
+// Sync folders of batch files, so renames are on disk
+// NOTE: Not supported on Windows, renames are written through
+static void SyncBatchFolders(FileBatch *batch)
+{
+#if !defined(_WIN32)
+    for (int i = 0; i < batch->count; i++)
+    {
+        char folder[512] = { 0 };
+        GetBatchFileFolder(batch->files[i].fileName, folder, sizeof(folder));
+
+        // Every folder is synced once
+        bool synced = false;
+        for (int k = 0; (k < i) && !synced; k++)
+        {
+            char previousFolder[512] = { 0 };
+            GetBatchFileFolder(batch->files[k].fileName, previousFolder, sizeof(previousFolder));
+            synced = (strcmp(folder, previousFolder) == 0);
+        }
+        if (synced) continue;
+
+        int fd = open(folder, O_RDONLY);
+        if (fd >= 0)
+        {
+            fsync(fd);
+            close(fd);
+        }
+    }
+#endif
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Begin file batch
+FileBatch *BeginFileBatch(void)
+{
+    return (FileBatch *)calloc(1, sizeof(FileBatch));
+}
+
+// End file batch: temp files are synced to disk, renamed over final files and folders are synced
+// NOTE: If any batch file failed to be written, all temp files are removed and no file is replaced
+bool EndFileBatch(FileBatch *batch)
+{
+    if (batch == NULL) return false;
+
+    bool success = !batch->failed && SyncBatchFiles(batch);
+
+    if (!success)
+    {
+        AbortFileBatch(batch);
+        return false;
+    }
+
+    for (int i = 0; i < batch->count; i++)
+    {
+#if defined(_WIN32)
+        // NOTE: rename() does not replace existing files on Windows
+        bool renamed = (MoveFileExA(batch->files[i].tempFileName, batch->files[i].fileName,
+            FILE_BATCH_MOVEFILE_REPLACE_EXISTING | FILE_BATCH_MOVEFILE_WRITE_THROUGH) != 0);
+#else
+        bool renamed = (rename(batch->files[i].tempFileName, batch->files[i].fileName) == 0);
+#endif
+        if (!renamed)
+        {
+            remove(batch->files[i].tempFileName);
+            success = false;
+        }
+    }
+
+    SyncBatchFolders(batch);
+
+    free(batch->files);
+    free(batch);
+
+    return success;
+}
+
+// Abort file batch, temp files are removed and final files are not touched
+void AbortFileBatch(FileBatch *batch)
+{
+    if (batch == NULL) return;
+
+    for (int i = 0; i < batch->count; i++) remove(batch->files[i].tempFileName);
+
+    free(batch->files);
+    free(batch);
+}
+
+// Add file to batch, returns temp file name to be written by caller (i.e. external writers)
+// NOTE: A file added twice keeps a single entry, last written temp file data is used
+const char *AddBatchFile(FileBatch *batch, const char *fileName)
+{
+    if ((batch == NULL) || (strlen(fileName) >= sizeof(batch->files[0].fileName)))
+    {
+        if (batch != NULL) batch->failed = true;
+        return NULL;
+    }
+
+    for (int i = 0; i < batch->count; i++)
+    {
+        if (strcmp(batch->files[i].fileName, fileName) == 0) return batch->files[i].tempFileName;
+    }
+
+    if (batch->count >= batch->capacity)
+    {
+        int capacity = (batch->capacity > 0)? batch->capacity*2 : 8;
+        BatchFile *files = (BatchFile *)realloc(batch->files, capacity*sizeof(BatchFile));
+        if (files == NULL)
+        {
+            batch->failed = true;
+            return NULL;
+        }
+
+        batch->files = files;
+        batch->capacity = capacity;
+    }
+
+    BatchFile *file = &batch->files[batch->count++];
+    snprintf(file->fileName, sizeof(file->fileName), "%s", fileName);
+    snprintf(file->tempFileName, sizeof(file->tempFileName), "%s" FILE_BATCH_TEMP_EXTENSION, fileName);
+
+    return file->tempFileName;
+}
+
+// Add file to batch and open its temp file for writing (binary mode)
+FILE *OpenBatchFile(FileBatch *batch, const char *fileName)
+{
+    const char *tempFileName = AddBatchFile(batch, fileName);
+    FILE *file = (tempFileName != NULL)? fopen(tempFileName, "wb") : NULL;
+
+    if ((file == NULL) && (batch != NULL)) batch->failed = true;
+
+    return file;
+}
+
+// Close batch file, write errors (i.e. disk full) make batch fail
+bool CloseBatchFile(FileBatch *batch, FILE *file)
+{
+    if (file == NULL) return false;
+
+    bool success = (ferror(file) == 0);
+    if (fclose(file) != 0) success = false;
+    if (!success) batch->failed = true;
+
+    return success;
+}
+
+// Save data as batch file
+bool SaveBatchFileData(FileBatch *batch, const char *fileName, const void *data, int dataSize)
+{
+    FILE *file = OpenBatchFile(batch, fileName);
+    if (file == NULL) return false;
+
+    bool success = (dataSize <= 0) || (fwrite(data, 1, dataSize, file) == (size_t)dataSize);
+    if (!success) batch->failed = true;
+
+    return CloseBatchFile(batch, file) && success;
+}
+
+// Save text as batch file
+bool SaveBatchFileText(FileBatch *batch, const char *fileName, const char *text)
+{
+    return SaveBatchFileData(batch, fileName, text, (int)strlen(text));
+}
+
+#endif // FILE_BATCH_IMPLEMENTATION
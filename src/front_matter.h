@@ -0,0 +1,1275 @@
+/*******************************************************************************************
+*
+*   Front Matter - Front matter parsing and site-wide rewriting (rename/merge/remove taxonomy values)
+*
+*   MODULE USAGE:
+*       #define FRONT_MATTER_IMPLEMENTATION
+*       #include "front_matter.h"
+*
+*       FrontMatterFile file = LoadFrontMatterFile("content/blog/post/index.md");    // Memory mapped
+*       FrontMatterParser parser = InitFrontMatterParser(file.data, file.dataSize);
+*       FrontMatterField field = { 0 };
+*       char title[256] = { 0 };
+*       while (NextFrontMatterField(&parser, &field))
+*       {
+*           FrontMatterSlice value = { 0 };
+*           if (IsFrontMatterKey(field.key, "title")) DecodeFrontMatterString(field.value, title, 256);    // "a \"b\"" -> a "b"
+*           else if (!field.list) printf("%.*s = %.*s\n", field.key.length, field.key.text, field.value.length, field.value.text);
+*           else while (NextFrontMatterValue(&field, &value)) printf("%.*s\n", value.length, value.text);
+*       }
+*       const char *body = file.data + parser.bodyOffset;
+*       UnloadFrontMatterFile(&file);
+*
+*       FrontMatterRule rules[2] = { 0 };
+*       ParseFrontMatterRule("tags:golang=go", &rules[0]);         // Rename (merge if "go" already set)
+*       ParseFrontMatterRule("categories:drafts=", &rules[1]);     // Remove value
+*       FrontMatterRewriteStats stats = RewriteSiteFrontMatter("target/content/blog", rules, 2, pool);
+*
+*   NOTES:
+*       Parser is a streaming line scanner with no heap allocation: keys and values are slices
+*       (pointer and length) into source text, quotes removed but escape sequences not decoded:
+*       DecodeFrontMatterString() copies a value decoded (\" \\ \n \uXXXX... in double quotes, '' in single).
+*       Parsing stops at closing delimiter, body is never touched (mapped pages not loaded): values are
+*       never scanned past it (unclosed arrays end at line end) and unterminated front matter is not parsed.
+*       TOML tables ([taxonomies]) and YAML parent keys (taxonomies:) are reported as field table.
+*       Multi-line values are reported as one value: YAML block scalars (key: | or key: >, indented lines)
+*       and TOML multi-line strings (""" or '''), DecodeFrontMatterString() removes block indentation
+*
+*       Supported front matter: TOML (+++ delimited, Hugo/Zola) and YAML (--- delimited, Jekyll/
+*       Eleventy). Rules apply to inline arrays (tags = ["a", "b"], tags: [a, b]), YAML block lists
+*       (- a) and scalar values (author = "a"); renamed values that end duplicated are merged
+*
+*       Only front matter region is read and rewritten: files are read until closing delimiter,
+*       body is never parsed. Fields are found by the parser, changed values are spliced at their
+*       source position (block scalars and multi-line strings are not rewritten). If rewritten
+*       front matter keeps its size it is overwritten in place, otherwise file is rewritten to a
+*       temp file (body streamed) and renamed into place
+*
+*       Files are processed in parallel on worker pool, in jobs of FRONT_MATTER_FILES_PER_JOB files
+*
+*   DEPENDENCIES:
+*       worker_pool.h   - Parallel files rewriting
+*
+*   LICENSE: GPLv3, check LICENSE file for details
+*
+**********************************************************************************************/
+
+#ifndef FRONT_MATTER_H
+#define FRONT_MATTER_H
+
+#include "worker_pool.h"
+
+#include <stdbool.h>        // Required for: bool
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define FRONT_MATTER_MAX_RULES          32          // Max rules applied in one rewrite
+#define FRONT_MATTER_MAX_ITEMS          256         // Max values of a front matter list
+#define FRONT_MATTER_MAX_SIZE           (1024*1024) // Max front matter region size, bigger regions are not rewritten
+#define FRONT_MATTER_FILES_PER_JOB      64          // Files rewritten by a worker job
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Front matter rewrite rule: value of key renamed (merged if new value already set) or removed
+typedef struct FrontMatterRule {
+    char key[32];                   // Front matter key (tags, categories, authors...)
+    char from[64];                  // Value to replace
+    char to[64];                    // New value, empty to remove value
+} FrontMatterRule;
+
+// Front matter format
+typedef enum {
+    FRONT_MATTER_NONE = 0,          // No front matter
+    FRONT_MATTER_TOML,              // +++ delimited (Hugo, Zola)
+    FRONT_MATTER_YAML               // --- delimited (Jekyll, Eleventy, Hugo)
+} FrontMatterFormat;
+
+// Text slice, view into source text (not NULL terminated)
+typedef struct FrontMatterSlice {
+    const char *text;
+    int length;
+    char quote;                     // Quote of quoted value ('"' or '\''), YAML block scalar style ('|' or '>'), 0 if not quoted
+} FrontMatterSlice;
+
+// Front matter field (key/value pair)
+typedef struct FrontMatterField {
+    FrontMatterSlice table;         // TOML table or YAML parent key, empty for root keys
+    FrontMatterSlice key;
+    FrontMatterSlice value;         // Scalar value (quotes removed) or list values, iterated with NextFrontMatterValue()
+    bool list;                      // Value is a list: inline array or YAML block list
+    bool blockList;                 // Value is a YAML block list ("- value" lines)
+} FrontMatterField;
+
+// Front matter parser state
+typedef struct FrontMatterParser {
+    const char *text;
+    int size;
+    FrontMatterFormat format;
+    int position;                   // Next line to parse
+    int end;                        // Closing delimiter line start, values are not scanned past it
+    FrontMatterSlice table;         // Current table (TOML) or parent key (YAML)
+    int bodyOffset;                 // Body start, set once closing delimiter is reached (0 if no front matter)
+    bool done;                      // Closing delimiter reached
+} FrontMatterParser;
+
+// Front matter file, memory mapped (read-only)
+typedef struct FrontMatterFile {
+    const char *data;
+    int dataSize;
+    bool mapped;                    // Data is memory mapped, otherwise it is loaded (Windows)
+} FrontMatterFile;
+
+// Markdown files list, names stored in a single buffer
+typedef struct FrontMatterFiles {
+    char *names;
+    int namesSize;
+    int namesCapacity;
+    int *offsets;                   // File name offset in names buffer
+    int count;
+    int capacity;
+} FrontMatterFiles;
+
+// Site front matter rewrite result
+typedef struct FrontMatterRewriteStats {
+    int fileCount;                  // Markdown files processed
+    int changedCount;               // Files rewritten
+    int failedCount;                // Files that could not be read or written
+} FrontMatterRewriteStats;
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+FrontMatterParser InitFrontMatterParser(const char *text, int size);    // Init front matter parser, format is FRONT_MATTER_NONE if text has no front matter
+bool NextFrontMatterField(FrontMatterParser *parser, FrontMatterField *field); // Parse next field, false once closing delimiter is reached
+bool NextFrontMatterValue(FrontMatterField *field, FrontMatterSlice *value); // Get next value of list field (field value is consumed)
+bool IsFrontMatterKey(FrontMatterSlice key, const char *text);           // Check if key (or any slice) is equal to text
+int DecodeFrontMatterString(FrontMatterSlice value, char *text, int size); // Decode value escape sequences into text (NULL terminated), returns decoded length
+
+FrontMatterFile LoadFrontMatterFile(const char *fileName);              // Load (map) markdown file
+void UnloadFrontMatterFile(FrontMatterFile *file);                      // Unload (unmap) markdown file
+FrontMatterFiles LoadFrontMatterFiles(const char *folderPath);          // Load markdown files list of folder (recursive)
+void UnloadFrontMatterFiles(FrontMatterFiles *files);                   // Unload markdown files list
+
+bool ParseFrontMatterRule(const char *text, FrontMatterRule *rule);     // Parse rule from text: "<key>:<from>=<to>"
+int GetFrontMatterSize(const char *text, int textSize);                  // Get front matter region size (delimiters included), 0 if none
+char *RewriteFrontMatter(const char *text, int textSize, const FrontMatterRule *rules, int ruleCount, int *regionSize, int *newRegionSize); // Rewrite front matter region, NULL if unchanged, free with free()
+int RewriteFrontMatterFile(const char *fileName, const FrontMatterRule *rules, int ruleCount); // Rewrite file front matter, returns 1 if changed, 0 unchanged, -1 on error
+FrontMatterRewriteStats RewriteSiteFrontMatter(const char *folderPath, const FrontMatterRule *rules, int ruleCount, WorkerPool *pool); // Rewrite front matter of all markdown files in folder (recursive)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FRONT_MATTER_H
+
+/***********************************************************************************
+*
+*   FRONT MATTER IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(FRONT_MATTER_IMPLEMENTATION)
+
+#include <stdio.h>          // Required for: FILE, fopen(), fread(), fwrite(), rename(), snprintf()
+#include <stdlib.h>         // Required for: malloc(), realloc(), free()
+#include <string.h>         // Required for: memcpy(), strlen(), strncmp(), strchr()
+#include <dirent.h>         // Required for: opendir(), readdir(), closedir()
+#include <sys/stat.h>       // Required for: stat()
+
+#if !defined(_WIN32)
+    #include <fcntl.h>      // Required for: open()
+    #include <unistd.h>     // Required for: close()
+    #include <sys/mman.h>   // Required for: mmap(), munmap()
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Growable text buffer
+typedef struct FrontMatterBuffer {
+    char *data;
+    int size;
+    int capacity;
+    bool failed;                    // Allocation failed
+} FrontMatterBuffer;
+
+// Front matter value to rewrite, parsed value (or rule value once renamed) and its source span
+typedef struct FrontMatterItem {
+    FrontMatterSlice value;         // Parsed value slice, rule new value if renamed
+    int start;                      // Source value span, quotes included
+    int end;
+    bool renamed;                   // Value renamed by a rule, written from rule value
+} FrontMatterItem;
+
+// Site rewrite jobs data
+typedef struct FrontMatterJobs {
+    const FrontMatterFiles *files;
+    const FrontMatterRule *rules;
+    int ruleCount;
+    signed char *results;           // Per file result: 1 changed, 0 unchanged, -1 error
+} FrontMatterJobs;
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+// Append text to buffer
+static void AppendFrontMatterText(FrontMatterBuffer *buffer, const char *text, int length)
+{
+    if (buffer->failed || (length <= 0)) return;
+
+    if ((buffer->size + length + 1) > buffer->capacity)
+    {
+        int capacity = (buffer->capacity > 0)? buffer->capacity*2 : 1024;
+        while (capacity < (buffer->size + length + 1)) capacity *= 2;
+
+        char *data = (char *)realloc(buffer->data, capacity);
+        if (data == NULL)
+        {
+            buffer->failed = true;
+            return;
+        }
+
+        buffer->data = data;
+        buffer->capacity = capacity;
+    }
+
+    memcpy(buffer->data + buffer->size, text, length);
+    buffer->size += length;
+    buffer->data[buffer->size] = '\0';
+}
+
+// Append value: source value copied verbatim, renamed value quoted as source value
+// NOTE: Renamed value is double quoted (escaped) if source quotes or unquoted value can not hold it
+static void AppendFrontMatterItem(FrontMatterBuffer *buffer, const char *text, const FrontMatterItem *item)
+{
+    if (!item->renamed)
+    {
+        AppendFrontMatterText(buffer, text + item->start, item->end - item->start);
+        return;
+    }
+
+    const char *value = item->value.text;
+    int length = item->value.length;
+    char quote = item->value.quote;
+
+    for (int i = 0; (i < length) && (quote != '"'); i++)
+    {
+        if ((quote == '\'') && (value[i] == '\'')) quote = '"';
+        else if ((quote == 0) && (strchr(",[]{}#:\"'\\", value[i]) != NULL)) quote = '"';
+    }
+    if ((quote == 0) && ((length == 0) || (value[0] == ' ') || (value[length - 1] == ' ') || (strchr("-?&*!|>%@`", value[0]) != NULL))) quote = '"';
+
+    if (quote != 0) AppendFrontMatterText(buffer, &quote, 1);
+    for (int i = 0; i < length; i++)
+    {
+        if ((quote == '"') && ((value[i] == '"') || (value[i] == '\\'))) AppendFrontMatterText(buffer, "\\", 1);
+        AppendFrontMatterText(buffer, value + i, 1);
+    }
+    if (quote != 0) AppendFrontMatterText(buffer, &quote, 1);
+}
+
+// Get line end position (position of '\n' or text end)
+static int GetFrontMatterLineEnd(const char *text, int textSize, int position)
+{
+    const char *end = (const char *)memchr(text + position, '\n', textSize - position);
+    return (end != NULL)? (int)(end - text) : textSize;
+}
+
+// Check if line is a front matter delimiter line ("+++" or "---", optional '\r')
+static bool IsFrontMatterDelimiter(const char *text, int textSize, int position, char delimiter)
+{
+    int lineEnd = GetFrontMatterLineEnd(text, textSize, position);
+    if ((lineEnd > position) && (text[lineEnd - 1] == '\r')) lineEnd--;
+
+    return ((lineEnd - position) == 3) && (text[position] == delimiter) && (text[position + 1] == delimiter) && (text[position + 2] == delimiter);
+}
+
+// Find front matter: closing delimiter line start and region end (after closing delimiter line)
+// NOTE: If text is not complete (file partially read), closing delimiter must be followed by a line end
+static bool FindFrontMatter(const char *text, int textSize, bool complete, int *closeStart, int *regionEnd)
+{
+    if ((textSize < 4) || ((text[0] != '+') && (text[0] != '-'))) return false;
+
+    char delimiter = text[0];
+    int position = GetFrontMatterLineEnd(text, textSize, 0);
+    if ((position >= textSize) || !IsFrontMatterDelimiter(text, textSize, 0, delimiter)) return false;
+    position++;
+
+    while (position < textSize)
+    {
+        int lineEnd = GetFrontMatterLineEnd(text, textSize, position);
+        if ((lineEnd >= textSize) && !complete) return false;
+
+        if (IsFrontMatterDelimiter(text, textSize, position, delimiter))
+        {
+            *closeStart = position;
+            *regionEnd = (lineEnd < textSize)? lineEnd + 1 : textSize;
+            return true;
+        }
+
+        position = lineEnd + 1;
+    }
+
+    return false;
+}
+
+// Find end of value span (closing quote or bracket), quoted text is skipped, -1 if not found
+static int FindFrontMatterValueEnd(const char *text, int position, int end, char close)
+{
+    char quote = 0;
+
+    for (int i = position; i < end; i++)
+    {
+        if (quote != 0)
+        {
+            if ((text[i] == '\\') && (quote == '"')) i++;
+            else if (text[i] == quote) quote = 0;
+        }
+        else if ((text[i] == '"') || (text[i] == '\'')) quote = text[i];
+        else if (text[i] == close) return i;
+    }
+
+    return -1;
+}
+
+// Find closing quote of quoted text (position after opening quote), -1 if not found
+// NOTE: Backslash escapes are skipped in double quoted text (TOML basic strings, YAML double quoted),
+// doubled quotes in single quoted text (YAML, 'it''s')
+static int FindFrontMatterQuoteEnd(const char *text, int position, int end, char quote)
+{
+    for (int i = position; i < end; i++)
+    {
+        if ((text[i] == '\\') && (quote == '"')) i++;
+        else if ((text[i] == '\'') && (quote == '\'') && ((i + 1) < end) && (text[i + 1] == '\'')) i++;
+        else if (text[i] == quote) return i;
+    }
+
+    return -1;
+}
+
+// Get parsed value as rewrite item, source span includes quotes
+static FrontMatterItem GetFrontMatterItem(const char *text, FrontMatterSlice value)
+{
+    FrontMatterItem item = { 0 };
+    item.value = value;
+    item.start = (int)(value.text - text) - ((value.quote != 0)? 1 : 0);
+    item.end = (int)(value.text - text) + value.length + ((value.quote != 0)? 1 : 0);
+
+    return item;
+}
+
+// Get item value decoded into text (NULL terminated), returns decoded length
+static int GetFrontMatterItemText(const FrontMatterItem *item, char *text, int size)
+{
+    FrontMatterSlice value = item->value;
+    if (item->renamed) value.quote = 0;     // Rule values are not escaped
+
+    return DecodeFrontMatterString(value, text, size);
+}
+
+// Check if item value (decoded) is equal to text, values too long to decode are never equal
+static bool IsFrontMatterItemText(const FrontMatterItem *item, const char *text)
+{
+    char value[256] = { 0 };
+    int length = GetFrontMatterItemText(item, value, (int)sizeof(value));
+
+    return (length < (int)(sizeof(value) - 1)) && (strcmp(value, text) == 0);
+}
+
+// Apply rules of key to values: values renamed or removed, duplicated values merged
+// NOTE: Returns true if values changed
+static bool ApplyFrontMatterRules(const FrontMatterRule *rules, int ruleCount, FrontMatterSlice key, FrontMatterItem *items, int *count)
+{
+    bool changed = false;
+
+    for (int r = 0; r < ruleCount; r++)
+    {
+        if (!IsFrontMatterKey(key, rules[r].key)) continue;
+
+        for (int i = 0; i < *count; i++)
+        {
+            if (!IsFrontMatterItemText(&items[i], rules[r].from)) continue;
+
+            if (rules[r].to[0] != '\0')
+            {
+                items[i].value.text = rules[r].to;
+                items[i].value.length = (int)strlen(rules[r].to);
+                items[i].renamed = true;
+            }
+            else
+            {
+                memmove(&items[i], &items[i + 1], (*count - i - 1)*sizeof(FrontMatterItem));
+                (*count)--;
+                i--;
+            }
+
+            changed = true;
+        }
+    }
+
+    // Merge duplicated values (i.e. tag renamed to an existing tag), first one is kept
+    if (changed)
+    {
+        for (int i = 0; i < *count; i++)
+        {
+            char value[256] = { 0 };
+            if (GetFrontMatterItemText(&items[i], value, (int)sizeof(value)) >= (int)(sizeof(value) - 1)) continue;
+
+            for (int j = i + 1; j < *count; j++)
+            {
+                if (!IsFrontMatterItemText(&items[j], value)) continue;
+
+                memmove(&items[j], &items[j + 1], (*count - j - 1)*sizeof(FrontMatterItem));
+                (*count)--;
+                j--;
+            }
+        }
+    }
+
+    return changed;
+}
+
+// Check if any rule applies to key
+static bool IsFrontMatterRuleKey(const FrontMatterRule *rules, int ruleCount, FrontMatterSlice key)
+{
+    for (int r = 0; r < ruleCount; r++)
+    {
+        if (IsFrontMatterKey(key, rules[r].key)) return true;
+    }
+
+    return false;
+}
+
+// Add markdown files in folder to list, subfolders are scanned recursively
+static void ScanFrontMatterFiles(const char *folderPath, FrontMatterFiles *files)
+{
+    DIR *dir = opendir(folderPath);
+    if (dir == NULL) return;
+
+    struct dirent *entry = NULL;
+    while ((entry = readdir(dir)) != NULL)
+    {
+        if (entry->d_name[0] == '.') continue;     // Current/parent folders and hidden files (i.e. .git)
+
+        char path[1024] = { 0 };
+        if (snprintf(path, sizeof(path), "%s/%s", folderPath, entry->d_name) >= (int)sizeof(path)) continue;
+
+        int length = (int)strlen(entry->d_name);
+        bool markdown = (length > 3) && (strcmp(entry->d_name + length - 3, ".md") == 0);
+
+        struct stat info = { 0 };
+        if (stat(path, &info) != 0) continue;
+
+        if (S_ISDIR(info.st_mode)) ScanFrontMatterFiles(path, files);
+        else if (markdown && S_ISREG(info.st_mode))
+        {
+            int pathLength = (int)strlen(path) + 1;
+
+            if ((files->namesSize + pathLength) > files->namesCapacity)
+            {
+                int capacity = (files->namesCapacity > 0)? files->namesCapacity*2 : 64*1024;
+                while (capacity < (files->namesSize + pathLength)) capacity *= 2;
+                char *names = (char *)realloc(files->names, capacity);
+                if (names == NULL) break;
+                files->names = names;
+                files->namesCapacity = capacity;
+            }
+
+            if (files->count >= files->capacity)
+            {
+                int capacity = (files->capacity > 0)? files->capacity*2 : 1024;
+                int *offsets = (int *)realloc(files->offsets, capacity*sizeof(int));
+                if (offsets == NULL) break;
+                files->offsets = offsets;
+                files->capacity = capacity;
+            }
+
+            memcpy(files->names + files->namesSize, path, pathLength);
+            files->offsets[files->count++] = files->namesSize;
+            files->namesSize += pathLength;
+        }
+    }
+
+    closedir(dir);
+}
+
+// Worker job: Rewrite front matter of a group of files
+static void RewriteFrontMatterFiles(void *data, int index)
+{
+    FrontMatterJobs *jobs = (FrontMatterJobs *)data;
+
+    int start = index*FRONT_MATTER_FILES_PER_JOB;
+    int end = ((start + FRONT_MATTER_FILES_PER_JOB) < jobs->files->count)? (start + FRONT_MATTER_FILES_PER_JOB) : jobs->files->count;
+
+    for (int i = start; i < end; i++)
+    {
+        jobs->results[i] = (signed char)RewriteFrontMatterFile(jobs->files->names + jobs->files->offsets[i], jobs->rules, jobs->ruleCount);
+    }
+}
+
+// Skip spaces and tabs
+static int SkipFrontMatterSpaces(const char *text, int position, int end)
+{
+    while ((position < end) && ((text[position] == ' ') || (text[position] == '\t'))) position++;
+    return position;
+}
+
+// Get scalar value slice: quoted value without quotes, unquoted value without trailing comment
+static FrontMatterSlice GetFrontMatterScalar(const char *text, int start, int end)
+{
+    FrontMatterSlice value = { text + start, 0 };
+
+    if ((start < end) && ((text[start] == '"') || (text[start] == '\'')))
+    {
+        int quoteEnd = FindFrontMatterQuoteEnd(text, start + 1, end, text[start]);
+        if (quoteEnd > start)
+        {
+            value.text = text + start + 1;
+            value.length = quoteEnd - start - 1;
+            value.quote = text[start];
+            return value;
+        }
+    }
+
+    for (int i = start; i < end; i++)
+    {
+        if ((text[i] == '#') && ((i == start) || (text[i - 1] == ' ') || (text[i - 1] == '\t'))) { end = i; break; }
+    }
+    while ((end > start) && ((text[end - 1] == ' ') || (text[end - 1] == '\t') || (text[end - 1] == '\r'))) end--;
+
+    value.length = end - start;
+
+    return value;
+}
+
+// Find closing quotes of TOML multi-line string (""" or '''), -1 if not found
+static int FindFrontMatterStringEnd(const char *text, int position, int end, char quote)
+{
+    for (int i = position; (i + 2) < end; i++)
+    {
+        if ((text[i] == '\\') && (quote == '"')) i++;
+        else if ((text[i] == quote) && (text[i + 1] == quote) && (text[i + 2] == quote)) return i;
+    }
+
+    return -1;
+}
+
+// Check if YAML value is a block scalar header: | or > with optional chomping/indentation indicators (|-, >+, |2)
+static bool IsFrontMatterBlockScalar(const char *text, int start, int end)
+{
+    if ((start >= end) || ((text[start] != '|') && (text[start] != '>'))) return false;
+
+    int position = start + 1;
+    while ((position < end) && ((text[position] == '-') || (text[position] == '+') || ((text[position] >= '0') && (text[position] <= '9')))) position++;
+
+    int commentStart = SkipFrontMatterSpaces(text, position, end);
+
+    return (position == end) || ((commentStart > position) && ((commentStart == end) || (text[commentStart] == '#')));
+}
+
+// Decode YAML block scalar lines into text (NULL terminated), returns decoded length
+// NOTE: First line indentation is removed from all lines, lines are joined with line breaks (literal, |)
+// or spaces (folded, >, empty lines kept as line breaks); chomping indicators are not applied, value
+// never ends with a line break
+static int DecodeFrontMatterBlock(FrontMatterSlice value, char *text, int size)
+{
+    int length = 0;
+    int indent = -1;
+    int emptyLines = 0;
+    int position = 0;
+
+    while ((position < value.length) && (length < (size - 1)))
+    {
+        int lineEnd = position;
+        while ((lineEnd < value.length) && (value.text[lineEnd] != '\n')) lineEnd++;
+        int contentEnd = ((lineEnd > position) && (value.text[lineEnd - 1] == '\r'))? lineEnd - 1 : lineEnd;
+        int contentStart = position;
+        while ((contentStart < contentEnd) && (value.text[contentStart] == ' ')) contentStart++;
+
+        if (contentStart >= contentEnd) emptyLines++;
+        else
+        {
+            if (indent < 0) indent = contentStart - position;
+            if ((contentStart - position) > indent) contentStart = position + indent;
+
+            // Line separator: line break per empty line, folded lines joined by a space
+            if (length > 0)
+            {
+                int breaks = (value.quote == '|')? emptyLines + 1 : emptyLines;
+                if (breaks == 0) text[length++] = ' ';
+                for (int k = 0; (k < breaks) && (length < (size - 1)); k++) text[length++] = '\n';
+            }
+            emptyLines = 0;
+
+            for (int i = contentStart; (i < contentEnd) && (length < (size - 1)); i++) text[length++] = value.text[i];
+        }
+
+        position = lineEnd + 1;
+    }
+
+    text[length] = '\0';
+
+    return length;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Init front matter parser, opening and closing delimiter lines are checked
+// NOTE: Unterminated front matter is not parsed (format is FRONT_MATTER_NONE), it would run into post body
+FrontMatterParser InitFrontMatterParser(const char *text, int size)
+{
+    FrontMatterParser parser = { 0 };
+    parser.text = text;
+    parser.size = size;
+
+    int closeStart = 0, regionEnd = 0;
+    if ((text == NULL) || !FindFrontMatter(text, size, true, &closeStart, &regionEnd)) return parser;
+
+    parser.format = (text[0] == '+')? FRONT_MATTER_TOML : FRONT_MATTER_YAML;
+    parser.position = GetFrontMatterLineEnd(text, size, 0) + 1;
+    parser.end = closeStart;
+
+    return parser;
+}
+
+// Parse next field, lines are scanned until a key/value pair is found
+// NOTE: Returns false once closing delimiter is reached (bodyOffset is set), values never span past it
+bool NextFrontMatterField(FrontMatterParser *parser, FrontMatterField *field)
+{
+    const char *text = parser->text;
+    int end = parser->end;
+
+    *field = (FrontMatterField){ 0 };
+
+    while ((parser->format != FRONT_MATTER_NONE) && !parser->done)
+    {
+        if (parser->position >= end)
+        {
+            int closeLineEnd = GetFrontMatterLineEnd(text, parser->size, end);
+            parser->done = true;
+            parser->bodyOffset = (closeLineEnd < parser->size)? closeLineEnd + 1 : parser->size;
+            return false;
+        }
+
+        // NOTE: Closing delimiter line start follows a line end, lines before it are complete
+        int lineStart = parser->position;
+        int lineEnd = GetFrontMatterLineEnd(text, end, lineStart);
+        parser->position = lineEnd + 1;
+
+        int keyStart = SkipFrontMatterSpaces(text, lineStart, lineEnd);
+        if ((keyStart >= lineEnd) || (text[keyStart] == '#') || (text[keyStart] == '\r')) continue;
+
+        // TOML table header: [table] or [[array]]
+        if ((parser->format == FRONT_MATTER_TOML) && (text[keyStart] == '['))
+        {
+            int nameStart = keyStart;
+            while ((nameStart < lineEnd) && (text[nameStart] == '[')) nameStart++;
+            int nameEnd = nameStart;
+            while ((nameEnd < lineEnd) && (text[nameEnd] != ']')) nameEnd++;
+
+            parser->table.text = text + nameStart;
+            parser->table.length = nameEnd - nameStart;
+            continue;
+        }
+
+        // Key: bare key (dotted keys included) or quoted key
+        int keyEnd = keyStart;
+        FrontMatterSlice key = { text + keyStart, 0 };
+        if ((text[keyStart] == '"') || (text[keyStart] == '\''))
+        {
+            keyEnd = FindFrontMatterQuoteEnd(text, keyStart + 1, lineEnd, text[keyStart]);
+            if (keyEnd < 0) continue;
+            key.text = text + keyStart + 1;
+            key.length = keyEnd - keyStart - 1;
+            keyEnd++;
+        }
+        else
+        {
+            while ((keyEnd < lineEnd) && (((text[keyEnd] >= 'a') && (text[keyEnd] <= 'z')) || ((text[keyEnd] >= 'A') && (text[keyEnd] <= 'Z')) ||
+                ((text[keyEnd] >= '0') && (text[keyEnd] <= '9')) || (text[keyEnd] == '_') || (text[keyEnd] == '-') || (text[keyEnd] == '.'))) keyEnd++;
+            key.length = keyEnd - keyStart;
+        }
+
+        int separator = SkipFrontMatterSpaces(text, keyEnd, lineEnd);
+        if ((key.length == 0) || (separator >= lineEnd) || (text[separator] != ((parser->format == FRONT_MATTER_TOML)? '=' : ':'))) continue;
+
+        // YAML nesting: root keys reset parent key
+        if ((parser->format == FRONT_MATTER_YAML) && (keyStart == lineStart)) parser->table = (FrontMatterSlice){ 0 };
+
+        field->table = parser->table;
+        field->key = key;
+
+        int valueStart = SkipFrontMatterSpaces(text, separator + 1, lineEnd);
+        int valueEnd = lineEnd;
+        while ((valueEnd > valueStart) && ((text[valueEnd - 1] == ' ') || (text[valueEnd - 1] == '\t') || (text[valueEnd - 1] == '\r'))) valueEnd--;
+
+        if ((valueStart < valueEnd) && (text[valueStart] == '['))
+        {
+            // Inline array, it could span several lines
+            // NOTE: Unclosed array ends at line end
+            int close = FindFrontMatterValueEnd(text, valueStart + 1, end, ']');
+            if (close < 0) close = valueEnd;
+
+            field->value.text = text + valueStart + 1;
+            field->value.length = close - valueStart - 1;
+            field->list = true;
+
+            if (close > lineEnd) parser->position = GetFrontMatterLineEnd(text, end, close) + 1;
+        }
+        else if ((parser->format == FRONT_MATTER_TOML) && ((valueEnd - valueStart) >= 3) && ((text[valueStart] == '"') || (text[valueStart] == '\'')) &&
+            (text[valueStart + 1] == text[valueStart]) && (text[valueStart + 2] == text[valueStart]))
+        {
+            // TOML multi-line string, line break after opening quotes is trimmed
+            int contentStart = valueStart + 3;
+            if ((contentStart < lineEnd) && (text[contentStart] == '\r')) contentStart++;
+            if (contentStart == lineEnd) contentStart++;
+
+            int close = FindFrontMatterStringEnd(text, contentStart, end, text[valueStart]);
+            if (close < 0) field->value = GetFrontMatterScalar(text, valueStart, valueEnd);
+            else
+            {
+                field->value.text = text + contentStart;
+                field->value.length = close - contentStart;
+                field->value.quote = text[valueStart];
+                parser->position = GetFrontMatterLineEnd(text, end, close) + 1;
+            }
+        }
+        else if ((parser->format == FRONT_MATTER_YAML) && IsFrontMatterBlockScalar(text, valueStart, valueEnd))
+        {
+            // YAML block scalar: following lines indented more than key (and empty lines) are the value
+            int blockStart = parser->position;
+            int blockEnd = blockStart;
+            int position = blockStart;
+
+            while (position < end)
+            {
+                int blockLineEnd = GetFrontMatterLineEnd(text, end, position);
+                int contentStart = SkipFrontMatterSpaces(text, position, blockLineEnd);
+                bool empty = (contentStart >= blockLineEnd) || (text[contentStart] == '\r');
+                if (!empty && ((contentStart - position) <= (keyStart - lineStart))) break;
+
+                if (!empty) blockEnd = blockLineEnd;
+                position = blockLineEnd + 1;
+            }
+
+            field->value.text = text + blockStart;
+            field->value.length = blockEnd - blockStart;
+            field->value.quote = text[valueStart];
+            parser->position = position;
+        }
+        else if ((valueStart == valueEnd) && (parser->format == FRONT_MATTER_YAML))
+        {
+            // YAML block list ("- value" lines) or parent key of nested keys
+            int listStart = parser->position;
+            int listEnd = listStart;
+
+            while (listEnd < end)
+            {
+                int itemLineEnd = GetFrontMatterLineEnd(text, end, listEnd);
+                int itemStart = SkipFrontMatterSpaces(text, listEnd, itemLineEnd);
+                if ((itemStart >= itemLineEnd) || (text[itemStart] != '-') || (((itemStart + 1) < itemLineEnd) &&
+                    (text[itemStart + 1] != ' ') && (text[itemStart + 1] != '\r'))) break;
+
+                listEnd = itemLineEnd + 1;
+            }
+
+            // Empty value: root key is parent of following indented keys
+            if (listEnd == listStart)
+            {
+                if (keyStart == lineStart) parser->table = key;
+                field->value.text = text + valueStart;
+            }
+            else
+            {
+                field->value.text = text + listStart;
+                field->value.length = listEnd - listStart;
+                field->list = true;
+                field->blockList = true;
+                parser->position = listEnd;
+            }
+        }
+        else field->value = GetFrontMatterScalar(text, valueStart, valueEnd);
+
+        return true;
+    }
+
+    return false;
+}
+
+// Get next value of list field, field value is consumed
+bool NextFrontMatterValue(FrontMatterField *field, FrontMatterSlice *value)
+{
+    const char *text = field->value.text;
+    int end = field->value.length;
+    int position = 0;
+
+    while (field->list && (position < end))
+    {
+        while ((position < end) && ((text[position] == ' ') || (text[position] == '\t') || (text[position] == '\r') ||
+            (text[position] == '\n') || (text[position] == ','))) position++;
+        if (field->blockList && (position < end) && (text[position] == '-')) position = SkipFrontMatterSpaces(text, position + 1, end);
+        if (position >= end) break;
+
+        // Value ends at separator: comma (inline array) or line end (block list)
+        int valueEnd = position;
+        if ((text[position] == '"') || (text[position] == '\''))
+        {
+            valueEnd = FindFrontMatterQuoteEnd(text, position + 1, end, text[position]);
+            valueEnd = (valueEnd < 0)? end : valueEnd + 1;
+        }
+        while ((valueEnd < end) && (text[valueEnd] != (field->blockList? '\n' : ','))) valueEnd++;
+
+        *value = GetFrontMatterScalar(text, position, valueEnd);
+
+        field->value.text = text + valueEnd;
+        field->value.length = end - valueEnd;
+
+        if (value->length > 0) return true;
+
+        text = field->value.text;
+        end = field->value.length;
+        position = 0;
+    }
+
+    field->value.length = 0;
+    return false;
+}
+
+// Check if key (or any slice) is equal to text
+bool IsFrontMatterKey(FrontMatterSlice key, const char *text)
+{
+    return (strncmp(key.text, text, key.length) == 0) && (text[key.length] == '\0');
+}
+
+// Decode value escape sequences into text (NULL terminated), returns decoded length
+// NOTE: Double quoted values (TOML basic strings, YAML double quoted) decode backslash escapes,
+// single quoted values decode '' (YAML), block scalars remove indentation; decoded value is never longer than value, so a
+// (value.length + 1) text size always fits, otherwise decoded value is truncated
+int DecodeFrontMatterString(FrontMatterSlice value, char *text, int size)
+{
+    int length = 0;
+    if (size <= 0) return 0;
+    if ((value.quote == '|') || (value.quote == '>')) return DecodeFrontMatterBlock(value, text, size);
+
+    for (int i = 0; (i < value.length) && (length < (size - 1)); i++)
+    {
+        unsigned char c = (unsigned char)value.text[i];
+
+        if ((value.quote == '\'') && (c == '\'') && ((i + 1) < value.length) && (value.text[i + 1] == '\''))
+        {
+            text[length++] = '\'';
+            i++;
+            continue;
+        }
+
+        if ((value.quote != '"') || (c != '\\') || ((i + 1) >= value.length))
+        {
+            text[length++] = (char)c;
+            continue;
+        }
+
+        char escape = value.text[i + 1];
+        int digits = (escape == 'x')? 2 : (escape == 'u')? 4 : (escape == 'U')? 8 : 0;
+
+        if (digits > 0)
+        {
+            // Unicode code point, encoded as UTF-8
+            unsigned int codepoint = 0;
+            int k = 0;
+            for (; (k < digits) && ((i + 2 + k) < value.length); k++)
+            {
+                char h = value.text[i + 2 + k];
+                int digit = ((h >= '0') && (h <= '9'))? h - '0' : (((h | 32) >= 'a') && ((h | 32) <= 'f'))? (h | 32) - 'a' + 10 : -1;
+                if (digit < 0) break;
+                codepoint = codepoint*16 + digit;
+            }
+
+            char bytes[4] = { 0 };
+            int byteCount = 0;
+            if ((k < digits) || (codepoint > 0x10ffff)) byteCount = 0;
+            else if (codepoint < 0x80) { bytes[0] = (char)codepoint; byteCount = 1; }
+            else if (codepoint < 0x800) { bytes[0] = (char)(0xc0 | (codepoint >> 6)); bytes[1] = (char)(0x80 | (codepoint & 0x3f)); byteCount = 2; }
+            else if (codepoint < 0x10000) { bytes[0] = (char)(0xe0 | (codepoint >> 12)); bytes[1] = (char)(0x80 | ((codepoint >> 6) & 0x3f)); bytes[2] = (char)(0x80 | (codepoint & 0x3f)); byteCount = 3; }
+            else { bytes[0] = (char)(0xf0 | (codepoint >> 18)); bytes[1] = (char)(0x80 | ((codepoint >> 12) & 0x3f)); bytes[2] = (char)(0x80 | ((codepoint >> 6) & 0x3f)); bytes[3] = (char)(0x80 | (codepoint & 0x3f)); byteCount = 4; }
+
+            // Invalid sequences are kept as is
+            if ((byteCount == 0) || ((length + byteCount) > (size - 1)))
+            {
+                text[length++] = (char)c;
+                continue;
+            }
+
+            for (int b = 0; b < byteCount; b++) text[length++] = bytes[b];
+            i += 1 + digits;
+            continue;
+        }
+
+        char decoded = 0;
+        switch (escape)
+        {
+            case 'b': decoded = '\b'; break;
+            case 't': decoded = '\t'; break;
+            case 'n': decoded = '\n'; break;
+            case 'f': decoded = '\f'; break;
+            case 'r': decoded = '\r'; break;
+            case 'e': decoded = 0x1b; break;
+            case '"': case '\\': case '/': case ' ': decoded = escape; break;
+            default: break;
+        }
+
+        // Unknown escapes are kept as is
+        if (decoded == 0)
+        {
+            text[length++] = (char)c;
+            continue;
+        }
+
+        text[length++] = decoded;
+        i++;
+    }
+
+    text[length] = '\0';
+
+    return length;
+}
+
+// Load (map) markdown file, read-only
+// NOTE: File is memory mapped, only pages accessed by parser are read from disk
+FrontMatterFile LoadFrontMatterFile(const char *fileName)
+{
+    FrontMatterFile file = { 0 };
+
+#if defined(_WIN32)
+    FILE *source = fopen(fileName, "rb");
+    if (source == NULL) return file;
+
+    fseek(source, 0, SEEK_END);
+    long size = ftell(source);
+    fseek(source, 0, SEEK_SET);
+
+    char *data = (size > 0)? (char *)malloc(size) : NULL;
+    if (data != NULL)
+    {
+        file.data = data;
+        file.dataSize = (int)fread(data, 1, size, source);
+    }
+    fclose(source);
+#else
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0) return file;
+
+    struct stat fileInfo = { 0 };
+    if ((fstat(fd, &fileInfo) == 0) && (fileInfo.st_size > 0))
+    {
+        void *data = mmap(NULL, fileInfo.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED)
+        {
+            file.data = (const char *)data;
+            file.dataSize = (int)fileInfo.st_size;
+            file.mapped = true;
+        }
+    }
+    close(fd);      // NOTE: Mapping is kept after closing file descriptor
+#endif
+
+    return file;
+}
+
+// Unload (unmap) markdown file
+void UnloadFrontMatterFile(FrontMatterFile *file)
+{
+#if !defined(_WIN32)
+    if (file->mapped) munmap((void *)file->data, file->dataSize);
+    else
+#endif
+    free((void *)file->data);
+
+    *file = (FrontMatterFile){ 0 };
+}
+
+// Load markdown files list of folder, subfolders are scanned recursively
+FrontMatterFiles LoadFrontMatterFiles(const char *folderPath)
+{
+    FrontMatterFiles files = { 0 };
+    ScanFrontMatterFiles(folderPath, &files);
+
+    return files;
+}
+
+// Unload markdown files list
+void UnloadFrontMatterFiles(FrontMatterFiles *files)
+{
+    free(files->offsets);
+    free(files->names);
+
+    *files = (FrontMatterFiles){ 0 };
+}
+
+// Parse rule from text: "<key>:<from>=<to>", empty <to> removes value
+bool ParseFrontMatterRule(const char *text, FrontMatterRule *rule)
+{
+    const char *keyEnd = strchr(text, ':');
+    const char *fromEnd = (keyEnd != NULL)? strchr(keyEnd + 1, '=') : NULL;
+    if ((keyEnd == NULL) || (fromEnd == NULL) || (keyEnd == text) || (fromEnd == (keyEnd + 1))) return false;
+
+    if (((keyEnd - text) >= (int)sizeof(rule->key)) || ((fromEnd - keyEnd - 1) >= (int)sizeof(rule->from)) ||
+        (strlen(fromEnd + 1) >= sizeof(rule->to))) return false;
+
+    *rule = (FrontMatterRule){ 0 };
+    memcpy(rule->key, text, keyEnd - text);
+    memcpy(rule->from, keyEnd + 1, fromEnd - keyEnd - 1);
+    strcpy(rule->to, fromEnd + 1);
+
+    return true;
+}
+
+// Get front matter region size: opening delimiter line to closing delimiter line (included)
+int GetFrontMatterSize(const char *text, int textSize)
+{
+    int closeStart = 0, regionEnd = 0;
+    return FindFrontMatter(text, textSize, true, &closeStart, &regionEnd)? regionEnd : 0;
+}
+
+// Rewrite front matter region applying rules, returns new region (NULL if no rule applies)
+// NOTE: Fields are parsed with NextFrontMatterField(), changed values are spliced at their source
+// position and everything else is copied verbatim, regionSize returns original region size
+char *RewriteFrontMatter(const char *text, int textSize, const FrontMatterRule *rules, int ruleCount, int *regionSize, int *newRegionSize)
+{
+    *regionSize = 0;
+    *newRegionSize = 0;
+
+    FrontMatterParser parser = InitFrontMatterParser(text, textSize);
+    if (parser.format == FRONT_MATTER_NONE) return NULL;
+
+    FrontMatterBuffer buffer = { 0 };
+    FrontMatterItem items[FRONT_MATTER_MAX_ITEMS] = { 0 };
+    FrontMatterField field = { 0 };
+    int copied = 0;             // Source text copied into buffer until this position
+    bool changed = false;
+
+    while (NextFrontMatterField(&parser, &field))
+    {
+        if (!IsFrontMatterRuleKey(rules, ruleCount, field.key)) continue;
+
+        int keyLineStart = (int)(field.key.text - text);
+        while ((keyLineStart > 0) && (text[keyLineStart - 1] != '\n')) keyLineStart--;
+
+        int count = 0;
+
+        if (field.list)
+        {
+            // NOTE: Unclosed inline arrays and lists of more than FRONT_MATTER_MAX_ITEMS values are not rewritten
+            int listStart = (int)(field.value.text - text);
+            int listEnd = listStart + field.value.length;
+            if (!field.blockList && (text[listEnd] != ']')) continue;
+
+            FrontMatterSlice value = { 0 };
+            bool overflow = false;
+            while (!overflow && NextFrontMatterValue(&field, &value))
+            {
+                if (count < FRONT_MATTER_MAX_ITEMS) items[count++] = GetFrontMatterItem(text, value);
+                else overflow = true;
+            }
+
+            if (overflow || !ApplyFrontMatterRules(rules, ruleCount, field.key, items, &count)) continue;
+
+            if (!field.blockList)
+            {
+                // Inline array: values between brackets rewritten
+                AppendFrontMatterText(&buffer, text + copied, listStart - copied);
+                for (int i = 0; i < count; i++)
+                {
+                    if (i > 0) AppendFrontMatterText(&buffer, ", ", 2);
+                    AppendFrontMatterItem(&buffer, text, &items[i]);
+                }
+            }
+            else
+            {
+                // YAML block list: kept values lines copied around value, no value left is an empty list
+                if (count == 0)
+                {
+                    int keyLineEnd = listStart - 1;
+                    while ((keyLineEnd > keyLineStart) && ((text[keyLineEnd - 1] == ' ') || (text[keyLineEnd - 1] == '\t') || (text[keyLineEnd - 1] == '\r'))) keyLineEnd--;
+
+                    AppendFrontMatterText(&buffer, text + copied, keyLineEnd - copied);
+                    AppendFrontMatterText(&buffer, " []", 3);
+                    AppendFrontMatterText(&buffer, text + keyLineEnd, listStart - keyLineEnd);
+                }
+                else AppendFrontMatterText(&buffer, text + copied, listStart - copied);
+
+                for (int i = 0; i < count; i++)
+                {
+                    int itemLineStart = items[i].start;
+                    while ((itemLineStart > listStart) && (text[itemLineStart - 1] != '\n')) itemLineStart--;
+                    int itemLineEnd = GetFrontMatterLineEnd(text, listEnd, items[i].end) + 1;
+
+                    AppendFrontMatterText(&buffer, text + itemLineStart, items[i].start - itemLineStart);
+                    AppendFrontMatterItem(&buffer, text, &items[i]);
+                    AppendFrontMatterText(&buffer, text + items[i].end, itemLineEnd - items[i].end);
+                }
+            }
+
+            copied = listEnd;
+        }
+        else
+        {
+            // NOTE: Block scalars and multi-line strings are not rewritten
+            bool multiline = (field.value.quote == '|') || (field.value.quote == '>') ||
+                ((field.value.quote != 0) && (field.value.text[-2] == field.value.quote));
+            if ((field.value.length == 0) || multiline) continue;
+
+            items[count++] = GetFrontMatterItem(text, field.value);
+            if (!ApplyFrontMatterRules(rules, ruleCount, field.key, items, &count)) continue;
+
+            if (count == 0)
+            {
+                // Removed scalar: key line is dropped
+                AppendFrontMatterText(&buffer, text + copied, keyLineStart - copied);
+                copied = parser.position;
+            }
+            else
+            {
+                AppendFrontMatterText(&buffer, text + copied, items[0].start - copied);
+                AppendFrontMatterItem(&buffer, text, &items[0]);
+                copied = items[0].end;
+            }
+        }
+
+        changed = true;
+    }
+
+    *regionSize = parser.bodyOffset;
+    AppendFrontMatterText(&buffer, text + copied, parser.bodyOffset - copied);
+
+    if (!changed || buffer.failed)
+    {
+        free(buffer.data);
+        return NULL;
+    }
+
+    *newRegionSize = buffer.size;
+
+    return buffer.data;
+}
+
+// Rewrite file front matter: only front matter region is read, body is not parsed
+// NOTE: Same size region is overwritten in place, otherwise file is rewritten through a temp file
+int RewriteFrontMatterFile(const char *fileName, const FrontMatterRule *rules, int ruleCount)
+{
+    FILE *file = fopen(fileName, "rb");
+    if (file == NULL) return -1;
+
+    int capacity = 4096;
+    int size = 0;
+    char *data = (char *)malloc(capacity);
+    bool complete = false;
+    int closeStart = 0, regionEnd = 0;
+
+    // Read until front matter closing delimiter is found
+    while (data != NULL)
+    {
+        size += (int)fread(data + size, 1, capacity - size, file);
+        complete = (size < capacity);
+
+        if ((size >= 4) && (data[0] != '+') && (data[0] != '-')) break;     // No front matter, not read further
+        if (FindFrontMatter(data, size, complete, &closeStart, &regionEnd) || complete || (capacity >= FRONT_MATTER_MAX_SIZE)) break;
+
+        char *newData = (char *)realloc(data, capacity*2);
+        if (newData == NULL) { free(data); data = NULL; break; }
+        data = newData;
+        capacity *= 2;
+    }
+
+    if (data == NULL)
+    {
+        fclose(file);
+        return -1;
+    }
+
+    int regionSize = 0, newRegionSize = 0;
+    char *region = RewriteFrontMatter(data, FindFrontMatter(data, size, complete, &closeStart, &regionEnd)? regionEnd : 0, rules, ruleCount, &regionSize, &newRegionSize);
+
+    int result = 0;
+
+    if ((region != NULL) && (newRegionSize == regionSize))
+    {
+        fclose(file);
+        file = fopen(fileName, "r+b");
+        result = ((file != NULL) && (fwrite(region, 1, newRegionSize, file) == (size_t)newRegionSize))? 1 : -1;
+        if ((file != NULL) && (fclose(file) != 0)) result = -1;
+        file = NULL;
+    }
+    else if (region != NULL)
+    {
+        // Body is streamed from original file after already read data
+        char tempFileName[1040] = { 0 };
+        snprintf(tempFileName, sizeof(tempFileName), "%s.tmp", fileName);
+
+        FILE *tempFile = fopen(tempFileName, "wb");
+        bool success = (tempFile != NULL) && (fwrite(region, 1, newRegionSize, tempFile) == (size_t)newRegionSize) &&
+            (fwrite(data + regionSize, 1, size - regionSize, tempFile) == (size_t)(size - regionSize));
+
+        char block[16*1024];
+        size_t blockSize = 0;
+        while (success && !complete && ((blockSize = fread(block, 1, sizeof(block), file)) > 0)) success = (fwrite(block, 1, blockSize, tempFile) == blockSize);
+        if (ferror(file)) success = false;
+
+        if ((tempFile != NULL) && (fclose(tempFile) != 0)) success = false;
+        fclose(file);
+        file = NULL;
+
+    #if defined(_WIN32)
+        if (success) remove(fileName);  // NOTE: rename() does not replace existing files on Windows
+    #endif
+        if (success) success = (rename(tempFileName, fileName) == 0);
+        if (!success) remove(tempFileName);
+
+        result = success? 1 : -1;
+    }
+
+    if (file != NULL) fclose(file);
+    free(region);
+    free(data);
+
+    return result;
+}
+
+// Rewrite front matter of all markdown files in folder (subfolders included), files are rewritten in parallel
+FrontMatterRewriteStats RewriteSiteFrontMatter(const char *folderPath, const FrontMatterRule *rules, int ruleCount, WorkerPool *pool)
+{
+    FrontMatterRewriteStats stats = { 0 };
+    FrontMatterFiles files = LoadFrontMatterFiles(folderPath);
+
+    FrontMatterJobs jobs = { 0 };
+    jobs.files = &files;
+    jobs.rules = rules;
+    jobs.ruleCount = ruleCount;
+    jobs.results = (signed char *)calloc(files.count + 1, sizeof(signed char));
+
+    if (jobs.results != NULL)
+    {
+        RunWorkerPoolJobs(pool, RewriteFrontMatterFiles, &jobs, (files.count + FRONT_MATTER_FILES_PER_JOB - 1)/FRONT_MATTER_FILES_PER_JOB);
+
+        stats.fileCount = files.count;
+        for (int i = 0; i < files.count; i++)
+        {
+            if (jobs.results[i] > 0) stats.changedCount++;
+            else if (jobs.results[i] < 0) stats.failedCount++;
+        }
+    }
+    else stats.failedCount = files.count;
+
+    free(jobs.results);
+    UnloadFrontMatterFiles(&files);
+
+    return stats;
+}
+
+#endif // FRONT_MATTER_IMPLEMENTATION
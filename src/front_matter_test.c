@@ -0,0 +1,214 @@
+/*******************************************************************************************
+*
+*   StatiqPress front matter tests - Front matter parser behavior on malformed and multi-line values
+*
+*   COMMAND LINE:
+*       statiqpress_test
+*           Run all tests, failed checks are printed, exit code is the number of failed tests
+*
+*   NOTES:
+*       Tests are a separate tool (make test), not part of StatiqPress executable: parser is tested
+*       on in-memory posts, front matter fields must never be read from post body
+*
+*   LICENSE: GPLv3, check LICENSE file for details
+*
+**********************************************************************************************/
+
+// C standard library
+#include <string.h>                 // Required for: strlen(), strcmp()
+#include <stdio.h>                  // Required for: printf(), snprintf()
+
+#define WORKER_POOL_IMPLEMENTATION
+#include "worker_pool.h"            // Worker pool: Run jobs in parallel on CPU cores
+#undef WORKER_POOL_IMPLEMENTATION   // Avoid including worker pool implementation again
+
+#define FRONT_MATTER_IMPLEMENTATION
+#include "front_matter.h"           // Front matter: Front matter parsing and site-wide rewriting
+#undef FRONT_MATTER_IMPLEMENTATION  // Avoid including front matter implementation again
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define TEST_MAX_FIELDS         16          // Max fields parsed from a test post
+
+// Check condition, failure is printed and counted on current test
+#define CHECK(condition) do { if (!(condition)) { printf("    FAILED: %s (line %i)\n", #condition, __LINE__); failures++; } } while (0)
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Parsed test post: fields decoded, list values joined with ','
+typedef struct TestPost {
+    char keys[TEST_MAX_FIELDS][64];
+    char values[TEST_MAX_FIELDS][256];
+    int count;
+    int bodyOffset;
+} TestPost;
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+static TestPost parseTestPost(const char *text);                // Parse all front matter fields of post
+static const char *getTestValue(const TestPost *post, const char *key); // Get decoded value of key, NULL if key not parsed
+
+static int testUnclosedArray(void);         // Unclosed inline array ends at line end, body is not parsed
+static int testBlockScalar(void);           // YAML block scalar lines are one value, not fields
+static int testMultilineString(void);       // TOML multi-line string lines are one value, not fields
+static int testUnterminated(void);          // Unterminated front matter is not parsed
+
+//------------------------------------------------------------------------------------
+// Program main entry point
+//------------------------------------------------------------------------------------
+int main(void)
+{
+    struct { const char *name; int (*run)(void); } tests[] = {
+        { "unclosed array", testUnclosedArray },
+        { "block scalar", testBlockScalar },
+        { "multi-line string", testMultilineString },
+        { "unterminated front matter", testUnterminated },
+    };
+    int testCount = sizeof(tests)/sizeof(tests[0]);
+    int failedCount = 0;
+
+    for (int i = 0; i < testCount; i++)
+    {
+        int failures = tests[i].run();
+        printf("%s: %s\n", (failures == 0)? "PASS" : "FAIL", tests[i].name);
+        if (failures > 0) failedCount++;
+    }
+
+    printf("%i/%i tests passed\n", testCount - failedCount, testCount);
+
+    return failedCount;
+}
+
+//--------------------------------------------------------------------------------------------
+// Module functions definition
+//--------------------------------------------------------------------------------------------
+// Parse all front matter fields of post, values decoded
+static TestPost parseTestPost(const char *text)
+{
+    TestPost post = { 0 };
+    FrontMatterParser parser = InitFrontMatterParser(text, (int)strlen(text));
+    FrontMatterField field = { 0 };
+
+    while ((post.count < TEST_MAX_FIELDS) && NextFrontMatterField(&parser, &field))
+    {
+        snprintf(post.keys[post.count], sizeof(post.keys[0]), "%.*s", field.key.length, field.key.text);
+
+        char *value = post.values[post.count];
+        if (!field.list) DecodeFrontMatterString(field.value, value, sizeof(post.values[0]));
+        else
+        {
+            FrontMatterSlice item = { 0 };
+            while (NextFrontMatterValue(&field, &item))
+            {
+                int length = (int)strlen(value);
+                if (length > 0) value[length++] = ',';
+                DecodeFrontMatterString(item, value + length, (int)sizeof(post.values[0]) - length);
+            }
+        }
+
+        post.count++;
+    }
+
+    post.bodyOffset = parser.bodyOffset;
+
+    return post;
+}
+
+// Get decoded value of key, NULL if key not parsed
+static const char *getTestValue(const TestPost *post, const char *key)
+{
+    for (int i = 0; i < post->count; i++)
+    {
+        if (strcmp(post->keys[i], key) == 0) return post->values[i];
+    }
+
+    return NULL;
+}
+
+// Unclosed inline array ends at line end, following fields and body are not part of it
+static int testUnclosedArray(void)
+{
+    int failures = 0;
+
+    const char *toml = "+++\ntitle = \"Post\"\ntags = [\"a\", \"b\"\n+++\nz = 1\n] closing bracket in body\n";
+    TestPost post = parseTestPost(toml);
+
+    CHECK(post.count == 2);
+    CHECK((getTestValue(&post, "tags") != NULL) && (strcmp(getTestValue(&post, "tags"), "a,b") == 0));
+    CHECK(getTestValue(&post, "z") == NULL);
+    CHECK(post.bodyOffset == (int)(strstr(toml, "z = 1") - toml));
+
+    const char *yaml = "---\ntags: [a, b\nauthor: real\n---\nz: 1\n]\n";
+    post = parseTestPost(yaml);
+
+    CHECK(post.count == 2);
+    CHECK((getTestValue(&post, "author") != NULL) && (strcmp(getTestValue(&post, "author"), "real") == 0));
+    CHECK(getTestValue(&post, "z") == NULL);
+
+    return failures;
+}
+
+// YAML block scalar lines are reported as one value (indentation removed), not as fields
+static int testBlockScalar(void)
+{
+    int failures = 0;
+
+    const char *literal = "---\ntitle: Post\ndescription: |\n  First line\n  author: fake\n\n  Last line\nauthor: real\n---\nbody\n";
+    TestPost post = parseTestPost(literal);
+
+    CHECK(post.count == 3);
+    CHECK((getTestValue(&post, "description") != NULL) && (strcmp(getTestValue(&post, "description"), "First line\nauthor: fake\n\nLast line") == 0));
+    CHECK((getTestValue(&post, "author") != NULL) && (strcmp(getTestValue(&post, "author"), "real") == 0));
+    CHECK(strcmp(literal + post.bodyOffset, "body\n") == 0);
+
+    const char *folded = "---\ndescription: >-\n    Folded\n    author: fake\n\n    paragraph\ntags:\n  - a\n---\n";
+    post = parseTestPost(folded);
+
+    CHECK(post.count == 2);
+    CHECK((getTestValue(&post, "description") != NULL) && (strcmp(getTestValue(&post, "description"), "Folded author: fake\nparagraph") == 0));
+    CHECK((getTestValue(&post, "tags") != NULL) && (strcmp(getTestValue(&post, "tags"), "a") == 0));
+    CHECK(getTestValue(&post, "author") == NULL);
+
+    // Block scalar of nested key ends at parent indentation
+    const char *nested = "---\nparams:\n  note: |\n    author: fake\n  author: nested\n---\n";
+    post = parseTestPost(nested);
+
+    CHECK((getTestValue(&post, "note") != NULL) && (strcmp(getTestValue(&post, "note"), "author: fake") == 0));
+    CHECK((getTestValue(&post, "author") != NULL) && (strcmp(getTestValue(&post, "author"), "nested") == 0));
+
+    return failures;
+}
+
+// TOML multi-line string lines are reported as one value, not as fields
+static int testMultilineString(void)
+{
+    int failures = 0;
+
+    const char *toml = "+++\ndescription = \"\"\"\nFirst \\\"line\\\"\nauthor = \"fake\"\n\"\"\"\nnote = '''\nz = 1'''\nauthor = \"real\"\n+++\n";
+    TestPost post = parseTestPost(toml);
+
+    CHECK(post.count == 3);
+    CHECK((getTestValue(&post, "description") != NULL) && (strcmp(getTestValue(&post, "description"), "First \"line\"\nauthor = \"fake\"\n") == 0));
+    CHECK((getTestValue(&post, "note") != NULL) && (strcmp(getTestValue(&post, "note"), "z = 1") == 0));
+    CHECK((getTestValue(&post, "author") != NULL) && (strcmp(getTestValue(&post, "author"), "real") == 0));
+
+    return failures;
+}
+
+// Unterminated front matter is not parsed: post has no closing delimiter, body would be read as fields
+static int testUnterminated(void)
+{
+    int failures = 0;
+
+    const char *toml = "+++\ntitle = \"Post\"\n\nz = 1\n";
+    TestPost post = parseTestPost(toml);
+
+    CHECK(post.count == 0);
+    CHECK(post.bodyOffset == 0);
+    CHECK(GetFrontMatterSize(toml, (int)strlen(toml)) == 0);
+
+    return failures;
+}
@@ -30,31 +30,187 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <string.h>
+#include <stdarg.h>
+#include <sys/stat.h>
+
+#include "arena.h"      // Commands and paths are allocated in caller arena
+
+#if defined(_WIN32)
+    #include <io.h>
+    #include <direct.h>     // Required for: _mkdir()
+    #define popen _popen
+    #define pclose _pclose
+#else
+    #include <unistd.h>
+#endif
 
 #define NEW_POST_PATH "./posts/new"
-#define CLONED_PROJECT_NAME "target"
+#define CLONED_PROJECT_NAME "target"  // Clone worktree name prefix, every clone gets a unique folder (target-XXXXXX)
+#define MIRRORS_PATH "./posts/mirror"   // Cached repository mirrors (bare), used to inspect repository without cloning
+
+// Called once post is copied into the cloned repository, to finish preparing it in the worktree
+typedef uint8_t (*GitPrepareCallback)(const char *worktreePath, void *userData);
+
+// Called for every blob read from mirror (requestIndex is blob index in requested ids), data is only valid during the call
+typedef void (*GitBlobCallback)(const char *id, int requestIndex, const char *data, long size, void *userData);
 
 typedef struct {
-    char url[__UINT8_MAX__];        // URL of git repository
-    char postsPath[__UINT8_MAX__];  // Path of the posts folder in the target repository
+    const char *url;        // URL of git repository
+    const char *postsPath;  // Path of the posts folder in the target repository
+    GitPrepareCallback finish; // Worktree update once all posts are copied (i.e. site feeds), optional
+    void *finishData;       // User data passed to finish callback
+    Arena *arena;           // Memory for repository strings and commands, released by caller
+    const char *worktreePath; // Clone worktree, unique folder created by cloneRepository()
 } GitRepository;
 
-GitRepository newRepository(const char *url, const char *postsPath) {
-    GitRepository repo;
-    strncpy(repo.url, url, sizeof(repo.url));
-    strncpy(repo.postsPath, postsPath, sizeof(repo.postsPath));
+// Prepared post to be pushed, several posts are pushed in a single commit
+typedef struct {
+    const char *sourcePath; // Prepared post folder, its contents are copied into postsPath
+    const char *postsPath;  // Path of the posts folder in the target repository
+    const char *assetsPath; // Path of the assets folder in the target repository, optional (added to commit)
+    GitPrepareCallback prepare; // Worktree preparation, optional
+    void *prepareData;      // User data passed to prepare callback
+} GitPost;
+
+// Blob of repository tree
+typedef struct {
+    char id[41];            // Object id (SHA-1, hex)
+    long size;              // Blob size in bytes
+    const char *path;       // Path in repository
+} GitTreeEntry;
+
+// Repository tree, all blobs of a branch
+typedef struct {
+    GitTreeEntry *entries;  // Entries sorted by path (strcmp() order)
+    int count;
+} GitTree;
+
+// SHA-1 context, used to compute object ids
+typedef struct {
+    uint32_t state[5];
+    uint64_t length;
+    uint8_t buffer[64];
+    size_t bufferSize;
+} Sha1Context;
+
+// NOTE: Strings are copied into arena, so they are valid until arena is reset
+GitRepository newRepository(Arena *arena, const char *url, const char *postsPath) {
+    GitRepository repo = { 0 };
+    repo.url = ArenaStrdup(arena, url);
+    repo.postsPath = ArenaStrdup(arena, postsPath);
+    repo.arena = arena;
     return repo;
 }
 
-uint8_t cloneRepository(GitRepository *repo) { 
-    char command[__UINT8_MAX__ + 50];  
-    snprintf(command, sizeof(command), "git clone %s %s", repo->url, CLONED_PROJECT_NAME);
-    
+// Run formatted shell command, command string is allocated in repository arena
+static int runCommand(GitRepository *repo, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    char *command = ArenaFormatV(repo->arena, format, args);
+    va_end(args);
+
+    if (command == NULL) return -1;
+
     #ifndef _DEBUG
         printf("Command: %s\n", command);
     #endif
 
-    int result = system(command);
+    return system(command);
+}
+
+// Quote text as a single shell argument ('text'), embedded single quotes are escaped as '\''
+// NOTE: Commands are built from repository URLs and paths (profiles, manifests), never trusted as shell syntax
+static const char *quoteShellArg(GitRepository *repo, const char *text) {
+    size_t quoteCount = 0;
+    for (const char *ptr = text; *ptr != '\0'; ptr++) if (*ptr == '\'') quoteCount++;
+
+    char *quoted = (char *)ArenaAlloc(repo->arena, strlen(text) + quoteCount*3 + 3);
+    if (quoted == NULL) return "''";    // Empty argument, command fails without side effects
+
+    char *out = quoted;
+    *out++ = '\'';
+    for (const char *ptr = text; *ptr != '\0'; ptr++) {
+        if (*ptr == '\'') {
+            memcpy(out, "'\\''", 4);
+            out += 4;
+        }
+        else *out++ = *ptr;
+    }
+    *out++ = '\'';
+    *out = '\0';
+
+    return quoted;
+}
+
+// Create clone worktree folder with a unique name, so concurrent pushes (i.e. two outbox drains)
+// never clone into the same folder, returns folder path or NULL on failure
+static const char *createWorktreeFolder(GitRepository *repo) {
+    char *path = ArenaFormat(repo->arena, "./%s-XXXXXX", CLONED_PROJECT_NAME);
+    if (path == NULL) return NULL;
+
+#if defined(_WIN32)
+    return ((_mktemp_s(path, strlen(path) + 1) == 0) && (_mkdir(path) == 0))? path : NULL;
+#else
+    return (mkdtemp(path) != NULL)? path : NULL;
+#endif
+}
+
+// Get local mirror path of repository, mirror could not exist yet (see updateMirror())
+const char *getMirrorPath(GitRepository *repo) {
+    uint32_t hash = 2166136261u;    // FNV-1a hash of url, used as mirror name
+    for (const char *ptr = repo->url; *ptr != '\0'; ptr++) hash = (hash ^ (uint8_t)*ptr)*16777619u;
+
+    return ArenaFormat(repo->arena, "%s/%08x.git", MIRRORS_PATH, hash);
+}
+
+// Update local mirror of repository (bare clone, cloned on first use), returns mirror path
+// NOTE: If remote is not reachable, previously fetched mirror data is used
+const char *updateMirror(GitRepository *repo) {
+    const char *mirrorPath = getMirrorPath(repo);
+
+    struct stat info;
+    if (stat(mirrorPath, &info) != 0) {
+        return (runCommand(repo, "git clone --quiet --mirror %s %s", quoteShellArg(repo, repo->url), quoteShellArg(repo, mirrorPath)) == 0)? mirrorPath : NULL;
+    }
+
+    if (runCommand(repo, "git --git-dir=%s fetch --quiet --prune origin", quoteShellArg(repo, mirrorPath)) != 0) {
+        fprintf(stderr, "Warning: Repository not reachable, using cached mirror: %s\n", repo->url);
+    }
+
+    return mirrorPath;
+}
+
+// Remove the cloned worktree to avoid conflicts
+uint8_t cleanupAfterPull(GitRepository *repo) {
+    if (repo->worktreePath == NULL) return EXIT_SUCCESS;
+
+    if (runCommand(repo, "rm -rf %s", quoteShellArg(repo, repo->worktreePath)) != 0) {
+        fprintf(stderr, "Error: Failed to remove cloned project\n");
+        return EXIT_FAILURE;
+    }
+
+    repo->worktreePath = NULL;
+
+    return EXIT_SUCCESS;
+}
+
+// Clone repository into a new worktree (repo->worktreePath), objects are borrowed from the local mirror
+// (fetched first), so only objects missing from the mirror are transferred; pushes still go to repository url
+uint8_t cloneRepository(GitRepository *repo) {
+    repo->worktreePath = createWorktreeFolder(repo);
+    if (repo->worktreePath == NULL) {
+        fprintf(stderr, "Error: Failed to create worktree folder for repository clone\n");
+        return EXIT_FAILURE;
+    }
+
+    const char *mirrorPath = updateMirror(repo);
+    const char *worktree = quoteShellArg(repo, repo->worktreePath);
+
+    int result = (mirrorPath != NULL)?
+        runCommand(repo, "git clone --quiet --reference %s %s %s", quoteShellArg(repo, mirrorPath), quoteShellArg(repo, repo->url), worktree) :
+        runCommand(repo, "git clone %s %s", quoteShellArg(repo, repo->url), worktree);
+
+    if (result != 0) cleanupAfterPull(repo);
 
     #if defined(_DEBUG)
     if (result == 0) {
@@ -68,37 +224,315 @@ uint8_t cloneRepository(GitRepository *repo) {
     return result == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
 }
 
-// Remove the cloned project to avoid conflicts
-uint8_t cleanupAfterPull(void){
-    char command[__UINT8_MAX__ + 50];
-    snprintf(command, sizeof(command), "rm -rf %s", CLONED_PROJECT_NAME);
-    if (system(command) != 0) {
-        fprintf(stderr, "Error: Failed to remove cloned project\n");
-        return EXIT_FAILURE;
+// Commit staged changes of the cloned repository and push them to the StatiqPress branch, cloned project is removed
+// NOTE: Nothing staged (posts identical to repository ones) is not an error, there is nothing to push
+static uint8_t commitAndPush(GitRepository *repo, const char *message) {
+    const char *worktree = quoteShellArg(repo, repo->worktreePath);
+
+    if (runCommand(repo, "cd %s && git diff --cached --quiet", worktree) == 0) {
+        printf("Posts already up to date in repository, nothing to push\n");
+        cleanupAfterPull(repo);
+        return EXIT_SUCCESS;
     }
 
-    return EXIT_SUCCESS;
+    uint8_t result = EXIT_SUCCESS;
+    if ((runCommand(repo, "cd %s && git commit -m %s", worktree, quoteShellArg(repo, message)) != 0) ||
+        (runCommand(repo, "cd %s && git push origin StatiqPress", worktree) != 0)) {
+        fprintf(stderr, "Error: Failed to commit and push new post\n");
+        result = EXIT_FAILURE;
+    }
+
+    cleanupAfterPull(repo);
+
+    return result;
+}
+
+// Copy the prepared posts into their posts folders,
+// then commit and push them all to the StatiqPress branch at once
+uint8_t pushPostsToRepository(GitRepository *repo, const GitPost *posts, int count) {
+    uint8_t result = cloneRepository(repo);
+    if (result != EXIT_SUCCESS) {
+        return result;
+    }
+
+    const char *worktree = quoteShellArg(repo, repo->worktreePath);
+
+    // Continue previous StatiqPress branch if already pushed, to keep pushes fast-forward
+    runCommand(repo, "cd %s && (git checkout StatiqPress 2>/dev/null || git checkout -b StatiqPress)", worktree);
+
+    for (int i = 0; i < count; i++) {
+        const char *postsPath = quoteShellArg(repo, ArenaFormat(repo->arena, "%s/%s", repo->worktreePath, posts[i].postsPath));
+        if (runCommand(repo, "mkdir -p %s && cp -r %s/. %s", postsPath, quoteShellArg(repo, posts[i].sourcePath), postsPath) != 0) {
+            fprintf(stderr, "Error: Failed to move new post to repository\n");
+            cleanupAfterPull(repo);
+            return EXIT_FAILURE;
+        }
+
+        if ((posts[i].prepare != NULL) && (posts[i].prepare(repo->worktreePath, posts[i].prepareData) != EXIT_SUCCESS)) {
+            fprintf(stderr, "Error: Failed to prepare new post in repository\n");
+            cleanupAfterPull(repo);
+            return EXIT_FAILURE;
+        }
+
+        runCommand(repo, "cd %s && git add %s", worktree, quoteShellArg(repo, posts[i].postsPath));
+        if (posts[i].assetsPath != NULL) runCommand(repo, "cd %s && git add %s", worktree, quoteShellArg(repo, posts[i].assetsPath));
+    }
+
+    // Files updated for all posts (i.e. feeds) are pushed in the same commit
+    // NOTE: Worktree is a fresh clone, so every change is staged
+    if (repo->finish != NULL) {
+        if (repo->finish(repo->worktreePath, repo->finishData) != EXIT_SUCCESS) {
+            fprintf(stderr, "Error: Failed to update repository files for new posts\n");
+            cleanupAfterPull(repo);
+            return EXIT_FAILURE;
+        }
+
+        runCommand(repo, "cd %s && git add -A", worktree);
+    }
+
+    return commitAndPush(repo, ArenaFormat(repo->arena, "StatiqPress Automatized Pull (%i post%s)", count, (count > 1)? "s" : ""));
 }
 
-uint8_t pullToRepository(GitRepository *repo) {
+// Rewrite posts in the cloned repository (i.e. bulk front matter changes),
+// then commit and push all changes to the StatiqPress branch at once
+uint8_t rewriteRepository(GitRepository *repo, GitPrepareCallback rewrite, void *userData, const char *message) {
     uint8_t result = cloneRepository(repo);
     if (result != EXIT_SUCCESS) {
         return result;
     }
 
-    char command[__UINT8_MAX__ + 50];
-    snprintf(command, sizeof(command), "cp %s %s", NEW_POST_PATH, repo->postsPath);
-    if (system(command) != 0) {
-        fprintf(stderr, "Error: Failed to move new post to repository\n");
+    const char *worktree = quoteShellArg(repo, repo->worktreePath);
+    runCommand(repo, "cd %s && (git checkout StatiqPress 2>/dev/null || git checkout -b StatiqPress)", worktree);
+
+    if (rewrite(repo->worktreePath, userData) != EXIT_SUCCESS) {
+        fprintf(stderr, "Error: Failed to rewrite posts in repository\n");
+        cleanupAfterPull(repo);
         return EXIT_FAILURE;
     }
 
-    system("cd target && git checkout -b StatiqPress");
-    system("cd target && git add content/en/post");
-    system("cd target && git commit -m 'StatiqPress Automatized Pull'");
-    system("cd target && git push origin StatiqPress");
+    runCommand(repo, "cd %s && git add -A %s", worktree, quoteShellArg(repo, repo->postsPath));
 
-    cleanupAfterPull();
+    return commitAndPush(repo, message);
+}
 
-    return EXIT_SUCCESS;
-}
\ No newline at end of file
+static uint32_t sha1Rotate(uint32_t value, int bits) {
+    return (value << bits) | (value >> (32 - bits));
+}
+
+// Process one 64 bytes SHA-1 block
+static void sha1Transform(Sha1Context *context, const uint8_t *block) {
+    uint32_t w[80];
+    for (int i = 0; i < 16; i++) w[i] = ((uint32_t)block[i*4] << 24) | ((uint32_t)block[i*4 + 1] << 16) | ((uint32_t)block[i*4 + 2] << 8) | block[i*4 + 3];
+    for (int i = 16; i < 80; i++) w[i] = sha1Rotate(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+    uint32_t a = context->state[0], b = context->state[1], c = context->state[2], d = context->state[3], e = context->state[4];
+
+    for (int i = 0; i < 80; i++) {
+        uint32_t f = 0, k = 0;
+        if (i < 20) { f = (b & c) | (~b & d); k = 0x5a827999; }
+        else if (i < 40) { f = b ^ c ^ d; k = 0x6ed9eba1; }
+        else if (i < 60) { f = (b & c) | (b & d) | (c & d); k = 0x8f1bbcdc; }
+        else { f = b ^ c ^ d; k = 0xca62c1d6; }
+
+        uint32_t temp = sha1Rotate(a, 5) + f + e + k + w[i];
+        e = d; d = c; c = sha1Rotate(b, 30); b = a; a = temp;
+    }
+
+    context->state[0] += a; context->state[1] += b; context->state[2] += c; context->state[3] += d; context->state[4] += e;
+}
+
+static void sha1Init(Sha1Context *context) {
+    static const uint32_t initState[5] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0 };
+    memset(context, 0, sizeof(Sha1Context));
+    memcpy(context->state, initState, sizeof(initState));
+}
+
+static void sha1Update(Sha1Context *context, const void *data, size_t size) {
+    const uint8_t *bytes = (const uint8_t *)data;
+    context->length += size;
+
+    while (size > 0) {
+        size_t count = ((64 - context->bufferSize) < size)? (64 - context->bufferSize) : size;
+        memcpy(context->buffer + context->bufferSize, bytes, count);
+        context->bufferSize += count;
+        bytes += count;
+        size -= count;
+
+        if (context->bufferSize == 64) {
+            sha1Transform(context, context->buffer);
+            context->bufferSize = 0;
+        }
+    }
+}
+
+// Finish SHA-1 computation, digest is written as hex string (41 chars including terminator)
+static void sha1Final(Sha1Context *context, char *hex) {
+    uint64_t bitLength = context->length*8;
+    uint8_t padding = 0x80;
+    sha1Update(context, &padding, 1);
+
+    padding = 0;
+    while (context->bufferSize != 56) sha1Update(context, &padding, 1);
+
+    uint8_t lengthBytes[8];
+    for (int i = 0; i < 8; i++) lengthBytes[i] = (uint8_t)(bitLength >> (56 - i*8));
+    sha1Update(context, lengthBytes, 8);
+
+    for (int i = 0; i < 5; i++) sprintf(hex + i*8, "%08x", context->state[i]);
+}
+
+// Compute git blob object id of data, as git hash-object does
+void computeBlobId(const void *data, size_t size, char *id) {
+    char header[32];
+    int headerSize = snprintf(header, sizeof(header), "blob %zu", size) + 1;   // Header includes NULL terminator
+
+    Sha1Context context;
+    sha1Init(&context);
+    sha1Update(&context, header, headerSize);
+    sha1Update(&context, data, size);
+    sha1Final(&context, id);
+}
+
+static int compareTreeEntries(const void *a, const void *b) {
+    return strcmp(((const GitTreeEntry *)a)->path, ((const GitTreeEntry *)b)->path);
+}
+
+// Load tree of StatiqPress branch (repository HEAD if not pushed yet) from mirror
+// NOTE: Entries are allocated in repository arena
+GitTree loadMirrorTree(GitRepository *repo, const char *mirrorPath) {
+    GitTree tree = { 0 };
+
+    const char *gitDir = quoteShellArg(repo, mirrorPath);
+    const char *command = ArenaFormat(repo->arena, "git --git-dir=%s ls-tree -r -l -z --full-tree StatiqPress 2>/dev/null || "
+        "git --git-dir=%s ls-tree -r -l -z --full-tree HEAD", gitDir, gitDir);
+
+    FILE *pipe = popen(command, "r");
+    if (pipe == NULL) return tree;
+
+    // Records are NULL terminated: "<mode> <type> <id> <size>\t<path>"
+    size_t size = 0, capacity = 64*1024;
+    char *output = (char *)malloc(capacity);
+    size_t read = 0;
+    while ((output != NULL) && ((read = fread(output + size, 1, capacity - size - 1, pipe)) > 0)) {
+        size += read;
+        if ((capacity - size) < 1024) {
+            char *newOutput = (char *)realloc(output, capacity*2);
+            if (newOutput == NULL) { free(output); output = NULL; break; }
+            output = newOutput;
+            capacity *= 2;
+        }
+    }
+    pclose(pipe);
+    if (output == NULL) return tree;
+    output[size] = '\0';
+
+    int count = 0;
+    for (size_t i = 0; i < size; i++) if (output[i] == '\0') count++;
+    tree.entries = (GitTreeEntry *)ArenaAlloc(repo->arena, (count + 1)*sizeof(GitTreeEntry));
+
+    for (char *record = output; (tree.entries != NULL) && (record < (output + size)); record += strlen(record) + 1) {
+        char type[16] = { 0 };
+        GitTreeEntry *entry = &tree.entries[tree.count];
+        char *path = strchr(record, '\t');
+
+        if ((path == NULL) || (sscanf(record, "%*s %15s %40s %ld", type, entry->id, &entry->size) != 3) || (strcmp(type, "blob") != 0)) continue;
+
+        entry->path = ArenaStrdup(repo->arena, path + 1);
+        tree.count++;
+    }
+
+    free(output);
+
+    qsort(tree.entries, tree.count, sizeof(GitTreeEntry), compareTreeEntries);
+
+    return tree;
+}
+
+// Find tree entry by path, NULL if not found
+const GitTreeEntry *findTreeEntry(const GitTree *tree, const char *path) {
+    GitTreeEntry key = { 0 };
+    key.path = path;
+
+    return (tree->count > 0)? (const GitTreeEntry *)bsearch(&key, tree->entries, tree->count, sizeof(GitTreeEntry), compareTreeEntries) : NULL;
+}
+
+// Create ids file with a unique name in mirror, so concurrent blob reads (i.e. index refresh
+// and site images check) do not overwrite each other requests
+static FILE *createBlobIdsFile(GitRepository *repo, const char *mirrorPath, char **idsPath) {
+    *idsPath = ArenaFormat(repo->arena, "%s/statiqpress-blobs-XXXXXX", mirrorPath);
+    if (*idsPath == NULL) return NULL;
+
+#if defined(_WIN32)
+    return (_mktemp_s(*idsPath, strlen(*idsPath) + 1) == 0)? fopen(*idsPath, "w") : NULL;
+#else
+    int fd = mkstemp(*idsPath);
+    if (fd < 0) return NULL;
+
+    FILE *file = fdopen(fd, "w");
+    if (file == NULL) {
+        close(fd);
+        remove(*idsPath);
+    }
+
+    return file;
+#endif
+}
+
+// Read blobs from mirror in a single git process, callback is called for every blob found
+// NOTE: Ids are passed through a file (not command line), thousands of blobs can be requested;
+// ids can be any object name (i.e. "HEAD:<path>"), callback gets the blob id and the request index
+int loadMirrorBlobs(GitRepository *repo, const char *mirrorPath, const char *const *ids, int count, GitBlobCallback callback, void *userData) {
+    if (count <= 0) return 0;
+
+    char *idsPath = NULL;
+    FILE *idsFile = createBlobIdsFile(repo, mirrorPath, &idsPath);
+    if (idsFile == NULL) return 0;
+    for (int i = 0; i < count; i++) fprintf(idsFile, "%s\n", ids[i]);
+    fclose(idsFile);
+
+    FILE *pipe = popen(ArenaFormat(repo->arena, "git --git-dir=%s cat-file --batch < %s", quoteShellArg(repo, mirrorPath), quoteShellArg(repo, idsPath)), "r");
+    if (pipe == NULL) {
+        remove(idsPath);
+        return 0;
+    }
+
+    // Records: "<id> <type> <size>\n<data>\n", missing objects: "<id> missing\n", one record per
+    // requested id in request order
+    int loaded = 0;
+    size_t capacity = 0;
+    char *data = NULL;
+    char line[256] = { 0 };
+    for (int request = 0; fgets(line, sizeof(line), pipe) != NULL; request++) {
+        if (strchr(line, '\n') == NULL) {
+            // Long object name (missing record), rest of line skipped
+            int c = 0;
+            while (((c = fgetc(pipe)) != EOF) && (c != '\n')) { }
+        }
+
+        char id[41] = { 0 }, type[16] = { 0 };
+        long size = 0;
+        if ((sscanf(line, "%40s %15s %ld", id, type, &size) != 3) || (size < 0)) continue;
+
+        if ((size_t)size + 1 > capacity) {
+            char *newData = (char *)realloc(data, size + 1);
+            if (newData == NULL) break;
+            data = newData;
+            capacity = size + 1;
+        }
+
+        if (fread(data, 1, size, pipe) != (size_t)size) break;
+        data[size] = '\0';
+        fgetc(pipe);    // Record trailing newline
+
+        if (strcmp(type, "blob") == 0) {
+            callback(id, request, data, size, userData);
+            loaded++;
+        }
+    }
+
+    free(data);
+    pclose(pipe);
+    remove(idsPath);
+
+    return loaded;
+}
@@ -58,8 +58,15 @@ typedef struct {
     bool btnIssuePressed;
     bool btnUserPressed;
 
-    // Custom variables
-    // TODO.
+    // Site profiles options
+    const char *profileNames;       // Site profiles names, separated by ';' (NULL if none)
+    int profileActive;
+    int prevProfileActive;
+    bool btnSaveProfilePressed;
+    bool btnExportProfilesPressed;
+
+    // Post options
+    bool btnExportBundlePressed;
 
 } GuiMainToolbarState;
 
@@ -130,8 +137,15 @@ GuiMainToolbarState InitGuiMainToolbar(void)
     state.btnIssuePressed = false;
     state.btnUserPressed = false;
     
-    // Custom variables
-    // TODO.
+    // Site profiles options
+    state.profileNames = NULL;
+    state.profileActive = 0;
+    state.prevProfileActive = 0;
+    state.btnSaveProfilePressed = false;
+    state.btnExportProfilesPressed = false;
+
+    // Post options
+    state.btnExportBundlePressed = false;
 
     // Enable tooltips by default
     GuiEnableTooltip();
@@ -150,6 +164,21 @@ void GuiMainToolbar(GuiMainToolbarState *state, int screenWidth) {
     GuiPanel((Rectangle){ state->anchorVisuals.x, state->anchorVisuals.y, 220, 40 }, NULL);
     GuiPanel((Rectangle){ state->anchorRight.x, state->anchorRight.y, 104, 40 }, NULL);
 
+    // Site profiles options
+    GuiSetTooltip("Save build settings as site profile");
+    state->btnSaveProfilePressed = GuiButton((Rectangle){ state->anchorFile.x + 8, state->anchorFile.y + 8, 24, 24 }, "#2#");
+    GuiSetTooltip("Export site profiles as text (.ini)");
+    state->btnExportProfilesPressed = GuiButton((Rectangle){ state->anchorFile.x + 8 + 24 + 4, state->anchorFile.y + 8, 24, 24 }, "#7#");
+
+    // Post options
+    GuiSetTooltip("Export bundle: post and assets as .zip");
+    state->btnExportBundlePressed = GuiButton((Rectangle){ state->anchorFile.x + 8 + (24 + 4)*2, state->anchorFile.y + 8, 24, 24 }, "#179#");
+
+    GuiSetTooltip("Select site profile");
+    if (state->profileNames == NULL) GuiDisable();
+    GuiComboBox((Rectangle){ state->anchorEdit.x + 8, state->anchorEdit.y + 8, 152, 24 }, (state->profileNames != NULL)? state->profileNames : "No profiles", &state->profileActive);
+    GuiEnable();
+
     // Info options
     GuiSetTooltip("Show help window (F1)");
     state->btnHelpPressed = GuiButton((Rectangle){ state->anchorRight.x + (screenWidth - state->anchorRight.x) - 12 - 72 - 8, state->anchorRight.y + 8, 24, 24 }, "#221#"); 
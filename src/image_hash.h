@@ -0,0 +1,455 @@
+/*******************************************************************************************
+*
+*   Image Hash - Perceptual image hashes, near-duplicates search (BK-tree) and hashes cache
+*
+*   MODULE USAGE:
+*       #define IMAGE_HASH_IMPLEMENTATION
+*       #include "image_hash.h"
+*
+*       uint64_t hash = ComputeImageHash(image);            // Any raylib image, any size
+*
+*       ImageHashTree tree = { 0 };
+*       AddImageHashTreeValue(&tree, siteHash, siteImageIndex);
+*       ImageHashMatch matches[4] = { 0 };
+*       int count = SearchImageHashTree(&tree, hash, 10, matches, 4);   // Closest first
+*       UnloadImageHashTree(&tree);
+*
+*   NOTES:
+*       Hash is a 64-bit DCT hash (pHash): image is reduced to 32x32 luminance (area average, alpha
+*       composed over white), transformed with a separable DCT-II and the 8x8 lowest frequencies
+*       are compared with their median, one bit each. Images resized, recompressed or slightly
+*       cropped/retouched keep most bits, distance between hashes is the count of different bits
+*
+*       DCT is computed as two small matrix products over contiguous float rows (only 8 output
+*       rows/columns are needed), plain loops the compiler vectorizes
+*
+*       BK-tree nodes are stored in a single array (children as linked lists), search only visits
+*       children whose distance to parent is within [d - maxDistance, d + maxDistance]
+*
+*   FILE STRUCTURE (hashes cache):
+*       ------------------------------------------------------
+*       Offset  | Size    | Type       | Description
+*       ------------------------------------------------------
+*       0       | 4       | char       | Signature: "SQPH"
+*       4       | 2       | short      | Version: 100
+*       6       | 2       | short      | Reserved
+*       8       | 4       | int        | Records count (N)
+*       12      | 32*N    | record     | Records sorted by blob id: blob id (SHA-1, binary, 20 bytes),
+*                                      | hash (8 bytes), flags (4 bytes, 1: image decoded)
+*
+*   DEPENDENCIES:
+*       raylib          - Image, LoadImageColors()
+*       file_batch.h    - Crash-safe file saving (temp file synced and renamed)
+*
+*   LICENSE: GPLv3, check LICENSE file for details
+*
+**********************************************************************************************/
+
+#ifndef IMAGE_HASH_H
+#define IMAGE_HASH_H
+
+#include "raylib.h"
+
+#include <stdint.h>         // Required for: uint64_t
+#include <stdbool.h>        // Required for: bool
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define IMAGE_HASH_VERSION          100     // Hashes cache file format version
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// BK-tree node
+typedef struct ImageHashNode {
+    uint64_t hash;
+    int value;                      // User value (i.e. image index)
+    int distance;                   // Distance to parent node
+    int firstChild;                 // Node index, -1 if none
+    int nextSibling;                // Node index, -1 if none
+} ImageHashNode;
+
+// BK-tree of image hashes, first node is root
+typedef struct ImageHashTree {
+    ImageHashNode *nodes;
+    int count;
+    int capacity;
+} ImageHashTree;
+
+// Search match
+typedef struct ImageHashMatch {
+    int value;
+    int distance;
+} ImageHashMatch;
+
+// Hashes cache record, hash of image blob (by blob id)
+typedef struct ImageHashRecord {
+    char blobId[41];                // Blob id (SHA-1, hex)
+    uint64_t hash;
+    bool decoded;                   // Image could be decoded (hash not valid otherwise)
+} ImageHashRecord;
+
+// Hashes cache, records sorted by blob id
+typedef struct ImageHashCache {
+    ImageHashRecord *records;
+    int count;
+} ImageHashCache;
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+uint64_t ComputeImageHash(Image image);                                 // Compute perceptual hash of image (0 if no data)
+int GetImageHashDistance(uint64_t hash1, uint64_t hash2);               // Get distance between hashes (different bits, 0..64)
+
+bool AddImageHashTreeValue(ImageHashTree *tree, uint64_t hash, int value); // Add hash to tree, with user value
+int SearchImageHashTree(const ImageHashTree *tree, uint64_t hash, int maxDistance, ImageHashMatch *matches, int maxCount); // Search hashes within distance, closest first
+void UnloadImageHashTree(ImageHashTree *tree);                          // Unload tree nodes
+
+ImageHashCache LoadImageHashCache(const char *fileName);                // Load hashes cache file, empty cache if not valid
+void UnloadImageHashCache(ImageHashCache *cache);                       // Unload hashes cache
+const ImageHashRecord *FindImageHashRecord(const ImageHashCache *cache, const char *blobId); // Find record by blob id, NULL if not found
+bool SaveImageHashCache(const char *fileName, ImageHashRecord *records, int count); // Save hashes cache file (records are sorted, duplicates skipped)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // IMAGE_HASH_H
+
+/***********************************************************************************
+*
+*   IMAGE_HASH IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(IMAGE_HASH_IMPLEMENTATION)
+
+#include "file_batch.h"     // Required for: BeginFileBatch(), SaveBatchFileData(), EndFileBatch()
+
+#include <stdio.h>          // Required for: FILE, fopen(), fread(), fclose()
+#include <stdlib.h>         // Required for: malloc(), realloc(), free(), qsort(), bsearch()
+#include <string.h>         // Required for: memcpy(), memcmp(), strcmp()
+#include <math.h>           // Required for: cosf(), sqrtf()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define IMAGE_HASH_SIZE             32      // Reduced image size (luminance)
+#define IMAGE_HASH_FREQUENCIES       8      // Lowest frequencies kept per axis (8x8 bits)
+#define IMAGE_HASH_HEADER_SIZE      12
+#define IMAGE_HASH_RECORD_SIZE      32
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+static int CompareImageHashFloats(const void *a, const void *b)
+{
+    float valueA = *(const float *)a, valueB = *(const float *)b;
+    return (valueA > valueB) - (valueA < valueB);
+}
+
+static int CompareImageHashRecords(const void *a, const void *b)
+{
+    return strcmp(((const ImageHashRecord *)a)->blobId, ((const ImageHashRecord *)b)->blobId);
+}
+
+// Reduce image colors to IMAGE_HASH_SIZE^2 luminance grid, area average (every cell gets at least one pixel)
+static void ReduceImageLuminance(const Color *colors, int width, int height, float *grid)
+{
+    for (int cy = 0; cy < IMAGE_HASH_SIZE; cy++)
+    {
+        int y0 = cy*height/IMAGE_HASH_SIZE;
+        int y1 = (cy + 1)*height/IMAGE_HASH_SIZE;
+        if (y1 <= y0) y1 = y0 + 1;
+
+        for (int cx = 0; cx < IMAGE_HASH_SIZE; cx++)
+        {
+            int x0 = cx*width/IMAGE_HASH_SIZE;
+            int x1 = (cx + 1)*width/IMAGE_HASH_SIZE;
+            if (x1 <= x0) x1 = x0 + 1;
+
+            float sum = 0.0f;
+            for (int y = y0; y < y1; y++)
+            {
+                const Color *row = colors + (size_t)y*width;
+                for (int x = x0; x < x1; x++)
+                {
+                    // Luminance (BT.601), transparent pixels composed over white
+                    float luminance = 0.299f*row[x].r + 0.587f*row[x].g + 0.114f*row[x].b;
+                    sum += (luminance*row[x].a + 255.0f*(255 - row[x].a))/255.0f;
+                }
+            }
+
+            grid[cy*IMAGE_HASH_SIZE + cx] = sum/((float)(y1 - y0)*(x1 - x0));
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Compute perceptual hash of image (DCT hash), 0 if image has no data
+uint64_t ComputeImageHash(Image image)
+{
+    if ((image.data == NULL) || (image.width <= 0) || (image.height <= 0)) return 0;
+
+    Color *colors = LoadImageColors(image);
+    if (colors == NULL) return 0;
+
+    float grid[IMAGE_HASH_SIZE*IMAGE_HASH_SIZE] = { 0 };
+    ReduceImageLuminance(colors, image.width, image.height, grid);
+    UnloadImageColors(colors);
+
+    // DCT-II basis, lowest frequencies only: basis[u][x] = c(u)*cos((2x + 1)*u*PI/2N)
+    float basis[IMAGE_HASH_FREQUENCIES][IMAGE_HASH_SIZE] = { 0 };
+    for (int u = 0; u < IMAGE_HASH_FREQUENCIES; u++)
+    {
+        float scale = (u == 0)? sqrtf(1.0f/IMAGE_HASH_SIZE) : sqrtf(2.0f/IMAGE_HASH_SIZE);
+        for (int x = 0; x < IMAGE_HASH_SIZE; x++) basis[u][x] = scale*cosf((2*x + 1)*u*3.14159265f/(2*IMAGE_HASH_SIZE));
+    }
+
+    // Vertical pass: rows[u] = sum(basis[u][y]*grid[y]), whole rows accumulated (contiguous, vectorized)
+    float rows[IMAGE_HASH_FREQUENCIES][IMAGE_HASH_SIZE] = { 0 };
+    for (int u = 0; u < IMAGE_HASH_FREQUENCIES; u++)
+    {
+        for (int y = 0; y < IMAGE_HASH_SIZE; y++)
+        {
+            const float weight = basis[u][y];
+            const float *row = grid + y*IMAGE_HASH_SIZE;
+            for (int x = 0; x < IMAGE_HASH_SIZE; x++) rows[u][x] += weight*row[x];
+        }
+    }
+
+    // Horizontal pass: coefficients[u][v] = sum(rows[u][x]*basis[v][x]), basis transposed to keep v contiguous
+    float basisT[IMAGE_HASH_SIZE][IMAGE_HASH_FREQUENCIES] = { 0 };
+    for (int v = 0; v < IMAGE_HASH_FREQUENCIES; v++) for (int x = 0; x < IMAGE_HASH_SIZE; x++) basisT[x][v] = basis[v][x];
+
+    float coefficients[IMAGE_HASH_FREQUENCIES*IMAGE_HASH_FREQUENCIES] = { 0 };
+    for (int u = 0; u < IMAGE_HASH_FREQUENCIES; u++)
+    {
+        float *output = coefficients + u*IMAGE_HASH_FREQUENCIES;
+        for (int x = 0; x < IMAGE_HASH_SIZE; x++)
+        {
+            const float weight = rows[u][x];
+            for (int v = 0; v < IMAGE_HASH_FREQUENCIES; v++) output[v] += weight*basisT[x][v];
+        }
+    }
+
+    // Median of frequencies, DC (average luminance) excluded
+    float sorted[IMAGE_HASH_FREQUENCIES*IMAGE_HASH_FREQUENCIES - 1] = { 0 };
+    memcpy(sorted, coefficients + 1, sizeof(sorted));
+    qsort(sorted, IMAGE_HASH_FREQUENCIES*IMAGE_HASH_FREQUENCIES - 1, sizeof(float), CompareImageHashFloats);
+    float median = sorted[(IMAGE_HASH_FREQUENCIES*IMAGE_HASH_FREQUENCIES - 1)/2];
+
+    uint64_t hash = 0;
+    for (int i = 0; i < IMAGE_HASH_FREQUENCIES*IMAGE_HASH_FREQUENCIES; i++) if (coefficients[i] > median) hash |= (1ull << i);
+
+    return hash;
+}
+
+// Get distance between hashes: number of different bits (0..64)
+int GetImageHashDistance(uint64_t hash1, uint64_t hash2)
+{
+    uint64_t bits = hash1 ^ hash2;
+    int count = 0;
+    while (bits != 0) { bits &= bits - 1; count++; }
+
+    return count;
+}
+
+// Add hash to tree, with user value
+bool AddImageHashTreeValue(ImageHashTree *tree, uint64_t hash, int value)
+{
+    if (tree->count >= tree->capacity)
+    {
+        int capacity = (tree->capacity > 0)? tree->capacity*2 : 256;
+        ImageHashNode *nodes = (ImageHashNode *)realloc(tree->nodes, capacity*sizeof(ImageHashNode));
+        if (nodes == NULL) return false;
+
+        tree->nodes = nodes;
+        tree->capacity = capacity;
+    }
+
+    int index = tree->count++;
+    tree->nodes[index] = (ImageHashNode){ hash, value, 0, -1, -1 };
+    if (index == 0) return true;
+
+    // Descend to the child at same distance from every node, new node is linked where there is none
+    int node = 0;
+    int distance = GetImageHashDistance(hash, tree->nodes[0].hash);
+    while (true)
+    {
+        int child = tree->nodes[node].firstChild;
+        while ((child >= 0) && (tree->nodes[child].distance != distance)) child = tree->nodes[child].nextSibling;
+
+        if (child < 0)
+        {
+            tree->nodes[index].distance = distance;
+            tree->nodes[index].nextSibling = tree->nodes[node].firstChild;
+            tree->nodes[node].firstChild = index;
+            break;
+        }
+
+        node = child;
+        distance = GetImageHashDistance(hash, tree->nodes[node].hash);
+    }
+
+    return true;
+}
+
+// Search hashes within distance, returns matches count (closest first, at most maxCount)
+int SearchImageHashTree(const ImageHashTree *tree, uint64_t hash, int maxDistance, ImageHashMatch *matches, int maxCount)
+{
+    if ((tree->count == 0) || (maxCount <= 0)) return 0;
+
+    // Every node is pushed at most once, stack never holds more than count nodes
+    int *stack = (int *)malloc(tree->count*sizeof(int));
+    if (stack == NULL) return 0;
+
+    int stackCount = 0;
+    int count = 0;
+    stack[stackCount++] = 0;
+
+    while (stackCount > 0)
+    {
+        const ImageHashNode *node = &tree->nodes[stack[--stackCount]];
+        int distance = GetImageHashDistance(hash, node->hash);
+
+        if (distance <= maxDistance)
+        {
+            // Sorted insertion, farthest match dropped when full
+            int position = count;
+            if (count < maxCount) count++;
+            else position = (distance < matches[maxCount - 1].distance)? maxCount - 1 : -1;
+
+            if (position >= 0)
+            {
+                while ((position > 0) && (matches[position - 1].distance > distance))
+                {
+                    matches[position] = matches[position - 1];
+                    position--;
+                }
+                matches[position] = (ImageHashMatch){ node->value, distance };
+            }
+        }
+
+        for (int child = node->firstChild; child >= 0; child = tree->nodes[child].nextSibling)
+        {
+            if (abs(tree->nodes[child].distance - distance) <= maxDistance) stack[stackCount++] = child;
+        }
+    }
+
+    free(stack);
+
+    return count;
+}
+
+// Unload tree nodes
+void UnloadImageHashTree(ImageHashTree *tree)
+{
+    free(tree->nodes);
+    *tree = (ImageHashTree){ 0 };
+}
+
+// Load hashes cache file, empty cache if not valid
+ImageHashCache LoadImageHashCache(const char *fileName)
+{
+    ImageHashCache cache = { 0 };
+
+    FILE *file = fopen(fileName, "rb");
+    if (file == NULL) return cache;
+
+    unsigned char header[IMAGE_HASH_HEADER_SIZE] = { 0 };
+    int count = 0;
+    if ((fread(header, 1, IMAGE_HASH_HEADER_SIZE, file) == IMAGE_HASH_HEADER_SIZE) && (memcmp(header, "SQPH", 4) == 0) &&
+        ((header[4] | (header[5] << 8)) == IMAGE_HASH_VERSION))
+    {
+        count = (int)(header[8] | (header[9] << 8) | (header[10] << 16) | ((unsigned int)header[11] << 24));
+    }
+
+    if (count > 0) cache.records = (ImageHashRecord *)calloc(count, sizeof(ImageHashRecord));
+
+    unsigned char record[IMAGE_HASH_RECORD_SIZE] = { 0 };
+    for (int i = 0; (cache.records != NULL) && (i < count); i++)
+    {
+        if (fread(record, 1, IMAGE_HASH_RECORD_SIZE, file) != IMAGE_HASH_RECORD_SIZE) break;
+
+        ImageHashRecord *entry = &cache.records[cache.count];
+        for (int k = 0; k < 20; k++) snprintf(entry->blobId + k*2, 3, "%02x", record[k]);
+        for (int k = 0; k < 8; k++) entry->hash |= (uint64_t)record[20 + k] << (k*8);
+        entry->decoded = (record[28] & 1);
+        cache.count++;
+    }
+
+    fclose(file);
+
+    if (cache.count < count) UnloadImageHashCache(&cache);     // Truncated file, not used
+
+    return cache;
+}
+
+// Unload hashes cache
+void UnloadImageHashCache(ImageHashCache *cache)
+{
+    free(cache->records);
+    *cache = (ImageHashCache){ 0 };
+}
+
+// Find record by blob id (binary search), NULL if not found
+const ImageHashRecord *FindImageHashRecord(const ImageHashCache *cache, const char *blobId)
+{
+    if (cache->count == 0) return NULL;
+
+    ImageHashRecord key = { 0 };
+    snprintf(key.blobId, sizeof(key.blobId), "%s", blobId);
+
+    return (const ImageHashRecord *)bsearch(&key, cache->records, cache->count, sizeof(ImageHashRecord), CompareImageHashRecords);
+}
+
+// Save hashes cache file (replaced atomically), records are sorted by blob id and duplicates skipped
+bool SaveImageHashCache(const char *fileName, ImageHashRecord *records, int count)
+{
+    if (count > 0) qsort(records, count, sizeof(ImageHashRecord), CompareImageHashRecords);
+
+    unsigned char *data = (unsigned char *)malloc(IMAGE_HASH_HEADER_SIZE + (size_t)count*IMAGE_HASH_RECORD_SIZE);
+    if (data == NULL) return false;
+
+    int savedCount = 0;
+    for (int i = 0; i < count; i++)
+    {
+        if ((i > 0) && (strcmp(records[i].blobId, records[i - 1].blobId) == 0)) continue;
+
+        unsigned char *record = data + IMAGE_HASH_HEADER_SIZE + (size_t)savedCount*IMAGE_HASH_RECORD_SIZE;
+        memset(record, 0, IMAGE_HASH_RECORD_SIZE);
+        for (int k = 0; k < 20; k++)
+        {
+            unsigned int byte = 0;
+            sscanf(records[i].blobId + k*2, "%2x", &byte);
+            record[k] = (unsigned char)byte;
+        }
+        for (int k = 0; k < 8; k++) record[20 + k] = (unsigned char)(records[i].hash >> (k*8));
+        record[28] = records[i].decoded? 1 : 0;
+        savedCount++;
+    }
+
+    memcpy(data, "SQPH", 4);
+    data[4] = IMAGE_HASH_VERSION & 0xff;
+    data[5] = (IMAGE_HASH_VERSION >> 8) & 0xff;
+    data[6] = data[7] = 0;
+    for (int k = 0; k < 4; k++) data[8 + k] = (unsigned char)((unsigned int)savedCount >> (k*8));
+
+    FileBatch *batch = BeginFileBatch();
+    SaveBatchFileData(batch, fileName, data, IMAGE_HASH_HEADER_SIZE + savedCount*IMAGE_HASH_RECORD_SIZE);
+    bool success = EndFileBatch(batch);
+
+    free(data);
+
+    return success;
+}
+
+#endif // IMAGE_HASH_IMPLEMENTATION
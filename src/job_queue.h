@@ -0,0 +1,258 @@
+/*******************************************************************************************
+*
+*   Job Queue - Background thread running jobs in order, polled without blocking
+*
+*   MODULE USAGE:
+*       #define JOB_QUEUE_IMPLEMENTATION
+*       #include "job_queue.h"
+*
+*       JobQueue *queue = LoadJobQueue();
+*       int job = AddJob(queue, PrepareDraft, draft);       // Returns immediately
+*       if (IsJobDone(queue, job)) ...                      // Poll, i.e. once per frame
+*       WaitJob(queue, job);                                // Or block until done
+*       UnloadJobQueue(queue);
+*
+*   NOTES:
+*       Jobs are run one at a time in the order they were added, so a job is done once every
+*       previously added job is done: job ids are increasing and a single counter is checked.
+*       Long CPU-bound batches should use worker_pool.h instead, this queue is meant to keep
+*       slow work (file reading, post preparation) out of the GUI frame
+*
+*       Threads are not available on PLATFORM_WEB, jobs are run on calling thread when added
+*
+*   LICENSE: GPLv3, check LICENSE file for details
+*
+**********************************************************************************************/
+
+#ifndef JOB_QUEUE_H
+#define JOB_QUEUE_H
+
+#include <stdbool.h>        // Required for: bool
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#if defined(__EMSCRIPTEN__) && !defined(JOB_QUEUE_NO_THREADS)
+    #define JOB_QUEUE_NO_THREADS
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Job function, data is owned by caller and must be valid until job is done
+typedef void (*JobFunc)(void *data);
+
+// Job queue, opaque type
+typedef struct JobQueue JobQueue;
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+JobQueue *LoadJobQueue(void);                           // Load job queue, background thread is started
+void UnloadJobQueue(JobQueue *queue);                   // Unload job queue, running job is waited, pending jobs are dropped
+int AddJob(JobQueue *queue, JobFunc func, void *data);  // Add job to queue, returns job id (-1 on error)
+bool IsJobDone(JobQueue *queue, int id);                // Check if job is done (or dropped)
+void WaitJob(JobQueue *queue, int id);                  // Wait for job to be done
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // JOB_QUEUE_H
+
+/***********************************************************************************
+*
+*   JOB_QUEUE IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(JOB_QUEUE_IMPLEMENTATION)
+
+#include <stdlib.h>         // Required for: calloc(), free()
+
+#if !defined(JOB_QUEUE_NO_THREADS)
+    #include <pthread.h>    // Required for: pthread_create(), pthread_join(), pthread_mutex_*(), pthread_cond_*()
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct Job {
+    JobFunc func;
+    void *data;
+} Job;
+
+struct JobQueue {
+    Job *jobs;                      // Pending jobs, circular buffer
+    int capacity;
+    int first;                      // Position of next job to run
+    int count;
+
+    int addedCount;                 // Jobs added, last job id + 1
+    int doneCount;                  // Jobs done, every job with id < doneCount is done
+    bool quit;
+#if !defined(JOB_QUEUE_NO_THREADS)
+    pthread_mutex_t mutex;          // Protects queue state
+    pthread_cond_t added;           // Signaled when a job is added or queue is unloaded
+    pthread_cond_t done;            // Signaled when a job is done
+    pthread_t thread;
+    bool threadRunning;
+#endif
+};
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+#if !defined(JOB_QUEUE_NO_THREADS)
+// Job queue thread: jobs are run in order until queue is unloaded
+static void *JobQueueThread(void *data)
+{
+    JobQueue *queue = (JobQueue *)data;
+
+    pthread_mutex_lock(&queue->mutex);
+    while (!queue->quit)
+    {
+        if (queue->count == 0)
+        {
+            pthread_cond_wait(&queue->added, &queue->mutex);
+            continue;
+        }
+
+        Job job = queue->jobs[queue->first];
+        queue->first = (queue->first + 1)%queue->capacity;
+        queue->count--;
+
+        pthread_mutex_unlock(&queue->mutex);
+        job.func(job.data);
+        pthread_mutex_lock(&queue->mutex);
+
+        queue->doneCount++;
+        pthread_cond_broadcast(&queue->done);
+    }
+    pthread_mutex_unlock(&queue->mutex);
+
+    return NULL;
+}
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Load job queue, background thread is started
+JobQueue *LoadJobQueue(void)
+{
+    JobQueue *queue = (JobQueue *)calloc(1, sizeof(JobQueue));
+    if (queue == NULL) return NULL;
+
+#if !defined(JOB_QUEUE_NO_THREADS)
+    pthread_mutex_init(&queue->mutex, NULL);
+    pthread_cond_init(&queue->added, NULL);
+    pthread_cond_init(&queue->done, NULL);
+    queue->threadRunning = (pthread_create(&queue->thread, NULL, JobQueueThread, queue) == 0);
+#endif
+
+    return queue;
+}
+
+// Unload job queue: running job is waited, pending jobs are dropped (reported as done)
+void UnloadJobQueue(JobQueue *queue)
+{
+    if (queue == NULL) return;
+
+#if !defined(JOB_QUEUE_NO_THREADS)
+    pthread_mutex_lock(&queue->mutex);
+    queue->quit = true;
+    pthread_cond_signal(&queue->added);
+    pthread_mutex_unlock(&queue->mutex);
+
+    if (queue->threadRunning) pthread_join(queue->thread, NULL);
+
+    pthread_cond_destroy(&queue->done);
+    pthread_cond_destroy(&queue->added);
+    pthread_mutex_destroy(&queue->mutex);
+#endif
+
+    free(queue->jobs);
+    free(queue);
+}
+
+// Add job to queue, returns job id (-1 on error)
+// NOTE: If no thread is available, job is run before returning
+int AddJob(JobQueue *queue, JobFunc func, void *data)
+{
+    if ((queue == NULL) || (func == NULL)) return -1;
+
+#if !defined(JOB_QUEUE_NO_THREADS)
+    if (queue->threadRunning)
+    {
+        pthread_mutex_lock(&queue->mutex);
+
+        if (queue->count >= queue->capacity)
+        {
+            // Circular buffer is grown, pending jobs are moved to buffer start
+            int capacity = (queue->capacity > 0)? queue->capacity*2 : 16;
+            Job *jobs = (Job *)calloc(capacity, sizeof(Job));
+            if (jobs == NULL)
+            {
+                pthread_mutex_unlock(&queue->mutex);
+                return -1;
+            }
+
+            for (int i = 0; i < queue->count; i++) jobs[i] = queue->jobs[(queue->first + i)%queue->capacity];
+            free(queue->jobs);
+            queue->jobs = jobs;
+            queue->capacity = capacity;
+            queue->first = 0;
+        }
+
+        queue->jobs[(queue->first + queue->count)%queue->capacity] = (Job){ func, data };
+        queue->count++;
+        int id = queue->addedCount++;
+
+        pthread_cond_signal(&queue->added);
+        pthread_mutex_unlock(&queue->mutex);
+
+        return id;
+    }
+#endif
+
+    // No thread available, job is run on calling thread
+    func(data);
+    queue->doneCount++;
+
+    return queue->addedCount++;
+}
+
+// Check if job is done
+bool IsJobDone(JobQueue *queue, int id)
+{
+    if ((queue == NULL) || (id < 0)) return true;
+
+#if !defined(JOB_QUEUE_NO_THREADS)
+    pthread_mutex_lock(&queue->mutex);
+    bool done = (id < queue->doneCount) || queue->quit;
+    pthread_mutex_unlock(&queue->mutex);
+
+    return done;
+#else
+    return (id < queue->doneCount);
+#endif
+}
+
+// Wait for job to be done
+void WaitJob(JobQueue *queue, int id)
+{
+    if ((queue == NULL) || (id < 0)) return;
+
+#if !defined(JOB_QUEUE_NO_THREADS)
+    pthread_mutex_lock(&queue->mutex);
+    while ((id >= queue->doneCount) && !queue->quit) pthread_cond_wait(&queue->done, &queue->mutex);
+    pthread_mutex_unlock(&queue->mutex);
+#endif
+}
+
+#endif // JOB_QUEUE_IMPLEMENTATION
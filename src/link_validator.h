@@ -0,0 +1,698 @@
+/*******************************************************************************************
+*
+*   Link Validator - Check post links and images against repository tree and post files
+*
+*   MODULE USAGE:
+*       #define LINK_VALIDATOR_IMPLEMENTATION
+*       #include "link_validator.h"
+*
+*       LinkTree site = LoadLinkTree(treeCount);                // Repository tree paths
+*       for (int i = 0; i < treeCount; i++) AddLinkTreePath(&site, tree[i].path);
+*       LinkTree post = LoadLinkTree(2);                        // Post folder files
+*       AddLinkTreePath(&post, "index.md");
+*       AddLinkTreePath(&post, "banner.png");
+*
+*       LinkIssue issues[64] = { 0 };
+*       int count = ValidatePostLinks(markdown, &site, &post, "content/blog/hello", issues, 64, NULL, pool);
+*
+*   NOTES:
+*       Links are collected from markdown inline links and images, reference definitions,
+*       autolinks and html src/href attributes; fenced code blocks and code spans are skipped
+*
+*       Internal links are resolved as the site would serve them: relative links from post
+*       folder (page bundle), root links from repository root, static folder or content folder
+*       (Hugo, Zola), "@/" links from content folder (Zola). A folder link is valid if folder has
+*       an index page (index.md, _index.md, index.html) or a page with folder name exists (.md)
+*
+*       Links into post folder are checked against post files (post is not in repository yet),
+*       other internal links are not checked if no repository tree is provided (LINK_SKIPPED)
+*
+*       External URLs are only checked syntactically: no network request is done
+*
+*       Paths are kept in hash tables (not copied), lookups are lock-free once tables are loaded,
+*       so links are checked in batches on worker pool; small posts are checked on calling thread
+*
+*   DEPENDENCIES:
+*       worker_pool.h       - Parallel links checking
+*
+*   LICENSE: GPLv3, check LICENSE file for details
+*
+**********************************************************************************************/
+
+#ifndef LINK_VALIDATOR_H
+#define LINK_VALIDATOR_H
+
+#include "worker_pool.h"
+
+#include <stdbool.h>        // Required for: bool
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define LINK_VALIDATOR_MAX_PATH         512     // Max length of resolved link path
+#define LINK_VALIDATOR_BATCH_SIZE       64      // Links checked per worker job
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Link check status
+typedef enum LinkStatus {
+    LINK_VALID = 0,
+    LINK_SKIPPED,                   // Not checked: fragment, template code, no repository tree
+    LINK_BROKEN,                    // Internal link target not found in repository tree or post files
+    LINK_MALFORMED                  // External URL not valid (syntax)
+} LinkStatus;
+
+// Link paths set, paths are not copied
+typedef struct LinkTree {
+    const char **paths;             // Open addressing hash table, NULL for empty slots
+    int capacity;                   // Power of two, kept at most half full
+    int count;
+} LinkTree;
+
+// Link issue found in content
+typedef struct LinkIssue {
+    int line;                       // Content line (1-based)
+    LinkStatus status;              // LINK_BROKEN or LINK_MALFORMED
+    char target[256];               // Link target, as written
+} LinkIssue;
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+LinkTree LoadLinkTree(int count);                                   // Load empty link paths set, sized for count paths
+void UnloadLinkTree(LinkTree *tree);                                // Unload link paths set
+void AddLinkTreePath(LinkTree *tree, const char *path);             // Add path to set, path must be valid while set is used
+bool IsLinkTreePath(const LinkTree *tree, const char *path, int length); // Check if path is in set
+
+int ValidatePostLinks(const char *content, const LinkTree *site, const LinkTree *post, const char *postPath,
+                      LinkIssue *issues, int maxCount, int *linkCount, WorkerPool *pool); // Check content links, returns issues count
+LinkStatus CheckLinkTarget(const char *target, int length, const LinkTree *site, const LinkTree *post, const char *postPath); // Check one link target
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LINK_VALIDATOR_H
+
+/***********************************************************************************
+*
+*   LINK_VALIDATOR IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(LINK_VALIDATOR_IMPLEMENTATION)
+
+#include <stdlib.h>         // Required for: calloc(), realloc(), free(), strtol()
+#include <string.h>         // Required for: strlen(), strncmp(), memcpy(), memmove(), memchr()
+#include <stdio.h>          // Required for: snprintf()
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Link found in content
+typedef struct ContentLink {
+    const char *target;
+    int length;
+    int line;
+    LinkStatus status;
+} ContentLink;
+
+// Links batch, checked by worker jobs
+typedef struct LinkBatch {
+    ContentLink *links;
+    int count;
+    const LinkTree *site;
+    const LinkTree *post;
+    const char *postPath;
+} LinkBatch;
+
+// Links found in content, array grown as required
+typedef struct LinkList {
+    ContentLink *links;
+    int count;
+    int capacity;
+} LinkList;
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+static unsigned int HashLinkPath(const char *path, int length)
+{
+    unsigned int hash = 2166136261u;    // FNV-1a
+    for (int i = 0; i < length; i++) hash = (hash ^ (unsigned char)path[i])*16777619u;
+
+    return hash;
+}
+
+// Find path slot: slot of path, or empty slot where it would be added
+static int FindLinkTreeSlot(const LinkTree *tree, const char *path, int length)
+{
+    int slot = (int)(HashLinkPath(path, length) & (tree->capacity - 1));
+    while ((tree->paths[slot] != NULL) && ((strncmp(tree->paths[slot], path, length) != 0) || (tree->paths[slot][length] != '\0')))
+    {
+        slot = (slot + 1) & (tree->capacity - 1);
+    }
+
+    return slot;
+}
+
+static void AddContentLink(LinkList *list, const char *target, int length, int line)
+{
+    if (length <= 0) return;
+
+    if (list->count >= list->capacity)
+    {
+        int capacity = (list->capacity > 0)? list->capacity*2 : 64;
+        ContentLink *links = (ContentLink *)realloc(list->links, capacity*sizeof(ContentLink));
+        if (links == NULL) return;
+
+        list->links = links;
+        list->capacity = capacity;
+    }
+
+    list->links[list->count++] = (ContentLink){ target, length, line, LINK_SKIPPED };
+}
+
+// Get link target length: until closing char, whitespace (markdown title follows) or line end
+// NOTE: Parentheses are balanced inside markdown targets, i.e. wiki URLs
+static int GetLinkTargetLength(const char *target, const char *lineEnd, char end)
+{
+    int length = 0;
+    int depth = 0;
+
+    while ((target + length) < lineEnd)
+    {
+        char c = target[length];
+        if ((c == end) && (depth == 0)) break;
+        if ((end != '>') && (end != '"') && (end != '\'') && ((c == ' ') || (c == '\t'))) break;
+
+        if ((end == ')') && (c == '(')) depth++;
+        else if ((end == ')') && (c == ')')) depth--;
+        length++;
+    }
+
+    return length;
+}
+
+// Collect links of one content line (not in fenced code block)
+static void ScanLinkLine(LinkList *list, const char *line, const char *lineEnd, int lineNumber)
+{
+    // Reference definition: [id]: target
+    const char *ptr = line;
+    while ((ptr < lineEnd) && (ptr < (line + 3)) && (*ptr == ' ')) ptr++;
+    if ((ptr < lineEnd) && (*ptr == '[') && (ptr[1] != '^'))
+    {
+        const char *close = (const char *)memchr(ptr, ']', lineEnd - ptr);
+        if ((close != NULL) && ((close + 1) < lineEnd) && (close[1] == ':'))
+        {
+            const char *target = close + 2;
+            while ((target < lineEnd) && ((*target == ' ') || (*target == '\t'))) target++;
+
+            char end = ' ';
+            if ((target < lineEnd) && (*target == '<')) { target++; end = '>'; }
+            AddContentLink(list, target, GetLinkTargetLength(target, lineEnd, end), lineNumber);
+            return;
+        }
+    }
+
+    for (ptr = line; ptr < lineEnd; ptr++)
+    {
+        // Code span: skipped up to closing backticks run of same length
+        if (*ptr == '`')
+        {
+            int ticks = 0;
+            while (((ptr + ticks) < lineEnd) && (ptr[ticks] == '`')) ticks++;
+
+            const char *close = ptr + ticks;
+            while (close < lineEnd)
+            {
+                int closeTicks = 0;
+                while (((close + closeTicks) < lineEnd) && (close[closeTicks] == '`')) closeTicks++;
+                if (closeTicks == ticks) break;
+                close += (closeTicks > 0)? closeTicks : 1;
+            }
+
+            ptr = (close < lineEnd)? close + ticks - 1 : ptr + ticks - 1;
+            continue;
+        }
+
+        const char *target = NULL;
+        char end = '\0';
+
+        if ((ptr[0] == ']') && ((ptr + 1) < lineEnd) && (ptr[1] == '('))
+        {
+            target = ptr + 2;
+            while ((target < lineEnd) && ((*target == ' ') || (*target == '\t'))) target++;
+
+            end = ')';
+            if ((target < lineEnd) && (*target == '<')) { target++; end = '>'; }
+        }
+        else if ((ptr[0] == '<') && ((ptr + 1) < lineEnd) && (((ptr[1] | 32) >= 'a') && ((ptr[1] | 32) <= 'z')))
+        {
+            // Autolink: <scheme:...> without spaces, html tags are not matched
+            const char *close = (const char *)memchr(ptr, '>', lineEnd - ptr);
+            const char *colon = (close != NULL)? (const char *)memchr(ptr, ':', close - ptr) : NULL;
+            const char *space = (close != NULL)? (const char *)memchr(ptr, ' ', close - ptr) : NULL;
+
+            if ((colon != NULL) && (space == NULL))
+            {
+                target = ptr + 1;
+                end = '>';
+            }
+        }
+        else if (((strncmp(ptr, "src=", 4) == 0) || (strncmp(ptr, "href=", 5) == 0)) && ((ptr == line) || (ptr[-1] == ' ') || (ptr[-1] == '\t')))
+        {
+            const char *quote = ptr + ((ptr[0] == 's')? 4 : 5);
+            if ((quote < lineEnd) && ((*quote == '"') || (*quote == '\'')))
+            {
+                target = quote + 1;
+                end = *quote;
+            }
+        }
+
+        if (target == NULL) continue;
+
+        int length = GetLinkTargetLength(target, lineEnd, end);
+        AddContentLink(list, target, length, lineNumber);
+        ptr = target + length - 1;
+    }
+}
+
+// Collect content links, fenced code blocks are skipped
+static void ScanContentLinks(LinkList *list, const char *content)
+{
+    const char *line = content;
+    char fence = '\0';
+    int lineNumber = 1;
+
+    while (*line != '\0')
+    {
+        const char *lineEnd = strchr(line, '\n');
+        if (lineEnd == NULL) lineEnd = line + strlen(line);
+
+        const char *ptr = line;
+        while ((ptr < lineEnd) && (ptr < (line + 3)) && (*ptr == ' ')) ptr++;
+
+        bool fenceLine = ((lineEnd - ptr) >= 3) && ((*ptr == '`') || (*ptr == '~')) && (ptr[1] == *ptr) && (ptr[2] == *ptr);
+
+        if (fenceLine && ((fence == '\0') || (fence == *ptr))) fence = (fence == '\0')? *ptr : '\0';
+        else if (fence == '\0') ScanLinkLine(list, line, lineEnd, lineNumber);
+
+        lineNumber++;
+        line = (*lineEnd == '\n')? lineEnd + 1 : lineEnd;
+    }
+}
+
+// Check URL authority (after "//"): [user@]host[:port], host labels of letters, digits and '-'
+static bool IsValidUrlAuthority(const char *authority, int length)
+{
+    int end = 0;
+    while ((end < length) && (authority[end] != '/') && (authority[end] != '?') && (authority[end] != '#')) end++;
+
+    int start = 0;
+    for (int i = 0; i < end; i++) if (authority[i] == '@') start = i + 1;
+
+    const char *host = authority + start;
+    int hostLength = end - start;
+    if (hostLength <= 0) return false;
+
+    if ((hostLength > 0) && (host[0] == '['))
+    {
+        // IPv6 literal
+        const char *close = (const char *)memchr(host, ']', hostLength);
+        if (close == NULL) return false;
+        hostLength = (int)(close - host) + 1;
+        if ((hostLength < end - start) && (host[hostLength] != ':')) return false;
+    }
+    else
+    {
+        const char *colon = (const char *)memchr(host, ':', hostLength);
+        if (colon != NULL)
+        {
+            for (const char *port = colon + 1; port < (host + hostLength); port++) if ((*port < '0') || (*port > '9')) return false;
+            hostLength = (int)(colon - host);
+        }
+
+        if (hostLength <= 0) return false;
+        if ((hostLength == 9) && (strncmp(host, "localhost", 9) == 0)) return true;
+
+        // Labels: 1..63 chars, no leading or trailing '-', at least two labels
+        // NOTE: Non-ASCII bytes are accepted (internationalized domain names)
+        int labelCount = 0;
+        int labelLength = 0;
+        for (int i = 0; i <= hostLength; i++)
+        {
+            char c = (i < hostLength)? host[i] : '.';
+
+            if (c == '.')
+            {
+                if ((labelLength == 0) || (labelLength > 63) || (host[i - 1] == '-')) return false;
+                labelCount++;
+                labelLength = 0;
+            }
+            else if (((c | 32) >= 'a') && ((c | 32) <= 'z')) labelLength++;
+            else if (((c >= '0') && (c <= '9')) || ((unsigned char)c >= 0x80)) labelLength++;
+            else if ((c == '-') && (labelLength > 0)) labelLength++;
+            else return false;
+        }
+
+        if (labelCount < 2) return false;
+    }
+
+    return true;
+}
+
+// Check external URL syntax: no spaces or control chars, valid percent escapes, valid authority
+static LinkStatus CheckExternalUrl(const char *url, int length, int schemeLength)
+{
+    for (int i = 0; i < length; i++)
+    {
+        unsigned char c = (unsigned char)url[i];
+        if ((c <= ' ') || (c == '"') || (c == '<') || (c == '>') || (c == '\\') || (c == 0x7f)) return LINK_MALFORMED;
+
+        if (c == '%')
+        {
+            for (int j = 1; j <= 2; j++)
+            {
+                char h = ((i + j) < length)? url[i + j] : '\0';
+                if (!(((h >= '0') && (h <= '9')) || (((h | 32) >= 'a') && ((h | 32) <= 'f')))) return LINK_MALFORMED;
+            }
+        }
+    }
+
+    const char *rest = url + schemeLength + 1;
+    int restLength = length - schemeLength - 1;
+
+    if ((schemeLength == 6) && (strncmp(url, "mailto", 6) == 0))
+    {
+        const char *at = (const char *)memchr(rest, '@', restLength);
+        return ((at != NULL) && (at > rest) && (at < (rest + restLength - 1)))? LINK_VALID : LINK_MALFORMED;
+    }
+
+    bool hierarchical = ((schemeLength == 4) && (strncmp(url, "http", 4) == 0)) || ((schemeLength == 5) && (strncmp(url, "https", 5) == 0)) ||
+        ((schemeLength == 3) && (strncmp(url, "ftp", 3) == 0)) || ((schemeLength == 2) && (strncmp(url, "ws", 2) == 0)) ||
+        ((schemeLength == 3) && (strncmp(url, "wss", 3) == 0));
+
+    if (!hierarchical) return LINK_VALID;   // tel:, data:, irc:... accepted as written
+    if ((restLength < 2) || (rest[0] != '/') || (rest[1] != '/')) return LINK_MALFORMED;
+
+    return IsValidUrlAuthority(rest + 2, restLength - 2)? LINK_VALID : LINK_MALFORMED;
+}
+
+// Append text to path buffer, returns new length (-1 if path is too long)
+static int AppendLinkPath(char *path, int length, const char *text, int textLength)
+{
+    if ((length < 0) || ((length + textLength) >= LINK_VALIDATOR_MAX_PATH)) return -1;
+
+    memcpy(path + length, text, textLength);
+    path[length + textLength] = '\0';
+
+    return length + textLength;
+}
+
+// Normalize path in place: "." and empty segments removed, ".." segments applied
+// NOTE: Trailing '/' is kept (folder link), returns new length (-1 if path goes above root)
+static int NormalizeLinkPath(char *path, int length)
+{
+    bool folder = (length > 0) && (path[length - 1] == '/');
+    int outLength = 0;
+    int start = 0;
+
+    while (start < length)
+    {
+        int end = start;
+        while ((end < length) && (path[end] != '/')) end++;
+        int segmentLength = end - start;
+
+        if ((segmentLength == 0) || ((segmentLength == 1) && (path[start] == '.'))) { }
+        else if ((segmentLength == 2) && (path[start] == '.') && (path[start + 1] == '.'))
+        {
+            if (outLength == 0) return -1;
+            while ((outLength > 0) && (path[outLength - 1] != '/')) outLength--;
+            if (outLength > 0) outLength--;
+        }
+        else
+        {
+            if (outLength > 0) path[outLength++] = '/';
+            memmove(path + outLength, path + start, segmentLength);
+            outLength += segmentLength;
+        }
+
+        start = end + 1;
+    }
+
+    if (folder && (outLength > 0)) path[outLength++] = '/';
+    path[outLength] = '\0';
+
+    return outLength;
+}
+
+// Check if path is a file of tree, or a page: folder with index page, or page file named as folder
+static bool IsLinkTreePage(const LinkTree *tree, const char *path, int length)
+{
+    static const char *pageSuffixes[] = { "/index.md", "/_index.md", "/index.html", ".md", ".html" };
+
+    while ((length > 0) && (path[length - 1] == '/')) length--;
+    if ((length > 0) && IsLinkTreePath(tree, path, length)) return true;
+
+    char page[LINK_VALIDATOR_MAX_PATH] = { 0 };
+    for (int i = 0; i < (int)(sizeof(pageSuffixes)/sizeof(pageSuffixes[0])); i++)
+    {
+        const char *suffix = pageSuffixes[i];
+        if (length == 0) suffix++;      // Root folder: "index.md"...
+
+        int pageLength = AppendLinkPath(page, 0, path, length);
+        pageLength = AppendLinkPath(page, pageLength, suffix, (int)strlen(suffix));
+        if ((pageLength > 0) && IsLinkTreePath(tree, page, pageLength)) return true;
+    }
+
+    return false;
+}
+
+// Resolve repository path (normalized): post files first, site tree otherwise
+static LinkStatus ResolveLinkPath(const char *path, int length, const LinkTree *site, const LinkTree *post, const char *postPath)
+{
+    int postPathLength = (postPath != NULL)? (int)strlen(postPath) : 0;
+    while ((postPathLength > 0) && (postPath[postPathLength - 1] == '/')) postPathLength--;
+
+    if ((postPathLength > 0) && (length >= postPathLength) && (strncmp(path, postPath, postPathLength) == 0) &&
+        ((length == postPathLength) || (path[postPathLength] == '/')))
+    {
+        const char *file = path + postPathLength;
+        while (*file == '/') file++;
+
+        // Post page itself, or one of post files
+        if (*file == '\0') return LINK_VALID;
+        if (post != NULL) return IsLinkTreePage(post, file, (int)(length - (file - path)))? LINK_VALID : LINK_BROKEN;
+    }
+
+    if ((site == NULL) || (site->count == 0)) return LINK_SKIPPED;
+
+    return IsLinkTreePage(site, path, length)? LINK_VALID : LINK_BROKEN;
+}
+
+static void CheckLinkBatch(void *data, int index)
+{
+    LinkBatch *batch = (LinkBatch *)data;
+
+    int end = (index + 1)*LINK_VALIDATOR_BATCH_SIZE;
+    if (end > batch->count) end = batch->count;
+
+    for (int i = index*LINK_VALIDATOR_BATCH_SIZE; i < end; i++)
+    {
+        ContentLink *link = &batch->links[i];
+        link->status = CheckLinkTarget(link->target, link->length, batch->site, batch->post, batch->postPath);
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Load empty link paths set, sized for count paths (grown if more are added)
+LinkTree LoadLinkTree(int count)
+{
+    LinkTree tree = { 0 };
+
+    tree.capacity = 64;
+    while (tree.capacity < count*2) tree.capacity *= 2;
+    tree.paths = (const char **)calloc(tree.capacity, sizeof(const char *));
+    if (tree.paths == NULL) tree.capacity = 0;
+
+    return tree;
+}
+
+// Unload link paths set
+void UnloadLinkTree(LinkTree *tree)
+{
+    free(tree->paths);
+    *tree = (LinkTree){ 0 };
+}
+
+// Add path to set, path is not copied
+void AddLinkTreePath(LinkTree *tree, const char *path)
+{
+    if ((tree->paths == NULL) || (path == NULL) || (path[0] == '\0')) return;
+
+    if ((tree->count + 1)*2 > tree->capacity)
+    {
+        const char **paths = (const char **)calloc(tree->capacity*2, sizeof(const char *));
+        if (paths == NULL) return;
+
+        LinkTree grown = { paths, tree->capacity*2, tree->count };
+        for (int i = 0; i < tree->capacity; i++)
+        {
+            if (tree->paths[i] != NULL) paths[FindLinkTreeSlot(&grown, tree->paths[i], (int)strlen(tree->paths[i]))] = tree->paths[i];
+        }
+
+        free(tree->paths);
+        *tree = grown;
+    }
+
+    int slot = FindLinkTreeSlot(tree, path, (int)strlen(path));
+    if (tree->paths[slot] != NULL) return;
+
+    tree->paths[slot] = path;
+    tree->count++;
+}
+
+// Check if path is in set
+bool IsLinkTreePath(const LinkTree *tree, const char *path, int length)
+{
+    if ((tree == NULL) || (tree->count == 0)) return false;
+
+    return (tree->paths[FindLinkTreeSlot(tree, path, length)] != NULL);
+}
+
+// Check one link target (as written in content)
+// NOTE: Relative paths are resolved from post folder (postPath, relative to repository root)
+LinkStatus CheckLinkTarget(const char *target, int length, const LinkTree *site, const LinkTree *post, const char *postPath)
+{
+    if ((length <= 0) || (target[0] == '#')) return LINK_SKIPPED;
+
+    // Template code (i.e. Hugo shortcodes, Jekyll liquid tags) is resolved by site generator
+    for (int i = 0; i < length - 1; i++) if ((target[i] == '{') && ((target[i + 1] == '{') || (target[i + 1] == '%'))) return LINK_SKIPPED;
+
+    // Scheme: letter followed by letters, digits, '+', '-' or '.', then ':'
+    // NOTE: One letter scheme is a local drive path (C:\...), never valid on site
+    int schemeLength = 0;
+    while ((schemeLength < length) && ((((target[schemeLength] | 32) >= 'a') && ((target[schemeLength] | 32) <= 'z')) ||
+           ((schemeLength > 0) && (((target[schemeLength] >= '0') && (target[schemeLength] <= '9')) ||
+           (target[schemeLength] == '+') || (target[schemeLength] == '-') || (target[schemeLength] == '.'))))) schemeLength++;
+
+    if ((schemeLength < length) && (target[schemeLength] == ':') && (schemeLength > 0))
+    {
+        if (schemeLength == 1) return LINK_BROKEN;
+        return CheckExternalUrl(target, length, schemeLength);
+    }
+
+    if ((length >= 2) && (target[0] == '/') && (target[1] == '/')) return IsValidUrlAuthority(target + 2, length - 2)? LINK_VALID : LINK_MALFORMED;
+    if ((length >= 1) && (target[0] == '\\')) return LINK_BROKEN;
+
+    // Path: query and fragment are removed, percent escapes decoded
+    char path[LINK_VALIDATOR_MAX_PATH] = { 0 };
+    int pathLength = 0;
+    for (int i = 0; (i < length) && (target[i] != '?') && (target[i] != '#'); i++)
+    {
+        char c = target[i];
+
+        if ((c == '%') && ((i + 2) < length))
+        {
+            char hex[3] = { target[i + 1], target[i + 2], '\0' };
+            char *hexEnd = NULL;
+            long value = strtol(hex, &hexEnd, 16);
+            if ((hexEnd == (hex + 2)) && (value > 0)) { c = (char)value; i += 2; }
+        }
+
+        if (pathLength >= (LINK_VALIDATOR_MAX_PATH/2)) return LINK_BROKEN;
+        path[pathLength++] = c;
+    }
+
+    if (pathLength == 0) return LINK_SKIPPED;
+
+    char resolved[LINK_VALIDATOR_MAX_PATH] = { 0 };
+    int resolvedLength = 0;
+
+    if ((pathLength >= 2) && (path[0] == '@') && (path[1] == '/'))
+    {
+        // Zola internal link: content file path
+        resolvedLength = AppendLinkPath(resolved, 0, "content/", 8);
+        resolvedLength = AppendLinkPath(resolved, resolvedLength, path + 2, pathLength - 2);
+        resolvedLength = NormalizeLinkPath(resolved, resolvedLength);
+
+        return (resolvedLength >= 0)? ResolveLinkPath(resolved, resolvedLength, site, post, postPath) : LINK_BROKEN;
+    }
+
+    if (path[0] == '/')
+    {
+        // Site root: repository root, static files folder or content folder (pages)
+        static const char *rootFolders[] = { "", "static/", "content/" };
+        LinkStatus status = LINK_BROKEN;
+
+        for (int i = 0; (i < (int)(sizeof(rootFolders)/sizeof(rootFolders[0]))) && (status != LINK_VALID); i++)
+        {
+            resolvedLength = AppendLinkPath(resolved, 0, rootFolders[i], (int)strlen(rootFolders[i]));
+            resolvedLength = AppendLinkPath(resolved, resolvedLength, path + 1, pathLength - 1);
+            resolvedLength = NormalizeLinkPath(resolved, resolvedLength);
+
+            LinkStatus folderStatus = (resolvedLength >= 0)? ResolveLinkPath(resolved, resolvedLength, site, post, postPath) : LINK_BROKEN;
+            if ((folderStatus == LINK_VALID) || (folderStatus == LINK_SKIPPED)) status = folderStatus;
+        }
+
+        return status;
+    }
+
+    // Relative path: from post folder (page bundle)
+    resolvedLength = AppendLinkPath(resolved, 0, postPath, (int)strlen(postPath));
+    resolvedLength = AppendLinkPath(resolved, resolvedLength, "/", 1);
+    resolvedLength = AppendLinkPath(resolved, resolvedLength, path, pathLength);
+    resolvedLength = NormalizeLinkPath(resolved, resolvedLength);
+
+    return (resolvedLength >= 0)? ResolveLinkPath(resolved, resolvedLength, site, post, postPath) : LINK_BROKEN;
+}
+
+// Check content links against repository tree (site) and post files (post), returns issues count
+// NOTE: Issues are reported in content order (only maxCount are filled), links checked are returned
+// in linkCount (optional)
+int ValidatePostLinks(const char *content, const LinkTree *site, const LinkTree *post, const char *postPath,
+                      LinkIssue *issues, int maxCount, int *linkCount, WorkerPool *pool)
+{
+    if (linkCount != NULL) *linkCount = 0;
+    if (content == NULL) return 0;
+
+    LinkList list = { 0 };
+    ScanContentLinks(&list, content);
+
+    LinkBatch batch = { list.links, list.count, site, post, (postPath != NULL)? postPath : "" };
+    int jobCount = (list.count + LINK_VALIDATOR_BATCH_SIZE - 1)/LINK_VALIDATOR_BATCH_SIZE;
+
+    if ((pool != NULL) && (jobCount > 1)) RunWorkerPoolJobs(pool, CheckLinkBatch, &batch, jobCount);
+    else for (int i = 0; i < jobCount; i++) CheckLinkBatch(&batch, i);
+
+    int count = 0;
+    for (int i = 0; i < list.count; i++)
+    {
+        const ContentLink *link = &list.links[i];
+        if ((link->status != LINK_BROKEN) && (link->status != LINK_MALFORMED)) continue;
+
+        if (count < maxCount)
+        {
+            issues[count] = (LinkIssue){ 0 };
+            issues[count].line = link->line;
+            issues[count].status = link->status;
+            snprintf(issues[count].target, sizeof(issues[count].target), "%.*s", link->length, link->target);
+        }
+        count++;
+    }
+
+    if (linkCount != NULL) *linkCount = list.count;
+    free(list.links);
+
+    return count;
+}
+
+#endif // LINK_VALIDATOR_IMPLEMENTATION
@@ -0,0 +1,1678 @@
+/*******************************************************************************************
+*
+*   Markdown HTML - CommonMark-ish markdown to HTML renderer, AST in arena, streamed output
+*
+*   MODULE USAGE:
+*       #define MARKDOWN_HTML_IMPLEMENTATION
+*       #include "markdown_html.h"
+*
+*       MarkdownDocument *document = LoadMarkdownDocument(&arena, text, size);  // Blocks tree in arena
+*       RenderMarkdownHtml(document, WriteToFile, file);                         // Buffered, streamed
+*       ArenaReset(&arena);                                                      // Text must be valid until here
+*
+*   NOTES:
+*       Blocks: ATX and setext headings, paragraphs, block quotes, bullet and ordered lists (tight
+*       and loose, nested), fenced and indented code, thematic breaks, HTML blocks, tables (GFM)
+*       Inlines: emphasis, strong, strikethrough (GFM), code spans, inline and reference links and
+*       images, autolinks, raw HTML, entities, backslash escapes, hard line breaks
+*
+*       Not a conforming CommonMark implementation, but close on real posts: emphasis closers are
+*       searched forward (no delimiter stack), HTML blocks only start with block-level tags and
+*       lazy continuation lines are only supported for paragraphs. Meant for previews, the site
+*       generator still renders the published site
+*
+*       Blocks tree is parsed first (reference definitions collected), inlines are parsed while
+*       rendering, output is written to a small buffer flushed through write callback. No global
+*       state: documents can be parsed and rendered in parallel, one arena per thread
+*
+*   DEPENDENCIES:
+*       arena.h         - Blocks tree and text allocation
+*
+*   LICENSE: GPLv3, check LICENSE file for details
+*
+**********************************************************************************************/
+
+#ifndef MARKDOWN_HTML_H
+#define MARKDOWN_HTML_H
+
+#include "arena.h"
+
+#include <stdbool.h>        // Required for: bool
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define MARKDOWN_MAX_DEPTH          32      // Max nesting of blocks and inlines, deeper content is rendered as text
+#define MARKDOWN_MAX_TABLE_COLUMNS  64      // Max table columns, extra cells are ignored
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Block types
+typedef enum {
+    MARKDOWN_DOCUMENT = 0,
+    MARKDOWN_PARAGRAPH,
+    MARKDOWN_HEADING,
+    MARKDOWN_THEMATIC_BREAK,
+    MARKDOWN_CODE_BLOCK,
+    MARKDOWN_HTML_BLOCK,
+    MARKDOWN_BLOCK_QUOTE,
+    MARKDOWN_LIST,
+    MARKDOWN_LIST_ITEM,
+    MARKDOWN_TABLE
+} MarkdownBlockType;
+
+// Block node
+// NOTE: Text points into arena (joined lines) or into source text
+typedef struct MarkdownBlock {
+    MarkdownBlockType type;
+    const char *text;               // Inline text (paragraph, heading, table rows), code or HTML lines
+    int length;
+    const char *info;               // Code block info (language), table columns alignment ('l', 'c', 'r' or 0)
+    int infoLength;
+    int level;                      // Heading level, ordered list start number, table columns
+    bool ordered;                   // Ordered list
+    bool tight;                     // Tight list: items paragraphs rendered without <p>
+    struct MarkdownBlock *firstChild;
+    struct MarkdownBlock *lastChild;
+    struct MarkdownBlock *next;
+} MarkdownBlock;
+
+// Link reference definition: [label]: url "title"
+typedef struct MarkdownReference {
+    const char *label;
+    int labelLength;
+    const char *url;
+    int urlLength;
+    const char *title;
+    int titleLength;
+    struct MarkdownReference *next;
+} MarkdownReference;
+
+// Markdown document, allocated in arena
+typedef struct MarkdownDocument {
+    MarkdownBlock root;
+    MarkdownReference *references;
+    int blockCount;
+} MarkdownDocument;
+
+// Output callback, data is only valid during the call
+typedef void (*MarkdownWriteFunc)(const char *data, int size, void *userData);
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+MarkdownDocument *LoadMarkdownDocument(Arena *arena, const char *text, int size); // Parse markdown blocks into arena (text must be valid until rendered)
+void RenderMarkdownHtml(const MarkdownDocument *document, MarkdownWriteFunc write, void *userData); // Render document HTML, streamed through write callback
+void RenderMarkdownText(const char *text, int length, MarkdownWriteFunc write, void *userData); // Render plain text, HTML escaped (i.e. page title)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MARKDOWN_HTML_H
+
+/***********************************************************************************
+*
+*   MARKDOWN_HTML IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(MARKDOWN_HTML_IMPLEMENTATION)
+
+#include <stdio.h>          // Required for: snprintf()
+#include <string.h>         // Required for: memcpy(), strlen(), strncmp()
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define MARKDOWN_WRITER_SIZE        4096    // Output buffer size
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Line of source text (or of container content, markers removed)
+typedef struct MarkdownLine {
+    const char *text;
+    int length;
+} MarkdownLine;
+
+// List item marker
+typedef struct MarkdownListMarker {
+    bool ordered;
+    int start;                      // Ordered list number
+    char delimiter;                 // Bullet char or ordered list delimiter ('.' or ')')
+    int contentIndent;              // Item content column
+    MarkdownLine content;           // First line content, marker removed
+    bool empty;                     // Item starts with an empty line
+} MarkdownListMarker;
+
+typedef struct MarkdownParser {
+    Arena *arena;
+    MarkdownDocument *document;
+    int depth;
+} MarkdownParser;
+
+typedef struct MarkdownWriter {
+    MarkdownWriteFunc write;
+    void *userData;
+    const MarkdownDocument *document;
+    int depth;
+    int size;
+    char buffer[MARKDOWN_WRITER_SIZE];
+} MarkdownWriter;
+
+// Link or image target, parsed from source
+typedef struct MarkdownLinkTarget {
+    int textStart;                  // Link text (inside brackets)
+    int textEnd;
+    const char *url;
+    int urlLength;
+    const char *title;
+    int titleLength;
+    int end;                        // Position after link
+} MarkdownLinkTarget;
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+static bool IsMarkdownSpace(char c) { return (c == ' ') || (c == '\t') || (c == '\n'); }
+static bool IsMarkdownAlnum(char c) { return ((c >= '0') && (c <= '9')) || ((c | 32) >= 'a' && (c | 32) <= 'z') || ((unsigned char)c >= 0x80); }
+static bool IsMarkdownPunct(char c) { return (c > 32) && (c < 127) && !IsMarkdownAlnum(c); }
+static char ToMarkdownLower(char c) { return ((c >= 'A') && (c <= 'Z'))? c + 32 : c; }
+
+// Get line indentation in columns (tab stops every 4 columns), offset of first non-space character is returned
+static int GetMarkdownIndent(MarkdownLine line, int *offset)
+{
+    int columns = 0;
+    int i = 0;
+    for (; i < line.length; i++)
+    {
+        if (line.text[i] == ' ') columns++;
+        else if (line.text[i] == '\t') columns += 4 - columns%4;
+        else break;
+    }
+
+    if (offset != NULL) *offset = i;
+    return columns;
+}
+
+static bool IsMarkdownBlank(MarkdownLine line)
+{
+    int offset = 0;
+    GetMarkdownIndent(line, &offset);
+    return (offset == line.length);
+}
+
+// Remove up to columns of indentation (a tab partially inside is removed)
+static MarkdownLine StripMarkdownIndent(MarkdownLine line, int columns)
+{
+    int removed = 0;
+    int i = 0;
+    for (; (i < line.length) && (removed < columns); i++)
+    {
+        if (line.text[i] == ' ') removed++;
+        else if (line.text[i] == '\t') removed += 4 - removed%4;
+        else break;
+    }
+
+    return (MarkdownLine){ line.text + i, line.length - i };
+}
+
+// Check thematic break: 3 or more '-', '*' or '_' (spaces allowed between them)
+static bool IsMarkdownThematicBreak(MarkdownLine line)
+{
+    int offset = 0;
+    if ((GetMarkdownIndent(line, &offset) >= 4) || (offset >= line.length)) return false;
+
+    char marker = line.text[offset];
+    if ((marker != '-') && (marker != '*') && (marker != '_')) return false;
+
+    int count = 0;
+    for (int i = offset; i < line.length; i++)
+    {
+        if (line.text[i] == marker) count++;
+        else if ((line.text[i] != ' ') && (line.text[i] != '\t')) return false;
+    }
+
+    return (count >= 3);
+}
+
+// Get ATX heading level (0 if not a heading) and its content, closing '#' sequence removed
+static int GetMarkdownAtxHeading(MarkdownLine line, MarkdownLine *content)
+{
+    int offset = 0;
+    if (GetMarkdownIndent(line, &offset) >= 4) return 0;
+
+    int level = 0;
+    while (((offset + level) < line.length) && (line.text[offset + level] == '#')) level++;
+    if ((level < 1) || (level > 6)) return 0;
+
+    int start = offset + level;
+    if ((start < line.length) && (line.text[start] != ' ') && (line.text[start] != '\t')) return 0;
+
+    while ((start < line.length) && ((line.text[start] == ' ') || (line.text[start] == '\t'))) start++;
+    int end = line.length;
+    while ((end > start) && ((line.text[end - 1] == ' ') || (line.text[end - 1] == '\t'))) end--;
+
+    int hashes = end;
+    while ((hashes > start) && (line.text[hashes - 1] == '#')) hashes--;
+    if (hashes == start) end = start;
+    else if ((hashes < end) && ((line.text[hashes - 1] == ' ') || (line.text[hashes - 1] == '\t')))
+    {
+        end = hashes;
+        while ((end > start) && ((line.text[end - 1] == ' ') || (line.text[end - 1] == '\t'))) end--;
+    }
+
+    *content = (MarkdownLine){ line.text + start, end - start };
+    return level;
+}
+
+// Get setext heading underline level: 1 for '=' line, 2 for '-' line, 0 if not an underline
+static int GetMarkdownSetextLevel(MarkdownLine line)
+{
+    int offset = 0;
+    if ((GetMarkdownIndent(line, &offset) >= 4) || (offset >= line.length)) return 0;
+
+    char marker = line.text[offset];
+    if ((marker != '=') && (marker != '-')) return 0;
+
+    int i = offset;
+    while ((i < line.length) && (line.text[i] == marker)) i++;
+    while ((i < line.length) && ((line.text[i] == ' ') || (line.text[i] == '\t'))) i++;
+
+    return (i == line.length)? ((marker == '=')? 1 : 2) : 0;
+}
+
+// Check code fence opening: 3 or more '`' or '~', info string (first word) is returned
+static bool GetMarkdownCodeFence(MarkdownLine line, char *fence, int *fenceLength, int *indent, MarkdownLine *info)
+{
+    int offset = 0;
+    *indent = GetMarkdownIndent(line, &offset);
+    if ((*indent >= 4) || (offset >= line.length)) return false;
+
+    *fence = line.text[offset];
+    if ((*fence != '`') && (*fence != '~')) return false;
+
+    int i = offset;
+    while ((i < line.length) && (line.text[i] == *fence)) i++;
+    *fenceLength = i - offset;
+    if (*fenceLength < 3) return false;
+
+    while ((i < line.length) && ((line.text[i] == ' ') || (line.text[i] == '\t'))) i++;
+    int start = i;
+    while ((i < line.length) && (line.text[i] != ' ') && (line.text[i] != '\t') && (line.text[i] != '{')) i++;
+
+    if (*fence == '`')
+    {
+        for (int k = start; k < line.length; k++) if (line.text[k] == '`') return false;
+    }
+
+    *info = (MarkdownLine){ line.text + start, i - start };
+    return true;
+}
+
+// Check code fence closing: same fence char, at least as long as opening fence
+static bool IsMarkdownCodeFenceClose(MarkdownLine line, char fence, int fenceLength)
+{
+    int offset = 0;
+    if (GetMarkdownIndent(line, &offset) >= 4) return false;
+
+    int i = offset;
+    while ((i < line.length) && (line.text[i] == fence)) i++;
+    if ((i - offset) < fenceLength) return false;
+
+    while ((i < line.length) && ((line.text[i] == ' ') || (line.text[i] == '\t'))) i++;
+    return (i == line.length);
+}
+
+// Check list item marker: bullet ('-', '+', '*') or ordered (1-9 digits and '.' or ')')
+static bool GetMarkdownListMarker(MarkdownLine line, MarkdownListMarker *marker)
+{
+    int offset = 0;
+    int indent = GetMarkdownIndent(line, &offset);
+    if ((indent >= 4) || (offset >= line.length)) return false;
+
+    int i = offset;
+    char c = line.text[i];
+    if ((c == '-') || (c == '+') || (c == '*'))
+    {
+        marker->ordered = false;
+        marker->start = 0;
+        marker->delimiter = c;
+        i++;
+    }
+    else
+    {
+        int number = 0;
+        while ((i < line.length) && ((i - offset) < 9) && (line.text[i] >= '0') && (line.text[i] <= '9')) number = number*10 + (line.text[i++] - '0');
+        if ((i == offset) || (i >= line.length) || ((line.text[i] != '.') && (line.text[i] != ')'))) return false;
+
+        marker->ordered = true;
+        marker->start = number;
+        marker->delimiter = line.text[i];
+        i++;
+    }
+
+    if ((i < line.length) && (line.text[i] != ' ') && (line.text[i] != '\t')) return false;
+
+    // Content starts after 1-4 spaces, 5 or more spaces mean indented code (content after 1 space)
+    int markerColumns = indent + (i - offset);
+    int spaces = 0;
+    int j = i;
+    while ((j < line.length) && ((line.text[j] == ' ') || (line.text[j] == '\t')))
+    {
+        spaces += (line.text[j] == '\t')? 4 - (markerColumns + spaces)%4 : 1;
+        j++;
+    }
+
+    marker->empty = (j >= line.length);
+    if (marker->empty) marker->content = (MarkdownLine){ line.text + line.length, 0 };
+    else if (spaces >= 5) marker->content = (MarkdownLine){ line.text + i + 1, line.length - i - 1 };
+    else marker->content = (MarkdownLine){ line.text + j, line.length - j };
+
+    marker->contentIndent = markerColumns + ((marker->empty || (spaces >= 5))? 1 : spaces);
+
+    return true;
+}
+
+// Get HTML block type: 0 if not an HTML block, 1 ends with closing tag (pre, script, style, textarea),
+// 2 ends with comment end, 3 ends at blank line (block-level tags, declarations)
+static int GetMarkdownHtmlBlockType(MarkdownLine line, const char **endMarker)
+{
+    static const char *rawTags[] = { "pre", "script", "style", "textarea" };
+    static const char *rawEnds[] = { "</pre>", "</script>", "</style>", "</textarea>" };
+    static const char *blockTags[] = {
+        "address", "article", "aside", "audio", "blockquote", "body", "canvas", "center", "details", "dialog", "dd", "div",
+        "dl", "dt", "fieldset", "figcaption", "figure", "footer", "form", "h1", "h2", "h3", "h4", "h5", "h6", "head",
+        "header", "hr", "html", "iframe", "legend", "li", "main", "nav", "noscript", "ol", "p", "picture", "section",
+        "source", "summary", "table", "tbody", "td", "tfoot", "th", "thead", "tr", "ul", "video"
+    };
+
+    int offset = 0;
+    if ((GetMarkdownIndent(line, &offset) >= 4) || ((offset + 1) >= line.length) || (line.text[offset] != '<')) return 0;
+
+    const char *text = line.text + offset + 1;
+    int length = line.length - offset - 1;
+
+    if ((length >= 3) && (strncmp(text, "!--", 3) == 0)) { *endMarker = "-->"; return 2; }
+    if ((text[0] == '!') || (text[0] == '?')) { *endMarker = NULL; return 3; }
+
+    bool closing = (text[0] == '/');
+    if (closing) { text++; length--; }
+
+    int nameLength = 0;
+    while ((nameLength < length) && (nameLength < 16) && IsMarkdownAlnum(text[nameLength])) nameLength++;
+    if ((nameLength == 0) || ((nameLength < length) && (text[nameLength] != ' ') && (text[nameLength] != '\t') &&
+        (text[nameLength] != '>') && (text[nameLength] != '/'))) return 0;
+
+    char name[17] = { 0 };
+    for (int i = 0; i < nameLength; i++) name[i] = ToMarkdownLower(text[i]);
+
+    for (int i = 0; !closing && (i < 4); i++) if (strcmp(name, rawTags[i]) == 0) { *endMarker = rawEnds[i]; return 1; }
+    for (int i = 0; i < (int)(sizeof(blockTags)/sizeof(blockTags[0])); i++) if (strcmp(name, blockTags[i]) == 0) { *endMarker = NULL; return 3; }
+
+    return 0;
+}
+
+// Check if line contains text (case-insensitive)
+static bool HasMarkdownText(MarkdownLine line, const char *text)
+{
+    int length = (int)strlen(text);
+    for (int i = 0; (i + length) <= line.length; i++)
+    {
+        int k = 0;
+        while ((k < length) && (ToMarkdownLower(line.text[i + k]) == text[k])) k++;
+        if (k == length) return true;
+    }
+
+    return false;
+}
+
+// Get table row cells: leading and trailing pipes removed, cells split by unescaped pipes (and trimmed)
+static int GetMarkdownTableCells(const char *text, int length, MarkdownLine *cells, int maxCells)
+{
+    int start = 0, end = length;
+    while ((start < end) && ((text[start] == ' ') || (text[start] == '\t'))) start++;
+    while ((end > start) && ((text[end - 1] == ' ') || (text[end - 1] == '\t'))) end--;
+    if ((start < end) && (text[start] == '|')) start++;
+    if ((end > start) && (text[end - 1] == '|') && ((end - 1) == start || (text[end - 2] != '\\'))) end--;
+
+    int count = 0;
+    int cellStart = start;
+    for (int i = start; i <= end; i++)
+    {
+        if ((i < end) && (text[i] == '\\')) { i++; continue; }
+        if ((i < end) && (text[i] != '|')) continue;
+
+        int a = cellStart, b = i;
+        while ((a < b) && ((text[a] == ' ') || (text[a] == '\t'))) a++;
+        while ((b > a) && ((text[b - 1] == ' ') || (text[b - 1] == '\t'))) b--;
+        if (count < maxCells) cells[count] = (MarkdownLine){ text + a, b - a };
+        count++;
+        cellStart = i + 1;
+    }
+
+    return count;
+}
+
+// Get table columns from delimiter row (i.e. "|:--|:-:|--:|"), 0 if not a delimiter row
+static int GetMarkdownTableColumns(MarkdownLine line, char *aligns)
+{
+    if (GetMarkdownIndent(line, NULL) >= 4) return 0;
+
+    bool pipe = false;
+    for (int i = 0; i < line.length; i++) if (line.text[i] == '|') pipe = true;
+
+    MarkdownLine cells[MARKDOWN_MAX_TABLE_COLUMNS] = { 0 };
+    int count = GetMarkdownTableCells(line.text, line.length, cells, MARKDOWN_MAX_TABLE_COLUMNS);
+    if ((count > MARKDOWN_MAX_TABLE_COLUMNS) || ((count == 1) && !pipe)) return 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        const char *cell = cells[i].text;
+        int length = cells[i].length;
+        bool left = (length > 0) && (cell[0] == ':');
+        bool right = (length > 1) && (cell[length - 1] == ':');
+
+        int dashes = 0;
+        for (int k = left? 1 : 0; k < (right? length - 1 : length); k++)
+        {
+            if (cell[k] != '-') return 0;
+            dashes++;
+        }
+        if (dashes == 0) return 0;
+
+        aligns[i] = (left && right)? 'c' : (right? 'r' : (left? 'l' : 0));
+    }
+
+    return count;
+}
+
+// Check if line starts a block that interrupts a paragraph
+static bool IsMarkdownBlockStart(MarkdownLine line)
+{
+    MarkdownLine content = { 0 };
+    char fence = 0;
+    int fenceLength = 0, indent = 0, offset = 0;
+    const char *endMarker = NULL;
+    MarkdownListMarker marker = { 0 };
+
+    if (GetMarkdownIndent(line, &offset) >= 4) return false;
+    if ((offset < line.length) && (line.text[offset] == '>')) return true;
+    if ((GetMarkdownAtxHeading(line, &content) > 0) || IsMarkdownThematicBreak(line)) return true;
+    if (GetMarkdownCodeFence(line, &fence, &fenceLength, &indent, &content)) return true;
+    if (GetMarkdownHtmlBlockType(line, &endMarker) > 0) return true;
+    if (GetMarkdownListMarker(line, &marker) && !marker.empty && (!marker.ordered || (marker.start == 1))) return true;
+
+    return false;
+}
+
+// Compare reference labels: case-insensitive, whitespace runs are equal
+static bool IsSameMarkdownLabel(const char *label1, int length1, const char *label2, int length2)
+{
+    int i = 0, k = 0;
+    while ((i < length1) && IsMarkdownSpace(label1[i])) i++;
+    while ((k < length2) && IsMarkdownSpace(label2[k])) k++;
+    while ((length1 > i) && IsMarkdownSpace(label1[length1 - 1])) length1--;
+    while ((length2 > k) && IsMarkdownSpace(label2[length2 - 1])) length2--;
+
+    while ((i < length1) && (k < length2))
+    {
+        if (IsMarkdownSpace(label1[i]) && IsMarkdownSpace(label2[k]))
+        {
+            while ((i < length1) && IsMarkdownSpace(label1[i])) i++;
+            while ((k < length2) && IsMarkdownSpace(label2[k])) k++;
+            continue;
+        }
+
+        if (ToMarkdownLower(label1[i]) != ToMarkdownLower(label2[k])) return false;
+        i++;
+        k++;
+    }
+
+    return (i == length1) && (k == length2);
+}
+
+static const MarkdownReference *FindMarkdownReference(const MarkdownDocument *document, const char *label, int length)
+{
+    for (const MarkdownReference *reference = document->references; reference != NULL; reference = reference->next)
+    {
+        if (IsSameMarkdownLabel(reference->label, reference->labelLength, label, length)) return reference;
+    }
+
+    return NULL;
+}
+
+// Parse link title: "title", 'title' or (title), returns position after title (-1 if not a title)
+static int ParseMarkdownLinkTitle(const char *text, int length, int position, int *titleStart, int *titleEnd)
+{
+    if (position >= length) return -1;
+
+    char open = text[position];
+    char close = (open == '(')? ')' : open;
+    if ((open != '"') && (open != '\'') && (open != '(')) return -1;
+
+    for (int i = position + 1; i < length; i++)
+    {
+        if ((text[i] == '\\') && ((i + 1) < length)) { i++; continue; }
+        if (text[i] == close)
+        {
+            *titleStart = position + 1;
+            *titleEnd = i;
+            return i + 1;
+        }
+    }
+
+    return -1;
+}
+
+// Parse link destination: <url> or url without spaces (balanced parentheses), returns position after it
+static int ParseMarkdownLinkDestination(const char *text, int length, int position, int *urlStart, int *urlEnd)
+{
+    if ((position < length) && (text[position] == '<'))
+    {
+        for (int i = position + 1; (i < length) && (text[i] != '\n'); i++)
+        {
+            if ((text[i] == '\\') && ((i + 1) < length)) { i++; continue; }
+            if (text[i] == '<') return -1;
+            if (text[i] == '>')
+            {
+                *urlStart = position + 1;
+                *urlEnd = i;
+                return i + 1;
+            }
+        }
+
+        return -1;
+    }
+
+    int depth = 0;
+    int i = position;
+    for (; (i < length) && ((unsigned char)text[i] > 32); i++)
+    {
+        if ((text[i] == '\\') && ((i + 1) < length)) { i++; continue; }
+        if (text[i] == '(') depth++;
+        else if (text[i] == ')') { if (depth == 0) break; depth--; }
+    }
+
+    if (depth != 0) return -1;
+
+    *urlStart = position;
+    *urlEnd = i;
+    return i;
+}
+
+// Parse reference definition line: [label]: url "title", added to document (first definition is kept)
+static bool ParseMarkdownReference(MarkdownParser *parser, MarkdownLine line)
+{
+    int offset = 0;
+    if ((GetMarkdownIndent(line, &offset) >= 4) || (offset >= line.length) || (line.text[offset] != '[')) return false;
+
+    const char *text = line.text;
+    int length = line.length;
+    int i = offset + 1;
+    for (; (i < length) && (text[i] != ']'); i++)
+    {
+        if (text[i] == '[') return false;
+        if ((text[i] == '\\') && ((i + 1) < length)) i++;
+    }
+
+    int labelStart = offset + 1, labelEnd = i;
+    if ((i >= length) || ((i + 1) >= length) || (text[i + 1] != ':')) return false;
+
+    bool blankLabel = true;
+    for (int k = labelStart; k < labelEnd; k++) if (!IsMarkdownSpace(text[k])) blankLabel = false;
+    if (blankLabel) return false;
+
+    i += 2;
+    while ((i < length) && IsMarkdownSpace(text[i])) i++;
+
+    int urlStart = 0, urlEnd = 0;
+    i = ParseMarkdownLinkDestination(text, length, i, &urlStart, &urlEnd);
+    if ((i < 0) || ((urlEnd == urlStart) && (text[urlStart - 1] != '<'))) return false;
+
+    int spaces = i;
+    while ((i < length) && IsMarkdownSpace(text[i])) i++;
+
+    int titleStart = 0, titleEnd = 0;
+    if ((i < length) && (i > spaces))
+    {
+        i = ParseMarkdownLinkTitle(text, length, i, &titleStart, &titleEnd);
+        if (i < 0) return false;
+        while ((i < length) && IsMarkdownSpace(text[i])) i++;
+    }
+
+    if (i < length) return false;
+
+    if (FindMarkdownReference(parser->document, text + labelStart, labelEnd - labelStart) == NULL)
+    {
+        MarkdownReference *reference = (MarkdownReference *)ArenaAlloc(parser->arena, sizeof(MarkdownReference));
+        if (reference == NULL) return true;
+
+        *reference = (MarkdownReference){ text + labelStart, labelEnd - labelStart, text + urlStart, urlEnd - urlStart,
+            text + titleStart, titleEnd - titleStart, parser->document->references };
+        parser->document->references = reference;
+    }
+
+    return true;
+}
+
+static MarkdownBlock *AddMarkdownBlock(MarkdownParser *parser, MarkdownBlock *parent, MarkdownBlockType type)
+{
+    MarkdownBlock *block = (MarkdownBlock *)ArenaAlloc(parser->arena, sizeof(MarkdownBlock));
+    if (block == NULL) return NULL;
+
+    block->type = type;
+    if (parent->lastChild != NULL) parent->lastChild->next = block;
+    else parent->firstChild = block;
+    parent->lastChild = block;
+    parser->document->blockCount++;
+
+    return block;
+}
+
+// Join lines into arena text separated by '\n', inline text lines are trimmed (last line trailing spaces too)
+static const char *JoinMarkdownLines(MarkdownParser *parser, const MarkdownLine *lines, int count, bool inlineText, int *length)
+{
+    int size = 0;
+    for (int i = 0; i < count; i++) size += lines[i].length + 1;
+
+    char *text = (char *)ArenaAlloc(parser->arena, size + 1);
+    *length = 0;
+    if (text == NULL) return "";
+
+    for (int i = 0; i < count; i++)
+    {
+        MarkdownLine line = inlineText? StripMarkdownIndent(lines[i], 1 << 30) : lines[i];
+        if (inlineText && (i == (count - 1))) while ((line.length > 0) && ((line.text[line.length - 1] == ' ') || (line.text[line.length - 1] == '\t'))) line.length--;
+
+        if (i > 0) text[(*length)++] = '\n';
+        memcpy(text + *length, line.text, line.length);
+        *length += line.length;
+    }
+
+    return text;
+}
+
+static void ParseMarkdownBlocks(MarkdownParser *parser, MarkdownBlock *parent, const MarkdownLine *lines, int count);
+
+// Parse list starting at line: consecutive items of same type, returns next line to parse
+static int ParseMarkdownList(MarkdownParser *parser, MarkdownBlock *parent, const MarkdownLine *lines, int count, int position)
+{
+    MarkdownListMarker first = { 0 };
+    GetMarkdownListMarker(lines[position], &first);
+
+    MarkdownBlock *list = AddMarkdownBlock(parser, parent, MARKDOWN_LIST);
+    MarkdownLine *itemLines = (MarkdownLine *)ArenaAlloc(parser->arena, (count - position + 1)*sizeof(MarkdownLine));
+    if ((list == NULL) || (itemLines == NULL)) return count;
+
+    list->ordered = first.ordered;
+    list->level = first.start;
+    list->tight = true;
+
+    int i = position;
+    bool blankBeforeItem = false;
+    MarkdownListMarker marker = { 0 };
+
+    while ((i < count) && !IsMarkdownThematicBreak(lines[i]) && GetMarkdownListMarker(lines[i], &marker) &&
+        (marker.ordered == first.ordered) && (marker.delimiter == first.delimiter))
+    {
+        if (blankBeforeItem) list->tight = false;
+
+        // Item lines: indented to content column, blank lines and lazy paragraph continuation lines
+        int itemCount = 0, contentCount = 0;
+        itemLines[itemCount++] = marker.content;
+        if (!marker.empty) contentCount = itemCount;
+        bool paragraph = !marker.empty;
+
+        int k = i + 1;
+        for (; k < count; k++)
+        {
+            MarkdownLine line = lines[k];
+            MarkdownListMarker next = { 0 };
+
+            if (IsMarkdownBlank(line))
+            {
+                if (contentCount == 0) break;       // Item starts with at most one blank line
+                itemLines[itemCount++] = (MarkdownLine){ line.text + line.length, 0 };
+                paragraph = false;
+            }
+            else if (GetMarkdownIndent(line, NULL) >= marker.contentIndent)
+            {
+                itemLines[itemCount++] = StripMarkdownIndent(line, marker.contentIndent);
+                contentCount = itemCount;
+                paragraph = !IsMarkdownBlockStart(itemLines[itemCount - 1]);
+            }
+            else if (paragraph && !IsMarkdownBlockStart(line) && !GetMarkdownListMarker(line, &next))
+            {
+                itemLines[itemCount++] = line;
+                contentCount = itemCount;
+            }
+            else break;
+        }
+
+        // Blank lines inside item content (not in fenced code) make list loose
+        char fence = 0;
+        int fenceLength = 0;
+        for (int j = 0; j < contentCount; j++)
+        {
+            MarkdownLine info = { 0 };
+            char lineFence = 0;
+            int lineFenceLength = 0, indent = 0;
+
+            if (fence != 0) { if (IsMarkdownCodeFenceClose(itemLines[j], fence, fenceLength)) fence = 0; }
+            else if (GetMarkdownCodeFence(itemLines[j], &lineFence, &lineFenceLength, &indent, &info)) { fence = lineFence; fenceLength = lineFenceLength; }
+            else if ((j > 0) && (itemLines[j].length == 0) && IsMarkdownBlank(itemLines[j]) && (GetMarkdownIndent(itemLines[j - 1], NULL) < 4)) list->tight = false;
+        }
+
+        MarkdownBlock *item = AddMarkdownBlock(parser, list, MARKDOWN_LIST_ITEM);
+        if (item == NULL) return count;
+        ParseMarkdownBlocks(parser, item, itemLines, contentCount);
+
+        blankBeforeItem = (itemCount > contentCount);
+        i = k;
+    }
+
+    return i;
+}
+
+// Parse lines into blocks, added as children of parent block
+static void ParseMarkdownBlocks(MarkdownParser *parser, MarkdownBlock *parent, const MarkdownLine *lines, int count)
+{
+    if (parser->depth >= MARKDOWN_MAX_DEPTH)
+    {
+        MarkdownBlock *block = AddMarkdownBlock(parser, parent, MARKDOWN_PARAGRAPH);
+        if (block != NULL) block->text = JoinMarkdownLines(parser, lines, count, true, &block->length);
+        return;
+    }
+
+    parser->depth++;
+
+    int i = 0;
+    while (i < count)
+    {
+        MarkdownLine line = lines[i];
+        MarkdownLine content = { 0 };
+        MarkdownListMarker marker = { 0 };
+        char aligns[MARKDOWN_MAX_TABLE_COLUMNS] = { 0 };
+        char fence = 0;
+        int fenceLength = 0, fenceIndent = 0, level = 0, htmlType = 0, columns = 0;
+        const char *htmlEnd = NULL;
+        int offset = 0;
+        int indent = GetMarkdownIndent(line, &offset);
+
+        if (offset == line.length) { i++; continue; }
+
+        MarkdownBlock *block = NULL;
+
+        if (indent >= 4)
+        {
+            // Indented code: indented and blank lines, trailing blank lines excluded
+            int end = i + 1;
+            for (int k = i + 1; k < count; k++)
+            {
+                if (IsMarkdownBlank(lines[k])) continue;
+                if (GetMarkdownIndent(lines[k], NULL) < 4) break;
+                end = k + 1;
+            }
+
+            MarkdownLine *code = (MarkdownLine *)ArenaAlloc(parser->arena, (end - i)*sizeof(MarkdownLine));
+            block = AddMarkdownBlock(parser, parent, MARKDOWN_CODE_BLOCK);
+            if ((code == NULL) || (block == NULL)) break;
+
+            for (int k = i; k < end; k++) code[k - i] = StripMarkdownIndent(lines[k], 4);
+            block->text = JoinMarkdownLines(parser, code, end - i, false, &block->length);
+            i = end;
+        }
+        else if (GetMarkdownCodeFence(line, &fence, &fenceLength, &fenceIndent, &content))
+        {
+            // Fenced code: until closing fence (or end of container), fence indentation removed
+            int end = i + 1;
+            while ((end < count) && !IsMarkdownCodeFenceClose(lines[end], fence, fenceLength)) end++;
+
+            MarkdownLine *code = (MarkdownLine *)ArenaAlloc(parser->arena, (end - i)*sizeof(MarkdownLine));
+            block = AddMarkdownBlock(parser, parent, MARKDOWN_CODE_BLOCK);
+            if ((code == NULL) || (block == NULL)) break;
+
+            for (int k = i + 1; k < end; k++) code[k - i - 1] = StripMarkdownIndent(lines[k], fenceIndent);
+            block->text = JoinMarkdownLines(parser, code, end - i - 1, false, &block->length);
+            block->info = content.text;
+            block->infoLength = content.length;
+            i = (end < count)? end + 1 : end;
+        }
+        else if ((level = GetMarkdownAtxHeading(line, &content)) > 0)
+        {
+            block = AddMarkdownBlock(parser, parent, MARKDOWN_HEADING);
+            if (block == NULL) break;
+
+            block->level = level;
+            block->text = content.text;
+            block->length = content.length;
+            i++;
+        }
+        else if (IsMarkdownThematicBreak(line))
+        {
+            if (AddMarkdownBlock(parser, parent, MARKDOWN_THEMATIC_BREAK) == NULL) break;
+            i++;
+        }
+        else if (line.text[offset] == '>')
+        {
+            // Block quote: '>' lines (marker and one space removed) and lazy paragraph continuation lines
+            MarkdownLine *quoted = (MarkdownLine *)ArenaAlloc(parser->arena, (count - i)*sizeof(MarkdownLine));
+            block = AddMarkdownBlock(parser, parent, MARKDOWN_BLOCK_QUOTE);
+            if ((quoted == NULL) || (block == NULL)) break;
+
+            int quotedCount = 0;
+            bool paragraph = false;
+            for (; i < count; i++)
+            {
+                int quoteOffset = 0;
+                if ((GetMarkdownIndent(lines[i], &quoteOffset) < 4) && (quoteOffset < lines[i].length) && (lines[i].text[quoteOffset] == '>'))
+                {
+                    MarkdownLine quotedLine = { lines[i].text + quoteOffset + 1, lines[i].length - quoteOffset - 1 };
+                    quoted[quotedCount++] = StripMarkdownIndent(quotedLine, 1);
+                    paragraph = !IsMarkdownBlank(quotedLine) && !IsMarkdownBlockStart(quoted[quotedCount - 1]);
+                }
+                else if (paragraph && !IsMarkdownBlank(lines[i]) && !IsMarkdownBlockStart(lines[i])) quoted[quotedCount++] = lines[i];
+                else break;
+            }
+
+            ParseMarkdownBlocks(parser, block, quoted, quotedCount);
+        }
+        else if (GetMarkdownListMarker(line, &marker))
+        {
+            i = ParseMarkdownList(parser, parent, lines, count, i);
+        }
+        else if ((htmlType = GetMarkdownHtmlBlockType(line, &htmlEnd)) > 0)
+        {
+            // HTML block: until blank line, or until line with end marker (included)
+            int end = i;
+            if (htmlType == 3) while ((end < count) && !IsMarkdownBlank(lines[end])) end++;
+            else
+            {
+                while ((end < count) && !HasMarkdownText(lines[end], htmlEnd)) end++;
+                if (end < count) end++;
+            }
+
+            block = AddMarkdownBlock(parser, parent, MARKDOWN_HTML_BLOCK);
+            if (block == NULL) break;
+
+            block->text = JoinMarkdownLines(parser, lines + i, end - i, false, &block->length);
+            i = end;
+        }
+        else if (((i + 1) < count) && ((columns = GetMarkdownTableColumns(lines[i + 1], aligns)) > 0) &&
+            (GetMarkdownTableCells(line.text, line.length, NULL, 0) == columns) && (memchr(line.text, '|', line.length) != NULL))
+        {
+            // Table: header, delimiter row and rows until blank line or block start
+            int end = i + 2;
+            while ((end < count) && !IsMarkdownBlank(lines[end]) && !IsMarkdownBlockStart(lines[end])) end++;
+
+            MarkdownLine *rows = (MarkdownLine *)ArenaAlloc(parser->arena, (end - i)*sizeof(MarkdownLine));
+            char *columnAligns = (char *)ArenaAlloc(parser->arena, columns);
+            block = AddMarkdownBlock(parser, parent, MARKDOWN_TABLE);
+            if ((rows == NULL) || (columnAligns == NULL) || (block == NULL)) break;
+
+            rows[0] = line;
+            for (int k = i + 2; k < end; k++) rows[k - i - 1] = lines[k];
+            memcpy(columnAligns, aligns, columns);
+
+            block->text = JoinMarkdownLines(parser, rows, end - i - 1, true, &block->length);
+            block->info = columnAligns;
+            block->infoLength = columns;
+            block->level = columns;
+            i = end;
+        }
+        else
+        {
+            // Paragraph: lines until blank line or block start, setext underline makes it a heading
+            int end = i + 1;
+            int setextLevel = 0;
+            for (; end < count; end++)
+            {
+                if (IsMarkdownBlank(lines[end])) break;
+                if ((setextLevel = GetMarkdownSetextLevel(lines[end])) > 0) break;
+                if (IsMarkdownBlockStart(lines[end])) break;
+            }
+
+            // Reference definitions are only allowed at paragraph start
+            int start = i;
+            while ((start < end) && ParseMarkdownReference(parser, lines[start])) start++;
+
+            if (start < end)
+            {
+                block = AddMarkdownBlock(parser, parent, (setextLevel > 0)? MARKDOWN_HEADING : MARKDOWN_PARAGRAPH);
+                if (block == NULL) break;
+
+                block->level = setextLevel;
+                block->text = JoinMarkdownLines(parser, lines + start, end - start, true, &block->length);
+            }
+
+            i = (setextLevel > 0)? end + 1 : end;
+        }
+    }
+
+    parser->depth--;
+}
+
+// Write data to output buffer, flushed through write callback when full
+static void WriteMarkdownData(MarkdownWriter *writer, const char *data, int size)
+{
+    if (size <= 0) return;
+
+    if (size > (MARKDOWN_WRITER_SIZE - writer->size))
+    {
+        if (writer->size > 0) writer->write(writer->buffer, writer->size, writer->userData);
+        writer->size = 0;
+
+        if (size > MARKDOWN_WRITER_SIZE)
+        {
+            writer->write(data, size, writer->userData);
+            return;
+        }
+    }
+
+    memcpy(writer->buffer + writer->size, data, size);
+    writer->size += size;
+}
+
+static void WriteMarkdownString(MarkdownWriter *writer, const char *text)
+{
+    WriteMarkdownData(writer, text, (int)strlen(text));
+}
+
+// Write text, HTML special characters escaped
+static void WriteMarkdownEscaped(MarkdownWriter *writer, const char *text, int length)
+{
+    int start = 0;
+    for (int i = 0; i < length; i++)
+    {
+        const char *entity = NULL;
+        switch (text[i])
+        {
+            case '&': entity = "&amp;"; break;
+            case '<': entity = "&lt;"; break;
+            case '>': entity = "&gt;"; break;
+            case '"': entity = "&quot;"; break;
+            default: break;
+        }
+
+        if (entity != NULL)
+        {
+            WriteMarkdownData(writer, text + start, i - start);
+            WriteMarkdownString(writer, entity);
+            start = i + 1;
+        }
+    }
+
+    WriteMarkdownData(writer, text + start, length - start);
+}
+
+// Write text with backslash escapes resolved, HTML escaped (link titles, code info)
+static void WriteMarkdownUnescaped(MarkdownWriter *writer, const char *text, int length)
+{
+    int start = 0;
+    for (int i = 0; i < length; i++)
+    {
+        if ((text[i] == '\\') && ((i + 1) < length) && IsMarkdownPunct(text[i + 1]))
+        {
+            WriteMarkdownEscaped(writer, text + start, i - start);
+            start = ++i;
+        }
+    }
+
+    WriteMarkdownEscaped(writer, text + start, length - start);
+}
+
+// Write URL for attribute: backslash escapes resolved, spaces and quotes percent-encoded
+static void WriteMarkdownUrl(MarkdownWriter *writer, const char *url, int length)
+{
+    for (int i = 0; i < length; i++)
+    {
+        char c = url[i];
+        if ((c == '\\') && ((i + 1) < length) && IsMarkdownPunct(url[i + 1])) c = url[++i];
+
+        switch (c)
+        {
+            case '&': WriteMarkdownString(writer, "&amp;"); break;
+            case '"': WriteMarkdownString(writer, "%22"); break;
+            case ' ': WriteMarkdownString(writer, "%20"); break;
+            case '<': WriteMarkdownString(writer, "%3C"); break;
+            case '>': WriteMarkdownString(writer, "%3E"); break;
+            default: WriteMarkdownData(writer, &c, 1); break;
+        }
+    }
+}
+
+// Get length of backtick run, code span closing run (same length) is searched, -1 if not found
+static int FindMarkdownCodeSpanEnd(const char *text, int length, int position, int *runLength)
+{
+    int run = 0;
+    while (((position + run) < length) && (text[position + run] == '`')) run++;
+    *runLength = run;
+
+    for (int i = position + run; i < length; )
+    {
+        if (text[i] != '`') { i++; continue; }
+
+        int closing = 0;
+        while (((i + closing) < length) && (text[i + closing] == '`')) closing++;
+        if (closing == run) return i;
+        i += closing;
+    }
+
+    return -1;
+}
+
+// Find matching closing bracket of link text, code spans and escapes skipped, -1 if not found
+static int FindMarkdownBracketEnd(const char *text, int length, int position)
+{
+    int depth = 0;
+    for (int i = position; i < length; i++)
+    {
+        if (text[i] == '\\') { i++; continue; }
+        if (text[i] == '`')
+        {
+            int run = 0;
+            int end = FindMarkdownCodeSpanEnd(text, length, i, &run);
+            i = (end >= 0)? end + run - 1 : i + run - 1;
+            continue;
+        }
+
+        if (text[i] == '[') depth++;
+        else if ((text[i] == ']') && (--depth == 0)) return i;
+    }
+
+    return -1;
+}
+
+// Parse link or image at '[': inline link, full/collapsed/shortcut reference link
+static bool ParseMarkdownLink(const MarkdownWriter *writer, const char *text, int length, int position, MarkdownLinkTarget *target)
+{
+    int close = FindMarkdownBracketEnd(text, length, position);
+    if (close < 0) return false;
+
+    *target = (MarkdownLinkTarget){ 0 };
+    target->textStart = position + 1;
+    target->textEnd = close;
+
+    int i = close + 1;
+    if ((i < length) && (text[i] == '('))
+    {
+        i++;
+        while ((i < length) && IsMarkdownSpace(text[i])) i++;
+
+        int urlStart = i, urlEnd = i;
+        if ((i < length) && (text[i] != ')'))
+        {
+            i = ParseMarkdownLinkDestination(text, length, i, &urlStart, &urlEnd);
+            if (i < 0) return false;
+        }
+
+        int spaces = i;
+        while ((i < length) && IsMarkdownSpace(text[i])) i++;
+
+        int titleStart = 0, titleEnd = 0;
+        if ((i < length) && (i > spaces) && (text[i] != ')'))
+        {
+            i = ParseMarkdownLinkTitle(text, length, i, &titleStart, &titleEnd);
+            if (i < 0) return false;
+            while ((i < length) && IsMarkdownSpace(text[i])) i++;
+        }
+
+        if ((i >= length) || (text[i] != ')')) return false;
+
+        target->url = text + urlStart;
+        target->urlLength = urlEnd - urlStart;
+        target->title = text + titleStart;
+        target->titleLength = titleEnd - titleStart;
+        target->end = i + 1;
+        return true;
+    }
+
+    // Reference link: [text][label], [text][] or [text]
+    const char *label = text + position + 1;
+    int labelLength = close - position - 1;
+    target->end = close + 1;
+
+    if ((i < length) && (text[i] == '['))
+    {
+        int labelEnd = i + 1;
+        while ((labelEnd < length) && (text[labelEnd] != ']') && (text[labelEnd] != '[')) labelEnd++;
+
+        if ((labelEnd < length) && (text[labelEnd] == ']'))
+        {
+            if (labelEnd > (i + 1))
+            {
+                label = text + i + 1;
+                labelLength = labelEnd - i - 1;
+            }
+            target->end = labelEnd + 1;
+        }
+    }
+
+    const MarkdownReference *reference = FindMarkdownReference(writer->document, label, labelLength);
+    if (reference == NULL) return false;
+
+    target->url = reference->url;
+    target->urlLength = reference->urlLength;
+    target->title = reference->title;
+    target->titleLength = reference->titleLength;
+    return true;
+}
+
+// Get autolink end: <scheme:address> or <user@domain>, -1 if not an autolink
+static int FindMarkdownAutolinkEnd(const char *text, int length, int position, bool *email)
+{
+    int i = position + 1;
+    int scheme = 0;
+    while (((i + scheme) < length) && (IsMarkdownAlnum(text[i + scheme]) || (text[i + scheme] == '+') || (text[i + scheme] == '.') || (text[i + scheme] == '-'))) scheme++;
+
+    if ((scheme >= 2) && (scheme <= 32) && ((i + scheme) < length) && (text[i + scheme] == ':'))
+    {
+        for (int k = i + scheme + 1; k < length; k++)
+        {
+            if (text[k] == '>') { *email = false; return k; }
+            if (((unsigned char)text[k] <= 32) || (text[k] == '<')) return -1;
+        }
+        return -1;
+    }
+
+    bool at = false;
+    for (int k = i; k < length; k++)
+    {
+        char c = text[k];
+        if ((c == '>') && at && (k > i)) { *email = true; return k; }
+        if (c == '@') { if (at || (k == i)) return -1; at = true; }
+        else if (!IsMarkdownAlnum(c) && (strchr(at? ".-" : ".!#$%&'*+/=?^_`{|}~-", c) == NULL)) return -1;
+    }
+
+    return -1;
+}
+
+// Get raw inline HTML end: open tag, closing tag or comment, -1 if not HTML
+static int FindMarkdownInlineHtmlEnd(const char *text, int length, int position)
+{
+    int i = position + 1;
+    if (i >= length) return -1;
+
+    if (((i + 2) < length) && (strncmp(text + i, "!--", 3) == 0))
+    {
+        for (int k = i + 3; (k + 2) < length; k++) if (strncmp(text + k, "-->", 3) == 0) return k + 2;
+        return -1;
+    }
+
+    if (text[i] == '/') i++;
+    if ((i >= length) || !(((text[i] | 32) >= 'a') && ((text[i] | 32) <= 'z'))) return -1;
+
+    char quote = 0;
+    for (int k = i; k < length; k++)
+    {
+        if (quote != 0) { if (text[k] == quote) quote = 0; continue; }
+        if ((text[k] == '"') || (text[k] == '\'')) quote = text[k];
+        else if (text[k] == '<') return -1;
+        else if (text[k] == '>') return k;
+    }
+
+    return -1;
+}
+
+// Get entity end: &name; &#123; or &#x1F; (-1 if not an entity)
+static int FindMarkdownEntityEnd(const char *text, int length, int position)
+{
+    int i = position + 1;
+    bool numeric = (i < length) && (text[i] == '#');
+    bool hex = numeric && ((i + 1) < length) && ((text[i + 1] | 32) == 'x');
+    if (numeric) i += hex? 2 : 1;
+
+    int start = i;
+    while ((i < length) && ((i - start) < 32))
+    {
+        char c = text[i];
+        bool valid = numeric? (((c >= '0') && (c <= '9')) || (hex && ((c | 32) >= 'a') && ((c | 32) <= 'f'))) : IsMarkdownAlnum(c);
+        if (!valid) break;
+        i++;
+    }
+
+    return ((i > start) && (i < length) && (text[i] == ';'))? i : -1;
+}
+
+// Check if delimiter run can open/close emphasis (flanking rules, '_' not intraword)
+static void GetMarkdownDelimiterFlanking(const char *text, int length, int position, int run, bool *canOpen, bool *canClose)
+{
+    char c = text[position];
+    char before = (position > 0)? text[position - 1] : ' ';
+    char after = ((position + run) < length)? text[position + run] : ' ';
+
+    bool leftFlanking = !IsMarkdownSpace(after) && (!IsMarkdownPunct(after) || IsMarkdownSpace(before) || IsMarkdownPunct(before));
+    bool rightFlanking = !IsMarkdownSpace(before) && (!IsMarkdownPunct(before) || IsMarkdownSpace(after) || IsMarkdownPunct(after));
+
+    *canOpen = leftFlanking && ((c == '*') || !rightFlanking || IsMarkdownPunct(before));
+    *canClose = rightFlanking && ((c == '*') || !leftFlanking || IsMarkdownPunct(after));
+}
+
+// Find emphasis closing run (at least count delimiters), -1 if not found
+// NOTE: Runs only able to open are counted as nested emphasis, their closers are skipped (linear scan)
+static int FindMarkdownEmphasisEnd(const char *text, int length, int position, char delimiter, int count)
+{
+    int nested = 0;
+
+    for (int i = position; i < length; )
+    {
+        char c = text[i];
+        if ((c == '\\') && ((i + 1) < length)) { i += 2; continue; }
+        if (c == '`')
+        {
+            int run = 0;
+            int end = FindMarkdownCodeSpanEnd(text, length, i, &run);
+            i = (end >= 0)? end + run : i + run;
+            continue;
+        }
+        if (c != delimiter) { i++; continue; }
+
+        int run = 0;
+        while (((i + run) < length) && (text[i + run] == delimiter)) run++;
+
+        bool canOpen = false, canClose = false;
+        GetMarkdownDelimiterFlanking(text, length, i, run, &canOpen, &canClose);
+
+        if (canClose && (nested > 0)) nested--;
+        else if (canClose && (run >= count)) return i;
+        else if (canOpen) nested++;
+
+        i += run;
+    }
+
+    return -1;
+}
+
+static void RenderMarkdownInlines(MarkdownWriter *writer, const char *text, int length);
+
+// Write image alt text: text without markup characters
+static void WriteMarkdownAltText(MarkdownWriter *writer, const char *text, int length)
+{
+    int start = 0;
+    for (int i = 0; i < length; i++)
+    {
+        if ((text[i] == '*') || (text[i] == '_') || (text[i] == '`') || (text[i] == '[') || (text[i] == ']') || (text[i] == '!'))
+        {
+            WriteMarkdownEscaped(writer, text + start, i - start);
+            start = i + 1;
+        }
+    }
+
+    WriteMarkdownEscaped(writer, text + start, length - start);
+}
+
+// Render inline text: markup is parsed while text is written
+static void RenderMarkdownInlines(MarkdownWriter *writer, const char *text, int length)
+{
+    if (writer->depth >= MARKDOWN_MAX_DEPTH)
+    {
+        WriteMarkdownEscaped(writer, text, length);
+        return;
+    }
+
+    writer->depth++;
+
+    int run = 0;        // Pending plain text start, written once markup is found
+    int i = 0;
+    while (i < length)
+    {
+        char c = text[i];
+        int next = -1;
+
+        #define FLUSH_MARKDOWN_TEXT(end) WriteMarkdownEscaped(writer, text + run, (end) - run)
+
+        if ((c == '\\') && ((i + 1) < length) && (IsMarkdownPunct(text[i + 1]) || (text[i + 1] == '\n')))
+        {
+            FLUSH_MARKDOWN_TEXT(i);
+            if (text[i + 1] == '\n') WriteMarkdownString(writer, "<br />\n");
+            else WriteMarkdownEscaped(writer, text + i + 1, 1);
+            next = i + 2;
+        }
+        else if (c == '\n')
+        {
+            int end = i;
+            while ((end > run) && (text[end - 1] == ' ')) end--;
+            FLUSH_MARKDOWN_TEXT(end);
+            WriteMarkdownString(writer, ((i - end) >= 2)? "<br />\n" : "\n");
+            next = i + 1;
+        }
+        else if (c == '`')
+        {
+            int runLength = 0;
+            int end = FindMarkdownCodeSpanEnd(text, length, i, &runLength);
+            if (end < 0) { i += runLength; continue; }
+
+            // Line endings are spaces, one space is stripped on both sides (if not only spaces)
+            int start = i + runLength, stop = end;
+            bool spaces = true;
+            for (int k = start; k < stop; k++) if ((text[k] != ' ') && (text[k] != '\n')) spaces = false;
+            if (!spaces && ((stop - start) >= 2) && ((text[start] == ' ') || (text[start] == '\n')) && ((text[stop - 1] == ' ') || (text[stop - 1] == '\n'))) { start++; stop--; }
+
+            FLUSH_MARKDOWN_TEXT(i);
+            WriteMarkdownString(writer, "<code>");
+            for (int k = start; k < stop; k++)
+            {
+                if (text[k] == '\n') WriteMarkdownString(writer, " ");
+                else WriteMarkdownEscaped(writer, text + k, 1);
+            }
+            WriteMarkdownString(writer, "</code>");
+            next = end + runLength;
+        }
+        else if ((c == '*') || (c == '_'))
+        {
+            int runLength = 0;
+            while (((i + runLength) < length) && (text[i + runLength] == c)) runLength++;
+
+            bool canOpen = false, canClose = false;
+            GetMarkdownDelimiterFlanking(text, length, i, runLength, &canOpen, &canClose);
+
+            // Closing run with as many delimiters as possible (3: strong and emphasis, 2: strong, 1: emphasis)
+            int end = -1, count = (runLength >= 3)? 3 : runLength;
+            for (; canOpen && (count > 0) && (end < 0); count--) end = FindMarkdownEmphasisEnd(text, length, i + runLength, c, count);
+            count++;
+
+            if (end < 0) { i += runLength; continue; }
+
+            // Extra opening delimiters are plain text, closing delimiters are taken from closer start
+            FLUSH_MARKDOWN_TEXT(i + runLength - count);
+            WriteMarkdownString(writer, (count == 3)? "<em><strong>" : ((count == 2)? "<strong>" : "<em>"));
+            RenderMarkdownInlines(writer, text + i + runLength, end - i - runLength);
+            WriteMarkdownString(writer, (count == 3)? "</strong></em>" : ((count == 2)? "</strong>" : "</em>"));
+            next = end + count;
+        }
+        else if ((c == '~') && ((i + 1) < length) && (text[i + 1] == '~') && ((i + 2) < length) && !IsMarkdownSpace(text[i + 2]))
+        {
+            int end = -1;
+            for (int k = i + 2; (k + 1) < length; k++) if ((text[k] == '~') && (text[k + 1] == '~') && !IsMarkdownSpace(text[k - 1])) { end = k; break; }
+            if (end < 0) { i += 2; continue; }
+
+            FLUSH_MARKDOWN_TEXT(i);
+            WriteMarkdownString(writer, "<del>");
+            RenderMarkdownInlines(writer, text + i + 2, end - i - 2);
+            WriteMarkdownString(writer, "</del>");
+            next = end + 2;
+        }
+        else if ((c == '[') || ((c == '!') && ((i + 1) < length) && (text[i + 1] == '[')))
+        {
+            bool image = (c == '!');
+            MarkdownLinkTarget target = { 0 };
+            if (!ParseMarkdownLink(writer, text, length, image? i + 1 : i, &target)) { i += image? 2 : 1; continue; }
+
+            FLUSH_MARKDOWN_TEXT(i);
+            WriteMarkdownString(writer, image? "<img src=\"" : "<a href=\"");
+            WriteMarkdownUrl(writer, target.url, target.urlLength);
+            WriteMarkdownString(writer, "\"");
+            if (image)
+            {
+                WriteMarkdownString(writer, " alt=\"");
+                WriteMarkdownAltText(writer, text + target.textStart, target.textEnd - target.textStart);
+                WriteMarkdownString(writer, "\"");
+            }
+            if (target.titleLength > 0)
+            {
+                WriteMarkdownString(writer, " title=\"");
+                WriteMarkdownUnescaped(writer, target.title, target.titleLength);
+                WriteMarkdownString(writer, "\"");
+            }
+
+            if (image) WriteMarkdownString(writer, " />");
+            else
+            {
+                WriteMarkdownString(writer, ">");
+                RenderMarkdownInlines(writer, text + target.textStart, target.textEnd - target.textStart);
+                WriteMarkdownString(writer, "</a>");
+            }
+            next = target.end;
+        }
+        else if (c == '<')
+        {
+            bool email = false;
+            int end = FindMarkdownAutolinkEnd(text, length, i, &email);
+            if (end >= 0)
+            {
+                FLUSH_MARKDOWN_TEXT(i);
+                WriteMarkdownString(writer, email? "<a href=\"mailto:" : "<a href=\"");
+                WriteMarkdownUrl(writer, text + i + 1, end - i - 1);
+                WriteMarkdownString(writer, "\">");
+                WriteMarkdownEscaped(writer, text + i + 1, end - i - 1);
+                WriteMarkdownString(writer, "</a>");
+                next = end + 1;
+            }
+            else if ((end = FindMarkdownInlineHtmlEnd(text, length, i)) >= 0)
+            {
+                FLUSH_MARKDOWN_TEXT(i);
+                WriteMarkdownData(writer, text + i, end - i + 1);
+                next = end + 1;
+            }
+        }
+        else if (c == '&')
+        {
+            int end = FindMarkdownEntityEnd(text, length, i);
+            if (end >= 0)
+            {
+                FLUSH_MARKDOWN_TEXT(i);
+                WriteMarkdownData(writer, text + i, end - i + 1);
+                next = end + 1;
+            }
+        }
+
+        #undef FLUSH_MARKDOWN_TEXT
+
+        if (next >= 0) i = run = next;
+        else i++;
+    }
+
+    WriteMarkdownEscaped(writer, text + run, length - run);
+    writer->depth--;
+}
+
+// Write heading id: lowercase letters and digits, spaces and dashes as '-', other characters removed
+static void WriteMarkdownHeadingId(MarkdownWriter *writer, const char *text, int length)
+{
+    bool dash = false;
+    int written = 0;
+    for (int i = 0; (i < length) && (written < 128); i++)
+    {
+        char c = ToMarkdownLower(text[i]);
+        if (IsMarkdownAlnum(c) || (c == '_'))
+        {
+            if (dash && (written > 0)) { WriteMarkdownData(writer, "-", 1); written++; }
+            WriteMarkdownData(writer, &c, 1);
+            written++;
+            dash = false;
+        }
+        else if ((c == ' ') || (c == '-')) dash = true;
+    }
+}
+
+// Render table row cells (th for header row), missing cells are written empty
+static void RenderMarkdownTableRow(MarkdownWriter *writer, const MarkdownBlock *table, const char *row, int length, bool header)
+{
+    MarkdownLine cells[MARKDOWN_MAX_TABLE_COLUMNS] = { 0 };
+    int count = GetMarkdownTableCells(row, length, cells, MARKDOWN_MAX_TABLE_COLUMNS);
+
+    WriteMarkdownString(writer, "<tr>\n");
+    for (int i = 0; i < table->level; i++)
+    {
+        char align = table->info[i];
+        WriteMarkdownString(writer, header? "<th" : "<td");
+        if (align != 0) WriteMarkdownString(writer, (align == 'c')? " align=\"center\"" : ((align == 'r')? " align=\"right\"" : " align=\"left\""));
+        WriteMarkdownString(writer, ">");
+        if (i < count) RenderMarkdownInlines(writer, cells[i].text, cells[i].length);
+        WriteMarkdownString(writer, header? "</th>\n" : "</td>\n");
+    }
+    WriteMarkdownString(writer, "</tr>\n");
+}
+
+static void RenderMarkdownBlocks(MarkdownWriter *writer, const MarkdownBlock *parent, bool tight);
+
+static void RenderMarkdownBlock(MarkdownWriter *writer, const MarkdownBlock *block, bool tight)
+{
+    char tag[32] = { 0 };
+
+    switch (block->type)
+    {
+        case MARKDOWN_PARAGRAPH:
+        {
+            if (!tight) WriteMarkdownString(writer, "<p>");
+            RenderMarkdownInlines(writer, block->text, block->length);
+            if (!tight) WriteMarkdownString(writer, "</p>\n");
+            else if (block->next != NULL) WriteMarkdownString(writer, "\n");
+        } break;
+        case MARKDOWN_HEADING:
+        {
+            snprintf(tag, sizeof(tag), "<h%i id=\"", block->level);
+            WriteMarkdownString(writer, tag);
+            WriteMarkdownHeadingId(writer, block->text, block->length);
+            WriteMarkdownString(writer, "\">");
+            RenderMarkdownInlines(writer, block->text, block->length);
+            snprintf(tag, sizeof(tag), "</h%i>\n", block->level);
+            WriteMarkdownString(writer, tag);
+        } break;
+        case MARKDOWN_THEMATIC_BREAK: WriteMarkdownString(writer, "<hr />\n"); break;
+        case MARKDOWN_CODE_BLOCK:
+        {
+            WriteMarkdownString(writer, "<pre><code");
+            if (block->infoLength > 0)
+            {
+                WriteMarkdownString(writer, " class=\"language-");
+                WriteMarkdownUnescaped(writer, block->info, block->infoLength);
+                WriteMarkdownString(writer, "\"");
+            }
+            WriteMarkdownString(writer, ">");
+            WriteMarkdownEscaped(writer, block->text, block->length);
+            if (block->length > 0) WriteMarkdownString(writer, "\n");
+            WriteMarkdownString(writer, "</code></pre>\n");
+        } break;
+        case MARKDOWN_HTML_BLOCK:
+        {
+            WriteMarkdownData(writer, block->text, block->length);
+            WriteMarkdownString(writer, "\n");
+        } break;
+        case MARKDOWN_BLOCK_QUOTE:
+        {
+            WriteMarkdownString(writer, "<blockquote>\n");
+            RenderMarkdownBlocks(writer, block, false);
+            WriteMarkdownString(writer, "</blockquote>\n");
+        } break;
+        case MARKDOWN_LIST:
+        {
+            if (!block->ordered) WriteMarkdownString(writer, "<ul>\n");
+            else if (block->level != 1)
+            {
+                snprintf(tag, sizeof(tag), "<ol start=\"%i\">\n", block->level);
+                WriteMarkdownString(writer, tag);
+            }
+            else WriteMarkdownString(writer, "<ol>\n");
+
+            for (const MarkdownBlock *item = block->firstChild; item != NULL; item = item->next)
+            {
+                WriteMarkdownString(writer, "<li>");
+                if ((item->firstChild != NULL) && (!block->tight || (item->firstChild->type != MARKDOWN_PARAGRAPH))) WriteMarkdownString(writer, "\n");
+                RenderMarkdownBlocks(writer, item, block->tight);
+                WriteMarkdownString(writer, "</li>\n");
+            }
+
+            WriteMarkdownString(writer, block->ordered? "</ol>\n" : "</ul>\n");
+        } break;
+        case MARKDOWN_TABLE:
+        {
+            // Rows are lines of table text, first one is header
+            WriteMarkdownString(writer, "<table>\n<thead>\n");
+            int start = 0;
+            for (int row = 0; start <= block->length; row++)
+            {
+                int end = start;
+                while ((end < block->length) && (block->text[end] != '\n')) end++;
+
+                if (row == 1) WriteMarkdownString(writer, "<tbody>\n");
+                RenderMarkdownTableRow(writer, block, block->text + start, end - start, (row == 0));
+                if (row == 0) WriteMarkdownString(writer, "</thead>\n");
+
+                if ((end >= block->length) && (row > 0)) WriteMarkdownString(writer, "</tbody>\n");
+                start = end + 1;
+            }
+            WriteMarkdownString(writer, "</table>\n");
+        } break;
+        default: break;
+    }
+}
+
+static void RenderMarkdownBlocks(MarkdownWriter *writer, const MarkdownBlock *parent, bool tight)
+{
+    for (const MarkdownBlock *block = parent->firstChild; block != NULL; block = block->next) RenderMarkdownBlock(writer, block, tight);
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Parse markdown blocks into arena, reference definitions are collected
+// NOTE: Blocks point into text, it must be valid until document is rendered
+MarkdownDocument *LoadMarkdownDocument(Arena *arena, const char *text, int size)
+{
+    MarkdownDocument *document = (MarkdownDocument *)ArenaAlloc(arena, sizeof(MarkdownDocument));
+    if (document == NULL) return NULL;
+
+    document->root.type = MARKDOWN_DOCUMENT;
+
+    int lineCount = 1;
+    for (int i = 0; i < size; i++) if (text[i] == '\n') lineCount++;
+
+    MarkdownLine *lines = (MarkdownLine *)ArenaAlloc(arena, lineCount*sizeof(MarkdownLine));
+    if (lines == NULL) return document;
+
+    // Lines split, line endings (\n or \r\n) removed
+    int count = 0;
+    for (int start = 0; start <= size; )
+    {
+        int end = start;
+        while ((end < size) && (text[end] != '\n')) end++;
+
+        int length = end - start;
+        if ((length > 0) && (text[end - 1] == '\r')) length--;
+        if ((end < size) || (length > 0)) lines[count++] = (MarkdownLine){ text + start, length };
+
+        start = end + 1;
+    }
+
+    MarkdownParser parser = { arena, document, 0 };
+    ParseMarkdownBlocks(&parser, &document->root, lines, count);
+
+    return document;
+}
+
+// Render document HTML, written in chunks through write callback
+void RenderMarkdownHtml(const MarkdownDocument *document, MarkdownWriteFunc write, void *userData)
+{
+    if (document == NULL) return;
+
+    MarkdownWriter writer = { 0 };
+    writer.write = write;
+    writer.userData = userData;
+    writer.document = document;
+
+    RenderMarkdownBlocks(&writer, &document->root, false);
+
+    if (writer.size > 0) write(writer.buffer, writer.size, userData);
+}
+
+// Render plain text, HTML escaped
+void RenderMarkdownText(const char *text, int length, MarkdownWriteFunc write, void *userData)
+{
+    MarkdownWriter writer = { 0 };
+    writer.write = write;
+    writer.userData = userData;
+
+    WriteMarkdownEscaped(&writer, text, length);
+
+    if (writer.size > 0) write(writer.buffer, writer.size, userData);
+}
+
+#endif // MARKDOWN_HTML_IMPLEMENTATION
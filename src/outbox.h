@@ -0,0 +1,553 @@
+/*******************************************************************************************
+*
+*   Outbox - Durable publish queue: journaled staged posts, drained in batches per repository
+*
+*   MODULE USAGE:
+*       #define OUTBOX_IMPLEMENTATION
+*       #include "outbox.h"
+*
+*       Outbox *outbox = LoadOutbox("posts/outbox");          // Pending entries are recovered from journal
+*       AddOutboxEntry(outbox, &entry, "posts/new", NULL);      // Post folder is moved into outbox
+*       DrainOutbox(outbox, PushEntries, NULL);                 // Or StartOutboxDrainer() for background drain
+*       UnloadOutbox(outbox);
+*
+*   NOTES:
+*       Every entry is staged into its own outbox folder (<outbox>/<id>) and then recorded in an
+*       append-only journal (<outbox>/journal.log), flushed to disk before AddOutboxEntry() returns.
+*       An entry is only marked done (journal DONE record) and its staged files removed once drain
+*       function reports success, so a failed push or a crash never loses a post
+*
+*       Drain function is called once per repository with all its pending entries, so a burst of
+*       posts becomes a single commit and push. Background drainer waits OUTBOX_COALESCE_DELAY
+*       after last added entry before draining, failed drains are retried with increasing delay
+*
+*       Journal is text, one record per line, last line is ignored if incomplete (crash on write):
+*           ADD <id> <hasAttachment> <repositoryUrl> <postsPath> <assetsPath>  (tab separated)
+*           DONE <id>
+*       Journal is removed when no entry is pending
+*
+*       Threads are not available on PLATFORM_WEB, StartOutboxDrainer() does nothing there
+*
+*   DEPENDENCIES:
+*       raylib          - MakeDirectory(), LoadDirectoryFiles() (staged folders removal)
+*
+*   LICENSE: GPLv3, check LICENSE file for details
+*
+**********************************************************************************************/
+
+#ifndef OUTBOX_H
+#define OUTBOX_H
+
+#include <stdbool.h>        // Required for: bool
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define OUTBOX_COALESCE_DELAY       2       // Seconds without new entries before background drain
+#define OUTBOX_MAX_RETRY_DELAY      300     // Max seconds between background drain retries
+
+#if defined(__EMSCRIPTEN__) && !defined(OUTBOX_NO_THREADS)
+    #define OUTBOX_NO_THREADS
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Outbox entry, a staged post waiting to be pushed
+typedef struct OutboxEntry {
+    int id;                         // Entry id, assigned by AddOutboxEntry()
+    char repositoryUrl[256];        // Target repository
+    char postsPath[256];            // Posts folder in repository
+    char assetsPath[256];           // Assets folder in repository (empty if not used)
+    char postPath[256];             // Staged post folder, assigned by AddOutboxEntry()
+    char attachmentPath[256];       // Staged attachment file (empty if not used), assigned by AddOutboxEntry()
+} OutboxEntry;
+
+// Drain function, called with pending entries of one repository, returns true if all were pushed
+typedef bool (*OutboxDrainFunc)(const OutboxEntry *entries, int count, void *userData);
+
+// Outbox, opaque type
+typedef struct Outbox Outbox;
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+Outbox *LoadOutbox(const char *path);                   // Load outbox, pending entries are recovered from journal
+void UnloadOutbox(Outbox *outbox);                      // Unload outbox, background drainer is stopped (pending entries are kept)
+int AddOutboxEntry(Outbox *outbox, OutboxEntry *entry, const char *postPath, const char *attachmentFileName); // Stage post folder (moved) and attachment (copied), returns entry id (-1 on error)
+int DrainOutbox(Outbox *outbox, OutboxDrainFunc func, void *userData); // Drain pending entries, returns number of entries still pending
+void StartOutboxDrainer(Outbox *outbox, OutboxDrainFunc func, void *userData, int retryDelay); // Start background drainer thread
+int GetOutboxPendingCount(Outbox *outbox);              // Get number of pending entries
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // OUTBOX_H
+
+/***********************************************************************************
+*
+*   OUTBOX IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(OUTBOX_IMPLEMENTATION)
+
+#include "raylib.h"         // Required for: MakeDirectory(), DirectoryExists(), LoadDirectoryFiles(), IsPathFile()
+
+#include <stdio.h>          // Required for: FILE, fopen(), fprintf(), rename(), remove()
+#include <stdlib.h>         // Required for: calloc(), realloc(), free(), atoi()
+#include <string.h>         // Required for: strcmp(), strchr(), strpbrk(), memcpy(), memmove()
+#include <time.h>           // Required for: time()
+
+#if defined(_WIN32)
+    #include <direct.h>     // Required for: _rmdir()
+    #include <io.h>         // Required for: _commit(), _fileno()
+    #define rmdir _rmdir
+#else
+    #include <unistd.h>     // Required for: rmdir(), fsync(), fileno()
+#endif
+
+#if !defined(OUTBOX_NO_THREADS)
+    #include <pthread.h>    // Required for: pthread_create(), pthread_join(), pthread_mutex_*(), pthread_cond_*()
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+struct Outbox {
+    char path[256];                 // Outbox folder
+    char journalFileName[256];      // Journal file
+    OutboxEntry *entries;           // Pending entries, in journal order
+    int count;
+    int capacity;
+    int nextId;
+
+    time_t lastAddTime;             // Time of last added entry (coalescing)
+#if !defined(OUTBOX_NO_THREADS)
+    pthread_mutex_t mutex;          // Protects entries and journal
+    pthread_mutex_t drainMutex;     // Serializes drains
+    pthread_cond_t changed;         // Signaled when an entry is added or outbox is unloaded
+    pthread_t thread;               // Background drainer
+    bool threadRunning;
+#endif
+    OutboxDrainFunc drainFunc;      // Background drain function
+    void *drainData;
+    int retryDelay;                 // Background drain retry delay after failure (seconds)
+    bool quit;
+};
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+static void LockOutbox(Outbox *outbox)
+{
+#if !defined(OUTBOX_NO_THREADS)
+    pthread_mutex_lock(&outbox->mutex);
+#endif
+}
+
+static void UnlockOutbox(Outbox *outbox)
+{
+#if !defined(OUTBOX_NO_THREADS)
+    pthread_mutex_unlock(&outbox->mutex);
+#endif
+}
+
+// Set entry staged paths from entry id, false if paths do not fit entry (outbox path too long)
+static bool SetOutboxEntryPaths(Outbox *outbox, OutboxEntry *entry, bool hasAttachment)
+{
+    entry->attachmentPath[0] = '\0';
+
+    int length = snprintf(entry->postPath, sizeof(entry->postPath), "%s/%i/post", outbox->path, entry->id);
+    if ((length < 0) || (length >= (int)sizeof(entry->postPath))) return false;
+
+    if (hasAttachment)
+    {
+        length = snprintf(entry->attachmentPath, sizeof(entry->attachmentPath), "%s/%i/attachment", outbox->path, entry->id);
+        if ((length < 0) || (length >= (int)sizeof(entry->attachmentPath))) return false;
+    }
+
+    return true;
+}
+
+// Append pending entry to outbox list
+static bool PushOutboxEntry(Outbox *outbox, const OutboxEntry *entry)
+{
+    if (outbox->count >= outbox->capacity)
+    {
+        int capacity = (outbox->capacity > 0)? outbox->capacity*2 : 16;
+        OutboxEntry *entries = (OutboxEntry *)realloc(outbox->entries, capacity*sizeof(OutboxEntry));
+        if (entries == NULL) return false;
+
+        outbox->entries = entries;
+        outbox->capacity = capacity;
+    }
+
+    outbox->entries[outbox->count++] = *entry;
+
+    return true;
+}
+
+// Remove pending entry from outbox list, entries order is kept
+static void PopOutboxEntry(Outbox *outbox, int id)
+{
+    for (int i = 0; i < outbox->count; i++)
+    {
+        if (outbox->entries[i].id != id) continue;
+
+        memmove(&outbox->entries[i], &outbox->entries[i + 1], (outbox->count - i - 1)*sizeof(OutboxEntry));
+        outbox->count--;
+        break;
+    }
+}
+
+// Append record to journal, flushed to disk before returning
+static bool WriteOutboxJournal(Outbox *outbox, const char *record)
+{
+    FILE *journal = fopen(outbox->journalFileName, "ab");
+    if (journal == NULL) return false;
+
+    bool success = (fputs(record, journal) >= 0) && (fflush(journal) == 0);
+#if defined(_WIN32)
+    if (success) success = (_commit(_fileno(journal)) == 0);
+#else
+    if (success) success = (fsync(fileno(journal)) == 0);
+#endif
+
+    return (fclose(journal) == 0) && success;
+}
+
+// Load pending entries from journal
+static void ReadOutboxJournal(Outbox *outbox)
+{
+    FILE *journal = fopen(outbox->journalFileName, "rb");
+    if (journal == NULL) return;
+
+    char line[1024] = { 0 };
+
+    while (fgets(line, sizeof(line), journal) != NULL)
+    {
+        // Incomplete record (interrupted write) is ignored
+        char *end = strchr(line, '\n');
+        if (end == NULL) break;
+        *end = '\0';
+
+        char *fields[6] = { 0 };
+        int fieldCount = 0;
+        for (char *ptr = line; (ptr != NULL) && (fieldCount < 6); fieldCount++)
+        {
+            fields[fieldCount] = ptr;
+            ptr = strchr(ptr, '\t');
+            if (ptr != NULL) *ptr++ = '\0';
+        }
+
+        if ((fieldCount == 6) && (strcmp(fields[0], "ADD") == 0))
+        {
+            OutboxEntry entry = { 0 };
+            entry.id = atoi(fields[1]);
+            snprintf(entry.repositoryUrl, sizeof(entry.repositoryUrl), "%s", fields[3]);
+            snprintf(entry.postsPath, sizeof(entry.postsPath), "%s", fields[4]);
+            snprintf(entry.assetsPath, sizeof(entry.assetsPath), "%s", fields[5]);
+            bool pathsFit = SetOutboxEntryPaths(outbox, &entry, (atoi(fields[2]) != 0));
+
+            if (!pathsFit) fprintf(stderr, "WARNING: Outbox entry %i staged paths too long, skipped\n", entry.id);
+            else if (DirectoryExists(entry.postPath)) PushOutboxEntry(outbox, &entry);
+            else fprintf(stderr, "WARNING: Outbox entry %i staged post not found, skipped\n", entry.id);
+
+            if (entry.id >= outbox->nextId) outbox->nextId = entry.id + 1;
+        }
+        else if ((fieldCount == 2) && (strcmp(fields[0], "DONE") == 0)) PopOutboxEntry(outbox, atoi(fields[1]));
+    }
+
+    fclose(journal);
+}
+
+// Copy file, data is streamed in blocks
+static bool CopyOutboxFile(const char *srcFileName, const char *dstFileName)
+{
+    FILE *src = fopen(srcFileName, "rb");
+    if (src == NULL) return false;
+
+    FILE *dst = fopen(dstFileName, "wb");
+    if (dst == NULL)
+    {
+        fclose(src);
+        return false;
+    }
+
+    unsigned char buffer[16*1024];
+    size_t size = 0;
+    bool success = true;
+    while (success && ((size = fread(buffer, 1, sizeof(buffer), src)) > 0)) success = (fwrite(buffer, 1, size, dst) == size);
+
+    success = success && !ferror(src);
+    fclose(src);
+
+    return (fclose(dst) == 0) && success;
+}
+
+// Remove folder and all its content
+static void RemoveOutboxFolder(const char *path)
+{
+    FilePathList files = LoadDirectoryFiles(path);
+
+    for (unsigned int i = 0; i < files.count; i++)
+    {
+        if (IsPathFile(files.paths[i])) remove(files.paths[i]);
+        else RemoveOutboxFolder(files.paths[i]);
+    }
+
+    UnloadDirectoryFiles(files);
+    rmdir(path);
+}
+
+#if !defined(OUTBOX_NO_THREADS)
+// Background drainer thread loop
+static void *OutboxDrainerThread(void *arg)
+{
+    Outbox *outbox = (Outbox *)arg;
+    int retryDelay = 0;             // Current retry delay after failed drains
+    time_t retryTime = 0;
+
+    pthread_mutex_lock(&outbox->mutex);
+
+    while (!outbox->quit)
+    {
+        time_t now = time(NULL);
+
+        if ((outbox->count > 0) && ((now - outbox->lastAddTime) >= OUTBOX_COALESCE_DELAY) && (now >= retryTime))
+        {
+            pthread_mutex_unlock(&outbox->mutex);
+            int pendingCount = DrainOutbox(outbox, outbox->drainFunc, outbox->drainData);
+            pthread_mutex_lock(&outbox->mutex);
+
+            if (pendingCount > 0)
+            {
+                retryDelay = (retryDelay == 0)? outbox->retryDelay : retryDelay*2;
+                if (retryDelay > OUTBOX_MAX_RETRY_DELAY) retryDelay = OUTBOX_MAX_RETRY_DELAY;
+                retryTime = time(NULL) + retryDelay;
+            }
+            else retryDelay = 0;
+
+            continue;
+        }
+
+        // Wake up once per second to check coalescing and retry delays, or when an entry is added
+        struct timespec wakeTime = { now + 1, 0 };
+        pthread_cond_timedwait(&outbox->changed, &outbox->mutex, &wakeTime);
+
+        // New entries are retried without waiting previous failure delay
+        if (outbox->lastAddTime > (retryTime - retryDelay)) retryTime = 0;
+    }
+
+    pthread_mutex_unlock(&outbox->mutex);
+
+    return NULL;
+}
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Load outbox, pending entries are recovered from journal
+Outbox *LoadOutbox(const char *path)
+{
+    Outbox *outbox = (Outbox *)calloc(1, sizeof(Outbox));
+    if (outbox == NULL) return NULL;
+
+    snprintf(outbox->path, sizeof(outbox->path), "%s", path);
+    snprintf(outbox->journalFileName, sizeof(outbox->journalFileName), "%s/journal.log", path);
+    outbox->nextId = 1;
+
+#if !defined(OUTBOX_NO_THREADS)
+    pthread_mutex_init(&outbox->mutex, NULL);
+    pthread_mutex_init(&outbox->drainMutex, NULL);
+    pthread_cond_init(&outbox->changed, NULL);
+#endif
+
+    ReadOutboxJournal(outbox);
+
+    return outbox;
+}
+
+// Unload outbox, background drainer is stopped, a drain in progress is completed
+// NOTE: Pending entries are kept in journal, to be drained on next load
+void UnloadOutbox(Outbox *outbox)
+{
+    if (outbox == NULL) return;
+
+#if !defined(OUTBOX_NO_THREADS)
+    pthread_mutex_lock(&outbox->mutex);
+    outbox->quit = true;
+    pthread_cond_broadcast(&outbox->changed);
+    pthread_mutex_unlock(&outbox->mutex);
+
+    if (outbox->threadRunning) pthread_join(outbox->thread, NULL);
+
+    pthread_cond_destroy(&outbox->changed);
+    pthread_mutex_destroy(&outbox->drainMutex);
+    pthread_mutex_destroy(&outbox->mutex);
+#endif
+
+    free(outbox->entries);
+    free(outbox);
+}
+
+// Stage post folder (moved into outbox) and attachment file (copied), then journal entry
+// NOTE: Entry id and staged paths are assigned, entry is pending once function returns
+int AddOutboxEntry(Outbox *outbox, OutboxEntry *entry, const char *postPath, const char *attachmentFileName)
+{
+    // Fields are journaled tab separated, one record per line
+    if ((strpbrk(entry->repositoryUrl, "\t\n") != NULL) || (strpbrk(entry->postsPath, "\t\n") != NULL) ||
+        (strpbrk(entry->assetsPath, "\t\n") != NULL)) return -1;
+
+    LockOutbox(outbox);
+    entry->id = outbox->nextId++;
+    UnlockOutbox(outbox);
+
+    if (!SetOutboxEntryPaths(outbox, entry, (attachmentFileName != NULL)))
+    {
+        fprintf(stderr, "ERROR: Outbox path too long to stage post: %s\n", outbox->path);
+        return -1;
+    }
+
+    char stagePath[256 + 16] = { 0 };   // Outbox path, separator and entry id
+    snprintf(stagePath, sizeof(stagePath), "%s/%i", outbox->path, entry->id);
+
+    // Ids restart once journal is compacted, a folder left with same id (not removed after done) is stale
+    if (DirectoryExists(stagePath)) RemoveOutboxFolder(stagePath);
+    MakeDirectory(stagePath);
+
+    if ((rename(postPath, entry->postPath) != 0) ||
+        ((attachmentFileName != NULL) && !CopyOutboxFile(attachmentFileName, entry->attachmentPath)))
+    {
+        fprintf(stderr, "ERROR: Post could not be staged into outbox: %s\n", stagePath);
+        rename(entry->postPath, postPath);
+        RemoveOutboxFolder(stagePath);
+        return -1;
+    }
+
+    char record[1024] = { 0 };
+    snprintf(record, sizeof(record), "ADD\t%i\t%i\t%s\t%s\t%s\n", entry->id, (attachmentFileName != NULL)? 1 : 0,
+        entry->repositoryUrl, entry->postsPath, entry->assetsPath);
+
+    LockOutbox(outbox);
+    bool success = WriteOutboxJournal(outbox, record) && PushOutboxEntry(outbox, entry);
+    if (success)
+    {
+        outbox->lastAddTime = time(NULL);
+#if !defined(OUTBOX_NO_THREADS)
+        pthread_cond_broadcast(&outbox->changed);
+#endif
+    }
+    UnlockOutbox(outbox);
+
+    if (!success)
+    {
+        fprintf(stderr, "ERROR: Outbox journal could not be written: %s\n", outbox->journalFileName);
+        rename(entry->postPath, postPath);
+        RemoveOutboxFolder(stagePath);
+        return -1;
+    }
+
+    return entry->id;
+}
+
+// Drain pending entries, drain function is called once per repository with all its entries
+// NOTE: Entries added while draining are left for next drain
+int DrainOutbox(Outbox *outbox, OutboxDrainFunc func, void *userData)
+{
+#if !defined(OUTBOX_NO_THREADS)
+    pthread_mutex_lock(&outbox->drainMutex);
+#endif
+
+    LockOutbox(outbox);
+    int count = outbox->count;
+    OutboxEntry *entries = (count > 0)? (OutboxEntry *)malloc(count*sizeof(OutboxEntry)) : NULL;
+    if (entries != NULL) memcpy(entries, outbox->entries, count*sizeof(OutboxEntry));
+    else count = 0;
+    UnlockOutbox(outbox);
+
+    // Entries are grouped by repository, keeping journal order inside every group
+    OutboxEntry *group = (count > 0)? (OutboxEntry *)malloc(count*sizeof(OutboxEntry)) : NULL;
+    bool *grouped = (count > 0)? (bool *)calloc(count, sizeof(bool)) : NULL;
+
+    for (int i = 0; (group != NULL) && (grouped != NULL) && (i < count); i++)
+    {
+        if (grouped[i]) continue;
+
+        int groupCount = 0;
+        for (int j = i; j < count; j++)
+        {
+            if (grouped[j] || (strcmp(entries[j].repositoryUrl, entries[i].repositoryUrl) != 0)) continue;
+
+            group[groupCount++] = entries[j];
+            grouped[j] = true;
+        }
+
+        if (!func(group, groupCount, userData)) continue;
+
+        LockOutbox(outbox);
+        for (int j = 0; j < groupCount; j++)
+        {
+            char record[64] = { 0 };
+            snprintf(record, sizeof(record), "DONE\t%i\n", group[j].id);
+            WriteOutboxJournal(outbox, record);
+            PopOutboxEntry(outbox, group[j].id);
+
+            char stagePath[256 + 16] = { 0 };   // Outbox path, separator and entry id
+            snprintf(stagePath, sizeof(stagePath), "%s/%i", outbox->path, group[j].id);
+            RemoveOutboxFolder(stagePath);
+        }
+        UnlockOutbox(outbox);
+    }
+
+    free(grouped);
+    free(group);
+    free(entries);
+
+    // Journal compaction: no pending entry, records are not needed anymore
+    LockOutbox(outbox);
+    int pendingCount = outbox->count;
+    if (pendingCount == 0) remove(outbox->journalFileName);
+    UnlockOutbox(outbox);
+
+#if !defined(OUTBOX_NO_THREADS)
+    pthread_mutex_unlock(&outbox->drainMutex);
+#endif
+
+    return pendingCount;
+}
+
+// Start background drainer thread, pending entries are drained once no entry is added
+// for OUTBOX_COALESCE_DELAY seconds, failed drains are retried (retryDelay doubled up to OUTBOX_MAX_RETRY_DELAY)
+void StartOutboxDrainer(Outbox *outbox, OutboxDrainFunc func, void *userData, int retryDelay)
+{
+#if !defined(OUTBOX_NO_THREADS)
+    if ((outbox == NULL) || outbox->threadRunning) return;
+
+    outbox->drainFunc = func;
+    outbox->drainData = userData;
+    outbox->retryDelay = (retryDelay > 0)? retryDelay : 1;
+    outbox->threadRunning = (pthread_create(&outbox->thread, NULL, OutboxDrainerThread, outbox) == 0);
+#endif
+}
+
+// Get number of pending entries
+int GetOutboxPendingCount(Outbox *outbox)
+{
+    if (outbox == NULL) return 0;
+
+    LockOutbox(outbox);
+    int count = outbox->count;
+    UnlockOutbox(outbox);
+
+    return count;
+}
+
+#endif // OUTBOX_IMPLEMENTATION
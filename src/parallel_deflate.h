@@ -0,0 +1,202 @@
+/*******************************************************************************************
+*
+*   Parallel Deflate - Chunked multi-threaded deflate compression (pigz-style) over miniz
+*
+*   MODULE USAGE:
+*       #define PARALLEL_DEFLATE_IMPLEMENTATION
+*       #include "parallel_deflate.h"
+*
+*       size_t compSize = 0;
+*       void *compData = CompressDataParallel(data, dataSize, &compSize, 6, pool);   // Free with mz_free()
+*
+*   NOTES:
+*       Input is split in independent chunks (PARALLEL_DEFLATE_CHUNK_SIZE) compressed on worker pool.
+*       Every chunk is primed with the last 32KB of previous chunk as dictionary, so matches across
+*       chunks are kept, and ends with a sync flush (empty stored block) so chunk outputs are byte
+*       aligned; last chunk ends with final block. Concatenated chunks are a valid raw deflate
+*       stream, same format as tdefl_compress_mem_to_heap(), decompressed by any inflater.
+*
+*       tdefl has no preset dictionary support, so dictionary is compressed before chunk data
+*       (sync flushed) and its output is dropped; chunk blocks after it can reference the
+*       dictionary bytes, as they are the previous chunk data when decompressing
+*
+*   DEPENDENCIES:
+*       miniz           - tdefl compressor
+*       worker_pool.h   - Parallel chunks compression
+*
+*   LICENSE: GPLv3, check LICENSE file for details
+*
+**********************************************************************************************/
+
+#ifndef PARALLEL_DEFLATE_H
+#define PARALLEL_DEFLATE_H
+
+#include "worker_pool.h"
+
+#include <stddef.h>         // Required for: size_t
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define PARALLEL_DEFLATE_CHUNK_SIZE     (256*1024)  // Input chunk size compressed by a job (dictionary priming overhead: DICT_SIZE/CHUNK_SIZE)
+#define PARALLEL_DEFLATE_DICT_SIZE      (32*1024)   // Dictionary size (deflate window) primed from previous chunk
+#define PARALLEL_DEFLATE_MIN_SIZE       (4*PARALLEL_DEFLATE_CHUNK_SIZE) // Minimum data size worth parallel compression
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+void *CompressDataParallel(const void *data, size_t dataSize, size_t *compDataSize, int level, WorkerPool *pool); // Compress data as raw deflate stream, free with mz_free()
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PARALLEL_DEFLATE_H
+
+/***********************************************************************************
+*
+*   PARALLEL_DEFLATE IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(PARALLEL_DEFLATE_IMPLEMENTATION)
+
+#include "external/miniz.h"
+
+#include <stdlib.h>         // Required for: malloc(), realloc(), free()
+#include <string.h>         // Required for: memcpy()
+#include <stdbool.h>        // Required for: bool
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Deflate chunk output
+typedef struct DeflateChunk {
+    unsigned char *data;            // Compressed data (including dropped dictionary output)
+    size_t size;
+    size_t capacity;
+    size_t offset;                  // Chunk output start, after dictionary output
+    bool failed;
+} DeflateChunk;
+
+// Deflate jobs data, shared by all chunks
+typedef struct DeflateJobs {
+    const unsigned char *data;
+    size_t dataSize;
+    int chunkCount;
+    mz_uint flags;                  // tdefl compression flags
+    DeflateChunk *chunks;
+} DeflateJobs;
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+// tdefl output callback, appends compressed data to chunk
+static mz_bool PutDeflateChunkData(const void *buffer, int length, void *user)
+{
+    DeflateChunk *chunk = (DeflateChunk *)user;
+
+    if ((chunk->size + length) > chunk->capacity)
+    {
+        size_t capacity = (chunk->capacity > 0)? chunk->capacity*2 : PARALLEL_DEFLATE_CHUNK_SIZE/2;
+        while (capacity < (chunk->size + length)) capacity *= 2;
+
+        unsigned char *data = (unsigned char *)realloc(chunk->data, capacity);
+        if (data == NULL) return MZ_FALSE;
+
+        chunk->data = data;
+        chunk->capacity = capacity;
+    }
+
+    memcpy(chunk->data + chunk->size, buffer, length);
+    chunk->size += length;
+
+    return MZ_TRUE;
+}
+
+// Worker job: Compress one chunk, primed with previous chunk data
+static void CompressDeflateChunk(void *data, int index)
+{
+    DeflateJobs *jobs = (DeflateJobs *)data;
+    DeflateChunk *chunk = &jobs->chunks[index];
+
+    size_t start = (size_t)index*PARALLEL_DEFLATE_CHUNK_SIZE;
+    size_t size = ((jobs->dataSize - start) < PARALLEL_DEFLATE_CHUNK_SIZE)? (jobs->dataSize - start) : PARALLEL_DEFLATE_CHUNK_SIZE;
+    bool lastChunk = (index == (jobs->chunkCount - 1));
+
+    tdefl_compressor *compressor = (tdefl_compressor *)malloc(sizeof(tdefl_compressor));
+    if ((compressor == NULL) || (tdefl_init(compressor, PutDeflateChunkData, chunk, jobs->flags) != TDEFL_STATUS_OKAY))
+    {
+        free(compressor);
+        chunk->failed = true;
+        return;
+    }
+
+    tdefl_status status = TDEFL_STATUS_OKAY;
+
+    if (index > 0)
+    {
+        size_t dictSize = (start < PARALLEL_DEFLATE_DICT_SIZE)? start : PARALLEL_DEFLATE_DICT_SIZE;
+        status = tdefl_compress_buffer(compressor, jobs->data + start - dictSize, dictSize, TDEFL_SYNC_FLUSH);
+        chunk->offset = chunk->size;
+    }
+
+    if (status == TDEFL_STATUS_OKAY) status = tdefl_compress_buffer(compressor, jobs->data + start, size, lastChunk? TDEFL_FINISH : TDEFL_SYNC_FLUSH);
+
+    chunk->failed = (status != (lastChunk? TDEFL_STATUS_DONE : TDEFL_STATUS_OKAY));
+
+    free(compressor);
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Compress data as raw deflate stream, chunks are compressed in parallel
+// NOTE: Without worker threads, data is compressed as a single stream (no chunks overhead)
+void *CompressDataParallel(const void *data, size_t dataSize, size_t *compDataSize, int level, WorkerPool *pool)
+{
+    *compDataSize = 0;
+
+    if (GetWorkerPoolThreadCount(pool) <= 1) return tdefl_compress_mem_to_heap(data, dataSize, compDataSize,
+        tdefl_create_comp_flags_from_zip_params(level, -MZ_DEFAULT_WINDOW_BITS, MZ_DEFAULT_STRATEGY));
+
+    DeflateJobs jobs = { 0 };
+    jobs.data = (const unsigned char *)data;
+    jobs.dataSize = dataSize;
+    jobs.chunkCount = (dataSize > 0)? (int)((dataSize + PARALLEL_DEFLATE_CHUNK_SIZE - 1)/PARALLEL_DEFLATE_CHUNK_SIZE) : 1;
+    jobs.flags = tdefl_create_comp_flags_from_zip_params(level, -MZ_DEFAULT_WINDOW_BITS, MZ_DEFAULT_STRATEGY);
+    jobs.chunks = (DeflateChunk *)calloc(jobs.chunkCount, sizeof(DeflateChunk));
+    if (jobs.chunks == NULL) return NULL;
+
+    RunWorkerPoolJobs(pool, CompressDeflateChunk, &jobs, jobs.chunkCount);
+
+    size_t size = 0;
+    bool failed = false;
+    for (int i = 0; i < jobs.chunkCount; i++)
+    {
+        size += jobs.chunks[i].size - jobs.chunks[i].offset;
+        if (jobs.chunks[i].failed) failed = true;
+    }
+
+    unsigned char *compData = failed? NULL : (unsigned char *)MZ_MALLOC((size > 0)? size : 1);
+
+    if (compData != NULL)
+    {
+        for (int i = 0; i < jobs.chunkCount; i++)
+        {
+            memcpy(compData + *compDataSize, jobs.chunks[i].data + jobs.chunks[i].offset, jobs.chunks[i].size - jobs.chunks[i].offset);
+            *compDataSize += jobs.chunks[i].size - jobs.chunks[i].offset;
+        }
+    }
+
+    for (int i = 0; i < jobs.chunkCount; i++) free(jobs.chunks[i].data);
+    free(jobs.chunks);
+
+    return compData;
+}
+
+#endif // PARALLEL_DEFLATE_IMPLEMENTATION
@@ -0,0 +1,458 @@
+/*******************************************************************************************
+*
+*   PNG Optimizer - Lossless PNG recompression, filter strategies tried in parallel
+*
+*   MODULE USAGE:
+*       #define PNG_OPTIMIZER_IMPLEMENTATION
+*       #include "png_optimizer.h"
+*
+*       int optimizedSize = 0;
+*       unsigned char *optimized = OptimizePngData(data, dataSize, &optimizedSize, NULL, pool);
+*       if (optimized != NULL) SaveFileData("banner.png", optimized, optimizedSize);  // Smaller
+*       free(optimized);
+*
+*   NOTES:
+*       Image data (IDAT) is inflated and unfiltered to raw scanlines, then filtered again with
+*       every strategy (fixed filters, per-row adaptive filter) and deflated at maximum miniz
+*       effort, one strategy per worker job; smallest result is kept, only if smaller than input
+*
+*       Pixels are never changed: same color type and bit depth (palette, 16-bit...), all other
+*       chunks are copied as they are. Only exception, 8-bit images with an alpha channel fully
+*       opaque are stored without it (RGBA to RGB, gray+alpha to gray), still lossless
+*
+*       Interlaced images are not supported (not optimized)
+*
+*   DEPENDENCIES:
+*       miniz           - Inflate (tinfl), deflate (tdefl), CRC32
+*       worker_pool.h   - Parallel strategies
+*
+*   LICENSE: GPLv3, check LICENSE file for details
+*
+**********************************************************************************************/
+
+#ifndef PNG_OPTIMIZER_H
+#define PNG_OPTIMIZER_H
+
+#include "worker_pool.h"
+
+#include <stdbool.h>        // Required for: bool
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define PNG_OPTIMIZER_STRATEGY_COUNT    7                   // Filter strategies tried, see GetPngStrategyName()
+#define PNG_OPTIMIZER_MAX_DATA_SIZE     (256*1024*1024)     // Max raw image data size (larger images are not optimized)
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+unsigned char *OptimizePngData(const unsigned char *data, int dataSize, int *optimizedSize, int *strategy, WorkerPool *pool); // Recompress PNG losslessly, NULL if not smaller, free with free()
+bool IsPngData(const unsigned char *data, int dataSize);   // Check PNG signature
+const char *GetPngStrategyName(int strategy);               // Get filter strategy name
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PNG_OPTIMIZER_H
+
+/***********************************************************************************
+*
+*   PNG_OPTIMIZER IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(PNG_OPTIMIZER_IMPLEMENTATION)
+
+#include "external/miniz.h"
+
+#include <stdlib.h>         // Required for: malloc(), calloc(), free(), abs()
+#include <string.h>         // Required for: memcpy(), memcmp(), memset()
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// PNG image: raw (unfiltered) scanlines and chunks of input data
+typedef struct PngImage {
+    const unsigned char *data;      // Input PNG data
+    int dataSize;
+
+    unsigned int width;
+    unsigned int height;
+    int bitDepth;
+    int colorType;
+    int channels;
+
+    unsigned char *pixels;          // Raw scanlines, without filter bytes
+    size_t rowSize;                 // Bytes per scanline
+    int pixelSize;                  // Bytes per complete pixel (at least 1), filters distance
+} PngImage;
+
+// Strategy job output
+typedef struct PngStrategyResult {
+    unsigned char *idat;            // zlib stream (tdefl allocated)
+    size_t idatSize;
+} PngStrategyResult;
+
+// Strategies batch, one job per strategy
+typedef struct PngStrategyBatch {
+    const PngImage *image;
+    PngStrategyResult results[PNG_OPTIMIZER_STRATEGY_COUNT];
+} PngStrategyBatch;
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+static unsigned int ReadPngUInt(const unsigned char *bytes)
+{
+    return ((unsigned int)bytes[0] << 24) | ((unsigned int)bytes[1] << 16) | ((unsigned int)bytes[2] << 8) | bytes[3];
+}
+
+static void WritePngUInt(unsigned char *bytes, unsigned int value)
+{
+    bytes[0] = (unsigned char)(value >> 24);
+    bytes[1] = (unsigned char)(value >> 16);
+    bytes[2] = (unsigned char)(value >> 8);
+    bytes[3] = (unsigned char)value;
+}
+
+// Write chunk: length, type, data and CRC (of type and data), returns bytes written
+static size_t WritePngChunk(unsigned char *output, const char *type, const unsigned char *data, size_t size)
+{
+    WritePngUInt(output, (unsigned int)size);
+    memcpy(output + 4, type, 4);
+    if (size > 0) memcpy(output + 8, data, size);
+    WritePngUInt(output + 8 + size, (unsigned int)mz_crc32(MZ_CRC32_INIT, output + 4, size + 4));
+
+    return size + 12;
+}
+
+static int PaethPredictor(int a, int b, int c)
+{
+    int p = a + b - c;
+    int pa = abs(p - a);
+    int pb = abs(p - b);
+    int pc = abs(p - c);
+
+    if ((pa <= pb) && (pa <= pc)) return a;
+    return (pb <= pc)? b : c;
+}
+
+// Filter scanline (PNG filter types 0..4), previous row is NULL for first row
+static void FilterPngRow(int filter, const unsigned char *row, const unsigned char *prev, size_t size, int pixelSize, unsigned char *output)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        int a = (i >= (size_t)pixelSize)? row[i - pixelSize] : 0;
+        int b = (prev != NULL)? prev[i] : 0;
+        int c = ((prev != NULL) && (i >= (size_t)pixelSize))? prev[i - pixelSize] : 0;
+
+        switch (filter)
+        {
+            case 1: output[i] = (unsigned char)(row[i] - a); break;
+            case 2: output[i] = (unsigned char)(row[i] - b); break;
+            case 3: output[i] = (unsigned char)(row[i] - ((a + b) >> 1)); break;
+            case 4: output[i] = (unsigned char)(row[i] - PaethPredictor(a, b, c)); break;
+            default: output[i] = row[i]; break;
+        }
+    }
+}
+
+// Unfilter scanline in place, previous row (already unfiltered) is NULL for first row
+static bool UnfilterPngRow(int filter, unsigned char *row, const unsigned char *prev, size_t size, int pixelSize)
+{
+    if (filter > 4) return false;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        int a = (i >= (size_t)pixelSize)? row[i - pixelSize] : 0;
+        int b = (prev != NULL)? prev[i] : 0;
+        int c = ((prev != NULL) && (i >= (size_t)pixelSize))? prev[i - pixelSize] : 0;
+
+        switch (filter)
+        {
+            case 1: row[i] = (unsigned char)(row[i] + a); break;
+            case 2: row[i] = (unsigned char)(row[i] + b); break;
+            case 3: row[i] = (unsigned char)(row[i] + ((a + b) >> 1)); break;
+            case 4: row[i] = (unsigned char)(row[i] + PaethPredictor(a, b, c)); break;
+            default: break;
+        }
+    }
+
+    return true;
+}
+
+// Load raw scanlines of PNG: IHDR parsed, IDAT chunks inflated and unfiltered
+static bool LoadPngImage(PngImage *image, const unsigned char *data, int dataSize)
+{
+    *image = (PngImage){ 0 };
+    image->data = data;
+    image->dataSize = dataSize;
+
+    if (!IsPngData(data, dataSize) || (dataSize < 33) || (memcmp(data + 12, "IHDR", 4) != 0) || (ReadPngUInt(data + 8) != 13)) return false;
+
+    const unsigned char *header = data + 16;
+    image->width = ReadPngUInt(header);
+    image->height = ReadPngUInt(header + 4);
+    image->bitDepth = header[8];
+    image->colorType = header[9];
+    if ((header[10] != 0) || (header[11] != 0) || (header[12] != 0)) return false;   // Interlaced (or unknown methods)
+
+    switch (image->colorType)
+    {
+        case 0: image->channels = 1; break;     // Gray
+        case 2: image->channels = 3; break;     // RGB
+        case 3: image->channels = 1; break;     // Palette
+        case 4: image->channels = 2; break;     // Gray + alpha
+        case 6: image->channels = 4; break;     // RGBA
+        default: return false;
+    }
+
+    if ((image->width == 0) || (image->height == 0) || (image->width > 0x7fffffff) || (image->height > 0x7fffffff)) return false;
+
+    unsigned long long rowBits = (unsigned long long)image->width*image->channels*image->bitDepth;
+    image->rowSize = (size_t)((rowBits + 7)/8);
+    image->pixelSize = (image->channels*image->bitDepth + 7)/8;
+
+    unsigned long long filteredSize = (unsigned long long)(image->rowSize + 1)*image->height;
+    if (filteredSize > PNG_OPTIMIZER_MAX_DATA_SIZE) return false;
+
+    // Image data of all IDAT chunks, concatenated
+    size_t idatSize = 0;
+    for (int offset = 8; (offset + 12) <= dataSize; )
+    {
+        unsigned int length = ReadPngUInt(data + offset);
+        if (length > (unsigned int)(dataSize - offset - 12)) return false;
+        if (memcmp(data + offset + 4, "IDAT", 4) == 0) idatSize += length;
+        if (memcmp(data + offset + 4, "IEND", 4) == 0) break;
+        offset += length + 12;
+    }
+
+    unsigned char *idat = (unsigned char *)malloc(idatSize + 1);
+    unsigned char *filtered = (unsigned char *)malloc((size_t)filteredSize);
+    bool success = (idat != NULL) && (filtered != NULL) && (idatSize > 0);
+
+    if (success)
+    {
+        idatSize = 0;
+        for (int offset = 8; (offset + 12) <= dataSize; )
+        {
+            unsigned int length = ReadPngUInt(data + offset);
+            if (memcmp(data + offset + 4, "IDAT", 4) == 0) { memcpy(idat + idatSize, data + offset + 8, length); idatSize += length; }
+            if (memcmp(data + offset + 4, "IEND", 4) == 0) break;
+            offset += length + 12;
+        }
+
+        size_t size = tinfl_decompress_mem_to_mem(filtered, (size_t)filteredSize, idat, idatSize, TINFL_FLAG_PARSE_ZLIB_HEADER);
+        success = (size == (size_t)filteredSize);
+    }
+
+    if (success)
+    {
+        image->pixels = (unsigned char *)malloc(image->rowSize*image->height);
+        success = (image->pixels != NULL);
+
+        for (unsigned int y = 0; success && (y < image->height); y++)
+        {
+            unsigned char *row = image->pixels + y*image->rowSize;
+            memcpy(row, filtered + y*(image->rowSize + 1) + 1, image->rowSize);
+            success = UnfilterPngRow(filtered[y*(image->rowSize + 1)], row, (y > 0)? row - image->rowSize : NULL, image->rowSize, image->pixelSize);
+        }
+    }
+
+    free(filtered);
+    free(idat);
+
+    if (!success) { free(image->pixels); image->pixels = NULL; }
+
+    return success;
+}
+
+// Check if PNG has a chunk of type
+static bool HasPngChunk(const PngImage *image, const char *type)
+{
+    for (int offset = 8; (offset + 12) <= image->dataSize; offset += ReadPngUInt(image->data + offset) + 12)
+    {
+        if (memcmp(image->data + offset + 4, type, 4) == 0) return true;
+        if (memcmp(image->data + offset + 4, "IEND", 4) == 0) break;
+    }
+
+    return false;
+}
+
+// Remove alpha channel of 8-bit image if fully opaque (RGBA to RGB, gray+alpha to gray)
+// NOTE: Not done if image has significant bits chunk (sBIT), its size depends on color type
+static void ReducePngAlpha(PngImage *image)
+{
+    if ((image->bitDepth != 8) || ((image->colorType != 4) && (image->colorType != 6)) || HasPngChunk(image, "sBIT")) return;
+
+    int channels = image->channels;
+    size_t pixelCount = (size_t)image->width*image->height;
+    for (size_t i = 0; i < pixelCount; i++) if (image->pixels[i*channels + channels - 1] != 255) return;
+
+    // Alpha dropped in place, rows stay contiguous
+    for (size_t i = 0; i < pixelCount; i++) memmove(image->pixels + i*(channels - 1), image->pixels + i*channels, channels - 1);
+
+    image->colorType = (image->colorType == 6)? 2 : 0;
+    image->channels = channels - 1;
+    image->pixelSize = channels - 1;
+    image->rowSize = (size_t)image->width*image->channels;
+}
+
+// Filter image with strategy and deflate it (job function, one job per strategy)
+static void RunPngStrategy(void *data, int strategy)
+{
+    PngStrategyBatch *batch = (PngStrategyBatch *)data;
+    const PngImage *image = batch->image;
+    size_t rowSize = image->rowSize;
+
+    unsigned char *filtered = (unsigned char *)malloc((rowSize + 1)*image->height);
+    unsigned char *candidate = (unsigned char *)malloc(rowSize);
+    if ((filtered == NULL) || (candidate == NULL)) { free(filtered); free(candidate); return; }
+
+    for (unsigned int y = 0; y < image->height; y++)
+    {
+        const unsigned char *row = image->pixels + y*rowSize;
+        const unsigned char *prev = (y > 0)? row - rowSize : NULL;
+        unsigned char *output = filtered + y*(rowSize + 1);
+
+        if (strategy < 5)
+        {
+            output[0] = (unsigned char)strategy;
+            FilterPngRow(strategy, row, prev, rowSize, image->pixelSize, output + 1);
+        }
+        else
+        {
+            // Adaptive: filter with minimum sum of absolute values (bytes as signed) for every row
+            unsigned long bestSum = ~0ul;
+            for (int filter = 0; filter < 5; filter++)
+            {
+                FilterPngRow(filter, row, prev, rowSize, image->pixelSize, candidate);
+
+                unsigned long sum = 0;
+                for (size_t i = 0; i < rowSize; i++) sum += (candidate[i] < 128)? candidate[i] : 256 - candidate[i];
+
+                if (sum < bestSum)
+                {
+                    bestSum = sum;
+                    output[0] = (unsigned char)filter;
+                    memcpy(output + 1, candidate, rowSize);
+                }
+            }
+        }
+    }
+
+    // Last strategy: adaptive filters, deflate favours literals (filtered matches, as zlib Z_FILTERED)
+    int flags = tdefl_create_comp_flags_from_zip_params(MZ_UBER_COMPRESSION, MZ_DEFAULT_WINDOW_BITS, (strategy == 6)? MZ_FILTERED : MZ_DEFAULT_STRATEGY);
+    batch->results[strategy].idat = (unsigned char *)tdefl_compress_mem_to_heap(filtered, (rowSize + 1)*image->height, &batch->results[strategy].idatSize, flags);
+
+    free(candidate);
+    free(filtered);
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Recompress PNG losslessly: all filter strategies are tried (in parallel on pool), smallest is kept
+// NOTE: Returns NULL if data is not a supported PNG or result is not smaller, strategy used is
+// returned in strategy (optional)
+unsigned char *OptimizePngData(const unsigned char *data, int dataSize, int *optimizedSize, int *strategy, WorkerPool *pool)
+{
+    *optimizedSize = 0;
+    if (strategy != NULL) *strategy = -1;
+
+    PngImage image = { 0 };
+    if (!LoadPngImage(&image, data, dataSize)) return NULL;
+
+    ReducePngAlpha(&image);
+
+    PngStrategyBatch batch = { 0 };
+    batch.image = &image;
+
+    if (pool != NULL) RunWorkerPoolJobs(pool, RunPngStrategy, &batch, PNG_OPTIMIZER_STRATEGY_COUNT);
+    else for (int i = 0; i < PNG_OPTIMIZER_STRATEGY_COUNT; i++) RunPngStrategy(&batch, i);
+
+    int best = -1;
+    for (int i = 0; i < PNG_OPTIMIZER_STRATEGY_COUNT; i++)
+    {
+        if ((batch.results[i].idat != NULL) && ((best < 0) || (batch.results[i].idatSize < batch.results[best].idatSize))) best = i;
+    }
+
+    unsigned char *output = NULL;
+    size_t outputSize = 0;
+
+    if (best >= 0)
+    {
+        // Chunks are copied in order, IDAT chunks are replaced by a single one (at first IDAT position)
+        output = (unsigned char *)malloc((size_t)dataSize + batch.results[best].idatSize + 12);
+
+        if (output != NULL)
+        {
+            memcpy(output, data, 8);
+            outputSize = 8;
+
+            bool idatWritten = false;
+            for (int offset = 8; (offset + 12) <= dataSize; )
+            {
+                unsigned int length = ReadPngUInt(data + offset);
+                const unsigned char *type = data + offset + 4;
+
+                if (memcmp(type, "IHDR", 4) == 0)
+                {
+                    unsigned char header[13] = { 0 };
+                    memcpy(header, data + offset + 8, 13);
+                    header[9] = (unsigned char)image.colorType;
+                    outputSize += WritePngChunk(output + outputSize, "IHDR", header, 13);
+                }
+                else if (memcmp(type, "IDAT", 4) == 0)
+                {
+                    if (!idatWritten) outputSize += WritePngChunk(output + outputSize, "IDAT", batch.results[best].idat, batch.results[best].idatSize);
+                    idatWritten = true;
+                }
+                else
+                {
+                    memcpy(output + outputSize, data + offset, length + 12);
+                    outputSize += length + 12;
+                }
+
+                if (memcmp(type, "IEND", 4) == 0) break;
+                offset += length + 12;
+            }
+
+            if (outputSize >= (size_t)dataSize) { free(output); output = NULL; }
+        }
+    }
+
+    for (int i = 0; i < PNG_OPTIMIZER_STRATEGY_COUNT; i++) mz_free(batch.results[i].idat);
+    free(image.pixels);
+
+    if (output != NULL)
+    {
+        *optimizedSize = (int)outputSize;
+        if (strategy != NULL) *strategy = best;
+    }
+
+    return output;
+}
+
+// Check PNG signature
+bool IsPngData(const unsigned char *data, int dataSize)
+{
+    static const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+
+    return (data != NULL) && (dataSize >= 8) && (memcmp(data, signature, 8) == 0);
+}
+
+// Get filter strategy name
+const char *GetPngStrategyName(int strategy)
+{
+    static const char *names[PNG_OPTIMIZER_STRATEGY_COUNT] = { "none", "sub", "up", "average", "paeth", "adaptive", "adaptive-filtered" };
+
+    return ((strategy >= 0) && (strategy < PNG_OPTIMIZER_STRATEGY_COUNT))? names[strategy] : "unknown";
+}
+
+#endif // PNG_OPTIMIZER_IMPLEMENTATION
@@ -0,0 +1,599 @@
+/*******************************************************************************************
+*
+*   Post Bundle - Export post files as a self-contained .zip bundle, import bundles
+*
+*   MODULE USAGE:
+*       #define POST_BUNDLE_IMPLEMENTATION
+*       #include "post_bundle.h"
+*
+*       BundleEntry entries[] = { { "index.md", "posts/new/index.md" }, { "banner.png", "posts/new/banner.png" } };
+*       SavePostBundle("post.zip", entries, 2, pool);
+*
+*       char *markdown = LoadPostBundleMarkdown("post.zip", &markdownSize);
+*       int assetCount = ImportPostBundleAssets("post.zip", "target/static/img", computeBlobId, assets, MAX_ASSETS);
+*
+*   NOTES:
+*       Entries are loaded and deflated in parallel on worker pool, then written in order to
+*       the .zip file as precompressed data; entries are processed in batches (a few per worker)
+*       and released once written, so the archive is streamed to disk, never held in memory
+*
+*       Already compressed files (i.e. PNG) that do not shrink are stored uncompressed
+*
+*       Large entries (PARALLEL_DEFLATE_MIN_SIZE) are only loaded by workers, they are compressed
+*       later in chunks using all workers, so one big asset does not keep a single core busy
+*
+*       On import, bundle is read through miniz reader: markdown is extracted into memory and assets
+*       are streamed straight into destination folder (flattened by file name), no temp directory.
+*       Import is planned first (PlanPostBundleAssets(), also used to preview an import over a folder
+*       listed from a repository tree), only assets planned as new files are extracted.
+*       Assets identical to a file already in destination (same content id, i.e. git blob id, only
+*       computed for files of same size) are not extracted, existing file is reused; names used by
+*       different files get a numeric suffix. Assets paths longer than BundleAsset paths are skipped
+*
+*   DEPENDENCIES:
+*       raylib              - Destination folder scanning (import)
+*       miniz               - Deflate compression and .zip writing
+*       worker_pool.h       - Parallel entries compression
+*       parallel_deflate.h  - Chunked parallel compression for large entries
+*
+*   LICENSE: GPLv3, check LICENSE file for details
+*
+**********************************************************************************************/
+
+#ifndef POST_BUNDLE_H
+#define POST_BUNDLE_H
+
+#include "worker_pool.h"
+#include "parallel_deflate.h"
+
+#include <stdbool.h>        // Required for: bool
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define POST_BUNDLE_COMPRESSION_LEVEL       6   // Deflate compression level (1..10)
+#define POST_BUNDLE_ENTRIES_PER_THREAD      2   // Entries compressed per thread on every batch
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Bundle entry
+typedef struct BundleEntry {
+    const char *archivePath;        // Path inside .zip archive
+    const char *filePath;           // Source file path
+} BundleEntry;
+
+// Bundle asset, imported into destination folder
+typedef struct BundleAsset {
+    char archivePath[256];          // Path inside .zip archive
+    char fileName[256];             // File name in destination folder
+    int entry;                      // Entry index inside .zip archive
+    bool reused;                    // Identical file already in destination folder, not extracted
+} BundleAsset;
+
+// Compute content id of data (hex string, up to 40 characters), i.e. git blob id
+typedef void (*BundleHashFunc)(const void *data, size_t size, char *id);
+
+// File in import destination folder
+// NOTE: Content id is only computed when an asset of same size is imported (empty until then)
+typedef struct BundleFolderFile {
+    char fileName[256];
+    long long size;
+    char id[41];
+    int entry;                      // Bundle entry planned as this file, -1 for files already in folder
+} BundleFolderFile;
+
+// Import destination folder files, planned assets are added
+typedef struct BundleFolder {
+    const char *path;               // Folder path, its files are read to compute ids (NULL if ids are provided)
+    BundleFolderFile *files;
+    int count;
+    int capacity;
+} BundleFolder;
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+bool SavePostBundle(const char *fileName, const BundleEntry *entries, int count, WorkerPool *pool); // Save entries as .zip bundle
+char *LoadPostBundleMarkdown(const char *fileName, int *dataSize);                  // Load bundle markdown (index.md or first .md), free with free()
+unsigned char *LoadPostBundleFileData(const char *fileName, const char *archivePath, int *dataSize); // Load one bundle entry data, free with free()
+int LoadPostBundleAssets(const char *fileName, BundleAsset *assets, int maxCount);   // List bundle assets (not imported), returns count (-1 on error)
+int ImportPostBundleAssets(const char *fileName, const char *destPath, BundleHashFunc hash, BundleAsset *assets, int maxCount); // Import bundle assets into folder, returns count (-1 on error)
+int PlanPostBundleAssets(const char *fileName, BundleFolder *folder, BundleHashFunc hash, BundleAsset *assets, int maxCount); // Plan assets import into folder (nothing extracted), returns count (-1 on error)
+BundleFolder LoadBundleFolder(const char *path);                                    // Load folder files (names and sizes), ids are computed on demand
+void AddBundleFolderFile(BundleFolder *folder, const char *fileName, long long size, const char *id); // Add file to folder files (i.e. from repository tree, id known)
+void UnloadBundleFolder(BundleFolder *folder);                                      // Unload folder files
+bool IsPostBundleAsset(const char *archivePath);                                    // Check if bundle entry is an asset, imported by ImportPostBundleAssets()
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // POST_BUNDLE_H
+
+/***********************************************************************************
+*
+*   POST BUNDLE IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(POST_BUNDLE_IMPLEMENTATION)
+
+#include "raylib.h"         // Required for: LoadDirectoryFiles(), GetFileLength(), MakeDirectory()
+#include "external/miniz.h"
+
+#include <stdio.h>          // Required for: FILE, fopen(), fread(), fprintf()
+#include <stdlib.h>         // Required for: calloc(), malloc(), free()
+#include <string.h>         // Required for: strcmp(), strcpy(), strrchr(), strlen()
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Bundle entry data, filled by worker job
+typedef struct BundleEntryData {
+    const BundleEntry *entry;
+    void *data;                     // Entry data, deflated if compressed is true
+    size_t dataSize;
+    size_t fileSize;                // Uncompressed size
+    mz_uint32 crc32;                // Uncompressed data CRC32
+    bool compressed;
+    bool loaded;
+    bool deferred;                  // Large entry, compressed later using all workers
+} BundleEntryData;
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+// Load file data, NULL if file can not be read
+static void *LoadBundleFileData(const char *fileName, size_t *dataSize)
+{
+    void *data = NULL;
+    *dataSize = 0;
+
+    FILE *file = fopen(fileName, "rb");
+    if (file == NULL) return NULL;
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    if (size >= 0)
+    {
+        data = malloc((size > 0)? (size_t)size : 1);
+        if ((data != NULL) && (fread(data, 1, (size_t)size, file) == (size_t)size)) *dataSize = (size_t)size;
+        else { free(data); data = NULL; }
+    }
+
+    fclose(file);
+
+    return data;
+}
+
+// Deflate loaded bundle entry data, data is kept uncompressed if it does not shrink
+static void DeflateBundleEntry(BundleEntryData *entryData, WorkerPool *pool)
+{
+    // NOTE: Very small files are always stored, as miniz does
+    if (entryData->fileSize <= 3) return;
+
+    entryData->crc32 = (mz_uint32)mz_crc32(MZ_CRC32_INIT, (const mz_uint8 *)entryData->data, entryData->fileSize);
+
+    size_t compSize = 0;
+    void *compData = NULL;
+
+    if (pool != NULL) compData = CompressDataParallel(entryData->data, entryData->fileSize, &compSize, POST_BUNDLE_COMPRESSION_LEVEL, pool);
+    else compData = tdefl_compress_mem_to_heap(entryData->data, entryData->fileSize, &compSize,
+        tdefl_create_comp_flags_from_zip_params(POST_BUNDLE_COMPRESSION_LEVEL, -MZ_DEFAULT_WINDOW_BITS, MZ_DEFAULT_STRATEGY));
+
+    if ((compData != NULL) && (compSize < entryData->fileSize))
+    {
+        free(entryData->data);
+        entryData->data = compData;
+        entryData->dataSize = compSize;
+        entryData->compressed = true;
+    }
+    else mz_free(compData);
+}
+
+// Worker job: Load and deflate one bundle entry
+static void CompressBundleEntry(void *data, int index)
+{
+    BundleEntryData *entryData = (BundleEntryData *)data + index;
+
+    void *fileData = LoadBundleFileData(entryData->entry->filePath, &entryData->fileSize);
+    if (fileData == NULL) return;
+
+    entryData->loaded = true;
+    entryData->data = fileData;
+    entryData->dataSize = entryData->fileSize;
+
+    if (entryData->deferred && (entryData->fileSize >= PARALLEL_DEFLATE_MIN_SIZE)) return;
+    entryData->deferred = false;
+
+    DeflateBundleEntry(entryData, NULL);
+}
+
+// Add file to folder files, returns added file (NULL if name does not fit or out of memory)
+static BundleFolderFile *AddBundleFolderEntry(BundleFolder *folder, const char *fileName, long long size, const char *id, int entry)
+{
+    if (strlen(fileName) >= sizeof(folder->files[0].fileName)) return NULL;
+
+    if (folder->count >= folder->capacity)
+    {
+        int capacity = (folder->capacity > 0)? folder->capacity*2 : 64;
+        BundleFolderFile *files = (BundleFolderFile *)realloc(folder->files, capacity*sizeof(BundleFolderFile));
+        if (files == NULL) return NULL;
+
+        folder->files = files;
+        folder->capacity = capacity;
+    }
+
+    BundleFolderFile *file = &folder->files[folder->count++];
+    *file = (BundleFolderFile){ 0 };
+    strcpy(file->fileName, fileName);
+    file->size = size;
+    if (id != NULL) snprintf(file->id, sizeof(file->id), "%s", id);
+    file->entry = entry;
+
+    return file;
+}
+
+// Get content id of bundle entry, false if entry could not be extracted
+static bool GetBundleEntryId(mz_zip_archive *zip, int entry, BundleHashFunc hash, char *id)
+{
+    size_t dataSize = 0;
+    void *data = mz_zip_reader_extract_to_heap(zip, entry, &dataSize, 0);
+    if (data == NULL) return false;
+
+    hash(data, dataSize, id);
+    mz_free(data);
+
+    return true;
+}
+
+// Get content id of folder file (computed once): planned asset from bundle entry, or file read from folder
+static bool GetBundleFolderFileId(mz_zip_archive *zip, const BundleFolder *folder, BundleFolderFile *file, BundleHashFunc hash)
+{
+    if (file->id[0] != '\0') return true;
+    if (file->entry >= 0) return GetBundleEntryId(zip, file->entry, hash, file->id);
+    if (folder->path == NULL) return false;
+
+    char filePath[512] = { 0 };
+    if (snprintf(filePath, sizeof(filePath), "%s/%s", folder->path, file->fileName) >= (int)sizeof(filePath)) return false;
+
+    size_t dataSize = 0;
+    void *data = LoadBundleFileData(filePath, &dataSize);
+    if (data == NULL) return false;
+
+    hash(data, dataSize, file->id);
+    free(data);
+
+    return true;
+}
+
+// Plan bundle assets import into folder: assets are flattened (file name), an asset identical to a folder
+// file (same content id) reuses it, a name used by a different file gets a numeric suffix
+// NOTE: Planned assets are added to folder files, so duplicates inside bundle are reused too;
+// no content is compared if hash is NULL
+static int PlanBundleAssets(mz_zip_archive *zip, BundleFolder *folder, BundleHashFunc hash, BundleAsset *assets, int maxCount)
+{
+    int count = 0;
+    int entryCount = (int)mz_zip_reader_get_num_files(zip);
+
+    for (int i = 0; i < entryCount; i++)
+    {
+        mz_zip_archive_file_stat stat = { 0 };
+        if (!mz_zip_reader_file_stat(zip, i, &stat) || stat.m_is_directory || !IsPostBundleAsset(stat.m_filename)) continue;
+
+        if (count >= maxCount)
+        {
+            fprintf(stderr, "WARNING: Too many bundle assets, not imported: %s\n", stat.m_filename);
+            break;
+        }
+
+        // NOTE: A truncated path would only match a part of post links to the asset
+        if (strlen(stat.m_filename) >= sizeof(assets[0].archivePath))
+        {
+            fprintf(stderr, "WARNING: Bundle asset path too long, not imported: %s\n", stat.m_filename);
+            continue;
+        }
+
+        const char *name = strrchr(stat.m_filename, '/');
+        name = (name != NULL)? name + 1 : stat.m_filename;
+
+        BundleAsset *asset = &assets[count];
+        *asset = (BundleAsset){ 0 };
+        strcpy(asset->archivePath, stat.m_filename);
+        asset->entry = i;
+
+        // Dedup: file with same content in folder is reused, asset id is only computed if a file has same size
+        char id[41] = { 0 };
+        for (int j = 0; (hash != NULL) && (j < folder->count) && !asset->reused; j++)
+        {
+            BundleFolderFile *file = &folder->files[j];
+            if (file->size != (long long)stat.m_uncomp_size) continue;
+
+            if ((id[0] == '\0') && !GetBundleEntryId(zip, i, hash, id)) break;
+            if (!GetBundleFolderFileId(zip, folder, file, hash)) continue;
+
+            if (strcmp(file->id, id) == 0)
+            {
+                strcpy(asset->fileName, file->fileName);
+                asset->reused = true;
+            }
+        }
+
+        if (!asset->reused)
+        {
+            // Name used by a different file: numeric suffix is added
+            const char *extension = strrchr(name, '.');
+            int nameLength = (extension != NULL)? (int)(extension - name) : (int)strlen(name);
+            bool fits = true;
+            strcpy(asset->fileName, name);
+
+            for (int suffix = 1, used = 1; used && fits; suffix++)
+            {
+                used = 0;
+                for (int j = 0; (j < folder->count) && !used; j++) used = (strcmp(folder->files[j].fileName, asset->fileName) == 0);
+                if (used) fits = (snprintf(asset->fileName, sizeof(asset->fileName), "%.*s-%i%s", nameLength, name, suffix, (extension != NULL)? extension : "") < (int)sizeof(asset->fileName));
+            }
+
+            if (!fits || (AddBundleFolderEntry(folder, asset->fileName, (long long)stat.m_uncomp_size, id, i) == NULL))
+            {
+                fprintf(stderr, "WARNING: Bundle asset name could not be used, not imported: %s\n", stat.m_filename);
+                continue;
+            }
+        }
+
+        count++;
+    }
+
+    return count;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Save entries as .zip bundle
+// NOTE: If pool is NULL, entries are compressed on calling thread
+bool SavePostBundle(const char *fileName, const BundleEntry *entries, int count, WorkerPool *pool)
+{
+    mz_zip_archive zip = { 0 };
+    if (!mz_zip_writer_init_file(&zip, fileName, 0))
+    {
+        fprintf(stderr, "ERROR: Bundle file could not be created: %s\n", fileName);
+        return false;
+    }
+
+    int batchSize = GetWorkerPoolThreadCount(pool)*POST_BUNDLE_ENTRIES_PER_THREAD;
+    BundleEntryData *batch = (BundleEntryData *)calloc(batchSize, sizeof(BundleEntryData));
+    bool success = (batch != NULL);
+
+    for (int first = 0; success && (first < count); first += batchSize)
+    {
+        int batchCount = ((count - first) < batchSize)? (count - first) : batchSize;
+        // NOTE: Large entries can only be deferred if there are workers to compress them
+        for (int i = 0; i < batchCount; i++) batch[i] = (BundleEntryData){ .entry = &entries[first + i], .deferred = (GetWorkerPoolThreadCount(pool) > 1) };
+
+        RunWorkerPoolJobs(pool, CompressBundleEntry, batch, batchCount);
+
+        // Entries are written in order, deflated data is added as is
+        for (int i = 0; i < batchCount; i++)
+        {
+            BundleEntryData *entryData = &batch[i];
+
+            if (!entryData->loaded)
+            {
+                fprintf(stderr, "ERROR: Bundle entry could not be loaded: %s\n", entryData->entry->filePath);
+                success = false;
+            }
+            else if (success)
+            {
+                mz_bool added = false;
+
+                if (entryData->deferred) DeflateBundleEntry(entryData, pool);
+
+                if (entryData->compressed) added = mz_zip_writer_add_mem_ex_v2(&zip, entryData->entry->archivePath, entryData->data, entryData->dataSize, NULL, 0,
+                    POST_BUNDLE_COMPRESSION_LEVEL | MZ_ZIP_FLAG_COMPRESSED_DATA, entryData->fileSize, entryData->crc32, NULL, NULL, 0, NULL, 0);
+                else added = mz_zip_writer_add_mem(&zip, entryData->entry->archivePath, entryData->data, entryData->dataSize, MZ_NO_COMPRESSION);
+
+                if (!added)
+                {
+                    fprintf(stderr, "ERROR: Bundle entry could not be written: %s (%s)\n", entryData->entry->archivePath, mz_zip_get_error_string(mz_zip_get_last_error(&zip)));
+                    success = false;
+                }
+            }
+
+            if (entryData->compressed) mz_free(entryData->data);
+            else free(entryData->data);
+        }
+    }
+
+    free(batch);
+
+    if (success) success = mz_zip_writer_finalize_archive(&zip);
+    mz_zip_writer_end(&zip);
+
+    if (!success) remove(fileName);
+
+    return success;
+}
+
+// Load bundle markdown: root index.md or first .md entry
+// NOTE: Data is NULL terminated, dataSize does not include terminator
+char *LoadPostBundleMarkdown(const char *fileName, int *dataSize)
+{
+    *dataSize = 0;
+
+    mz_zip_archive zip = { 0 };
+    if (!mz_zip_reader_init_file(&zip, fileName, 0))
+    {
+        fprintf(stderr, "ERROR: Bundle file could not be opened: %s\n", fileName);
+        return NULL;
+    }
+
+    int index = mz_zip_reader_locate_file(&zip, "index.md", NULL, 0);
+
+    for (mz_uint i = 0; (index < 0) && (i < mz_zip_reader_get_num_files(&zip)); i++)
+    {
+        char archivePath[256] = { 0 };
+        mz_zip_reader_get_filename(&zip, i, archivePath, sizeof(archivePath));
+        const char *extension = strrchr(archivePath, '.');
+
+        if (!mz_zip_reader_is_file_a_directory(&zip, i) && (extension != NULL) && (strcmp(extension, ".md") == 0)) index = (int)i;
+    }
+
+    char *text = NULL;
+    mz_zip_archive_file_stat stat = { 0 };
+
+    if ((index >= 0) && mz_zip_reader_file_stat(&zip, index, &stat) && (stat.m_uncomp_size < 0x7fffffff))
+    {
+        text = (char *)malloc((size_t)stat.m_uncomp_size + 1);
+
+        if ((text != NULL) && mz_zip_reader_extract_to_mem(&zip, index, text, (size_t)stat.m_uncomp_size, 0))
+        {
+            text[stat.m_uncomp_size] = '\0';
+            *dataSize = (int)stat.m_uncomp_size;
+        }
+        else { free(text); text = NULL; }
+    }
+
+    if (text == NULL) fprintf(stderr, "ERROR: Bundle markdown could not be loaded: %s\n", fileName);
+
+    mz_zip_reader_end(&zip);
+
+    return text;
+}
+
+// Load one bundle entry data, NULL if not found
+unsigned char *LoadPostBundleFileData(const char *fileName, const char *archivePath, int *dataSize)
+{
+    *dataSize = 0;
+
+    mz_zip_archive zip = { 0 };
+    if (!mz_zip_reader_init_file(&zip, fileName, 0)) return NULL;
+
+    size_t size = 0;
+    unsigned char *data = (unsigned char *)mz_zip_reader_extract_file_to_heap(&zip, archivePath, &size, 0);
+    if (data != NULL) *dataSize = (int)size;
+
+    mz_zip_reader_end(&zip);
+
+    return data;
+}
+
+// List bundle assets, as ImportPostBundleAssets() would import them, nothing is extracted
+// NOTE: Asset file name is its flattened name in bundle (destination folder is not checked, contents not compared)
+int LoadPostBundleAssets(const char *fileName, BundleAsset *assets, int maxCount)
+{
+    BundleFolder folder = { 0 };
+    int count = PlanPostBundleAssets(fileName, &folder, NULL, assets, maxCount);
+    UnloadBundleFolder(&folder);
+
+    return count;
+}
+
+// Import bundle assets into destination folder, entries are streamed to files
+// NOTE: Files already in destination folder are not overwritten, function can be called from any thread
+int ImportPostBundleAssets(const char *fileName, const char *destPath, BundleHashFunc hash, BundleAsset *assets, int maxCount)
+{
+    mz_zip_archive zip = { 0 };
+    if (!mz_zip_reader_init_file(&zip, fileName, 0))
+    {
+        fprintf(stderr, "ERROR: Bundle file could not be opened: %s\n", fileName);
+        return -1;
+    }
+
+    MakeDirectory(destPath);
+
+    BundleFolder folder = LoadBundleFolder(destPath);
+    int count = PlanBundleAssets(&zip, &folder, hash, assets, maxCount);
+    bool success = true;
+
+    for (int i = 0; (i < count) && success; i++)
+    {
+        if (assets[i].reused) continue;
+
+        char destFileName[512] = { 0 };
+        success = (snprintf(destFileName, sizeof(destFileName), "%s/%s", destPath, assets[i].fileName) < (int)sizeof(destFileName)) &&
+            mz_zip_reader_extract_to_file(&zip, assets[i].entry, destFileName, 0);
+
+        if (!success) fprintf(stderr, "ERROR: Bundle asset could not be extracted: %s\n", assets[i].archivePath);
+    }
+
+    UnloadBundleFolder(&folder);
+    mz_zip_reader_end(&zip);
+
+    return success? count : -1;
+}
+
+// Plan bundle assets import into folder as ImportPostBundleAssets() would import them, nothing is extracted:
+// asset file names, assets identical to a folder file are reused (planned assets are added to folder)
+int PlanPostBundleAssets(const char *fileName, BundleFolder *folder, BundleHashFunc hash, BundleAsset *assets, int maxCount)
+{
+    mz_zip_archive zip = { 0 };
+    if (!mz_zip_reader_init_file(&zip, fileName, 0))
+    {
+        fprintf(stderr, "ERROR: Bundle file could not be opened: %s\n", fileName);
+        return -1;
+    }
+
+    int count = PlanBundleAssets(&zip, folder, hash, assets, maxCount);
+    mz_zip_reader_end(&zip);
+
+    return count;
+}
+
+// Load folder files (names and sizes), content ids are computed when needed
+// NOTE: Files with names longer than BundleFolderFile names are not listed
+BundleFolder LoadBundleFolder(const char *path)
+{
+    BundleFolder folder = { 0 };
+    folder.path = path;
+
+    FilePathList files = LoadDirectoryFiles(path);
+
+    for (unsigned int i = 0; i < files.count; i++)
+    {
+        if (IsPathFile(files.paths[i])) AddBundleFolderEntry(&folder, GetFileName(files.paths[i]), (long long)GetFileLength(files.paths[i]), NULL, -1);
+    }
+
+    UnloadDirectoryFiles(files);
+
+    return folder;
+}
+
+// Add file to folder files, id can be NULL (computed from folder file when needed)
+// NOTE: Files with names longer than BundleFolderFile names are not added
+void AddBundleFolderFile(BundleFolder *folder, const char *fileName, long long size, const char *id)
+{
+    AddBundleFolderEntry(folder, fileName, size, id, -1);
+}
+
+// Unload folder files
+void UnloadBundleFolder(BundleFolder *folder)
+{
+    free(folder->files);
+    *folder = (BundleFolder){ 0 };
+}
+
+// Check if bundle entry is an asset to import
+// NOTE: Markdown files and root banner are post content, not assets
+bool IsPostBundleAsset(const char *archivePath)
+{
+    const char *name = strrchr(archivePath, '/');
+    name = (name != NULL)? name + 1 : archivePath;
+
+    const char *extension = strrchr(name, '.');
+
+    if (name[0] == '\0') return false;
+    if ((extension != NULL) && (strcmp(extension, ".md") == 0)) return false;
+    if ((name == archivePath) && (strncmp(name, "banner.", 7) == 0)) return false;
+
+    return true;
+}
+
+#endif // POST_BUNDLE_IMPLEMENTATION
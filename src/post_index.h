@@ -0,0 +1,703 @@
+/*******************************************************************************************
+*
+*   Post Index - Compact binary metadata index of site posts, memory-mapped
+*
+*   MODULE USAGE:
+*       #define POST_INDEX_IMPLEMENTATION
+*       #include "post_index.h"
+*
+*       BUILD:  PostIndexBuilder *builder = BeginPostIndex();
+*               AddPostIndexEntry(builder, &entry);                     // Strings are copied (interned)
+*               EndPostIndex(builder, "posts/mirror/site.git/statiqpress-posts.idx");
+*
+*       QUERY:  PostIndex index = LoadPostIndex("posts/mirror/site.git/statiqpress-posts.idx");
+*               int post = FindPostIndexSlug(&index, "hello-world");    // Binary search
+*               PostIndexEntry entry = GetPostIndexEntry(&index, post); // Strings point into mapped data
+*               int tag = FindPostIndexValue(&index, POST_INDEX_TAGS, "go");
+*               UnloadPostIndex(&index);
+*
+*   FILE STRUCTURE (.idx):
+*       Columns are stored struct-of-arrays (one array per field), strings are interned (stored
+*       once, referenced by offset). Posts are sorted by path, slug order is stored as a
+*       permutation, and distinct tags/categories/authors are stored sorted with their post
+*       counts: every lookup is a binary search over mapped data, no parsing or allocation
+*
+*       ------------------------------------------------------
+*       Offset  | Size    | Type       | Description
+*       ------------------------------------------------------
+*       0       | 4       | char       | Signature: "SQPI"
+*       4       | 2       | short      | Version: 100
+*       6       | 2       | short      | Reserved
+*       8       | 4       | int        | Posts count (N)
+*       12      | 4       | int        | Lists data size (L), in ints
+*       16      | 4       | int        | Strings data size (S)
+*       20      | 12      | int        | Distinct values count per field (tags, categories, authors)
+*       32      | 32*N    | int        | Columns: path, slug, title, date (string offsets), tags,
+*                                      | categories, authors (lists offsets), slug order (post index)
+*       ...     | 20*N    | char       | Column: post blob ids (SHA-1, binary)
+*       ...     | 4*L     | int        | Lists data: values count followed by values (string offsets)
+*       ...     | 8*V     | int        | Values tables per field: sorted values (string offsets), post counts
+*       ...     | S       | char       | Strings data, NULL terminated UTF-8 strings
+*
+*   DEPENDENCIES:
+*       file_batch.h    - Crash-safe file saving (temp file synced and renamed)
+*
+*   LICENSE: GPLv3, check LICENSE file for details
+*
+**********************************************************************************************/
+
+#ifndef POST_INDEX_H
+#define POST_INDEX_H
+
+#include <stdbool.h>        // Required for: bool
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define POST_INDEX_VERSION          101     // Binary file format version
+#define POST_INDEX_FIELD_COUNT        3     // List fields: tags, categories, authors
+#define POST_INDEX_MAX_VALUES        32     // Max values of a list field per post
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Post list fields
+typedef enum {
+    POST_INDEX_TAGS = 0,
+    POST_INDEX_CATEGORIES,
+    POST_INDEX_AUTHORS
+} PostIndexField;
+
+// Post metadata entry
+// NOTE: Strings are not owned by the entry, they usually point into mapped index data
+typedef struct PostIndexEntry {
+    const char *path;               // Path in repository
+    const char *slug;               // Front matter slug, or post folder/file name
+    const char *title;
+    const char *date;
+    const char *values[POST_INDEX_FIELD_COUNT][POST_INDEX_MAX_VALUES]; // Tags, categories and authors
+    int valueCounts[POST_INDEX_FIELD_COUNT];
+    char blobId[41];                // Post blob id (SHA-1, hex), used for incremental updates
+} PostIndexEntry;
+
+// Post index, mapped from file
+typedef struct PostIndex {
+    int count;                      // Posts count
+    const unsigned char *data;      // File data (memory mapped if supported)
+    int dataSize;
+    bool mapped;                    // File data is memory mapped (or loaded)
+} PostIndex;
+
+// Post index builder, opaque type
+typedef struct PostIndexBuilder PostIndexBuilder;
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+PostIndex LoadPostIndex(const char *fileName);                          // Load (map) post index file, empty index if not valid
+void UnloadPostIndex(PostIndex *index);                                 // Unload (unmap) post index file
+PostIndexEntry GetPostIndexEntry(const PostIndex *index, int position); // Get post entry (posts sorted by path)
+int FindPostIndexPath(const PostIndex *index, const char *path);        // Find post by path, -1 if not found
+int FindPostIndexSlug(const PostIndex *index, const char *slug);        // Find post by slug, -1 if not found
+int GetPostIndexValueCount(const PostIndex *index, PostIndexField field); // Get distinct values count of field
+const char *GetPostIndexValue(const PostIndex *index, PostIndexField field, int position, int *postCount); // Get distinct value (sorted) and its posts count
+int FindPostIndexValue(const PostIndex *index, PostIndexField field, const char *value); // Find distinct value, -1 if not found
+
+PostIndexBuilder *BeginPostIndex(void);                                 // Begin building post index
+bool AddPostIndexEntry(PostIndexBuilder *builder, const PostIndexEntry *entry); // Add post entry, strings are copied
+bool EndPostIndex(PostIndexBuilder *builder, const char *fileName);     // Save post index file (replaced atomically), builder is freed
+void AbortPostIndex(PostIndexBuilder *builder);                         // Abort post index building, builder is freed
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // POST_INDEX_H
+
+/***********************************************************************************
+*
+*   POST_INDEX IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(POST_INDEX_IMPLEMENTATION)
+
+#include "file_batch.h"     // Required for: BeginFileBatch(), SaveBatchFileData(), EndFileBatch()
+
+#include <stdio.h>          // Required for: FILE, fopen(), fread()
+#include <stdlib.h>         // Required for: calloc(), realloc(), free(), qsort()
+#include <string.h>         // Required for: memcpy(), strlen(), strcmp()
+
+#if !defined(_WIN32)
+    #include <fcntl.h>      // Required for: open()
+    #include <unistd.h>     // Required for: close()
+    #include <sys/mman.h>   // Required for: mmap(), munmap()
+    #include <sys/stat.h>   // Required for: fstat()
+#endif
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define POST_INDEX_HEADER_SIZE      32
+#define POST_INDEX_COLUMNS           8      // Int columns: path, slug, title, date, tags, categories, authors, slug order
+#define POST_INDEX_COLUMN_SLUG_ORDER 7
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Post record, built in memory
+typedef struct PostIndexRecord {
+    unsigned int strings[4];        // Path, slug, title, date (string offsets)
+    unsigned int lists[POST_INDEX_FIELD_COUNT]; // Lists offsets
+    unsigned char blobId[20];
+} PostIndexRecord;
+
+struct PostIndexBuilder {
+    PostIndexRecord *records;
+    int count;
+    int capacity;
+
+    char *strings;                  // Interned strings, first one is empty string
+    unsigned int stringsSize;
+    unsigned int stringsCapacity;
+    unsigned int *stringsTable;     // Interning hash table: string offset + 1 (0: empty slot)
+    unsigned int tableCapacity;
+    unsigned int tableCount;
+
+    unsigned int *lists;            // Lists data, first one is empty list
+    unsigned int listsSize;
+    unsigned int listsCapacity;
+
+    bool failed;                    // Allocation failed
+};
+
+// Sort key, used to sort records and values by string
+typedef struct PostIndexSortKey {
+    const char *text;
+    unsigned int value;
+} PostIndexSortKey;
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+// Read/write 32bit little-endian values
+static unsigned int ReadPostIndexUint(const unsigned char *data) { return data[0] | (data[1] << 8) | (data[2] << 16) | ((unsigned int)data[3] << 24); }
+static void WritePostIndexUint(unsigned char *data, unsigned int value) { data[0] = value & 0xff; data[1] = (value >> 8) & 0xff; data[2] = (value >> 16) & 0xff; data[3] = (value >> 24) & 0xff; }
+
+// Get index data sections
+static const unsigned char *GetPostIndexColumn(const PostIndex *index, int column) { return index->data + POST_INDEX_HEADER_SIZE + column*index->count*4; }
+static const unsigned char *GetPostIndexBlobIds(const PostIndex *index) { return GetPostIndexColumn(index, POST_INDEX_COLUMNS); }
+static const unsigned char *GetPostIndexLists(const PostIndex *index) { return GetPostIndexBlobIds(index) + index->count*20; }
+static const char *GetPostIndexString(const PostIndex *index, unsigned int offset)
+{
+    return (const char *)GetPostIndexLists(index) + ReadPostIndexUint(index->data + 12)*4 +
+        (ReadPostIndexUint(index->data + 20) + ReadPostIndexUint(index->data + 24) + ReadPostIndexUint(index->data + 28))*8 + offset;
+}
+
+// Get values table of field: sorted string offsets followed by posts counts
+static const unsigned char *GetPostIndexValues(const PostIndex *index, PostIndexField field)
+{
+    const unsigned char *values = GetPostIndexLists(index) + ReadPostIndexUint(index->data + 12)*4;
+    for (int f = 0; f < (int)field; f++) values += ReadPostIndexUint(index->data + 20 + f*4)*8;
+
+    return values;
+}
+
+// Check mapped data is a valid index file: header, sections size, offsets in bounds
+static bool IsPostIndexDataValid(const unsigned char *data, int dataSize)
+{
+    if ((data == NULL) || (dataSize < POST_INDEX_HEADER_SIZE)) return false;
+    if ((data[0] != 'S') || (data[1] != 'Q') || (data[2] != 'P') || (data[3] != 'I')) return false;
+    if ((data[4] | (data[5] << 8)) != POST_INDEX_VERSION) return false;
+
+    unsigned long long count = ReadPostIndexUint(data + 8);
+    unsigned long long listsSize = ReadPostIndexUint(data + 12);
+    unsigned long long stringsSize = ReadPostIndexUint(data + 16);
+    unsigned long long valuesCount = (unsigned long long)ReadPostIndexUint(data + 20) + ReadPostIndexUint(data + 24) + ReadPostIndexUint(data + 28);
+
+    if ((listsSize == 0) || (stringsSize == 0)) return false;
+    if ((POST_INDEX_HEADER_SIZE + count*(POST_INDEX_COLUMNS*4 + 20) + listsSize*4 + valuesCount*8 + stringsSize) != (unsigned long long)dataSize) return false;
+
+    PostIndex index = { (int)count, data, dataSize, false };
+    const unsigned char *lists = GetPostIndexLists(&index);
+    if (GetPostIndexString(&index, 0)[stringsSize - 1] != '\0') return false;     // Last string must be terminated
+
+    for (unsigned int i = 0; i < count; i++)
+    {
+        for (int k = 0; k < 4; k++) if (ReadPostIndexUint(GetPostIndexColumn(&index, k) + i*4) >= stringsSize) return false;
+        for (int k = 4; k < 7; k++) if (ReadPostIndexUint(GetPostIndexColumn(&index, k) + i*4) >= listsSize) return false;
+        if (ReadPostIndexUint(GetPostIndexColumn(&index, POST_INDEX_COLUMN_SLUG_ORDER) + i*4) >= count) return false;
+    }
+
+    for (unsigned int i = 0; i < listsSize; )
+    {
+        unsigned int valueCount = ReadPostIndexUint(lists + i*4);
+        if ((i + 1 + valueCount) > listsSize) return false;
+        for (unsigned int k = 0; k < valueCount; k++) if (ReadPostIndexUint(lists + (i + 1 + k)*4) >= stringsSize) return false;
+        i += 1 + valueCount;
+    }
+
+    for (unsigned int i = 0; i < valuesCount; i++)
+    {
+        if (ReadPostIndexUint(lists + listsSize*4 + i*8) >= stringsSize) return false;
+    }
+
+    return true;
+}
+
+// Intern string into builder strings data, returns string offset
+static unsigned int InternPostIndexString(PostIndexBuilder *builder, const char *text)
+{
+    if ((text == NULL) || (text[0] == '\0') || builder->failed) return 0;
+
+    // Hash table is kept at most half full
+    if (((builder->tableCount + 1)*2) > builder->tableCapacity)
+    {
+        unsigned int capacity = (builder->tableCapacity > 0)? builder->tableCapacity*2 : 1024;
+        unsigned int *table = (unsigned int *)calloc(capacity, sizeof(unsigned int));
+        if (table == NULL) { builder->failed = true; return 0; }
+
+        for (unsigned int i = 0; i < builder->tableCapacity; i++)
+        {
+            if (builder->stringsTable[i] == 0) continue;
+
+            unsigned int hash = 2166136261u;
+            for (const char *ptr = builder->strings + builder->stringsTable[i] - 1; *ptr != '\0'; ptr++) hash = (hash ^ (unsigned char)*ptr)*16777619u;
+
+            unsigned int slot = hash & (capacity - 1);
+            while (table[slot] != 0) slot = (slot + 1) & (capacity - 1);
+            table[slot] = builder->stringsTable[i];
+        }
+
+        free(builder->stringsTable);
+        builder->stringsTable = table;
+        builder->tableCapacity = capacity;
+    }
+
+    unsigned int hash = 2166136261u;
+    for (const char *ptr = text; *ptr != '\0'; ptr++) hash = (hash ^ (unsigned char)*ptr)*16777619u;
+
+    unsigned int slot = hash & (builder->tableCapacity - 1);
+    while (builder->stringsTable[slot] != 0)
+    {
+        if (strcmp(builder->strings + builder->stringsTable[slot] - 1, text) == 0) return builder->stringsTable[slot] - 1;
+        slot = (slot + 1) & (builder->tableCapacity - 1);
+    }
+
+    unsigned int length = (unsigned int)strlen(text) + 1;
+    if ((builder->stringsSize + length) > builder->stringsCapacity)
+    {
+        unsigned int capacity = builder->stringsCapacity*2;
+        while (capacity < (builder->stringsSize + length)) capacity *= 2;
+
+        char *strings = (char *)realloc(builder->strings, capacity);
+        if (strings == NULL) { builder->failed = true; return 0; }
+
+        builder->strings = strings;
+        builder->stringsCapacity = capacity;
+    }
+
+    unsigned int offset = builder->stringsSize;
+    memcpy(builder->strings + offset, text, length);
+    builder->stringsSize += length;
+
+    builder->stringsTable[slot] = offset + 1;
+    builder->tableCount++;
+
+    return offset;
+}
+
+// Add values list into builder lists data, returns list offset
+static unsigned int AddPostIndexList(PostIndexBuilder *builder, const char *const *values, int count)
+{
+    if ((count <= 0) || builder->failed) return 0;
+
+    if ((builder->listsSize + count + 1) > builder->listsCapacity)
+    {
+        unsigned int capacity = builder->listsCapacity*2;
+        while (capacity < (builder->listsSize + count + 1)) capacity *= 2;
+
+        unsigned int *lists = (unsigned int *)realloc(builder->lists, capacity*sizeof(unsigned int));
+        if (lists == NULL) { builder->failed = true; return 0; }
+
+        builder->lists = lists;
+        builder->listsCapacity = capacity;
+    }
+
+    unsigned int offset = builder->listsSize;
+    builder->lists[builder->listsSize++] = (unsigned int)count;
+    for (int i = 0; i < count; i++) builder->lists[builder->listsSize++] = InternPostIndexString(builder, values[i]);
+
+    return offset;
+}
+
+static int ComparePostIndexKeys(const void *a, const void *b)
+{
+    return strcmp(((const PostIndexSortKey *)a)->text, ((const PostIndexSortKey *)b)->text);
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Load post index file
+// NOTE: File is memory mapped (read-only), entries are not parsed until requested
+PostIndex LoadPostIndex(const char *fileName)
+{
+    PostIndex index = { 0 };
+
+#if defined(_WIN32)
+    FILE *file = fopen(fileName, "rb");
+    if (file == NULL) return index;
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    if (size > 0)
+    {
+        unsigned char *data = (unsigned char *)calloc(size, 1);
+        if (data != NULL) index.dataSize = (int)fread(data, 1, size, file);
+        index.data = data;
+    }
+    fclose(file);
+#else
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0) return index;
+
+    struct stat fileInfo = { 0 };
+    if ((fstat(fd, &fileInfo) == 0) && (fileInfo.st_size > 0))
+    {
+        void *data = mmap(NULL, fileInfo.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED)
+        {
+            index.data = (const unsigned char *)data;
+            index.dataSize = (int)fileInfo.st_size;
+            index.mapped = true;
+        }
+    }
+    close(fd);      // NOTE: Mapping is kept after closing file descriptor
+#endif
+
+    if (IsPostIndexDataValid(index.data, index.dataSize)) index.count = (int)ReadPostIndexUint(index.data + 8);
+    else UnloadPostIndex(&index);
+
+    return index;
+}
+
+// Unload post index file
+void UnloadPostIndex(PostIndex *index)
+{
+#if !defined(_WIN32)
+    if (index->mapped) munmap((void *)index->data, index->dataSize);
+    else
+#endif
+    free((void *)index->data);
+
+    *index = (PostIndex){ 0 };
+}
+
+// Get post entry, strings point into index data
+PostIndexEntry GetPostIndexEntry(const PostIndex *index, int position)
+{
+    PostIndexEntry entry = { 0 };
+
+    if ((position < 0) || (position >= index->count)) return entry;
+
+    entry.path = GetPostIndexString(index, ReadPostIndexUint(GetPostIndexColumn(index, 0) + position*4));
+    entry.slug = GetPostIndexString(index, ReadPostIndexUint(GetPostIndexColumn(index, 1) + position*4));
+    entry.title = GetPostIndexString(index, ReadPostIndexUint(GetPostIndexColumn(index, 2) + position*4));
+    entry.date = GetPostIndexString(index, ReadPostIndexUint(GetPostIndexColumn(index, 3) + position*4));
+
+    const unsigned char *lists = GetPostIndexLists(index);
+    for (int f = 0; f < POST_INDEX_FIELD_COUNT; f++)
+    {
+        const unsigned char *list = lists + ReadPostIndexUint(GetPostIndexColumn(index, 4 + f) + position*4)*4;
+        int count = (int)ReadPostIndexUint(list);
+        if (count > POST_INDEX_MAX_VALUES) count = POST_INDEX_MAX_VALUES;
+
+        for (int i = 0; i < count; i++) entry.values[f][i] = GetPostIndexString(index, ReadPostIndexUint(list + 4 + i*4));
+        entry.valueCounts[f] = count;
+    }
+
+    const unsigned char *blobId = GetPostIndexBlobIds(index) + position*20;
+    for (int i = 0; i < 20; i++)
+    {
+        entry.blobId[i*2] = "0123456789abcdef"[blobId[i] >> 4];
+        entry.blobId[i*2 + 1] = "0123456789abcdef"[blobId[i] & 0x0f];
+    }
+
+    return entry;
+}
+
+// Find post by path, binary search (posts are sorted by path)
+int FindPostIndexPath(const PostIndex *index, const char *path)
+{
+    int low = 0, high = index->count - 1;
+
+    while (low <= high)
+    {
+        int middle = low + (high - low)/2;
+        int result = strcmp(GetPostIndexString(index, ReadPostIndexUint(GetPostIndexColumn(index, 0) + middle*4)), path);
+
+        if (result == 0) return middle;
+        else if (result < 0) low = middle + 1;
+        else high = middle - 1;
+    }
+
+    return -1;
+}
+
+// Find post by slug, binary search over slug order
+// NOTE: If several posts share slug, first one (by path) is returned
+int FindPostIndexSlug(const PostIndex *index, const char *slug)
+{
+    const unsigned char *order = GetPostIndexColumn(index, POST_INDEX_COLUMN_SLUG_ORDER);
+    int low = 0, high = index->count - 1, found = -1;
+
+    while (low <= high)
+    {
+        int middle = low + (high - low)/2;
+        unsigned int position = ReadPostIndexUint(order + middle*4);
+        int result = strcmp(GetPostIndexString(index, ReadPostIndexUint(GetPostIndexColumn(index, 1) + position*4)), slug);
+
+        if (result == 0) { found = (int)position; high = middle - 1; }
+        else if (result < 0) low = middle + 1;
+        else high = middle - 1;
+    }
+
+    return found;
+}
+
+// Get distinct values count of field
+int GetPostIndexValueCount(const PostIndex *index, PostIndexField field)
+{
+    return (index->count > 0)? (int)ReadPostIndexUint(index->data + 20 + field*4) : 0;
+}
+
+// Get distinct value of field (values sorted) and number of posts using it
+const char *GetPostIndexValue(const PostIndex *index, PostIndexField field, int position, int *postCount)
+{
+    int count = GetPostIndexValueCount(index, field);
+    if ((position < 0) || (position >= count)) return NULL;
+
+    const unsigned char *values = GetPostIndexValues(index, field);
+    if (postCount != NULL) *postCount = (int)ReadPostIndexUint(values + (count + position)*4);
+
+    return GetPostIndexString(index, ReadPostIndexUint(values + position*4));
+}
+
+// Find distinct value of field, binary search
+int FindPostIndexValue(const PostIndex *index, PostIndexField field, const char *value)
+{
+    const unsigned char *values = GetPostIndexValues(index, field);
+    int low = 0, high = GetPostIndexValueCount(index, field) - 1;
+
+    while (low <= high)
+    {
+        int middle = low + (high - low)/2;
+        int result = strcmp(GetPostIndexString(index, ReadPostIndexUint(values + middle*4)), value);
+
+        if (result == 0) return middle;
+        else if (result < 0) low = middle + 1;
+        else high = middle - 1;
+    }
+
+    return -1;
+}
+
+// Begin building post index
+PostIndexBuilder *BeginPostIndex(void)
+{
+    PostIndexBuilder *builder = (PostIndexBuilder *)calloc(1, sizeof(PostIndexBuilder));
+    if (builder == NULL) return NULL;
+
+    // Offset 0 is empty string and empty list, used by missing fields
+    builder->strings = (char *)calloc(4096, 1);
+    builder->stringsSize = 1;
+    builder->stringsCapacity = 4096;
+    builder->lists = (unsigned int *)calloc(1024, sizeof(unsigned int));
+    builder->listsSize = 1;
+    builder->listsCapacity = 1024;
+
+    if ((builder->strings == NULL) || (builder->lists == NULL)) builder->failed = true;
+
+    return builder;
+}
+
+// Add post entry, strings are interned into builder
+bool AddPostIndexEntry(PostIndexBuilder *builder, const PostIndexEntry *entry)
+{
+    if ((builder == NULL) || builder->failed || (entry->path == NULL)) return false;
+
+    if (builder->count >= builder->capacity)
+    {
+        int capacity = (builder->capacity > 0)? builder->capacity*2 : 256;
+        PostIndexRecord *records = (PostIndexRecord *)realloc(builder->records, capacity*sizeof(PostIndexRecord));
+        if (records == NULL) { builder->failed = true; return false; }
+
+        builder->records = records;
+        builder->capacity = capacity;
+    }
+
+    PostIndexRecord record = { 0 };
+    record.strings[0] = InternPostIndexString(builder, entry->path);
+    record.strings[1] = InternPostIndexString(builder, entry->slug);
+    record.strings[2] = InternPostIndexString(builder, entry->title);
+    record.strings[3] = InternPostIndexString(builder, entry->date);
+    for (int f = 0; f < POST_INDEX_FIELD_COUNT; f++) record.lists[f] = AddPostIndexList(builder, entry->values[f], entry->valueCounts[f]);
+
+    for (int i = 0; (i < 40) && (entry->blobId[i] != '\0'); i++)
+    {
+        char digit = entry->blobId[i];
+        int value = ((digit >= '0') && (digit <= '9'))? (digit - '0') : ((digit | 0x20) - 'a' + 10);
+        record.blobId[i/2] |= (unsigned char)((value & 0x0f) << ((i%2 == 0)? 4 : 0));
+    }
+
+    builder->records[builder->count++] = record;
+
+    return !builder->failed;
+}
+
+// Save post index file: records are sorted by path, slug order and values tables are computed
+// NOTE: Data is written as a file batch (temp file renamed over previous file), a currently
+// mapped index stays valid (old file data) until unloaded
+bool EndPostIndex(PostIndexBuilder *builder, const char *fileName)
+{
+    if ((builder == NULL) || builder->failed)
+    {
+        AbortPostIndex(builder);
+        return false;
+    }
+
+    int count = builder->count;
+    unsigned int valuesCount[POST_INDEX_FIELD_COUNT] = { 0 };
+    unsigned int totalValues = 0;
+    for (int i = 0; i < count; i++)
+    {
+        for (int f = 0; f < POST_INDEX_FIELD_COUNT; f++) totalValues += builder->lists[builder->records[i].lists[f]];
+    }
+
+    PostIndexSortKey *keys = (PostIndexSortKey *)calloc(count + totalValues + 1, sizeof(PostIndexSortKey));
+    unsigned int *values[POST_INDEX_FIELD_COUNT] = { 0 };   // Distinct values: offsets followed by counts
+    for (int f = 0; f < POST_INDEX_FIELD_COUNT; f++) values[f] = (unsigned int *)calloc(totalValues*2 + 1, sizeof(unsigned int));
+
+    bool success = (keys != NULL) && (values[0] != NULL) && (values[1] != NULL) && (values[2] != NULL);
+    unsigned char *data = NULL;
+    size_t dataSize = 0;
+
+    if (success)
+    {
+        // Records sorted by path
+        for (int i = 0; i < count; i++) keys[i] = (PostIndexSortKey){ builder->strings + builder->records[i].strings[0], (unsigned int)i };
+        qsort(keys, count, sizeof(PostIndexSortKey), ComparePostIndexKeys);
+
+        PostIndexRecord *records = (PostIndexRecord *)malloc((count + 1)*sizeof(PostIndexRecord));
+        success = (records != NULL);
+        for (int i = 0; success && (i < count); i++) records[i] = builder->records[keys[i].value];
+        if (success)
+        {
+            free(builder->records);
+            builder->records = records;
+        }
+    }
+
+    if (success)
+    {
+        // Distinct values of every field, sorted, with posts count
+        for (int f = 0; f < POST_INDEX_FIELD_COUNT; f++)
+        {
+            int keyCount = 0;
+            for (int i = 0; i < count; i++)
+            {
+                const unsigned int *list = builder->lists + builder->records[i].lists[f];
+                for (unsigned int k = 0; k < list[0]; k++) keys[keyCount++] = (PostIndexSortKey){ builder->strings + list[1 + k], list[1 + k] };
+            }
+            qsort(keys, keyCount, sizeof(PostIndexSortKey), ComparePostIndexKeys);
+
+            unsigned int distinct = 0;
+            unsigned int *counts = values[f] + totalValues;
+            for (int i = 0; i < keyCount; i++)
+            {
+                if ((distinct == 0) || (values[f][distinct - 1] != keys[i].value))
+                {
+                    values[f][distinct] = keys[i].value;
+                    counts[distinct] = 0;
+                    distinct++;
+                }
+                counts[distinct - 1]++;
+            }
+            valuesCount[f] = distinct;
+        }
+
+        // Slug order: records positions sorted by slug
+        for (int i = 0; i < count; i++) keys[i] = (PostIndexSortKey){ builder->strings + builder->records[i].strings[1], (unsigned int)i };
+        qsort(keys, count, sizeof(PostIndexSortKey), ComparePostIndexKeys);
+
+        dataSize = POST_INDEX_HEADER_SIZE + (size_t)count*(POST_INDEX_COLUMNS*4 + 20) + builder->listsSize*4 +
+            (valuesCount[0] + valuesCount[1] + valuesCount[2])*8 + builder->stringsSize;
+        data = (unsigned char *)calloc(dataSize, 1);
+        success = (data != NULL);
+    }
+
+    if (success)
+    {
+        memcpy(data, "SQPI", 4);
+        data[4] = POST_INDEX_VERSION & 0xff;
+        data[5] = (POST_INDEX_VERSION >> 8) & 0xff;
+        WritePostIndexUint(data + 8, (unsigned int)count);
+        WritePostIndexUint(data + 12, builder->listsSize);
+        WritePostIndexUint(data + 16, builder->stringsSize);
+        for (int f = 0; f < POST_INDEX_FIELD_COUNT; f++) WritePostIndexUint(data + 20 + f*4, valuesCount[f]);
+
+        unsigned char *column = data + POST_INDEX_HEADER_SIZE;
+        for (int k = 0; k < 4; k++, column += count*4) for (int i = 0; i < count; i++) WritePostIndexUint(column + i*4, builder->records[i].strings[k]);
+        for (int f = 0; f < POST_INDEX_FIELD_COUNT; f++, column += count*4) for (int i = 0; i < count; i++) WritePostIndexUint(column + i*4, builder->records[i].lists[f]);
+        for (int i = 0; i < count; i++) WritePostIndexUint(column + i*4, keys[i].value);
+        column += count*4;
+
+        for (int i = 0; i < count; i++) memcpy(column + i*20, builder->records[i].blobId, 20);
+        column += count*20;
+
+        for (unsigned int i = 0; i < builder->listsSize; i++) WritePostIndexUint(column + i*4, builder->lists[i]);
+        column += builder->listsSize*4;
+
+        for (int f = 0; f < POST_INDEX_FIELD_COUNT; f++)
+        {
+            for (unsigned int i = 0; i < valuesCount[f]; i++) WritePostIndexUint(column + i*4, values[f][i]);
+            column += valuesCount[f]*4;
+            for (unsigned int i = 0; i < valuesCount[f]; i++) WritePostIndexUint(column + i*4, values[f][totalValues + i]);
+            column += valuesCount[f]*4;
+        }
+
+        memcpy(column, builder->strings, builder->stringsSize);
+
+        FileBatch *batch = BeginFileBatch();
+        SaveBatchFileData(batch, fileName, data, (int)dataSize);
+        success = EndFileBatch(batch);
+    }
+
+    free(data);
+    free(keys);
+    for (int f = 0; f < POST_INDEX_FIELD_COUNT; f++) free(values[f]);
+    AbortPostIndex(builder);
+
+    return success;
+}
+
+// Abort post index building, builder is freed
+void AbortPostIndex(PostIndexBuilder *builder)
+{
+    if (builder == NULL) return;
+
+    free(builder->records);
+    free(builder->strings);
+    free(builder->stringsTable);
+    free(builder->lists);
+    free(builder);
+}
+
+#endif // POST_INDEX_IMPLEMENTATION
@@ -0,0 +1,770 @@
+/*******************************************************************************************
+*
+*   Preview Server - Local HTTP/1.1 server for rendered previews, epoll event loop thread
+*
+*   MODULE USAGE:
+*       #define PREVIEW_SERVER_IMPLEMENTATION
+*       #include "preview_server.h"
+*
+*       PreviewServer *server = LoadPreviewServer("./posts/preview", 4390);  // NULL if not available
+*       SetPreviewServerPage(server, "/draft-0/index.html", html, size);     // Served from memory (copied)
+*       OpenURL(TextFormat("http://127.0.0.1:%i/draft-0/", GetPreviewServerPort(server)));
+*       RemovePreviewServerPage(server, "/draft-0/index.html");             // Served from disk again
+*       UnloadPreviewServer(server);
+*
+*   NOTES:
+*       Server only listens on 127.0.0.1, a single thread runs an epoll loop (non-blocking sockets,
+*       keep-alive and pipelined requests), so a browser refreshing a preview never blocks the GUI.
+*       Only GET and HEAD requests are served
+*
+*       Pages set in memory are served first (i.e. draft previews, replaced when draft is prepared
+*       again), other paths are files of root folder sent with sendfile() (no copies to user space).
+*       Memory pages are reference counted: a page replaced while being sent is freed once sent
+*
+*       Paths ending with '/' are served as <path>/index.html, folders are redirected to <path>/,
+*       paths with ".." segments are rejected. Responses are never cached by browser (no-cache)
+*
+*       Only available on Linux (epoll, sendfile), LoadPreviewServer() returns NULL otherwise
+*
+*   DEPENDENCIES:
+*       pthread         - Server thread, pages mutex
+*
+*   LICENSE: GPLv3, check LICENSE file for details
+*
+**********************************************************************************************/
+
+#ifndef PREVIEW_SERVER_H
+#define PREVIEW_SERVER_H
+
+#include <stdbool.h>        // Required for: bool
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define PREVIEW_SERVER_MAX_CONNECTIONS  256         // Connections over limit are closed when accepted
+#define PREVIEW_SERVER_REQUEST_SIZE     8192        // Max request header size
+#define PREVIEW_SERVER_PAGE_BUCKETS     1024        // Memory pages hash table size
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Preview server, opaque type
+typedef struct PreviewServer PreviewServer;
+
+// Preview server statistics
+typedef struct PreviewServerStats {
+    long long requestCount;
+    long long memoryCount;          // Requests served from memory pages
+    long long bytesSent;
+    double averageLatency;          // Seconds from request received to response sent
+    double maxLatency;
+} PreviewServerStats;
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+PreviewServer *LoadPreviewServer(const char *rootPath, int port); // Load server on 127.0.0.1:port (0: any free port), NULL on failure
+void UnloadPreviewServer(PreviewServer *server);        // Unload server, thread is stopped and connections closed
+int GetPreviewServerPort(const PreviewServer *server);  // Get listening port
+void SetPreviewServerPage(PreviewServer *server, const char *path, const char *data, int size); // Set page served from memory (data copied), replaces previous page
+void RemovePreviewServerPage(PreviewServer *server, const char *path); // Remove page from memory, path is served from root folder again
+PreviewServerStats GetPreviewServerStats(PreviewServer *server); // Get requests statistics
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PREVIEW_SERVER_H
+
+/***********************************************************************************
+*
+*   PREVIEW_SERVER IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(PREVIEW_SERVER_IMPLEMENTATION)
+
+#if defined(__linux__)
+
+#include <stdio.h>          // Required for: snprintf()
+#include <stdlib.h>         // Required for: calloc(), malloc(), free()
+#include <string.h>         // Required for: memcpy(), memmove(), strlen(), strcmp(), strncmp(), strrchr()
+#include <strings.h>        // Required for: strncasecmp()
+#include <errno.h>          // Required for: errno, EAGAIN, EINTR
+#include <time.h>           // Required for: clock_gettime()
+#include <pthread.h>        // Required for: pthread_create(), pthread_join(), pthread_mutex_*(), pthread_sigmask()
+#include <signal.h>         // Required for: sigset_t, sigemptyset(), sigaddset(), SIGPIPE
+#include <fcntl.h>          // Required for: open(), fcntl(), O_NONBLOCK
+#include <unistd.h>         // Required for: close(), read(), write()
+#include <sys/stat.h>       // Required for: stat()
+#include <sys/socket.h>     // Required for: socket(), bind(), listen(), accept(), send(), recv()
+#include <sys/epoll.h>      // Required for: epoll_create1(), epoll_ctl(), epoll_wait()
+#include <sys/eventfd.h>    // Required for: eventfd()
+#include <sys/sendfile.h>   // Required for: sendfile()
+#include <netinet/in.h>     // Required for: sockaddr_in, htons(), htonl()
+#include <netinet/tcp.h>    // Required for: TCP_NODELAY
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Page served from memory, freed once removed and not being sent
+typedef struct PreviewPage {
+    char *path;
+    char *data;
+    int size;
+    int references;                 // Table reference (until removed) and connections sending it
+    struct PreviewPage *next;       // Next page in hash bucket
+} PreviewPage;
+
+// Client connection, request is read and response is sent without blocking
+typedef struct PreviewConnection {
+    int socket;
+    char request[PREVIEW_SERVER_REQUEST_SIZE];
+    int requestSize;
+    char header[512];               // Response header
+    int headerSize;
+    int headerSent;
+    PreviewPage *page;              // Response body from memory
+    int file;                       // Response body from file (-1 if none)
+    off_t offset;                   // Body bytes sent
+    off_t bodySize;
+    bool keepAlive;
+    double startTime;               // Request received
+    struct PreviewConnection *prev;
+    struct PreviewConnection *next;
+} PreviewConnection;
+
+struct PreviewServer {
+    int socket;                     // Listening socket
+    int epoll;
+    int wakeEvent;                  // Stop request, makes epoll_wait() return
+    int port;
+    char rootPath[256];
+    pthread_t thread;
+    pthread_mutex_t mutex;          // Protects pages and statistics
+    PreviewPage *pages[PREVIEW_SERVER_PAGE_BUCKETS];
+    PreviewConnection *connections; // Open connections list (server thread only)
+    int connectionCount;
+    PreviewServerStats stats;
+    double totalLatency;
+};
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+static double GetPreviewServerTime(void)
+{
+    struct timespec now = { 0 };
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec*1e-9;
+}
+
+static unsigned int HashPreviewPath(const char *path)
+{
+    unsigned int hash = 2166136261u;
+    for (const char *ptr = path; *ptr != '\0'; ptr++) hash = (hash ^ (unsigned char)*ptr)*16777619u;
+    return hash%PREVIEW_SERVER_PAGE_BUCKETS;
+}
+
+// Release page reference, page is freed once not referenced (mutex locked by caller)
+static void ReleasePreviewPage(PreviewPage *page)
+{
+    if (--page->references > 0) return;
+
+    free(page->path);
+    free(page->data);
+    free(page);
+}
+
+// Detach page from table (mutex locked by caller), table reference is released
+static void RemovePreviewPage(PreviewServer *server, const char *path)
+{
+    PreviewPage **link = &server->pages[HashPreviewPath(path)];
+    while ((*link != NULL) && (strcmp((*link)->path, path) != 0)) link = &(*link)->next;
+    if (*link == NULL) return;
+
+    PreviewPage *page = *link;
+    *link = page->next;
+    ReleasePreviewPage(page);
+}
+
+// Get content type from file extension
+static const char *GetPreviewContentType(const char *path)
+{
+    static const char *types[][2] = {
+        { ".html", "text/html; charset=utf-8" }, { ".htm", "text/html; charset=utf-8" }, { ".css", "text/css" },
+        { ".js", "text/javascript" }, { ".json", "application/json" }, { ".xml", "application/xml" },
+        { ".txt", "text/plain; charset=utf-8" }, { ".md", "text/plain; charset=utf-8" }, { ".png", "image/png" },
+        { ".jpg", "image/jpeg" }, { ".jpeg", "image/jpeg" }, { ".gif", "image/gif" }, { ".svg", "image/svg+xml" },
+        { ".webp", "image/webp" }, { ".ico", "image/x-icon" }, { ".woff2", "font/woff2" }
+    };
+
+    const char *extension = strrchr(path, '.');
+    if ((extension == NULL) || (strchr(extension, '/') != NULL)) return "application/octet-stream";
+
+    for (int i = 0; i < (int)(sizeof(types)/sizeof(types[0])); i++)
+    {
+        const char *type = types[i][0];
+        int k = 0;
+        while ((type[k] != '\0') && (extension[k] != '\0') && (type[k] == (((extension[k] >= 'A') && (extension[k] <= 'Z'))? extension[k] + 32 : extension[k]))) k++;
+        if ((type[k] == '\0') && (extension[k] == '\0')) return types[i][1];
+    }
+
+    return "application/octet-stream";
+}
+
+// Decode request path: query removed, %XX sequences decoded, "index.html" added to folders paths
+// NOTE: Returns false if path is not valid (not absolute, ".." segments, control characters, too long)
+static bool DecodePreviewPath(const char *target, int length, char *path, int pathSize)
+{
+    int size = 0;
+    for (int i = 0; (i < length) && (target[i] != '?') && (target[i] != '#'); i++)
+    {
+        char c = target[i];
+        if ((c == '%') && ((i + 2) < length))
+        {
+            int value = 0;
+            for (int k = 1; k <= 2; k++)
+            {
+                char h = target[i + k];
+                value = value*16 + (((h >= '0') && (h <= '9'))? h - '0' : (((h | 32) >= 'a') && ((h | 32) <= 'f'))? (h | 32) - 'a' + 10 : -256);
+            }
+            if ((value <= 0) || (value > 255)) return false;
+
+            c = (char)value;
+            i += 2;
+        }
+
+        // Control characters (i.e. decoded CR/LF) are never valid, path is echoed in Location header
+        if (((unsigned char)c < 0x20) || ((unsigned char)c == 0x7f)) return false;
+
+        if (size >= (pathSize - 16)) return false;
+        path[size++] = c;
+    }
+    path[size] = '\0';
+
+    if ((size == 0) || (path[0] != '/')) return false;
+
+    for (int i = 0; i < size; i++)
+    {
+        if ((path[i] == '/') && (path[i + 1] == '.') && (path[i + 2] == '.') && ((path[i + 3] == '/') || (path[i + 3] == '\0'))) return false;
+        if (path[i] == '\\') return false;
+    }
+
+    if (path[size - 1] == '/') strcpy(path + size, "index.html");
+
+    return true;
+}
+
+// Prepare response header (and body, page or file) for request
+static void PreparePreviewResponse(PreviewServer *server, PreviewConnection *connection, const char *method, const char *target, int targetLength)
+{
+    static const char *notFound = "<!DOCTYPE html>\n<html><body><h1>404 Not Found</h1></body></html>\n";
+
+    bool head = (strcmp(method, "HEAD") == 0);
+    char path[1024] = { 0 };
+    int status = 200;
+    const char *type = "text/html; charset=utf-8";
+    const char *location = NULL;
+
+    connection->page = NULL;
+    connection->file = -1;
+    connection->offset = 0;
+    connection->bodySize = 0;
+
+    if (!head && (strcmp(method, "GET") != 0)) status = 405;
+    else if (!DecodePreviewPath(target, targetLength, path, sizeof(path))) status = 404;
+    else
+    {
+        pthread_mutex_lock(&server->mutex);
+        PreviewPage *page = server->pages[HashPreviewPath(path)];
+        while ((page != NULL) && (strcmp(page->path, path) != 0)) page = page->next;
+        if (page != NULL)
+        {
+            page->references++;
+            server->stats.memoryCount++;
+        }
+        pthread_mutex_unlock(&server->mutex);
+
+        if (page != NULL)
+        {
+            connection->page = page;
+            connection->bodySize = page->size;
+            type = GetPreviewContentType(path);
+        }
+        else
+        {
+            char fileName[1400] = { 0 };
+            snprintf(fileName, sizeof(fileName), "%s%s", server->rootPath, path);
+
+            // Folders are redirected to <path>/, so relative links resolve from folder
+            struct stat info = { 0 };
+            int file = -1;
+            if (stat(fileName, &info) != 0) status = 404;
+            else if (S_ISDIR(info.st_mode)) status = 301;
+            else if (!S_ISREG(info.st_mode) || ((file = open(fileName, O_RDONLY | O_CLOEXEC)) < 0)) status = 404;
+
+            if (status == 200)
+            {
+                connection->file = file;
+                connection->bodySize = info.st_size;
+                type = GetPreviewContentType(path);
+            }
+            else if (status == 301) location = path;
+        }
+    }
+
+    const char *reason = (status == 200)? "OK" : (status == 301)? "Moved Permanently" : (status == 405)? "Method Not Allowed" : "Not Found";
+    if (status != 200) connection->bodySize = (off_t)strlen(notFound);
+
+    connection->headerSize = snprintf(connection->header, sizeof(connection->header),
+        "HTTP/1.1 %i %s\r\nContent-Type: %s\r\nContent-Length: %lld\r\nCache-Control: no-cache\r\n%s%s%s%s\r\n",
+        status, reason, type, (long long)connection->bodySize, (location != NULL)? "Location: " : "", (location != NULL)? location : "",
+        (location != NULL)? "/\r\n" : "", connection->keepAlive? "" : "Connection: close\r\n");
+    connection->headerSent = 0;
+
+    // Error responses body is sent with header
+    if (status != 200)
+    {
+        if (!head && ((connection->headerSize + (int)strlen(notFound)) < (int)sizeof(connection->header)))
+        {
+            strcpy(connection->header + connection->headerSize, notFound);
+            connection->headerSize += (int)strlen(notFound);
+        }
+        connection->bodySize = 0;
+    }
+
+    if (head)
+    {
+        if (connection->file >= 0) close(connection->file);
+        connection->file = -1;
+        if (connection->page != NULL)
+        {
+            pthread_mutex_lock(&server->mutex);
+            ReleasePreviewPage(connection->page);
+            pthread_mutex_unlock(&server->mutex);
+        }
+        connection->page = NULL;
+        connection->bodySize = 0;
+    }
+}
+
+// Release response body (page reference or file), request statistics updated
+static void EndPreviewResponse(PreviewServer *server, PreviewConnection *connection)
+{
+    double latency = GetPreviewServerTime() - connection->startTime;
+
+    pthread_mutex_lock(&server->mutex);
+    if (connection->page != NULL) ReleasePreviewPage(connection->page);
+    server->stats.requestCount++;
+    server->stats.bytesSent += connection->headerSize + connection->offset;
+    server->totalLatency += latency;
+    if (latency > server->stats.maxLatency) server->stats.maxLatency = latency;
+    pthread_mutex_unlock(&server->mutex);
+
+    if (connection->file >= 0) close(connection->file);
+    connection->page = NULL;
+    connection->file = -1;
+    connection->headerSize = 0;
+}
+
+static void ClosePreviewConnection(PreviewServer *server, PreviewConnection *connection)
+{
+    if ((connection->page != NULL) || (connection->file >= 0))
+    {
+        pthread_mutex_lock(&server->mutex);
+        if (connection->page != NULL) ReleasePreviewPage(connection->page);
+        pthread_mutex_unlock(&server->mutex);
+        if (connection->file >= 0) close(connection->file);
+    }
+
+    close(connection->socket);      // Removed from epoll set once closed
+
+    if (connection->prev != NULL) connection->prev->next = connection->next;
+    else server->connections = connection->next;
+    if (connection->next != NULL) connection->next->prev = connection->prev;
+
+    free(connection);
+    server->connectionCount--;
+}
+
+// Parse complete request in connection buffer, response is prepared (returns false if no complete request)
+static bool ParsePreviewRequest(PreviewServer *server, PreviewConnection *connection, bool *invalid)
+{
+    *invalid = false;
+
+    int end = -1;
+    for (int i = 3; i < connection->requestSize; i++)
+    {
+        if ((connection->request[i - 3] == '\r') && (connection->request[i - 2] == '\n') && (connection->request[i - 1] == '\r') && (connection->request[i] == '\n')) { end = i + 1; break; }
+    }
+
+    if (end < 0)
+    {
+        *invalid = (connection->requestSize >= PREVIEW_SERVER_REQUEST_SIZE);
+        return false;
+    }
+
+    // Request line: <method> <target> HTTP/1.x
+    const char *request = connection->request;
+    int methodLength = 0;
+    while ((methodLength < 8) && (request[methodLength] != ' ') && (methodLength < end)) methodLength++;
+    int targetStart = methodLength + 1;
+    int targetEnd = targetStart;
+    while ((targetEnd < end) && (request[targetEnd] != ' ') && (request[targetEnd] != '\r')) targetEnd++;
+
+    if ((methodLength >= 8) || (request[methodLength] != ' ') || (targetEnd >= end) || (request[targetEnd] != ' ') || (strncmp(request + targetEnd + 1, "HTTP/1.", 7) != 0))
+    {
+        *invalid = true;
+        return false;
+    }
+
+    char method[8] = { 0 };
+    memcpy(method, request, methodLength);
+
+    // HTTP/1.1 keeps connection alive unless "Connection: close", HTTP/1.0 only with "Connection: keep-alive"
+    connection->keepAlive = (request[targetEnd + 8] == '1');
+    for (int i = targetEnd; i < (end - 12); i++)
+    {
+        if ((request[i] != '\n') || (strncasecmp(request + i + 1, "Connection:", 11) != 0)) continue;
+
+        int value = i + 12;
+        while ((value < end) && (request[value] == ' ')) value++;
+        if (strncasecmp(request + value, "close", 5) == 0) connection->keepAlive = false;
+        else if (strncasecmp(request + value, "keep-alive", 10) == 0) connection->keepAlive = true;
+    }
+
+    connection->startTime = GetPreviewServerTime();
+    PreparePreviewResponse(server, connection, method, request + targetStart, targetEnd - targetStart);
+
+    // Pipelined requests are kept for next response
+    memmove(connection->request, connection->request + end, connection->requestSize - end);
+    connection->requestSize -= end;
+
+    return true;
+}
+
+// Send response (header, then body without copies), returns false if connection failed
+static bool SendPreviewResponse(PreviewConnection *connection)
+{
+    while (connection->headerSent < connection->headerSize)
+    {
+        ssize_t sent = send(connection->socket, connection->header + connection->headerSent, connection->headerSize - connection->headerSent,
+            MSG_NOSIGNAL | ((connection->bodySize > 0)? MSG_MORE : 0));
+        if (sent < 0) return (errno == EAGAIN) || (errno == EINTR);
+        connection->headerSent += (int)sent;
+    }
+
+    while (connection->offset < connection->bodySize)
+    {
+        ssize_t sent = 0;
+        if (connection->page != NULL) sent = send(connection->socket, connection->page->data + connection->offset, connection->bodySize - connection->offset, MSG_NOSIGNAL);
+        else
+        {
+            off_t offset = connection->offset;
+            sent = sendfile(connection->socket, connection->file, &offset, connection->bodySize - connection->offset);
+            if (sent == 0) return false;    // File truncated while sent
+        }
+
+        if (sent < 0) return (errno == EAGAIN) || (errno == EINTR);
+        connection->offset += sent;
+    }
+
+    return true;
+}
+
+static bool IsPreviewResponseDone(const PreviewConnection *connection)
+{
+    return (connection->headerSent >= connection->headerSize) && (connection->offset >= connection->bodySize);
+}
+
+// Handle connection event: read requests and send responses until socket would block
+static void UpdatePreviewConnection(PreviewServer *server, PreviewConnection *connection, unsigned int events)
+{
+    if (events & (EPOLLERR | EPOLLHUP))
+    {
+        ClosePreviewConnection(server, connection);
+        return;
+    }
+
+    bool reading = (connection->headerSize == 0);
+    bool failed = false;
+
+    if (reading && (events & EPOLLIN))
+    {
+        ssize_t size = recv(connection->socket, connection->request + connection->requestSize, PREVIEW_SERVER_REQUEST_SIZE - connection->requestSize, 0);
+        if (size > 0) connection->requestSize += (int)size;
+        else if ((size == 0) || ((errno != EAGAIN) && (errno != EINTR))) failed = true;
+    }
+
+    // Responses are sent while complete requests are available (pipelining), stops when socket buffer is full
+    while (!failed)
+    {
+        if (connection->headerSize == 0)
+        {
+            bool invalid = false;
+            if (!ParsePreviewRequest(server, connection, &invalid)) { failed = invalid; break; }
+        }
+
+        if (!SendPreviewResponse(connection)) { failed = true; break; }
+        if (!IsPreviewResponseDone(connection)) break;
+
+        bool keepAlive = connection->keepAlive;
+        EndPreviewResponse(server, connection);
+        if (!keepAlive) { failed = true; break; }
+    }
+
+    if (failed)
+    {
+        ClosePreviewConnection(server, connection);
+        return;
+    }
+
+    // Socket is watched for writing only while a response is pending
+    struct epoll_event event = { 0 };
+    event.events = (connection->headerSize > 0)? EPOLLOUT : EPOLLIN;
+    event.data.ptr = connection;
+    epoll_ctl(server->epoll, EPOLL_CTL_MOD, connection->socket, &event);
+}
+
+// Accept pending connections, connections over limit are closed
+static void AcceptPreviewConnections(PreviewServer *server)
+{
+    while (true)
+    {
+        int client = accept(server->socket, NULL, NULL);
+        if (client < 0) return;
+
+        fcntl(client, F_SETFL, O_NONBLOCK);
+        fcntl(client, F_SETFD, FD_CLOEXEC);
+
+        PreviewConnection *connection = (server->connectionCount < PREVIEW_SERVER_MAX_CONNECTIONS)? (PreviewConnection *)calloc(1, sizeof(PreviewConnection)) : NULL;
+        if (connection == NULL)
+        {
+            close(client);
+            continue;
+        }
+
+        int noDelay = 1;
+        setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+        connection->socket = client;
+        connection->file = -1;
+
+        struct epoll_event event = { 0 };
+        event.events = EPOLLIN;
+        event.data.ptr = connection;
+        if (epoll_ctl(server->epoll, EPOLL_CTL_ADD, client, &event) != 0)
+        {
+            close(client);
+            free(connection);
+            continue;
+        }
+
+        connection->next = server->connections;
+        if (server->connections != NULL) server->connections->prev = connection;
+        server->connections = connection;
+        server->connectionCount++;
+    }
+}
+
+// Server thread: epoll loop until stop is requested, connections are closed on exit
+static void *RunPreviewServer(void *data)
+{
+    PreviewServer *server = (PreviewServer *)data;
+    struct epoll_event events[64];
+    bool running = true;
+
+    // sendfile() to a closed connection raises SIGPIPE (no MSG_NOSIGNAL flag), blocked for this thread
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &signals, NULL);
+
+    while (running)
+    {
+        int count = epoll_wait(server->epoll, events, 64, -1);
+        if ((count < 0) && (errno != EINTR)) break;
+
+        for (int i = 0; i < count; i++)
+        {
+            if (events[i].data.ptr == &server->socket) AcceptPreviewConnections(server);
+            else if (events[i].data.ptr == &server->wakeEvent) running = false;
+            else UpdatePreviewConnection(server, (PreviewConnection *)events[i].data.ptr, events[i].events);
+        }
+    }
+
+    while (server->connections != NULL) ClosePreviewConnection(server, server->connections);
+
+    return NULL;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Load preview server: socket listening on 127.0.0.1:port and epoll loop thread started
+PreviewServer *LoadPreviewServer(const char *rootPath, int port)
+{
+    PreviewServer *server = (PreviewServer *)calloc(1, sizeof(PreviewServer));
+    if (server == NULL) return NULL;
+
+    snprintf(server->rootPath, sizeof(server->rootPath), "%s", rootPath);
+    int length = (int)strlen(server->rootPath);
+    while ((length > 0) && (server->rootPath[length - 1] == '/')) server->rootPath[--length] = '\0';
+
+    server->socket = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    server->epoll = epoll_create1(EPOLL_CLOEXEC);
+    server->wakeEvent = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    int reuse = 1;
+    if (server->socket >= 0) setsockopt(server->socket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    struct sockaddr_in address = { 0 };
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons((unsigned short)port);
+    socklen_t addressSize = sizeof(address);
+
+    bool success = (server->socket >= 0) && (server->epoll >= 0) && (server->wakeEvent >= 0) &&
+        (bind(server->socket, (struct sockaddr *)&address, sizeof(address)) == 0) && (listen(server->socket, 128) == 0) &&
+        (getsockname(server->socket, (struct sockaddr *)&address, &addressSize) == 0);
+
+    if (success)
+    {
+        server->port = ntohs(address.sin_port);
+
+        struct epoll_event event = { 0 };
+        event.events = EPOLLIN;
+        event.data.ptr = &server->socket;
+        success = (epoll_ctl(server->epoll, EPOLL_CTL_ADD, server->socket, &event) == 0);
+
+        event.data.ptr = &server->wakeEvent;
+        success = success && (epoll_ctl(server->epoll, EPOLL_CTL_ADD, server->wakeEvent, &event) == 0);
+    }
+
+    success = success && (pthread_mutex_init(&server->mutex, NULL) == 0);
+    if (success && (pthread_create(&server->thread, NULL, RunPreviewServer, server) != 0))
+    {
+        pthread_mutex_destroy(&server->mutex);
+        success = false;
+    }
+
+    if (!success)
+    {
+        if (server->socket >= 0) close(server->socket);
+        if (server->epoll >= 0) close(server->epoll);
+        if (server->wakeEvent >= 0) close(server->wakeEvent);
+        free(server);
+        return NULL;
+    }
+
+    return server;
+}
+
+// Unload preview server: thread is stopped, connections closed and memory pages freed
+void UnloadPreviewServer(PreviewServer *server)
+{
+    if (server == NULL) return;
+
+    unsigned long long value = 1;
+    if (write(server->wakeEvent, &value, sizeof(value)) == sizeof(value)) pthread_join(server->thread, NULL);
+
+    close(server->socket);
+    close(server->epoll);
+    close(server->wakeEvent);
+
+    for (int i = 0; i < PREVIEW_SERVER_PAGE_BUCKETS; i++)
+    {
+        while (server->pages[i] != NULL)
+        {
+            PreviewPage *page = server->pages[i];
+            server->pages[i] = page->next;
+            ReleasePreviewPage(page);
+        }
+    }
+
+    pthread_mutex_destroy(&server->mutex);
+    free(server);
+}
+
+int GetPreviewServerPort(const PreviewServer *server)
+{
+    return (server != NULL)? server->port : 0;
+}
+
+// Set page served from memory, data is copied
+// NOTE: A previous page with same path is replaced, requests already being answered keep previous page
+void SetPreviewServerPage(PreviewServer *server, const char *path, const char *data, int size)
+{
+    if (server == NULL) return;
+
+    PreviewPage *page = (PreviewPage *)calloc(1, sizeof(PreviewPage));
+    if (page == NULL) return;
+
+    page->path = (char *)malloc(strlen(path) + 1);
+    page->data = (char *)malloc((size > 0)? size : 1);
+    if ((page->path == NULL) || (page->data == NULL))
+    {
+        free(page->path);
+        free(page->data);
+        free(page);
+        return;
+    }
+
+    strcpy(page->path, path);
+    memcpy(page->data, data, size);
+    page->size = size;
+    page->references = 1;
+
+    unsigned int bucket = HashPreviewPath(path);
+
+    pthread_mutex_lock(&server->mutex);
+    RemovePreviewPage(server, path);
+    page->next = server->pages[bucket];
+    server->pages[bucket] = page;
+    pthread_mutex_unlock(&server->mutex);
+}
+
+// Remove page from memory, path is served from root folder again
+void RemovePreviewServerPage(PreviewServer *server, const char *path)
+{
+    if (server == NULL) return;
+
+    pthread_mutex_lock(&server->mutex);
+    RemovePreviewPage(server, path);
+    pthread_mutex_unlock(&server->mutex);
+}
+
+// Get requests statistics
+PreviewServerStats GetPreviewServerStats(PreviewServer *server)
+{
+    PreviewServerStats stats = { 0 };
+    if (server == NULL) return stats;
+
+    pthread_mutex_lock(&server->mutex);
+    stats = server->stats;
+    if (stats.requestCount > 0) stats.averageLatency = server->totalLatency/stats.requestCount;
+    pthread_mutex_unlock(&server->mutex);
+
+    return stats;
+}
+
+#else
+
+// Preview server is not available on this platform (epoll, sendfile)
+struct PreviewServer { int port; };
+
+PreviewServer *LoadPreviewServer(const char *rootPath, int port) { (void)rootPath; (void)port; return NULL; }
+void UnloadPreviewServer(PreviewServer *server) { (void)server; }
+int GetPreviewServerPort(const PreviewServer *server) { (void)server; return 0; }
+void SetPreviewServerPage(PreviewServer *server, const char *path, const char *data, int size) { (void)server; (void)path; (void)data; (void)size; }
+void RemovePreviewServerPage(PreviewServer *server, const char *path) { (void)server; (void)path; }
+PreviewServerStats GetPreviewServerStats(PreviewServer *server) { (void)server; return (PreviewServerStats){ 0 }; }
+
+#endif  // __linux__
+
+#endif  // PREVIEW_SERVER_IMPLEMENTATION
@@ -0,0 +1,774 @@
+/*******************************************************************************************
+*
+*   Search Index - Incremental sharded inverted index for client-side site search
+*
+*   MODULE USAGE:
+*       #define SEARCH_INDEX_IMPLEMENTATION
+*       #include "search_index.h"
+*
+*       SearchIndexPost post = { "/blog/hello/", "Hello", "2024-05-01", body, bodyLength, previousBody, previousBodyLength };
+*       SearchIndexStats stats = { 0 };
+*       UpdateSearchIndex(&arena, "static/search", &post, 1, &stats);  // Only shards of post terms are updated
+*
+*   NOTES:
+*       Index is a folder of small text files, loaded lazily by browser: a query only fetches
+*       index.json (shards layout), one term shard per query term and one doc shard per result
+*
+*       Terms: lowercase ASCII letters and digits, UTF-8 sequences kept as is, 2 to 32 bytes,
+*       common english words skipped, link targets skipped; title terms count 3 times
+*
+*       Documents are identified by key: FNV-1a hash (64 bit) of post path, in base 36; if key is
+*       already used by another path (doc line of key has another path), next keys are probed
+*       (hash + 1, hash + 2...), so a post keeps the key found on its first update
+*
+*       Index of another version (or missing) must be created with all site posts: its shards are
+*       not read, every shard is written again (see IsSearchIndexCurrent())
+*
+*       Shards are grown with linear hashing: shard of a key (hash h, FNV-1a of key UTF-8 bytes)
+*           shard = h % 2^level; if (shard < split) shard = h % 2^(level + 1)
+*       once table average shard size is over SEARCH_INDEX_SHARD_SIZE, shard 'split' is divided
+*       in two (only that shard is rewritten), so shards stay small as site grows and an update
+*       only rewrites shards of published posts terms, never the whole index
+*
+*       Updated posts postings are removed from shards of their previous terms (previous text
+*       tokenized) and from every shard loaded, then their new postings are added
+*
+*   FILE STRUCTURE:
+*       index.json      Layout: {"version":2,"hash":"fnv1a32","shardSize":S,
+*                           "terms":{"level":L,"split":P,"size":B},"docs":{"level":L,"split":P,"size":B}}
+*       t/<shard>.txt   Term lines, sorted: <term>\t<key>[*<count>] <key>[*<count>] ...
+*       d/<shard>.txt   Document lines, sorted: <key>\t<path>\t<title>\t<date>
+*
+*   DEPENDENCIES:
+*       arena.h             - Shards data and tokens are allocated in caller arena
+*
+*   LICENSE: GPLv3, check LICENSE file for details
+*
+**********************************************************************************************/
+
+#ifndef SEARCH_INDEX_H
+#define SEARCH_INDEX_H
+
+#include "arena.h"
+
+#include <stdbool.h>        // Required for: bool
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define SEARCH_INDEX_VERSION            2
+#define SEARCH_INDEX_MAX_PROBES        16       // Document keys probed on key collisions
+#define SEARCH_INDEX_SHARD_SIZE     32768       // Average shard size (bytes) before a shard is split
+#define SEARCH_INDEX_MIN_TERM           2       // Term length limits (bytes)
+#define SEARCH_INDEX_MAX_TERM          32
+#define SEARCH_INDEX_TITLE_WEIGHT       3       // Title terms count
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Post published or updated, strings are not copied
+typedef struct SearchIndexPost {
+    const char *path;               // Site path (i.e. "/blog/hello/"), document key is its hash (probed on collision)
+    const char *title;
+    const char *date;
+    const char *text;               // Searchable text (i.e. markdown body)
+    int textLength;
+    const char *previousText;       // Previously indexed text, its terms postings are removed (NULL if new post)
+    int previousTextLength;
+} SearchIndexPost;
+
+// Index update statistics
+typedef struct SearchIndexStats {
+    int postCount;
+    int postingCount;               // Postings added (distinct terms of posts)
+    int shardsLoaded;
+    int shardsSaved;
+    int shardsSplit;
+    int shardCount;                 // Term shards after update
+    long long bytesRead;
+    long long bytesWritten;
+} SearchIndexStats;
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+bool UpdateSearchIndex(Arena *arena, const char *folder, const SearchIndexPost *posts, int count, SearchIndexStats *stats); // Update index folder with posts, false if files could not be written
+bool IsSearchIndexCurrent(const char *folder);                  // Check if index folder has an index of current version
+unsigned int GetSearchIndexHash(const char *text, int length);  // Get hash of term or key (FNV-1a, 32 bit)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SEARCH_INDEX_H
+
+/***********************************************************************************
+*
+*   SEARCH_INDEX IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(SEARCH_INDEX_IMPLEMENTATION)
+
+#include <stdio.h>          // Required for: FILE, fopen(), fread(), fprintf(), fscanf(), snprintf(), sscanf(), remove()
+#include <string.h>         // Required for: memcpy(), memmove(), strlen(), strncmp(), strchr(), strstr()
+
+#if defined(_WIN32)
+    #include <direct.h>     // Required for: _mkdir()
+    #define SEARCH_INDEX_MKDIR(path) _mkdir(path)
+#else
+    #include <sys/stat.h>   // Required for: mkdir()
+    #define SEARCH_INDEX_MKDIR(path) mkdir(path, 0755)
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Shard line: key and value (text after first tab)
+typedef struct SearchLine {
+    const char *key;
+    const char *value;
+} SearchLine;
+
+// Shard loaded in memory, lines sorted by key
+typedef struct SearchShard {
+    SearchLine *lines;
+    int count;
+    int capacity;
+    long long loadedSize;           // File size when loaded
+    bool modified;
+} SearchShard;
+
+// Shards table (linear hashing), loaded shards are kept until saved
+typedef struct SearchTable {
+    const char *name;               // Shards folder name
+    int level;
+    int split;
+    long long size;                 // Shards files size, as saved
+    SearchShard **shards;           // Loaded shards by index (NULL if not loaded)
+    int shardCapacity;
+} SearchTable;
+
+// Term of post and its count
+typedef struct SearchTerm {
+    const char *text;
+    int length;
+    int count;
+} SearchTerm;
+
+// Update context
+typedef struct SearchIndex {
+    Arena *arena;
+    const char *folder;
+    SearchTable terms;
+    SearchTable docs;
+    const char **keys;              // Updated posts keys, removed from every term shard loaded
+    const char **paths;             // Updated posts paths (document line text), keys collisions check
+    int keyCount;
+    bool rebuild;                   // Index of another version, shards files are not read
+    SearchIndexStats *stats;
+} SearchIndex;
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+static int GetSearchShardCount(const SearchTable *table)
+{
+    return (1 << table->level) + table->split;
+}
+
+static int GetSearchShardIndex(const SearchTable *table, unsigned int hash)
+{
+    int shard = (int)(hash%(1u << table->level));
+    if (shard < table->split) shard = (int)(hash%(1u << (table->level + 1)));
+
+    return shard;
+}
+
+static long long GetSearchShardSize(const SearchShard *shard)
+{
+    long long size = 0;
+    for (int i = 0; i < shard->count; i++) size += strlen(shard->lines[i].key) + 1 + strlen(shard->lines[i].value) + 1;
+
+    return size;
+}
+
+// Find line by key (binary search), inserted with empty value if requested, -1 if not found
+static int FindSearchLine(Arena *arena, SearchShard *shard, const char *key, int keyLength, bool insert)
+{
+    int low = 0, high = shard->count - 1;
+
+    while (low <= high)
+    {
+        int middle = (low + high)/2;
+        const char *lineKey = shard->lines[middle].key;
+        int result = strncmp(lineKey, key, keyLength);
+        if ((result == 0) && (lineKey[keyLength] != '\0')) result = 1;
+
+        if (result == 0) return middle;
+        else if (result < 0) low = middle + 1;
+        else high = middle - 1;
+    }
+
+    if (!insert) return -1;
+
+    if (shard->count >= shard->capacity)
+    {
+        int capacity = (shard->capacity > 0)? shard->capacity*2 : 64;
+        SearchLine *lines = (SearchLine *)ArenaAlloc(arena, capacity*sizeof(SearchLine));
+        if (shard->count > 0) memcpy(lines, shard->lines, shard->count*sizeof(SearchLine));
+        shard->lines = lines;
+        shard->capacity = capacity;
+    }
+
+    memmove(&shard->lines[low + 1], &shard->lines[low], (shard->count - low)*sizeof(SearchLine));
+    shard->lines[low].key = ArenaFormat(arena, "%.*s", keyLength, key);
+    shard->lines[low].value = "";
+    shard->count++;
+
+    return low;
+}
+
+static void AddSearchLine(Arena *arena, SearchShard *shard, const char *key, int keyLength, const char *value)
+{
+    int line = FindSearchLine(arena, shard, key, keyLength, true);
+    shard->lines[line].value = value;
+    shard->modified = true;
+}
+
+// Remove postings of updated posts from term line value, returns new value
+static const char *RemoveSearchPostings(Arena *arena, const char *value, const char **keys, int keyCount, bool *changed)
+{
+    char *result = NULL;
+    int size = 0;
+    const char *ptr = value;
+
+    while (*ptr != '\0')
+    {
+        const char *posting = ptr;
+        while ((*ptr != ' ') && (*ptr != '\0')) ptr++;
+        int postingLength = (int)(ptr - posting);
+        if (*ptr == ' ') ptr++;
+
+        int keyLength = 0;
+        while ((keyLength < postingLength) && (posting[keyLength] != '*')) keyLength++;
+
+        bool removed = false;
+        for (int i = 0; (i < keyCount) && !removed; i++) removed = ((int)strlen(keys[i]) == keyLength) && (strncmp(keys[i], posting, keyLength) == 0);
+
+        if (removed)
+        {
+            if (result == NULL)
+            {
+                // First removed posting: previous postings copied
+                result = (char *)ArenaAlloc(arena, strlen(value) + 1);
+                size = (int)(posting - value);
+                memcpy(result, value, size);
+                while ((size > 0) && (result[size - 1] == ' ')) size--;
+            }
+            *changed = true;
+        }
+        else if (result != NULL)
+        {
+            if (size > 0) result[size++] = ' ';
+            memcpy(result + size, posting, postingLength);
+            size += postingLength;
+        }
+    }
+
+    if (result == NULL) return value;
+
+    result[size] = '\0';
+    return result;
+}
+
+// Insert posting into term line value, postings sorted by key
+static const char *InsertSearchPosting(Arena *arena, const char *value, const char *key, int count)
+{
+    char posting[32] = { 0 };
+    if (count > 1) snprintf(posting, sizeof(posting), "%s*%i", key, (count < 999)? count : 999);
+    else snprintf(posting, sizeof(posting), "%s", key);
+
+    int keyLength = (int)strlen(key);
+    const char *ptr = value;
+
+    while (*ptr != '\0')
+    {
+        int length = 0;
+        while ((ptr[length] != ' ') && (ptr[length] != '*') && (ptr[length] != '\0')) length++;
+
+        int result = strncmp(ptr, key, (length < keyLength)? length : keyLength);
+        if ((result > 0) || ((result == 0) && (length > keyLength))) break;
+
+        while ((*ptr != ' ') && (*ptr != '\0')) ptr++;
+        if (*ptr == ' ') ptr++;
+    }
+
+    int before = (int)(ptr - value);
+    while ((before > 0) && (value[before - 1] == ' ')) before--;
+
+    return ArenaFormat(arena, "%.*s%s%s%s%s", before, value, (before > 0)? " " : "", posting, (*ptr != '\0')? " " : "", ptr);
+}
+
+static const char *GetSearchShardFileName(const SearchIndex *index, const SearchTable *table, int shard)
+{
+    return ArenaFormat(index->arena, "%s/%s/%i.txt", index->folder, table->name, shard);
+}
+
+// Load shard (once), updated posts postings are removed from term shards
+static SearchShard *LoadSearchShard(SearchIndex *index, SearchTable *table, int shardIndex)
+{
+    if (shardIndex >= table->shardCapacity)
+    {
+        int capacity = (table->shardCapacity > 0)? table->shardCapacity : 64;
+        while (capacity <= shardIndex) capacity *= 2;
+
+        SearchShard **shards = (SearchShard **)ArenaAlloc(index->arena, capacity*sizeof(SearchShard *));
+        if (table->shardCapacity > 0) memcpy(shards, table->shards, table->shardCapacity*sizeof(SearchShard *));
+        table->shards = shards;
+        table->shardCapacity = capacity;
+    }
+
+    if (table->shards[shardIndex] != NULL) return table->shards[shardIndex];
+
+    SearchShard *shard = (SearchShard *)ArenaAlloc(index->arena, sizeof(SearchShard));
+    table->shards[shardIndex] = shard;
+
+    FILE *file = index->rebuild? NULL : fopen(GetSearchShardFileName(index, table, shardIndex), "rb");
+    if (file == NULL) return shard;
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    char *data = (char *)ArenaAlloc(index->arena, (size > 0)? size + 1 : 1);
+    size = (size > 0)? (long)fread(data, 1, size, file) : 0;
+    data[size] = '\0';
+    fclose(file);
+
+    shard->loadedSize = size;
+    index->stats->shardsLoaded++;
+    index->stats->bytesRead += size;
+
+    // Lines are split in place, file lines are sorted (as saved)
+    int lineCount = 0;
+    for (long i = 0; i < size; i++) if (data[i] == '\n') lineCount++;
+    shard->capacity = lineCount + 1;
+    shard->lines = (SearchLine *)ArenaAlloc(index->arena, shard->capacity*sizeof(SearchLine));
+
+    for (char *line = data; *line != '\0'; )
+    {
+        char *end = strchr(line, '\n');
+        if (end != NULL) *end = '\0';
+
+        char *tab = strchr(line, '\t');
+        if ((tab != NULL) && (shard->count < shard->capacity))
+        {
+            *tab = '\0';
+            shard->lines[shard->count].key = line;
+            shard->lines[shard->count].value = tab + 1;
+            shard->count++;
+        }
+
+        if (end == NULL) break;
+        line = end + 1;
+    }
+
+    if (table == &index->terms)
+    {
+        int kept = 0;
+        for (int i = 0; i < shard->count; i++)
+        {
+            shard->lines[i].value = RemoveSearchPostings(index->arena, shard->lines[i].value, index->keys, index->keyCount, &shard->modified);
+            if (shard->lines[i].value[0] != '\0') shard->lines[kept++] = shard->lines[i];
+        }
+        shard->count = kept;
+    }
+
+    return shard;
+}
+
+static bool SaveSearchShard(SearchIndex *index, SearchTable *table, int shardIndex)
+{
+    SearchShard *shard = table->shards[shardIndex];
+
+    FILE *file = fopen(GetSearchShardFileName(index, table, shardIndex), "wb");
+    if (file == NULL) return false;
+
+    long long size = 0;
+    for (int i = 0; i < shard->count; i++) size += fprintf(file, "%s\t%s\n", shard->lines[i].key, shard->lines[i].value);
+
+    bool success = !ferror(file);
+    success = (fclose(file) == 0) && success;
+
+    table->size += size - shard->loadedSize;
+    shard->loadedSize = size;
+    shard->modified = false;
+    index->stats->shardsSaved++;
+    index->stats->bytesWritten += size;
+
+    return success;
+}
+
+// Get table size: shards as saved, loaded shards as modified
+static long long GetSearchTableSize(const SearchTable *table)
+{
+    long long size = table->size;
+
+    for (int i = 0; i < table->shardCapacity; i++)
+    {
+        if ((table->shards[i] != NULL) && table->shards[i]->modified) size += GetSearchShardSize(table->shards[i]) - table->shards[i]->loadedSize;
+    }
+
+    return size;
+}
+
+// Split shards while average shard size is over limit: lines of shard 'split' are divided
+// between it and new shard (split + 2^level), other shards are not read
+static void SplitSearchShards(SearchIndex *index, SearchTable *table)
+{
+    while (GetSearchTableSize(table) > (long long)SEARCH_INDEX_SHARD_SIZE*GetSearchShardCount(table))
+    {
+        int splitIndex = table->split;
+        int newIndex = table->split + (1 << table->level);
+
+        SearchShard *shard = LoadSearchShard(index, table, splitIndex);
+        SearchShard *newShard = LoadSearchShard(index, table, newIndex);
+
+        int kept = 0;
+        for (int i = 0; i < shard->count; i++)
+        {
+            const SearchLine *line = &shard->lines[i];
+            unsigned int hash = GetSearchIndexHash(line->key, (int)strlen(line->key));
+
+            if ((int)(hash%(1u << (table->level + 1))) == newIndex) AddSearchLine(index->arena, newShard, line->key, (int)strlen(line->key), line->value);
+            else shard->lines[kept++] = *line;
+        }
+
+        shard->count = kept;
+        shard->modified = true;
+        newShard->modified = true;      // Saved even if empty, browser never requests a missing shard
+
+        table->split++;
+        if (table->split == (1 << table->level))
+        {
+            table->level++;
+            table->split = 0;
+        }
+
+        index->stats->shardsSplit++;
+    }
+}
+
+// Check if term is a common word (not indexed)
+static bool IsSearchStopWord(const char *text, int length)
+{
+    static const char *words[] = { "a", "an", "and", "are", "as", "at", "be", "but", "by", "for", "from", "has", "have",
+        "if", "in", "into", "is", "it", "its", "not", "of", "on", "or", "so", "that", "the", "their", "then", "there",
+        "these", "this", "to", "was", "were", "will", "with", "you", "your" };
+
+    for (int i = 0; i < (int)(sizeof(words)/sizeof(words[0])); i++)
+    {
+        if (((int)strlen(words[i]) == length) && (strncmp(words[i], text, length) == 0)) return true;
+    }
+
+    return false;
+}
+
+// Add terms of text into terms hash table (open addressing, capacity power of two, lowercase text kept in arena)
+static void AddSearchTerms(Arena *arena, SearchTerm *terms, int capacity, int *termCount, const char *text, int length, int weight)
+{
+    char term[SEARCH_INDEX_MAX_TERM + 1] = { 0 };
+    int termLength = 0;
+    bool tooLong = false;
+
+    for (int i = 0; i <= length; i++)
+    {
+        unsigned char c = (i < length)? (unsigned char)text[i] : ' ';
+
+        // Link targets skipped: ](target)
+        if ((c == '(') && (i > 0) && (text[i - 1] == ']'))
+        {
+            while ((i < length) && (text[i] != ')') && (text[i] != '\n')) i++;
+            c = ' ';
+        }
+
+        bool wordChar = ((c >= 'a') && (c <= 'z')) || ((c >= '0') && (c <= '9')) || ((c >= 'A') && (c <= 'Z')) || (c >= 0x80);
+        if (wordChar)
+        {
+            if (termLength < SEARCH_INDEX_MAX_TERM) term[termLength++] = ((c >= 'A') && (c <= 'Z'))? (char)(c + 32) : (char)c;
+            else tooLong = true;
+            continue;
+        }
+
+        if ((termLength >= SEARCH_INDEX_MIN_TERM) && !tooLong && !IsSearchStopWord(term, termLength) && (*termCount < capacity/2))
+        {
+            unsigned int slot = GetSearchIndexHash(term, termLength) & (capacity - 1);
+            while ((terms[slot].text != NULL) && ((terms[slot].length != termLength) || (strncmp(terms[slot].text, term, termLength) != 0))) slot = (slot + 1) & (capacity - 1);
+
+            if (terms[slot].text == NULL)
+            {
+                terms[slot].text = ArenaFormat(arena, "%.*s", termLength, term);
+                terms[slot].length = termLength;
+                (*termCount)++;
+            }
+            terms[slot].count += weight;
+        }
+
+        termLength = 0;
+        tooLong = false;
+    }
+}
+
+// Tokenize texts into terms table, returns table capacity (terms are non NULL slots)
+static SearchTerm *LoadSearchTerms(Arena *arena, const char *title, const char *text, int length, int *capacity)
+{
+    int titleLength = (title != NULL)? (int)strlen(title) : 0;
+
+    *capacity = 64;
+    while (*capacity < (titleLength + length)/2 + 16) *capacity *= 2;
+
+    SearchTerm *terms = (SearchTerm *)ArenaAlloc(arena, (*capacity)*sizeof(SearchTerm));
+    int termCount = 0;
+
+    if (titleLength > 0) AddSearchTerms(arena, terms, *capacity, &termCount, title, titleLength, SEARCH_INDEX_TITLE_WEIGHT);
+    if (text != NULL) AddSearchTerms(arena, terms, *capacity, &termCount, text, length, 1);
+
+    return terms;
+}
+
+// Format document key: post path hash (FNV-1a, 64 bit) plus probe, in base 36
+static const char *GetSearchDocumentKey(Arena *arena, const char *path, int probe)
+{
+    static const char *digits = "0123456789abcdefghijklmnopqrstuvwxyz";
+    unsigned long long hash = 14695981039346656037ull;
+    for (const char *ptr = path; *ptr != '\0'; ptr++) hash = (hash ^ (unsigned char)*ptr)*1099511628211ull;
+    hash += probe;
+
+    char key[16] = { 0 };
+    int length = 0;
+    do { key[length++] = digits[hash%36]; hash /= 36; } while (hash > 0);
+
+    for (int i = 0; i < length/2; i++)
+    {
+        char c = key[i];
+        key[i] = key[length - 1 - i];
+        key[length - 1 - i] = c;
+    }
+
+    return ArenaFormat(arena, "%s", key);
+}
+
+// Get document key of post path: first probed key that is not used, or used by same path (doc line
+// path or previous post of update), NULL if all probed keys are used by other paths
+static const char *GetSearchPostKey(SearchIndex *index, const char *path, int postIndex)
+{
+    int pathLength = (int)strlen(path);
+
+    for (int probe = 0; probe < SEARCH_INDEX_MAX_PROBES; probe++)
+    {
+        const char *key = GetSearchDocumentKey(index->arena, path, probe);
+        int keyLength = (int)strlen(key);
+
+        SearchShard *shard = LoadSearchShard(index, &index->docs, GetSearchShardIndex(&index->docs, GetSearchIndexHash(key, keyLength)));
+        int line = FindSearchLine(index->arena, shard, key, keyLength, false);
+        const char *linePath = (line >= 0)? shard->lines[line].value : NULL;
+
+        bool used = (linePath != NULL) && !((strncmp(linePath, path, pathLength) == 0) && (linePath[pathLength] == '\t'));
+        for (int i = 0; (i < postIndex) && !used; i++) used = (strcmp(index->keys[i], key) == 0) && (strcmp(index->paths[i], path) != 0);
+
+        if (!used) return key;
+    }
+
+    return NULL;
+}
+
+// Copy text for document line: tabs and line breaks replaced
+static const char *GetSearchLineText(Arena *arena, const char *text)
+{
+    char *result = (char *)ArenaFormat(arena, "%s", (text != NULL)? text : "");
+    for (char *ptr = result; *ptr != '\0'; ptr++) if ((*ptr == '\t') || (*ptr == '\n') || (*ptr == '\r')) *ptr = ' ';
+
+    return result;
+}
+
+// Read table layout from index.json text
+static void LoadSearchTableLayout(SearchTable *table, const char *text, const char *name)
+{
+    char section[32] = { 0 };
+    snprintf(section, sizeof(section), "\"%s\":{", name);
+
+    const char *ptr = (text != NULL)? strstr(text, section) : NULL;
+    if (ptr == NULL) return;
+
+    const char *level = strstr(ptr, "\"level\":");
+    const char *split = strstr(ptr, "\"split\":");
+    const char *size = strstr(ptr, "\"size\":");
+    if ((level == NULL) || (split == NULL) || (size == NULL)) return;
+
+    table->level = 0;
+    table->split = 0;
+    table->size = 0;
+    sscanf(level + 8, "%i", &table->level);
+    sscanf(split + 8, "%i", &table->split);
+    sscanf(size + 7, "%lld", &table->size);
+
+    if ((table->level < 0) || (table->level > 24) || (table->split < 0) || (table->split >= (1 << table->level))) table->level = table->split = 0;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Check if index folder has an index of current version, otherwise (missing or outdated)
+// index must be created: all site posts passed to UpdateSearchIndex()
+bool IsSearchIndexCurrent(const char *folder)
+{
+    char fileName[512] = { 0 };
+    if (snprintf(fileName, sizeof(fileName), "%s/index.json", folder) >= (int)sizeof(fileName)) return false;
+
+    FILE *file = fopen(fileName, "rb");
+    if (file == NULL) return false;
+
+    int version = 0;
+    bool current = (fscanf(file, "{\"version\":%i", &version) == 1) && (version == SEARCH_INDEX_VERSION);
+    fclose(file);
+
+    return current;
+}
+
+// Get hash of term or key: FNV-1a (32 bit) of UTF-8 bytes
+unsigned int GetSearchIndexHash(const char *text, int length)
+{
+    unsigned int hash = 2166136261u;
+    for (int i = 0; i < length; i++) hash = (hash ^ (unsigned char)text[i])*16777619u;
+
+    return hash;
+}
+
+// Update index folder with published posts: previous postings of posts are removed, new postings
+// and document lines are added, shards are split as needed; only shards touched are read and written
+bool UpdateSearchIndex(Arena *arena, const char *folder, const SearchIndexPost *posts, int count, SearchIndexStats *stats)
+{
+    SearchIndexStats localStats = { 0 };
+    if (stats == NULL) stats = &localStats;
+
+    SearchIndex index = { 0 };
+    index.arena = arena;
+    index.folder = folder;
+    index.terms.name = "t";
+    index.docs.name = "d";
+    index.stats = stats;
+
+    SearchTable previous[2] = { 0 };    // Layout of outdated index, its shards files beyond new layout are removed
+    const char *layoutFileName = ArenaFormat(arena, "%s/index.json", folder);
+    FILE *layoutFile = fopen(layoutFileName, "rb");
+    if (layoutFile != NULL)
+    {
+        char layout[1024] = { 0 };
+        size_t size = fread(layout, 1, sizeof(layout) - 1, layoutFile);
+        layout[size] = '\0';
+        fclose(layoutFile);
+
+        // Index of another version is rebuilt, from empty tables
+        int version = 0;
+        if ((sscanf(layout, "{\"version\":%i", &version) == 1) && (version == SEARCH_INDEX_VERSION))
+        {
+            LoadSearchTableLayout(&index.terms, layout, "terms");
+            LoadSearchTableLayout(&index.docs, layout, "docs");
+        }
+        else
+        {
+            LoadSearchTableLayout(&previous[0], layout, "terms");
+            LoadSearchTableLayout(&previous[1], layout, "docs");
+            index.rebuild = true;
+        }
+    }
+
+    SEARCH_INDEX_MKDIR(folder);
+    SEARCH_INDEX_MKDIR(ArenaFormat(arena, "%s/t", folder));
+    SEARCH_INDEX_MKDIR(ArenaFormat(arena, "%s/d", folder));
+
+    // Keys are resolved before any term shard is loaded, their postings are removed on load
+    index.keys = (const char **)ArenaAlloc(arena, (count + 1)*sizeof(const char *));
+    index.paths = (const char **)ArenaAlloc(arena, (count + 1)*sizeof(const char *));
+    for (int i = 0; i < count; i++)
+    {
+        index.paths[i] = GetSearchLineText(arena, posts[i].path);
+        index.keys[i] = GetSearchPostKey(&index, index.paths[i], i);
+        if (index.keys[i] == NULL) return false;
+    }
+    index.keyCount = count;
+
+    for (int i = 0; i < count; i++)
+    {
+        const SearchIndexPost *post = &posts[i];
+
+        // Shards of previous terms loaded, so post postings are removed from them
+        if (post->previousText != NULL)
+        {
+            int capacity = 0;
+            SearchTerm *previous = LoadSearchTerms(arena, NULL, post->previousText, post->previousTextLength, &capacity);
+            for (int k = 0; k < capacity; k++)
+            {
+                if (previous[k].text != NULL) LoadSearchShard(&index, &index.terms, GetSearchShardIndex(&index.terms, GetSearchIndexHash(previous[k].text, previous[k].length)));
+            }
+        }
+
+        int capacity = 0;
+        SearchTerm *terms = LoadSearchTerms(arena, post->title, post->text, post->textLength, &capacity);
+        for (int k = 0; k < capacity; k++)
+        {
+            if (terms[k].text == NULL) continue;
+
+            SearchShard *shard = LoadSearchShard(&index, &index.terms, GetSearchShardIndex(&index.terms, GetSearchIndexHash(terms[k].text, terms[k].length)));
+            int line = FindSearchLine(arena, shard, terms[k].text, terms[k].length, true);
+            shard->lines[line].value = InsertSearchPosting(arena, shard->lines[line].value, index.keys[i], terms[k].count);
+            shard->modified = true;
+            stats->postingCount++;
+        }
+
+        // Document line: repeated posts (same path) keep last one
+        const char *key = index.keys[i];
+        SearchShard *shard = LoadSearchShard(&index, &index.docs, GetSearchShardIndex(&index.docs, GetSearchIndexHash(key, (int)strlen(key))));
+        AddSearchLine(arena, shard, key, (int)strlen(key), ArenaFormat(arena, "%s\t%s\t%s",
+            index.paths[i], GetSearchLineText(arena, post->title), GetSearchLineText(arena, post->date)));
+
+        stats->postCount++;
+    }
+
+    SplitSearchShards(&index, &index.terms);
+    SplitSearchShards(&index, &index.docs);
+
+    bool success = true;
+    SearchTable *tables[2] = { &index.terms, &index.docs };
+    for (int t = 0; t < 2; t++)
+    {
+        for (int i = 0; i < tables[t]->shardCapacity; i++)
+        {
+            if ((tables[t]->shards[i] != NULL) && tables[t]->shards[i]->modified) success = SaveSearchShard(&index, tables[t], i) && success;
+        }
+
+        for (int i = GetSearchShardCount(tables[t]); index.rebuild && (i < GetSearchShardCount(&previous[t])); i++) remove(GetSearchShardFileName(&index, tables[t], i));
+    }
+
+    layoutFile = fopen(layoutFileName, "wb");
+    if (layoutFile != NULL)
+    {
+        fprintf(layoutFile, "{\"version\":%i,\"hash\":\"fnv1a32\",\"shardSize\":%i,\n\"terms\":{\"level\":%i,\"split\":%i,\"size\":%lld},\n"
+            "\"docs\":{\"level\":%i,\"split\":%i,\"size\":%lld}}\n", SEARCH_INDEX_VERSION, SEARCH_INDEX_SHARD_SIZE,
+            index.terms.level, index.terms.split, index.terms.size, index.docs.level, index.docs.split, index.docs.size);
+        success = !ferror(layoutFile) && success;
+        success = (fclose(layoutFile) == 0) && success;
+    }
+    else success = false;
+
+    stats->shardCount = GetSearchShardCount(&index.terms);
+
+    return success;
+}
+
+#endif  // SEARCH_INDEX_IMPLEMENTATION
@@ -0,0 +1,424 @@
+/*******************************************************************************************
+*
+*   StatiqPress site commands - Command line subcommands over site posts
+*
+*   COMMANDS:
+*       rewrite     Rewrite front matter of all site posts (rules), pushed in a single commit
+*       index       Refresh site posts index from repository mirror and query it
+*       preview     Render post (and site) HTML preview pages, optionally served until ENTER
+*
+*   NOTES:
+*       Not a standalone module: included by statiqpress.c at the end of its command line
+*       functionality (PLATFORM_DESKTOP), functions are declared there and use app config,
+*       arenas, worker pool and helpers also shared with GUI
+*
+*   LICENSE: GPLv3, check LICENSE file for details
+*
+**********************************************************************************************/
+
+#ifndef SITE_COMMANDS_H
+#define SITE_COMMANDS_H
+
+//----------------------------------------------------------------------------------
+// Rewrite command
+//----------------------------------------------------------------------------------
+// Site front matter rewrite, rules applied to posts folder
+typedef struct SiteRewrite {
+    const FrontMatterRule *rules;
+    int ruleCount;
+    const char *contentPath;        // Posts folder, relative to site root
+} SiteRewrite;
+
+// Rewrite front matter of all posts in site folder (repository worktree or local site)
+static uint8_t rewriteSiteFrontMatter(const char *sitePath, void *userData) {
+    const SiteRewrite *rewrite = (const SiteRewrite *)userData;
+    const char *folderPath = TextFormat("%s/%s", sitePath, rewrite->contentPath);
+
+    double startTime = getBenchmarkTime();
+    FrontMatterRewriteStats stats = RewriteSiteFrontMatter(folderPath, rewrite->rules, rewrite->ruleCount, workerPool);
+    double elapsedTime = getBenchmarkTime() - startTime;
+
+    LOG("INFO: Front matter rewritten: %i of %i post(s) changed, %i failed (%.2f ms, %i thread(s))\n",
+        stats.changedCount, stats.fileCount, stats.failedCount, elapsedTime*1000.0, GetWorkerPoolThreadCount(workerPool));
+
+    return (stats.failedCount == 0)? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// Rewrite front matter of all site posts: site repository is cloned, posts are rewritten and
+// pushed in a single commit, or a local site folder (--path) is rewritten in place
+static int rewriteFromCommandLine(int argc, char *argv[]) {
+    ProjectConfig config = { 0 };
+    loadDefaultConfig(&config);
+
+    FrontMatterRule rules[FRONT_MATTER_MAX_RULES] = { 0 };
+    int ruleCount = 0;
+    const char *localPath = NULL;
+    bool showUsageInfo = false;
+
+    for (int i = 2; (i < argc) && !showUsageInfo; i++) {
+        if ((strcmp(argv[i], "--rule") == 0) && ((i + 1) < argc)) {
+            if ((ruleCount < FRONT_MATTER_MAX_RULES) && ParseFrontMatterRule(argv[i + 1], &rules[ruleCount])) ruleCount++;
+            else {
+                fprintf(stderr, "WARNING: Invalid rule (<key>:<from>=<to>): %s\n", argv[i + 1]);
+                showUsageInfo = true;
+            }
+            i++;
+        }
+        else if ((strcmp(argv[i], "--path") == 0) && ((i + 1) < argc)) localPath = argv[++i];
+        else if ((strncmp(argv[i], "--", 2) == 0) && ((i + 1) < argc) && setConfigField(&config, argv[i] + 2, argv[i + 1])) i++;
+        else {
+            fprintf(stderr, "WARNING: Unrecognized or incomplete option: %s\n", argv[i]);
+            showUsageInfo = true;
+        }
+    }
+
+    if (showUsageInfo || (ruleCount == 0)) {
+        showCommandLineInfo();
+        return 1;
+    }
+
+    SiteRewrite rewrite = { rules, ruleCount, config.building.contentFolderPath };
+
+    if (localPath != NULL) {
+        rewrite.contentPath = ".";
+        return (rewriteSiteFrontMatter(localPath, &rewrite) == EXIT_SUCCESS)? 0 : 1;
+    }
+
+    // Commit message lists rules (shell quoted by git handler)
+    char message[512] = "StatiqPress Front Matter Rewrite:";
+    for (int i = 0; i < ruleCount; i++) {
+        const char *rule = TextFormat(" %s:%s=%s", rules[i].key, rules[i].from, rules[i].to);
+        if ((strlen(message) + strlen(rule)) < sizeof(message)) strcat(message, rule);
+    }
+
+    GitRepository repo = newRepository(&publishArena, config.building.gitRepositoryUrl, config.building.contentFolderPath);
+    int result = (rewriteRepository(&repo, rewriteSiteFrontMatter, &rewrite, message) == EXIT_SUCCESS)? 0 : 1;
+    ArenaReset(&publishArena);
+
+    return result;
+}
+
+//----------------------------------------------------------------------------------
+// Index command
+//----------------------------------------------------------------------------------
+// Print post index entry
+static void printPostIndexEntry(const PostIndex *index, int position) {
+    static const char *fieldNames[POST_INDEX_FIELD_COUNT] = { "tags", "categories", "authors" };
+    PostIndexEntry entry = GetPostIndexEntry(index, position);
+
+    printf("  %s\n    slug: %s, title: %s, date: %s\n", entry.path, entry.slug, entry.title, entry.date);
+    for (int f = 0; f < POST_INDEX_FIELD_COUNT; f++) {
+        if (entry.valueCounts[f] == 0) continue;
+
+        printf("    %s:", fieldNames[f]);
+        for (int i = 0; i < entry.valueCounts[f]; i++) printf("%s %s", (i > 0)? "," : "", entry.values[f][i]);
+        printf("\n");
+    }
+}
+
+// Refresh site posts index and query it: post by slug/path, posts by tag/category/author, field values
+// NOTE: Lookups are timed separately from refresh, index is memory mapped (no parsing)
+static int indexFromCommandLine(int argc, char *argv[]) {
+    ProjectConfig config = { 0 };
+    loadDefaultConfig(&config);
+
+    const char *slug = NULL;
+    const char *path = NULL;
+    const char *value = NULL;
+    int valueField = -1;
+    int listField = -1;
+    bool showUsageInfo = false;
+
+    for (int i = 2; (i < argc) && !showUsageInfo; i++) {
+        if ((strcmp(argv[i], "--slug") == 0) && ((i + 1) < argc)) slug = argv[++i];
+        else if ((strcmp(argv[i], "--path") == 0) && ((i + 1) < argc)) path = argv[++i];
+        else if ((strcmp(argv[i], "--tag") == 0) && ((i + 1) < argc)) { valueField = POST_INDEX_TAGS; value = argv[++i]; }
+        else if ((strcmp(argv[i], "--category") == 0) && ((i + 1) < argc)) { valueField = POST_INDEX_CATEGORIES; value = argv[++i]; }
+        else if ((strcmp(argv[i], "--author") == 0) && ((i + 1) < argc)) { valueField = POST_INDEX_AUTHORS; value = argv[++i]; }
+        else if ((strcmp(argv[i], "--list") == 0) && ((i + 1) < argc)) {
+            i++;
+            if (strcmp(argv[i], "tags") == 0) listField = POST_INDEX_TAGS;
+            else if (strcmp(argv[i], "categories") == 0) listField = POST_INDEX_CATEGORIES;
+            else if (strcmp(argv[i], "authors") == 0) listField = POST_INDEX_AUTHORS;
+            else showUsageInfo = true;
+        }
+        else if ((strcmp(argv[i], "--repo") == 0) || (strcmp(argv[i], "--content") == 0) || (strcmp(argv[i], "--profile") == 0)) {
+            if (((i + 1) < argc) && setConfigField(&config, argv[i] + 2, argv[i + 1])) i++;
+            else showUsageInfo = true;
+        }
+        else {
+            fprintf(stderr, "WARNING: Unrecognized or incomplete option: %s\n", argv[i]);
+            showUsageInfo = true;
+        }
+    }
+
+    if (showUsageInfo) {
+        showCommandLineInfo();
+        return 1;
+    }
+
+    GitRepository repo = newRepository(&publishArena, config.building.gitRepositoryUrl, config.building.contentFolderPath);
+    const char *indexPath = refreshPostIndex(&repo, config.building.contentFolderPath);
+    PostIndex index = (indexPath != NULL)? LoadPostIndex(indexPath) : (PostIndex){ 0 };
+    ArenaReset(&publishArena);
+
+    if (index.data == NULL) return 1;
+
+    LOG("INFO: Post index: %i post(s), distinct values: %i tags, %i categories, %i authors\n", index.count, GetPostIndexValueCount(&index, POST_INDEX_TAGS),
+        GetPostIndexValueCount(&index, POST_INDEX_CATEGORIES), GetPostIndexValueCount(&index, POST_INDEX_AUTHORS));
+
+    int result = 0;
+
+    if ((slug != NULL) || (path != NULL)) {
+        double startTime = getBenchmarkTime();
+        int position = (slug != NULL)? FindPostIndexSlug(&index, slug) : FindPostIndexPath(&index, path);
+        double elapsedTime = getBenchmarkTime() - startTime;
+
+        if (position >= 0) printPostIndexEntry(&index, position);
+        else result = 1;
+        LOG("INFO: Post %s (%.2f us)\n", (position >= 0)? "found" : "not found", elapsedTime*1000000.0);
+    }
+
+    if (value != NULL) {
+        // Posts are matched by value string offset (values are interned), no string comparisons
+        double startTime = getBenchmarkTime();
+        int position = FindPostIndexValue(&index, (PostIndexField)valueField, value);
+        int postCount = 0;
+        const char *interned = GetPostIndexValue(&index, (PostIndexField)valueField, position, &postCount);
+        int *posts = (int *)ArenaAlloc(&publishArena, (postCount + 1)*sizeof(int));
+        int count = 0;
+
+        for (int i = 0; (interned != NULL) && (i < index.count) && (count < postCount); i++) {
+            PostIndexEntry entry = GetPostIndexEntry(&index, i);
+            for (int k = 0; k < entry.valueCounts[valueField]; k++) {
+                if (entry.values[valueField][k] == interned) { posts[count++] = i; break; }
+            }
+        }
+        double elapsedTime = getBenchmarkTime() - startTime;
+
+        for (int i = 0; i < count; i++) printPostIndexEntry(&index, posts[i]);
+        LOG("INFO: %i post(s) with %s (%.2f us)\n", count, value, elapsedTime*1000000.0);
+        if (count == 0) result = 1;
+        ArenaReset(&publishArena);
+    }
+
+    if (listField >= 0) {
+        for (int i = 0; i < GetPostIndexValueCount(&index, (PostIndexField)listField); i++) {
+            int postCount = 0;
+            const char *text = GetPostIndexValue(&index, (PostIndexField)listField, i, &postCount);
+            printf("  %s (%i)\n", text, postCount);
+        }
+    }
+
+    UnloadPostIndex(&index);
+
+    return result;
+}
+
+//----------------------------------------------------------------------------------
+// Preview command
+//----------------------------------------------------------------------------------
+// Site preview: markdown files of site content folder (repository mirror), rendered in parallel
+// NOTE: Blobs are read into site preview arena (main thread), every job renders into its own arena
+typedef struct SitePreview {
+    Arena *arena;
+    const char **ids;               // Markdown files blob ids, in requested order
+    const char **pagePaths;         // Preview pages paths
+    const char **texts;             // Markdown files content, NULL if not read
+    int *sizes;
+    bool *saved;                    // Page written, per file
+    int count;
+    int position;                   // Next expected blob (blobs are read in requested order)
+} SitePreview;
+
+// Blob read callback: keep markdown file content to be rendered
+static void readSitePreviewBlob(const char *id, int requestIndex, const char *data, long size, void *userData) {
+    SitePreview *preview = (SitePreview *)userData;
+
+    while ((preview->position < preview->count) && (strcmp(preview->ids[preview->position], id) != 0)) preview->position++;
+    if (preview->position >= preview->count) return;
+
+    char *text = (char *)ArenaAlloc(preview->arena, (size_t)size + 1);
+    if (text != NULL) {
+        memcpy(text, data, size);
+        preview->texts[preview->position] = text;
+        preview->sizes[preview->position] = (int)size;
+    }
+    preview->position++;
+}
+
+// Site preview job: render a group of pages
+static void renderSitePreviewPages(void *data, int index) {
+    SitePreview *preview = (SitePreview *)data;
+    Arena arena = { 0 };
+
+    int start = index*PREVIEW_PAGES_PER_JOB;
+    int end = ((start + PREVIEW_PAGES_PER_JOB) < preview->count)? (start + PREVIEW_PAGES_PER_JOB) : preview->count;
+
+    for (int i = start; i < end; i++) {
+        if (preview->texts[i] != NULL) preview->saved[i] = savePreviewPage(&arena, preview->pagePaths[i], preview->texts[i], preview->sizes[i]);
+        ArenaReset(&arena);
+    }
+
+    ArenaFree(&arena);
+}
+
+// Render site posts preview: markdown files of content folder in mirror tree are read (one git process)
+// and rendered in parallel into preview folder, same relative paths ("_index.md" sections as index.html)
+// NOTE: Pages only link to each other with site URLs, page bundles resources are not copied
+static int renderSitePreview(ProjectConfig *config) {
+    GitRepository repo = newRepository(&publishArena, config->building.gitRepositoryUrl, config->building.contentFolderPath);
+    const char *mirrorPath = updateMirror(&repo);
+    if (mirrorPath == NULL) {
+        fprintf(stderr, "ERROR: Repository mirror not available: %s\n", repo.url);
+        return 1;
+    }
+
+    double startTime = getBenchmarkTime();
+    GitTree tree = loadMirrorTree(&repo, mirrorPath);
+    const char *prefix = getRepositoryPath(config->building.contentFolderPath, "");
+    int prefixLength = (int)strlen(prefix);
+
+    SitePreview preview = { 0 };
+    preview.arena = &publishArena;
+    preview.ids = (const char **)ArenaAlloc(&publishArena, (tree.count + 1)*sizeof(const char *));
+    preview.pagePaths = (const char **)ArenaAlloc(&publishArena, (tree.count + 1)*sizeof(const char *));
+    preview.texts = (const char **)ArenaAlloc(&publishArena, (tree.count + 1)*sizeof(const char *));
+    preview.sizes = (int *)ArenaAlloc(&publishArena, (tree.count + 1)*sizeof(int));
+    preview.saved = (bool *)ArenaAlloc(&publishArena, (tree.count + 1)*sizeof(bool));
+    if ((preview.ids == NULL) || (preview.pagePaths == NULL) || (preview.texts == NULL) || (preview.sizes == NULL) || (preview.saved == NULL)) return 1;
+
+    // Pages folders are created here, tree is sorted by path so every folder is only created once
+    const char *folder = "";
+    int folderLength = 0;
+
+    for (int i = 0; i < tree.count; i++) {
+        const char *path = tree.entries[i].path;
+        int length = (int)strlen(path);
+        if ((strncmp(path, prefix, prefixLength) != 0) || (length < 3) || (strcmp(path + length - 3, ".md") != 0)) continue;
+
+        const char *fileName = strrchr(path, '/');
+        fileName = (fileName != NULL)? fileName + 1 : path;
+        int pathLength = (int)(fileName - path);
+
+        const char *pagePath = (strcmp(fileName, "_index.md") == 0)?
+            ArenaFormat(&publishArena, "%s/site/%.*s%s", PREVIEW_PATH, pathLength - prefixLength, path + prefixLength, PREVIEW_FILE_NAME) :
+            ArenaFormat(&publishArena, "%s/site/%.*s.html", PREVIEW_PATH, length - prefixLength - 3, path + prefixLength);
+
+        if ((pathLength != folderLength) || (strncmp(path, folder, pathLength) != 0)) {
+            MakeDirectory(ArenaFormat(&publishArena, "%s/site/%.*s", PREVIEW_PATH, pathLength - prefixLength, path + prefixLength));
+            folder = path;
+            folderLength = pathLength;
+        }
+
+        preview.ids[preview.count] = tree.entries[i].id;
+        preview.pagePaths[preview.count] = pagePath;
+        preview.count++;
+    }
+
+    loadMirrorBlobs(&repo, mirrorPath, preview.ids, preview.count, readSitePreviewBlob, &preview);
+    double readTime = getBenchmarkTime() - startTime;
+
+    long long markdownSize = 0;
+    for (int i = 0; i < preview.count; i++) markdownSize += preview.sizes[i];
+
+    startTime = getBenchmarkTime();
+    RunWorkerPoolJobs(workerPool, renderSitePreviewPages, &preview, (preview.count + PREVIEW_PAGES_PER_JOB - 1)/PREVIEW_PAGES_PER_JOB);
+    double renderTime = getBenchmarkTime() - startTime;
+
+    int failedCount = 0;
+    for (int i = 0; i < preview.count; i++) if (!preview.saved[i]) failedCount++;
+
+    LOG("INFO: Site preview rendered: %i page(s) (%.2f MB markdown read in %.2f ms) in %.2f ms, %.0f pages/s, %i thread(s)%s\n",
+        preview.count - failedCount, markdownSize/(1024.0*1024.0), readTime*1000.0, renderTime*1000.0,
+        (renderTime > 0.0)? preview.count/renderTime : 0.0, GetWorkerPoolThreadCount(workerPool),
+        (failedCount > 0)? TextFormat(", %i failed", failedCount) : "");
+    LOG("INFO: Site preview: %s/site\n", PREVIEW_PATH);
+
+    return (failedCount > 0)? 1 : 0;
+}
+
+// Render post HTML preview, as prepared for publishing (front matter, optimized banner), and site
+// preview if requested; post is prepared into a scratch folder, removed once rendered
+// NOTE: With --serve, previews are served by local preview server (post page from memory) until ENTER
+static int previewFromCommandLine(int argc, char *argv[]) {
+    ProjectConfig config = { 0 };
+    loadDefaultConfig(&config);
+
+    bool site = false;
+    bool serve = false;
+    int port = PREVIEW_SERVER_PORT;
+    bool showUsageInfo = false;
+
+    for (int i = 2; (i < argc) && !showUsageInfo; i++) {
+        if (strcmp(argv[i], "--site") == 0) site = true;
+        else if (strcmp(argv[i], "--serve") == 0) serve = true;
+        else if ((strcmp(argv[i], "--port") == 0) && ((i + 1) < argc)) port = atoi(argv[++i]);
+        else if ((strncmp(argv[i], "--", 2) == 0) && ((i + 1) < argc) && setConfigField(&config, argv[i] + 2, argv[i + 1])) i++;
+        else {
+            fprintf(stderr, "WARNING: Unrecognized or incomplete option: %s\n", argv[i]);
+            showUsageInfo = true;
+        }
+    }
+
+    if (showUsageInfo || ((config.project.srcContentPath[0] == '\0') && !site)) {
+        showCommandLineInfo();
+        return 1;
+    }
+
+    // Server is loaded before rendering, so post page is set into memory
+    if (serve) {
+        MakeDirectory(PREVIEW_PATH);
+        previewServer = LoadPreviewServer(PREVIEW_PATH, port);
+        if ((previewServer == NULL) && (port == PREVIEW_SERVER_PORT)) previewServer = LoadPreviewServer(PREVIEW_PATH, 0);  // Default port in use
+
+        if (previewServer == NULL) {
+            fprintf(stderr, "ERROR: Preview server could not be started (port %i)\n", port);
+            return 1;
+        }
+    }
+
+    int result = 0;
+    char pagePath[256] = "/site/";
+
+    if (config.project.srcContentPath[0] != '\0') {
+        const char *postPath = ArenaFormat(&publishArena, "%s/.preview", NEW_POST_PATH);
+        result = writeContent(&publishArena, &config, postPath);
+
+        // Slug is not reserved, post is not published
+        const char *previewPath = ArenaFormat(&publishArena, "%s/%s", PREVIEW_PATH, getPostSlug(&config));
+        if (result == 0) result = renderPostPreview(&publishArena, previewServer, postPath, previewPath);
+
+        snprintf(pagePath, sizeof(pagePath), "/%s/", getPostSlug(&config));
+
+        if (result == 0) LOG("INFO: Post preview rendered: %s/%s\n", previewPath, PREVIEW_FILE_NAME);
+        else fprintf(stderr, "ERROR: Post preview could not be rendered (%i): %s\n", result, config.project.srcContentPath);
+
+        remove(ArenaFormat(&publishArena, "%s/%s", postPath, POST_FILE_NAME));
+        remove(ArenaFormat(&publishArena, "%s/%s", postPath, BANNER_FILE_NAME));
+        rmdir(postPath);
+        ArenaReset(&publishArena);
+    }
+
+    if (site && (renderSitePreview(&config) != 0)) result = 1;
+    ArenaReset(&publishArena);
+
+    if (previewServer != NULL) {
+        const char *url = TextFormat("http://127.0.0.1:%i%s", GetPreviewServerPort(previewServer), pagePath);
+        LOG("INFO: Serving previews: %s (press ENTER to stop)\n", url);
+        fflush(stdout);
+        OpenURL(url);
+        getchar();
+
+        PreviewServerStats stats = GetPreviewServerStats(previewServer);
+        LOG("INFO: Preview server: %lld requests (%lld from memory), %.2f MB sent, latency avg %.3f ms, max %.3f ms\n",
+            stats.requestCount, stats.memoryCount, stats.bytesSent/(1024.0*1024.0), stats.averageLatency*1000.0, stats.maxLatency*1000.0);
+
+        UnloadPreviewServer(previewServer);
+        previewServer = NULL;
+    }
+
+    return (result != 0)? 1 : 0;
+}
+
+#endif // SITE_COMMANDS_H
@@ -0,0 +1,535 @@
+/*******************************************************************************************
+*
+*   Site Feed - Incremental RSS feed and sitemap updates
+*
+*   MODULE USAGE:
+*       #define SITE_FEED_IMPLEMENTATION
+*       #include "site_feed.h"
+*
+*       SiteFeedPost posts[1] = { { "/blog/hello/", "Hello", "2024-05-01T10:00:00+0200", "First post" } };
+*       int size = 0;
+*       char *feed = UpdateSiteFeed(&arena, feedText, feedSize, "https://example.com", "Example", posts, 1, 20, &size);
+*       char *sitemap = UpdateSiteMap(&arena, sitemapText, sitemapSize, "https://example.com", posts, 1, &size);
+*
+*   NOTES:
+*       Existing files are spliced, not rebuilt: items/urls are located by a single scan of the
+*       file, entries of updated posts are replaced in place, new posts entries are inserted
+*       (feed: before existing items, newest first; sitemap: appended), everything else is copied
+*       as is. Update cost only depends on file size and posts updated, never on site posts count
+*
+*       Feed keeps at most maxItems items (oldest ones dropped), so feed size is bounded;
+*       sitemap keeps all posts (one small <url> entry per post)
+*
+*       Entries are matched by post link (feed <guid>/<link>, sitemap <loc>), links are post path
+*       joined to site link (base URL, relative links if empty). Front matter dates (RFC 3339)
+*       are converted to RFC 822 (feed) or kept (sitemap <lastmod>)
+*
+*       A missing or not valid file is created from an empty template, new feed channel title is
+*       site title (site link if empty)
+*
+*   DEPENDENCIES:
+*       arena.h             - Output data and entries slices are allocated in caller arena
+*
+*   LICENSE: GPLv3, check LICENSE file for details
+*
+**********************************************************************************************/
+
+#ifndef SITE_FEED_H
+#define SITE_FEED_H
+
+#include "arena.h"
+
+#include <stdbool.h>        // Required for: bool
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Post published or updated, strings are not copied
+typedef struct SiteFeedPost {
+    const char *path;               // Post path in site (i.e. "/blog/hello/"), joined to site link
+    const char *title;
+    const char *date;               // RFC 3339 (front matter), i.e. "2024-05-01T10:00:00+0200"
+    const char *description;        // Optional (NULL or empty)
+} SiteFeedPost;
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+char *UpdateSiteFeed(Arena *arena, const char *feed, int feedSize, const char *siteLink, const char *siteTitle, const SiteFeedPost *posts, int count, int maxItems, int *dataSize); // Update RSS feed with posts, returns new feed (arena)
+char *UpdateSiteMap(Arena *arena, const char *sitemap, int sitemapSize, const char *siteLink, const SiteFeedPost *posts, int count, int *dataSize); // Update sitemap with posts, returns new sitemap (arena)
+bool GetSiteFeedLink(const char *feed, int feedSize, char *link, int linkSize); // Get site link of feed (channel <link>), false if not found
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SITE_FEED_H
+
+/***********************************************************************************
+*
+*   SITE_FEED IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(SITE_FEED_IMPLEMENTATION)
+
+#include <stdio.h>          // Required for: snprintf()
+#include <string.h>         // Required for: memcpy(), strlen(), strncmp()
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Output buffer, grows into arena (doubled)
+typedef struct SiteFeedBuffer {
+    Arena *arena;
+    char *data;
+    int size;
+    int capacity;
+} SiteFeedBuffer;
+
+// Entry of existing file: <item> or <url> element, and its link text
+typedef struct SiteFeedEntry {
+    int start;                      // Element start offset (first '<')
+    int end;                        // Element end offset (after closing tag)
+    const char *link;
+    int linkLength;
+} SiteFeedEntry;
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+static void AppendSiteFeedData(SiteFeedBuffer *buffer, const char *data, int size)
+{
+    if ((buffer->size + size + 1) > buffer->capacity)
+    {
+        int capacity = (buffer->capacity > 0)? buffer->capacity*2 : 4096;
+        while (capacity < (buffer->size + size + 1)) capacity *= 2;
+
+        char *grown = (char *)ArenaAlloc(buffer->arena, capacity);
+        if (buffer->size > 0) memcpy(grown, buffer->data, buffer->size);
+        buffer->data = grown;
+        buffer->capacity = capacity;
+    }
+
+    memcpy(buffer->data + buffer->size, data, size);
+    buffer->size += size;
+    buffer->data[buffer->size] = '\0';
+}
+
+static void AppendSiteFeedText(SiteFeedBuffer *buffer, const char *text)
+{
+    AppendSiteFeedData(buffer, text, (int)strlen(text));
+}
+
+// Append text escaped for XML content and attributes
+static void AppendSiteFeedEscaped(SiteFeedBuffer *buffer, const char *text)
+{
+    const char *run = text;
+
+    for (const char *ptr = text; *ptr != '\0'; ptr++)
+    {
+        const char *entity = (*ptr == '&')? "&amp;" : (*ptr == '<')? "&lt;" : (*ptr == '>')? "&gt;" : (*ptr == '"')? "&quot;" : NULL;
+        if (entity == NULL) continue;
+
+        AppendSiteFeedData(buffer, run, (int)(ptr - run));
+        AppendSiteFeedText(buffer, entity);
+        run = ptr + 1;
+    }
+
+    AppendSiteFeedText(buffer, run);
+}
+
+// Append post link: site link (without trailing '/') and post path
+static void AppendSiteFeedLink(SiteFeedBuffer *buffer, const char *siteLink, const char *path)
+{
+    int length = (int)strlen(siteLink);
+    while ((length > 0) && (siteLink[length - 1] == '/')) length--;
+
+    SiteFeedBuffer link = { .arena = buffer->arena };
+    AppendSiteFeedData(&link, siteLink, length);
+    if (path[0] != '/') AppendSiteFeedText(&link, "/");
+    AppendSiteFeedText(&link, path);
+
+    AppendSiteFeedEscaped(buffer, link.data);
+}
+
+// Find text in data range, returns offset or -1
+static int FindSiteFeedText(const char *data, int start, int end, const char *text)
+{
+    int length = (int)strlen(text);
+
+    for (int i = start; i <= (end - length); i++)
+    {
+        if ((data[i] == text[0]) && (strncmp(data + i, text, length) == 0)) return i;
+    }
+
+    return -1;
+}
+
+// Get element text in data range (first <tag>...</tag>), surrounding whitespace trimmed
+static bool GetSiteFeedElement(const char *data, int start, int end, const char *tag, const char **text, int *length)
+{
+    char open[32] = { 0 }, close[32] = { 0 };
+    snprintf(open, sizeof(open), "<%s>", tag);
+    snprintf(close, sizeof(close), "</%s>", tag);
+
+    int textStart = FindSiteFeedText(data, start, end, open);
+    if (textStart < 0) return false;
+    textStart += (int)strlen(open);
+
+    int textEnd = FindSiteFeedText(data, textStart, end, close);
+    if (textEnd < 0) return false;
+
+    while ((textStart < textEnd) && ((data[textStart] == ' ') || (data[textStart] == '\n') || (data[textStart] == '\r') || (data[textStart] == '\t'))) textStart++;
+    while ((textEnd > textStart) && ((data[textEnd - 1] == ' ') || (data[textEnd - 1] == '\n') || (data[textEnd - 1] == '\r') || (data[textEnd - 1] == '\t'))) textEnd--;
+
+    *text = data + textStart;
+    *length = textEnd - textStart;
+
+    return true;
+}
+
+// Scan file entries (<item>/<url> elements) in data range, entries allocated in arena
+// NOTE: Entry link is first <guid> element, or first <link> element if no guid (feed)
+static SiteFeedEntry *LoadSiteFeedEntries(Arena *arena, const char *data, int start, int end, const char *tag, const char *linkTag, const char *altLinkTag, int *count)
+{
+    char open[32] = { 0 }, close[32] = { 0 };
+    snprintf(open, sizeof(open), "<%s>", tag);
+    snprintf(close, sizeof(close), "</%s>", tag);
+
+    int capacity = 64;
+    SiteFeedEntry *entries = (SiteFeedEntry *)ArenaAlloc(arena, capacity*sizeof(SiteFeedEntry));
+    *count = 0;
+
+    for (int offset = FindSiteFeedText(data, start, end, open); offset >= 0; offset = FindSiteFeedText(data, offset, end, open))
+    {
+        int elementEnd = FindSiteFeedText(data, offset, end, close);
+        if (elementEnd < 0) break;
+        elementEnd += (int)strlen(close);
+
+        if (*count >= capacity)
+        {
+            SiteFeedEntry *grown = (SiteFeedEntry *)ArenaAlloc(arena, capacity*2*sizeof(SiteFeedEntry));
+            memcpy(grown, entries, capacity*sizeof(SiteFeedEntry));
+            entries = grown;
+            capacity *= 2;
+        }
+
+        SiteFeedEntry *entry = &entries[(*count)++];
+        entry->start = offset;
+        entry->end = elementEnd;
+        entry->link = NULL;
+        entry->linkLength = 0;
+        if (!GetSiteFeedElement(data, offset, elementEnd, linkTag, &entry->link, &entry->linkLength) && (altLinkTag != NULL))
+        {
+            GetSiteFeedElement(data, offset, elementEnd, altLinkTag, &entry->link, &entry->linkLength);
+        }
+
+        offset = elementEnd;
+    }
+
+    return entries;
+}
+
+// Find post matching entry link, -1 if none
+// NOTE: Post links are escaped as written, so they compare with file text
+static int FindSiteFeedPost(const SiteFeedEntry *entry, const char **links, int count)
+{
+    for (int i = 0; (i < count) && (entry->link != NULL); i++)
+    {
+        if (((int)strlen(links[i]) == entry->linkLength) && (strncmp(links[i], entry->link, entry->linkLength) == 0)) return i;
+    }
+
+    return -1;
+}
+
+// Format RFC 3339 date as RFC 822 date (RSS), i.e. "Wed, 01 May 2024 10:00:00 +0200"
+// NOTE: Returns false if date is not valid, time and offset are optional
+static bool FormatSiteFeedDate(const char *date, char *text, int textSize)
+{
+    static const char *days[] = { "Thu", "Fri", "Sat", "Sun", "Mon", "Tue", "Wed" };
+    static const char *months[] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+
+    int year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0;
+    if ((date == NULL) || (sscanf(date, "%4d-%2d-%2d", &year, &month, &day) != 3) || (month < 1) || (month > 12) || (day < 1) || (day > 31)) return false;
+
+    const char *zone = "+0000";
+    char offset[8] = { 0 };
+    if ((strlen(date) >= 19) && (date[10] == 'T') && (sscanf(date + 11, "%2d:%2d:%2d", &hour, &minute, &second) == 3))
+    {
+        const char *ptr = date + 19;
+        if (*ptr == '.') while ((*(++ptr) >= '0') && (*ptr <= '9')) { }   // Fraction of second skipped
+
+        if (((ptr[0] == '+') || (ptr[0] == '-')) && (strlen(ptr) >= 5))
+        {
+            // Offset as +HHMM or +HH:MM
+            snprintf(offset, sizeof(offset), "%c%c%c%c%c", ptr[0], ptr[1], ptr[2], ptr[(ptr[3] == ':')? 4 : 3], ptr[(ptr[3] == ':')? 5 : 4]);
+            zone = offset;
+        }
+    }
+
+    // Days since 1970-01-01 (civil calendar), weekday from it (1970-01-01 was Thursday)
+    int y = (month <= 2)? year - 1 : year;
+    int era = ((y >= 0)? y : y - 399)/400;
+    int yearOfEra = y - era*400;
+    int dayOfYear = (153*((month > 2)? month - 3 : month + 9) + 2)/5 + day - 1;
+    int dayOfEra = yearOfEra*365 + yearOfEra/4 - yearOfEra/100 + dayOfYear;
+    long long days1970 = (long long)era*146097 + dayOfEra - 719468;
+    int weekday = (int)(((days1970%7) + 7)%7);
+
+    snprintf(text, textSize, "%s, %02d %s %04d %02d:%02d:%02d %s", days[weekday], day, months[month - 1], year, hour, minute, second, zone);
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Update RSS feed with published posts: their items are replaced in place or inserted first (newest),
+// channel <lastBuildDate> is set to first post date, items over maxItems are dropped
+// NOTE: Posts are expected newest first, feed is created if not valid (no <channel>)
+char *UpdateSiteFeed(Arena *arena, const char *feed, int feedSize, const char *siteLink, const char *siteTitle, const SiteFeedPost *posts, int count, int maxItems, int *dataSize)
+{
+    if ((feed == NULL) || (feedSize <= 0) || (FindSiteFeedText(feed, 0, feedSize, "</channel>") < 0))
+    {
+        // New feed: site title (site link if not available) set as channel title
+        SiteFeedBuffer created = { .arena = arena };
+        AppendSiteFeedText(&created, "<?xml version=\"1.0\" encoding=\"utf-8\" standalone=\"yes\"?>\n<rss version=\"2.0\">\n  <channel>\n    <title>");
+        AppendSiteFeedEscaped(&created, ((siteTitle != NULL) && (siteTitle[0] != '\0'))? siteTitle : siteLink);
+        AppendSiteFeedText(&created, "</title>\n    <link>");
+        AppendSiteFeedLink(&created, siteLink, "/");
+        AppendSiteFeedText(&created, "</link>\n    <description>Recent posts</description>\n    <lastBuildDate></lastBuildDate>\n  </channel>\n</rss>\n");
+
+        feed = created.data;
+        feedSize = created.size;
+    }
+
+    int channelEnd = FindSiteFeedText(feed, 0, feedSize, "</channel>");
+    int entryCount = 0;
+    SiteFeedEntry *entries = LoadSiteFeedEntries(arena, feed, 0, channelEnd, "item", "guid", "link", &entryCount);
+
+    // Posts items, links escaped as written into feed
+    const char **links = (const char **)ArenaAlloc(arena, (count + 1)*sizeof(const char *));
+    char **items = (char **)ArenaAlloc(arena, (count + 1)*sizeof(char *));
+    bool *placed = (bool *)ArenaAlloc(arena, (count + 1)*sizeof(bool));
+
+    for (int i = 0; i < count; i++)
+    {
+        SiteFeedBuffer link = { .arena = arena };
+        AppendSiteFeedLink(&link, siteLink, posts[i].path);
+        links[i] = link.data;
+
+        char date[64] = { 0 };
+        SiteFeedBuffer item = { .arena = arena };
+        AppendSiteFeedText(&item, "<item>\n      <title>");
+        AppendSiteFeedEscaped(&item, (posts[i].title != NULL)? posts[i].title : "");
+        AppendSiteFeedText(&item, "</title>\n      <link>");
+        AppendSiteFeedText(&item, links[i]);
+        AppendSiteFeedText(&item, "</link>\n");
+        if (FormatSiteFeedDate(posts[i].date, date, sizeof(date)))
+        {
+            AppendSiteFeedText(&item, "      <pubDate>");
+            AppendSiteFeedText(&item, date);
+            AppendSiteFeedText(&item, "</pubDate>\n");
+        }
+        AppendSiteFeedText(&item, "      <guid>");
+        AppendSiteFeedText(&item, links[i]);
+        AppendSiteFeedText(&item, "</guid>\n");
+        if ((posts[i].description != NULL) && (posts[i].description[0] != '\0'))
+        {
+            AppendSiteFeedText(&item, "      <description>");
+            AppendSiteFeedEscaped(&item, posts[i].description);
+            AppendSiteFeedText(&item, "</description>\n");
+        }
+        AppendSiteFeedText(&item, "    </item>");
+        items[i] = item.data;
+    }
+
+    // Posts with an existing item are replaced in place, others inserted before first item
+    for (int i = 0; i < entryCount; i++)
+    {
+        int post = FindSiteFeedPost(&entries[i], links, count);
+        if (post >= 0) placed[post] = true;
+    }
+
+    SiteFeedBuffer output = { .arena = arena };
+    int itemCount = 0;
+    int copied = 0;                 // Feed data copied up to this offset
+    int insertAt = (entryCount > 0)? entries[0].start : channelEnd;
+
+    // No items: inserted at start of </channel> line, indented
+    if (entryCount == 0) while ((insertAt > 0) && (feed[insertAt - 1] == ' ')) insertAt--;
+
+    // Channel header, last build date updated
+    const char *buildDate = NULL;
+    int buildDateLength = 0;
+    char date[64] = { 0 };
+    if ((count > 0) && FormatSiteFeedDate(posts[0].date, date, sizeof(date)) &&
+        GetSiteFeedElement(feed, 0, insertAt, "lastBuildDate", &buildDate, &buildDateLength))
+    {
+        int offset = (int)(buildDate - feed);
+        AppendSiteFeedData(&output, feed, offset);
+        AppendSiteFeedText(&output, date);
+        copied = offset + buildDateLength;
+    }
+
+    AppendSiteFeedData(&output, feed + copied, insertAt - copied);
+    copied = insertAt;
+
+    for (int i = 0; (i < count) && (itemCount < maxItems); i++)
+    {
+        if (placed[i]) continue;
+
+        // Duplicated post links are only inserted once
+        bool duplicated = false;
+        for (int k = 0; k < i; k++) if (strcmp(links[k], links[i]) == 0) duplicated = true;
+        if (duplicated) continue;
+
+        if (entryCount == 0) AppendSiteFeedText(&output, "    ");
+        AppendSiteFeedText(&output, items[i]);
+        AppendSiteFeedText(&output, (entryCount == 0)? "\n" : "\n    ");
+        itemCount++;
+    }
+
+    for (int i = 0; i < entryCount; i++)
+    {
+        // Text between items kept (whitespace), dropped items are removed with text before them
+        if (itemCount >= maxItems)
+        {
+            copied = entries[i].end;
+            continue;
+        }
+
+        AppendSiteFeedData(&output, feed + copied, entries[i].start - copied);
+
+        int post = FindSiteFeedPost(&entries[i], links, count);
+        if (post >= 0) AppendSiteFeedText(&output, items[post]);
+        else AppendSiteFeedData(&output, feed + entries[i].start, entries[i].end - entries[i].start);
+
+        copied = entries[i].end;
+        itemCount++;
+    }
+
+    AppendSiteFeedData(&output, feed + copied, feedSize - copied);
+
+    *dataSize = output.size;
+    return output.data;
+}
+
+// Update sitemap with published posts: their urls are replaced in place or appended, with post date as <lastmod>
+// NOTE: Sitemap is created if not valid (no <urlset>)
+char *UpdateSiteMap(Arena *arena, const char *sitemap, int sitemapSize, const char *siteLink, const SiteFeedPost *posts, int count, int *dataSize)
+{
+    static const char *sitemapTemplate = "<?xml version=\"1.0\" encoding=\"utf-8\" standalone=\"yes\"?>\n"
+        "<urlset xmlns=\"http://www.sitemaps.org/schemas/sitemap/0.9\">\n</urlset>\n";
+
+    if ((sitemap == NULL) || (sitemapSize <= 0) || (FindSiteFeedText(sitemap, 0, sitemapSize, "</urlset>") < 0))
+    {
+        sitemap = sitemapTemplate;
+        sitemapSize = (int)strlen(sitemapTemplate);
+    }
+
+    int urlsetEnd = FindSiteFeedText(sitemap, 0, sitemapSize, "</urlset>");
+    int entryCount = 0;
+    SiteFeedEntry *entries = LoadSiteFeedEntries(arena, sitemap, 0, urlsetEnd, "url", "loc", NULL, &entryCount);
+
+    const char **links = (const char **)ArenaAlloc(arena, (count + 1)*sizeof(const char *));
+    char **urls = (char **)ArenaAlloc(arena, (count + 1)*sizeof(char *));
+    bool *placed = (bool *)ArenaAlloc(arena, (count + 1)*sizeof(bool));
+
+    for (int i = 0; i < count; i++)
+    {
+        SiteFeedBuffer link = { .arena = arena };
+        AppendSiteFeedLink(&link, siteLink, posts[i].path);
+        links[i] = link.data;
+
+        SiteFeedBuffer url = { .arena = arena };
+        AppendSiteFeedText(&url, "<url>\n    <loc>");
+        AppendSiteFeedText(&url, links[i]);
+        AppendSiteFeedText(&url, "</loc>\n");
+        if ((posts[i].date != NULL) && (posts[i].date[0] != '\0'))
+        {
+            // W3C datetime offset is +HH:MM, front matter (strftime %z) offset is +HHMM
+            const char *date = posts[i].date;
+            int length = (int)strlen(date);
+            bool offset = (length >= 24) && (date[10] == 'T') && ((date[length - 5] == '+') || (date[length - 5] == '-'));
+
+            AppendSiteFeedText(&url, "    <lastmod>");
+            if (offset)
+            {
+                AppendSiteFeedData(&url, date, length - 2);
+                AppendSiteFeedText(&url, ":");
+                AppendSiteFeedText(&url, date + length - 2);
+            }
+            else AppendSiteFeedEscaped(&url, date);
+            AppendSiteFeedText(&url, "</lastmod>\n");
+        }
+        AppendSiteFeedText(&url, "  </url>");
+        urls[i] = url.data;
+    }
+
+    SiteFeedBuffer output = { .arena = arena };
+    int copied = 0;
+
+    for (int i = 0; i < entryCount; i++)
+    {
+        int post = FindSiteFeedPost(&entries[i], links, count);
+        if (post < 0) continue;
+
+        AppendSiteFeedData(&output, sitemap + copied, entries[i].start - copied);
+        AppendSiteFeedText(&output, urls[post]);
+        copied = entries[i].end;
+        placed[post] = true;
+    }
+
+    // New urls appended after last url (or after <urlset> opening tag)
+    int appendAt = (entryCount > 0)? entries[entryCount - 1].end : urlsetEnd;
+    if (entryCount == 0)
+    {
+        while ((appendAt > 0) && (sitemap[appendAt - 1] != '>')) appendAt--;
+    }
+
+    AppendSiteFeedData(&output, sitemap + copied, appendAt - copied);
+    copied = appendAt;
+
+    for (int i = 0; i < count; i++)
+    {
+        if (placed[i]) continue;
+
+        bool duplicated = false;
+        for (int k = 0; k < i; k++) if (strcmp(links[k], links[i]) == 0) duplicated = true;
+        if (duplicated) continue;
+
+        AppendSiteFeedText(&output, "\n  ");
+        AppendSiteFeedText(&output, urls[i]);
+    }
+
+    AppendSiteFeedData(&output, sitemap + copied, sitemapSize - copied);
+
+    *dataSize = output.size;
+    return output.data;
+}
+
+// Get site link of feed (channel <link>, before first item)
+bool GetSiteFeedLink(const char *feed, int feedSize, char *link, int linkSize)
+{
+    if ((feed == NULL) || (feedSize <= 0)) return false;
+
+    int end = FindSiteFeedText(feed, 0, feedSize, "<item>");
+    if (end < 0) end = feedSize;
+
+    const char *text = NULL;
+    int length = 0;
+    if (!GetSiteFeedElement(feed, 0, end, "link", &text, &length) || (length == 0) || (length >= linkSize)) return false;
+
+    memcpy(link, text, length);
+    link[length] = '\0';
+
+    return true;
+}
+
+#endif  // SITE_FEED_IMPLEMENTATION
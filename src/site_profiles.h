@@ -0,0 +1,340 @@
+/*******************************************************************************************
+*
+*   Site Profiles - Persistent site build settings, stored as a memory-mapped binary file
+*
+*   MODULE USAGE:
+*       #define SITE_PROFILES_IMPLEMENTATION
+*       #include "site_profiles.h"
+*
+*       INIT: SiteProfiles profiles = LoadSiteProfiles("config/profiles.sqp");
+*       READ: SiteProfile profile = GetSiteProfile(&profiles, index);
+*       SAVE: SaveSiteProfiles("config/profiles.sqp", profilesArray, count);
+*       FREE: UnloadSiteProfiles(&profiles);
+*
+*   FILE STRUCTURE (.sqp):
+*       Profiles are read directly from the mapped file, no parsing or allocation required,
+*       all strings returned by GetSiteProfile() point into the mapped data
+*
+*       ------------------------------------------------------
+*       Offset  | Size    | Type       | Description
+*       ------------------------------------------------------
+*       0       | 4       | char       | Signature: "SQPP"
+*       4       | 2       | short      | Version: 100
+*       6       | 2       | short      | Profiles count (N)
+*       8       | 4       | int        | Strings data size (S)
+*       12      | 20*N    | int        | Profile records: flags, name, url, content path, images path
+*                                      | (strings as offsets into strings data)
+*       12+20*N | S       | char       | Strings data, NULL terminated UTF-8 strings
+*
+*   DEPENDENCIES:
+*       file_batch.h    - Crash-safe file saving (temp file synced and renamed)
+*
+*   LICENSE: GPLv3, check LICENSE file for details
+*
+**********************************************************************************************/
+
+#ifndef SITE_PROFILES_H
+#define SITE_PROFILES_H
+
+#include <stdbool.h>
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define SITE_PROFILES_VERSION       100     // Binary file format version
+#define SITE_PROFILES_MAX_COUNT      64     // Maximum number of profiles supported
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Site profile, build settings for one site
+// NOTE: Strings are not owned by the profile, they usually point into mapped file data
+typedef struct SiteProfile {
+    int flags;                          // Hugo, Zola, Jekyll, Eleventy
+    const char *name;                   // Profile name (shown on selector)
+    const char *gitRepositoryUrl;       // git remote repository (to be cloned)
+    const char *contentFolderPath;      // content folder to create the new post
+    const char *imageFolderPath;        // image folder
+} SiteProfile;
+
+// Site profiles store, mapped from file
+typedef struct SiteProfiles {
+    int count;                          // Profiles count
+    unsigned char *data;                // File data (memory mapped if supported)
+    int dataSize;                       // File data size
+    bool mapped;                        // File data is memory mapped (or loaded)
+} SiteProfiles;
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+SiteProfiles LoadSiteProfiles(const char *fileName);                // Load (map) site profiles file, empty store if not valid
+void UnloadSiteProfiles(SiteProfiles *profiles);                    // Unload (unmap) site profiles file
+SiteProfile GetSiteProfile(const SiteProfiles *profiles, int index); // Get site profile, strings point into store data
+int FindSiteProfile(const SiteProfiles *profiles, const char *gitRepositoryUrl); // Find profile index by repository, -1 if not found
+bool SaveSiteProfiles(const char *fileName, const SiteProfile *profiles, int count); // Save site profiles into binary file (replaced atomically)
+bool ExportSiteProfilesAsText(const char *fileName, const SiteProfiles *profiles);   // Export site profiles as text (.ini) for review
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SITE_PROFILES_H
+
+/***********************************************************************************
+*
+*   SITE_PROFILES IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(SITE_PROFILES_IMPLEMENTATION)
+
+#include "file_batch.h"     // Required for: BeginFileBatch(), OpenBatchFile(), EndFileBatch()
+
+#include <stdio.h>          // Required for: FILE, fopen(), fwrite(), fprintf()
+#include <stdlib.h>         // Required for: calloc(), free()
+#include <string.h>         // Required for: memcpy(), strlen(), strcmp()
+
+#if !defined(_WIN32)
+    #include <fcntl.h>      // Required for: open()
+    #include <unistd.h>     // Required for: close()
+    #include <sys/mman.h>   // Required for: mmap(), munmap()
+    #include <sys/stat.h>   // Required for: fstat()
+#endif
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define SITE_PROFILES_HEADER_SIZE       12
+#define SITE_PROFILES_RECORD_FIELDS      5
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+// Read 32bit/16bit little-endian values from data
+static unsigned int ReadProfilesUint(const unsigned char *data) { return data[0] | (data[1] << 8) | (data[2] << 16) | ((unsigned int)data[3] << 24); }
+static unsigned short ReadProfilesUshort(const unsigned char *data) { return (unsigned short)(data[0] | (data[1] << 8)); }
+
+// Write 32bit/16bit little-endian values to file
+static void WriteProfilesUint(FILE *file, unsigned int value)
+{
+    unsigned char bytes[4] = { value & 0xff, (value >> 8) & 0xff, (value >> 16) & 0xff, (value >> 24) & 0xff };
+    fwrite(bytes, 1, 4, file);
+}
+
+static void WriteProfilesUshort(FILE *file, unsigned short value)
+{
+    unsigned char bytes[2] = { value & 0xff, (value >> 8) & 0xff };
+    fwrite(bytes, 1, 2, file);
+}
+
+// Check mapped data is a valid profiles file: header, records and strings in bounds
+static bool IsSiteProfilesDataValid(const unsigned char *data, int dataSize)
+{
+    if ((data == NULL) || (dataSize < SITE_PROFILES_HEADER_SIZE)) return false;
+    if ((data[0] != 'S') || (data[1] != 'Q') || (data[2] != 'P') || (data[3] != 'P')) return false;
+    if (ReadProfilesUshort(data + 4) != SITE_PROFILES_VERSION) return false;
+
+    unsigned int count = ReadProfilesUshort(data + 6);
+    unsigned int stringsSize = ReadProfilesUint(data + 8);
+    unsigned int recordsSize = count*SITE_PROFILES_RECORD_FIELDS*4;
+
+    if ((count > SITE_PROFILES_MAX_COUNT) || (stringsSize == 0)) return false;
+    if ((SITE_PROFILES_HEADER_SIZE + recordsSize + stringsSize) != (unsigned int)dataSize) return false;
+
+    const unsigned char *strings = data + SITE_PROFILES_HEADER_SIZE + recordsSize;
+    if (strings[stringsSize - 1] != '\0') return false;    // Last string must be terminated
+
+    for (unsigned int i = 0; i < count; i++)
+    {
+        for (int k = 1; k < SITE_PROFILES_RECORD_FIELDS; k++)
+        {
+            if (ReadProfilesUint(data + SITE_PROFILES_HEADER_SIZE + (i*SITE_PROFILES_RECORD_FIELDS + k)*4) >= stringsSize) return false;
+        }
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Load site profiles file
+// NOTE: File is memory mapped (read-only), profiles are not parsed until requested
+SiteProfiles LoadSiteProfiles(const char *fileName)
+{
+    SiteProfiles profiles = { 0 };
+
+#if defined(_WIN32)
+    FILE *file = fopen(fileName, "rb");
+    if (file == NULL) return profiles;
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    if (size > 0)
+    {
+        profiles.data = (unsigned char *)calloc(size, 1);
+        profiles.dataSize = (int)fread(profiles.data, 1, size, file);
+    }
+    fclose(file);
+#else
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0) return profiles;
+
+    struct stat fileInfo = { 0 };
+    if ((fstat(fd, &fileInfo) == 0) && (fileInfo.st_size > 0))
+    {
+        void *data = mmap(NULL, fileInfo.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED)
+        {
+            profiles.data = (unsigned char *)data;
+            profiles.dataSize = (int)fileInfo.st_size;
+            profiles.mapped = true;
+        }
+    }
+    close(fd);      // NOTE: Mapping is kept after closing file descriptor
+#endif
+
+    if (IsSiteProfilesDataValid(profiles.data, profiles.dataSize)) profiles.count = ReadProfilesUshort(profiles.data + 6);
+    else UnloadSiteProfiles(&profiles);
+
+    return profiles;
+}
+
+// Unload site profiles file
+void UnloadSiteProfiles(SiteProfiles *profiles)
+{
+#if !defined(_WIN32)
+    if (profiles->mapped) munmap(profiles->data, profiles->dataSize);
+    else
+#endif
+    free(profiles->data);
+
+    *profiles = (SiteProfiles){ 0 };
+}
+
+// Get site profile by index
+SiteProfile GetSiteProfile(const SiteProfiles *profiles, int index)
+{
+    SiteProfile profile = { 0 };
+
+    if ((index < 0) || (index >= profiles->count)) return profile;
+
+    const unsigned char *record = profiles->data + SITE_PROFILES_HEADER_SIZE + index*SITE_PROFILES_RECORD_FIELDS*4;
+    const char *strings = (const char *)profiles->data + SITE_PROFILES_HEADER_SIZE + profiles->count*SITE_PROFILES_RECORD_FIELDS*4;
+
+    profile.flags = (int)ReadProfilesUint(record);
+    profile.name = strings + ReadProfilesUint(record + 4);
+    profile.gitRepositoryUrl = strings + ReadProfilesUint(record + 8);
+    profile.contentFolderPath = strings + ReadProfilesUint(record + 12);
+    profile.imageFolderPath = strings + ReadProfilesUint(record + 16);
+
+    return profile;
+}
+
+// Find site profile by git repository url
+int FindSiteProfile(const SiteProfiles *profiles, const char *gitRepositoryUrl)
+{
+    for (int i = 0; i < profiles->count; i++)
+    {
+        if (strcmp(GetSiteProfile(profiles, i).gitRepositoryUrl, gitRepositoryUrl) == 0) return i;
+    }
+
+    return -1;
+}
+
+// Save site profiles into binary file
+// NOTE: Data is written as a file batch (temp file renamed over previous file), a currently
+// mapped profiles store stays valid (old file data) until unloaded
+bool SaveSiteProfiles(const char *fileName, const SiteProfile *profiles, int count)
+{
+    if ((count < 0) || (count > SITE_PROFILES_MAX_COUNT)) return false;
+
+    FileBatch *batch = BeginFileBatch();
+    FILE *file = OpenBatchFile(batch, fileName);
+    if (file == NULL)
+    {
+        AbortFileBatch(batch);
+        return false;
+    }
+
+    // Strings data starts with an empty string, used by NULL fields
+    unsigned int stringsSize = 1;
+    for (int i = 0; i < count; i++)
+    {
+        const char *fields[4] = { profiles[i].name, profiles[i].gitRepositoryUrl, profiles[i].contentFolderPath, profiles[i].imageFolderPath };
+        for (int k = 0; k < 4; k++) if (fields[k] != NULL) stringsSize += (unsigned int)strlen(fields[k]) + 1;
+    }
+
+    fwrite("SQPP", 1, 4, file);
+    WriteProfilesUshort(file, SITE_PROFILES_VERSION);
+    WriteProfilesUshort(file, (unsigned short)count);
+    WriteProfilesUint(file, stringsSize);
+
+    unsigned int offset = 1;
+    for (int i = 0; i < count; i++)
+    {
+        const char *fields[4] = { profiles[i].name, profiles[i].gitRepositoryUrl, profiles[i].contentFolderPath, profiles[i].imageFolderPath };
+
+        WriteProfilesUint(file, (unsigned int)profiles[i].flags);
+        for (int k = 0; k < 4; k++)
+        {
+            if (fields[k] != NULL)
+            {
+                WriteProfilesUint(file, offset);
+                offset += (unsigned int)strlen(fields[k]) + 1;
+            }
+            else WriteProfilesUint(file, 0);
+        }
+    }
+
+    fputc('\0', file);
+    for (int i = 0; i < count; i++)
+    {
+        const char *fields[4] = { profiles[i].name, profiles[i].gitRepositoryUrl, profiles[i].contentFolderPath, profiles[i].imageFolderPath };
+        for (int k = 0; k < 4; k++) if (fields[k] != NULL) fwrite(fields[k], 1, strlen(fields[k]) + 1, file);
+    }
+
+    CloseBatchFile(batch, file);
+
+    return EndFileBatch(batch);
+}
+
+// Export site profiles as text file (.ini), one section per profile
+// NOTE: Keys match command line options and publish manifest keys
+bool ExportSiteProfilesAsText(const char *fileName, const SiteProfiles *profiles)
+{
+    FileBatch *batch = BeginFileBatch();
+    FILE *file = OpenBatchFile(batch, fileName);
+    if (file == NULL)
+    {
+        AbortFileBatch(batch);
+        return false;
+    }
+
+    fprintf(file, "# StatiqPress site profiles (v%i), exported for review\n", SITE_PROFILES_VERSION);
+    fprintf(file, "# NOTE: Profiles are loaded from binary file, changes on this file are not loaded\n");
+
+    for (int i = 0; i < profiles->count; i++)
+    {
+        SiteProfile profile = GetSiteProfile(profiles, i);
+
+        fprintf(file, "\n[%s]\n", profile.name);
+        fprintf(file, "repo = %s\n", profile.gitRepositoryUrl);
+        fprintf(file, "content = %s\n", profile.contentFolderPath);
+        fprintf(file, "images = %s\n", profile.imageFolderPath);
+        fprintf(file, "flags = %i\n", profile.flags);
+    }
+
+    CloseBatchFile(batch, file);
+
+    return EndFileBatch(batch);
+}
+
+#endif // SITE_PROFILES_IMPLEMENTATION
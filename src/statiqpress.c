@@ -1,16 +1,59 @@
 /*******************************************************************************************
 *
-*   raylib projects creator
+*   StatiqPress - Effortless GUI for uploading content to GitHub static blogs
 *
 *   FEATURES:
-*       - Generate complete build systems: Makefile, VSCode, VS2022
-*       - Generate complete GitHub project, ready to upload
--       - Generate preconfigured GitHub Actions, ready to run
-*       - WEB: Download generated template as a .zip file
+*       - Publish markdown posts (front matter, banner, assets) to a static site repository (Hugo, Zola, Jekyll)
+*       - Headless command line mode sharing the GUI publish pipeline, batch manifests
+*       - Durable outbox: queued posts pushed in one commit per repository, kept while offline
+*       - Site-wide front matter rewrites, posts metadata index and taxonomy autocompletion
+*       - Offline HTML previews (built-in markdown renderer), served from local HTTP server
+*       - Incremental RSS feed, sitemap and client-side search index updated on publish
+*       - Post bundles (.zip) export and import, lossless PNG recompression, duplicate images detection
 *
 *   LIMITATIONS:
-*       - Script: build.bat requires Makefile, it could be a cmd/shell script instead
-*       - VSCode: Requires compiler tools (make.exe) in the system path
+*       - Git (CLI) must be installed and configured with access to the site repository
+*       - Previews use built-in renderer, site theme and shortcodes are not applied
+*
+*   COMMAND LINE:
+*       statiqpress publish --title <text> --md <file.md> [--banner <file.png>] [--repo <url>] ...
+*       statiqpress publish --manifest <posts.ini> [--stats] [--dry-run] [--reuse-images]
+*           Publish post(s) without window or graphic context, using same pipeline as GUI
+*           Every post is published as a page bundle, <content>/<slug>/index.md (and banner), slug is
+*           --slug or generated from title, a number is appended if slug is already used in site
+*           --stats reports memory usage after every post (arenas and process RSS)
+*           --dry-run prepares posts in memory and compares them with a cached mirror of the site
+*           repository (./posts/mirror): files added/modified, bytes to push and estimated pack
+*           size are reported, nothing is written, queued or pushed
+*           Banner is compared with site images (perceptual hash): a similar image is reported,
+*           --reuse-images links it as post banner instead of publishing a new banner file
+*           --md also accepts a post bundle (.zip): markdown and banner are read from bundle,
+*           assets are imported into site images folder and links are updated
+*           Posts are queued in outbox and pushed at once (one commit per repository) before exit,
+*           posts that could not be pushed are kept in outbox
+*           Site RSS feed (posts-feed.xml) and sitemap (posts-sitemap.xml) are updated in the same commit:
+*           only pushed posts entries are spliced in, files are created from site posts index if missing;
+*           names differ from site generator outputs (Hugo index.xml, sitemap.xml), so both are kept
+*           Site search index (search/index.json and shards) is updated in the same commit: only
+*           pushed posts are tokenized, only shards of their terms are rewritten
+*       statiqpress outbox
+*           Push posts kept in outbox (i.e. previous push failed while offline)
+*       statiqpress rewrite --rule <key>:<from>=<to> [--rule ...] [--repo <url>] [--content <path>] [--path <folder>]
+*           Rename/merge/remove front matter values (tags, categories, authors...) of all site posts,
+*           rewritten in parallel and pushed in a single commit; --path rewrites a local folder instead
+*       statiqpress index [--repo <url>] [--content <path>] [--slug <slug>] [--tag <tag>] [--list <field>]
+*           Refresh metadata index of site posts (path, slug, title, date, tags, categories, authors)
+*           from cached repository mirror: only posts changed since last refresh are read and parsed,
+*           index is memory mapped and queried with binary searches
+*       statiqpress preview [publish options] [--site] [--serve] [--port <port>]
+*           Render post as prepared for publishing (front matter, banner) into an HTML page with the
+*           built-in markdown renderer (./posts/preview/<slug>/index.html), no site generator needed;
+*           --site also renders all markdown files of site content folder from the cached repository
+*           mirror, in parallel (./posts/preview/site)
+*           --serve opens previews from local HTTP server (127.0.0.1, port 4390 by default) until ENTER,
+*           GUI PREVIEW button uses the same server, refreshed every time the draft is prepared
+*       statiqpress bundle --md <file.md> [--banner <file.png>] ... --output <post.zip>
+*           Export post (generated index.md, banner and referenced assets) as .zip bundle
 *
 *   CONFIGURATION:
 *       #define CUSTOM_MODAL_DIALOGS
@@ -51,6 +94,11 @@
 *
 **********************************************************************************************/
 
+#define TOOL_NAME               "StatiqPress"
+#define TOOL_SHORT_NAME         "SqP"
+#define TOOL_VERSION            "1.0"
+#define TOOL_DESCRIPTION        "Effortless GUI for uploading content to GitHub static blogs"
+
 #include "raylib.h"
 
 #if defined(PLATFORM_WEB)
@@ -89,6 +137,69 @@
 #include <time.h>                   // Required for: time_t now to get hugo format
 #include <stdio.h>                  // Required for: printf
 
+#define ARENA_IMPLEMENTATION
+#include "arena.h"                  // Arena: Bump allocator for transient strings and buffers
+#undef ARENA_IMPLEMENTATION         // Avoid including arena implementation again
+
+#define WORKER_POOL_IMPLEMENTATION
+#include "worker_pool.h"            // Worker pool: Run jobs in parallel on CPU cores
+#undef WORKER_POOL_IMPLEMENTATION   // Avoid including worker pool implementation again
+
+#define FILE_BATCH_IMPLEMENTATION
+#include "file_batch.h"             // File batch: Crash-safe output files, synced at batch end
+#undef FILE_BATCH_IMPLEMENTATION    // Avoid including file batch implementation again
+
+#define PARALLEL_DEFLATE_IMPLEMENTATION
+#include "parallel_deflate.h"       // Parallel deflate: Chunked multi-threaded compression for large assets
+#undef PARALLEL_DEFLATE_IMPLEMENTATION  // Avoid including parallel deflate implementation again
+
+#define POST_BUNDLE_IMPLEMENTATION
+#include "post_bundle.h"            // Post bundle: Export post and assets as .zip
+
+#define DATA_PACK_IMPLEMENTATION
+#include "data_pack.h"              // Data pack: Template files attached to executable
+
+#define OUTBOX_IMPLEMENTATION
+#include "outbox.h"                 // Outbox: Durable publish queue, posts pushed in batches
+
+#include "git_handler.h"            // Git: Clone, commit and push to site repository
+
+#define SITE_PROFILES_IMPLEMENTATION
+#include "site_profiles.h"          // Site profiles: Persistent build settings per site
+
+#define FRONT_MATTER_IMPLEMENTATION
+#include "front_matter.h"           // Front matter: Front matter parsing and site-wide rewriting
+
+#define POST_INDEX_IMPLEMENTATION
+#include "post_index.h"             // Post index: Compact metadata index of site posts (memory mapped)
+
+#define COMPLETION_TRIE_IMPLEMENTATION
+#include "completion_trie.h"        // Completion trie: Text completion of existing values, ranked by frequency
+
+#define JOB_QUEUE_IMPLEMENTATION
+#include "job_queue.h"              // Job queue: Background jobs polled by GUI (drafts preparation)
+
+#define LINK_VALIDATOR_IMPLEMENTATION
+#include "link_validator.h"         // Link validator: Check post links against repository tree and post files
+
+#define PNG_OPTIMIZER_IMPLEMENTATION
+#include "png_optimizer.h"          // PNG optimizer: Lossless PNG recompression, filter strategies tried in parallel
+
+#define IMAGE_HASH_IMPLEMENTATION
+#include "image_hash.h"             // Image hash: Perceptual image hashes, near-duplicates search (BK-tree)
+
+#define MARKDOWN_HTML_IMPLEMENTATION
+#include "markdown_html.h"          // Markdown HTML: Markdown to HTML renderer for offline previews (streamed output)
+
+#define PREVIEW_SERVER_IMPLEMENTATION
+#include "preview_server.h"         // Preview server: Local HTTP server for previews, pages served from memory (epoll)
+
+#define SITE_FEED_IMPLEMENTATION
+#include "site_feed.h"              // Site feed: Incremental RSS feed and sitemap updates (published posts spliced)
+
+#define SEARCH_INDEX_IMPLEMENTATION
+#include "search_index.h"           // Search index: Incremental sharded inverted index for client-side search
+
 //----------------------------------------------------------------------------------
 // Defines and Macros
 //----------------------------------------------------------------------------------
@@ -107,6 +218,27 @@ bool __stdcall FreeConsole(void);       // Close console from code (kernel32.lib
 
 //#define BUILD_TEMPLATE_INTO_EXE
 
+#define SITE_PROFILES_FILE_PATH         "config/profiles.sqp"   // Relative to application directory
+#define SITE_PROFILES_EXPORT_PATH       "config/profiles.ini"
+
+#define OUTBOX_PATH                     "./posts/outbox"        // Queued posts, pushed by outbox drainer
+#define OUTBOX_RETRY_DELAY              30                      // Seconds before retrying a failed push (doubled on every failure)
+
+#define PREVIEW_PATH                    "./posts/preview"       // Rendered HTML previews: drafts, command line posts and site
+#define PREVIEW_PAGES_PER_JOB           16                      // Site preview pages rendered by a worker job
+#define PREVIEW_SERVER_PORT             4390                    // Local preview server port, any free port if not available
+
+#define POST_INDEX_FILE_NAME            "statiqpress-posts.idx" // Site posts index, saved into repository mirror folder
+#define IMAGE_HASH_FILE_NAME            "statiqpress-images.idx" // Site images perceptual hashes (by blob id), saved into repository mirror folder
+#define IMAGE_DUPLICATE_DISTANCE        10                      // Max perceptual hash distance (bits of 64) of similar images
+
+#define SITE_FEED_FILE_NAME             "posts-feed.xml"        // Site RSS feed, in repository static folder (or root), not a generator output name
+#define SITE_MAP_FILE_NAME              "posts-sitemap.xml"     // Site sitemap, next to feed (site root, so all posts URLs are in its scope)
+#define SITE_FEED_MAX_ITEMS             20                      // Feed items kept (newest), older ones dropped
+#define SEARCH_INDEX_FOLDER_NAME        "search"                // Site search index folder, next to feed
+
+#define MAX_POST_DRAFTS                 4                       // Drafts workspace tabs (fixed tab width, all tabs visible)
+
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
@@ -121,7 +253,9 @@ typedef struct ProjectConfig {
         char description[256];      // Post Descripton
         char tags[64];              // Post Tags
         char category[64];          // Post Category
+        char slug[128];             // Post slug, page bundle folder name (generated from title if empty)
         char srcBannerPath[256];    // Post banner image path
+        char bannerLink[256];       // Site image reused as banner (similar to banner), no banner file published
         char srcContentPath[256];   // Post content path
     } project;
     struct {
@@ -132,13 +266,39 @@ typedef struct ProjectConfig {
     } building;
 } ProjectConfig;
 
-// Packed file entry
-// NOTE: Used for template packing and attach to executable
-typedef struct PackFileEntry {
-    int fileSize;
-    int compFileSize;
-    char filePath[256];
-} PackFileEntry;
+// Draft preparation: post written into draft scratch folder, on job queue thread
+// NOTE: Preparation is allocated apart from draft, so it is not moved while a job uses it,
+// job only reads source and writes config/result, main thread reads them once job is done
+typedef struct DraftPreparation {
+    ProjectConfig source;           // Draft config when prepared, compared to detect changes
+    ProjectConfig config;           // Prepared config (empty fields set from post front matter)
+    long contentModTime;            // Source files modification times when prepared
+    long bannerModTime;
+    char postPath[256];             // Prepared post folder (scratch), NEW_POST_PATH/.draft-<id>
+    char previewPath[256];          // Prepared post HTML preview folder, PREVIEW_PATH/draft-<id>
+    PreviewServer *server;          // Preview server when prepared (NULL if not loaded yet), preview page is set into it
+    Arena arena;                    // Transient memory of preparation, reset on every preparation
+    int job;                        // Preparation job id (-1 if never prepared)
+    int result;                     // writeContent() result of last preparation
+} DraftPreparation;
+
+// Post draft, one tab of drafts workspace
+typedef struct PostDraft {
+    ProjectConfig config;
+    int id;                         // Unique in session, names draft scratch folder
+    char tabName[32];
+    struct {
+        bool title;                 // Text boxes edit mode, draft is not prepared while edited
+        bool author;
+        bool description;
+        bool tags;
+        bool category;
+        bool repository;
+        bool contentPath;
+        bool imagesPath;
+    } editMode;
+    DraftPreparation *preparation;
+} PostDraft;
 
 //----------------------------------------------------------------------------------
 // Module Functions Declaration
@@ -146,7 +306,74 @@ typedef struct PackFileEntry {
 
 // GUI: Load Source Files Dialog
 static void getFilePath(ProjectConfig *config);
-static void uploadProject(ProjectConfig *config);
+static void uploadProject(void);
+
+static void loadDefaultConfig(ProjectConfig *config);   // Load project config defaults
+static int writeContent(Arena *arena, ProjectConfig *config, const char *postPath); // Write post content with front matter
+static int writePostContent(Arena *arena, ProjectConfig *config, const char *postPath, const char *content, size_t contentSize); // Write post content (already loaded) with front matter
+static const char *getPostSlug(ProjectConfig *config);  // Get post slug: config slug or slugified title
+static const char *reservePostSlug(ProjectConfig *config); // Get post slug not used by site posts or session posts, reserved for post
+static void loadSiteSlugs(ProjectConfig *config, bool refreshIndex); // Load slugs used in site content folder, from site posts index
+static bool isPostBundleFile(const char *fileName);     // Check if file is a post bundle (.zip), thread safe
+static char *loadPostContent(Arena *arena, ProjectConfig *config, size_t *contentSize); // Load post markdown, from file or post bundle
+static unsigned char *optimizeBanner(const unsigned char *data, int dataSize, int *optimizedSize); // Recompress PNG banner losslessly, NULL if not smaller
+static size_t importPostFrontMatter(ProjectConfig *config, const char *content, size_t contentSize); // Set empty config fields from post front matter, returns body offset
+static const char *formatFrontMatter(Arena *arena, ProjectConfig *config); // Format post front matter (TOML)
+static void escapeFrontMatterString(const char *text, char *escaped, size_t size); // Escape text as TOML basic string content (quotes, backslashes, line breaks)
+static const char *copyFrontMatterValue(Arena *arena, FrontMatterSlice value); // Copy front matter value into arena, escape sequences decoded
+static char *rewriteBundleLinks(Arena *arena, const char *content, const char *assetsPath, const BundleAsset *assets, int count); // Update links to bundle assets
+static uint8_t importPostBundle(const char *worktreePath, void *userData); // Import post bundle into repository worktree
+static bool pushOutboxEntries(const OutboxEntry *entries, int count, void *userData); // Push outbox entries of one repository
+static uint8_t updateSiteFeeds(const char *worktreePath, void *userData); // Update site feed and sitemap in repository worktree with pushed posts
+static uint8_t updateSiteSearchIndex(const char *worktreePath, void *userData); // Update site search index in repository worktree with pushed posts
+static uint8_t updateSiteFiles(const char *worktreePath, void *userData); // Update site files (feeds, search index) in repository worktree with pushed posts
+static const LinkTree *loadSiteLinks(ProjectConfig *config); // Load site repository tree paths (mirror), for links validation
+static void unloadSiteLinks(void);                      // Unload site repository tree paths
+static int validatePostLinks(ProjectConfig *config, const char *slug, const char *content, bool banner); // Validate post links and images, returns issues count
+static int validatePostFolderLinks(ProjectConfig *config, const char *slug, const char *postPath); // Validate links of post written into post folder
+static void renderPreviewPage(Arena *arena, const char *text, int size, MarkdownWriteFunc write, void *userData); // Render HTML preview page of post (front matter and markdown)
+static int renderPostPreview(Arena *arena, PreviewServer *server, const char *postPath, const char *previewPath); // Render preview of post prepared into post folder
+static const ImageHashTree *loadSiteImages(ProjectConfig *config); // Load site images hashes (mirror), for similar images search
+static void unloadSiteImages(void);                     // Unload site images hashes
+static bool findSimilarBanner(ProjectConfig *config, char *path, char *link, int *distance); // Find site image similar to post banner (path and link, 256 bytes)
+static void checkBanner(void *data);                    // Find site image similar to selected banner (job function)
+static int queuePost(ProjectConfig *config, const char *slug, const char *postPath); // Queue post folder in outbox, to be pushed as site post <slug>
+static int publishProject(ProjectConfig *config);       // Write post content and queue it to be pushed to site repository
+static void logMemoryStats(const char *label);          // Log arenas and process memory usage
+static bool exportPostBundle(ProjectConfig *config, const char *fileName); // Export post and referenced assets as .zip bundle
+
+// Drafts workspace functionality
+static PostDraft *addPostDraft(const ProjectConfig *building); // Add empty draft, build settings copied
+static void removePostDraft(int index);                 // Remove draft, its preparation is waited and scratch folder removed
+static bool isPostDraftEdited(const PostDraft *draft);  // Check if any draft text box is in edit mode
+static bool isPostDraftStale(const PostDraft *draft);   // Check if draft changed since prepared (config or source files)
+static void beginPostDraftPreparation(PostDraft *draft); // Snapshot draft for preparation (main thread)
+static void preparePostDraft(void *data);               // Prepare draft post into scratch folder (job function)
+static void openPostDraftPreview(const PostDraft *draft); // Open draft HTML preview in browser (local preview server)
+static void updatePostDrafts(void);                     // Queue preparation of changed drafts not being edited
+static int publishPostDrafts(void);                     // Publish all ready drafts at once, returns number of posts queued
+
+// Site profiles functionality
+static void loadSiteProfiles(void);                     // Load (map) site profiles and update profiles names
+static void applySiteProfile(ProjectConfig *config, int index); // Set build settings from site profile
+static bool saveSiteProfile(ProjectConfig *config);     // Save build settings as site profile (update if repository exists)
+
+#if defined(PLATFORM_DESKTOP)
+// Command line functionality
+static void showCommandLineInfo(void);                  // Show command line usage info
+static int processCommandLine(int argc, char *argv[]);  // Process command line input, returns exit code
+static int drainOutbox(void);                           // Push queued posts, returns number of posts still pending
+static int rewriteFromCommandLine(int argc, char *argv[]); // Rewrite front matter of all site posts, returns exit code
+static int indexFromCommandLine(int argc, char *argv[]); // Refresh and query site posts index, returns exit code
+static const char *refreshPostIndex(GitRepository *repo, const char *contentPath); // Refresh site posts index from repository mirror, returns index file path
+static int previewFromCommandLine(int argc, char *argv[]); // Render post (and site) HTML preview, returns exit code
+
+// Taxonomy completions functionality
+static void updateTaxonomyCompletions(ProjectConfig *config); // Start building completions of site repository (background), if changed
+static bool guiCompletionList(Rectangle bounds, char *text, int textSize, PostIndexField field); // GUI: Completions of item being edited, returns true if one was chosen
+static int dryRunPost(ProjectConfig *config);           // Prepare post in memory and compare it with repository mirror
+static void reportDryRun(void);                         // Report files changed by dry run posts, per repository
+#endif
 
 //----------------------------------------------------------------------------------
 // Global Variables Definition
@@ -160,6 +387,8 @@ static bool showLoadRaylibSourcePathDialog = false;
 static bool showLoadCompilerPathDialog = false;
 static bool showLoadOutputPathDialog = false;
 static bool showUploadProjectPopup = false;
+static bool showExportBundleDialog = false;
+static bool showBannerReusePopup = false;
 static bool showInfoMessagePanel = false;
 static const char *infoTitle = NULL;
 static const char *infoMessage = NULL;
@@ -169,6 +398,64 @@ static bool lockBackground = false;
 
 static char **srcFileNameList = NULL;
 
+// Memory arenas: session arena lives until program ends, publish arena is reset after every publish
+static Arena sessionArena = { 0 };
+static Arena publishArena = { 0 };
+static bool showMemoryStats = false;            // Log memory usage after every publish (command line --stats)
+
+static WorkerPool *workerPool = NULL;           // Worker threads for parallel jobs (i.e. bundle compression)
+static PreviewServer *previewServer = NULL;     // Local preview server (PREVIEW_PATH), loaded on first preview request
+
+// Publish outbox: posts are queued on publish and pushed by outbox drainer (background thread in GUI mode)
+// NOTE: Outbox arena is only used by drains, as they run on drainer thread
+static Outbox *outbox = NULL;
+static Arena outboxArena = { 0 };
+
+static bool publishDryRun = false;              // Prepare posts and report changes, without publishing (command line --dry-run)
+
+#if defined(BUILD_TEMPLATE_INTO_EXE)
+static DataPack templatePack = { 0 };           // Template files attached to executable, load with LoadDataPackFile()
+#endif
+
+static SiteProfiles siteProfiles = { 0 };       // Site profiles (mapped from file)
+static char siteProfilesNames[1024] = { 0 };    // Site profiles names for selector, separated by ';'
+
+// Drafts workspace: every draft is prepared on job queue thread while another one is edited
+static PostDraft drafts[MAX_POST_DRAFTS] = { 0 };
+static int draftCount = 0;
+static int activeDraft = 0;
+static int nextDraftId = 0;
+static JobQueue *draftQueue = NULL;
+
+// Banner check: selected banner is compared with site images on job queue thread, reuse is offered
+// NOTE: Job only reads config and writes result, GUI reads result once job is done
+typedef struct BannerCheck {
+    ProjectConfig config;           // Draft config when banner was selected
+    int draftId;
+    int job;
+    bool pending;                   // Job queued, result not read yet
+    bool found;
+    char path[256];                 // Similar site image path in repository
+    char link[256];                 // Similar site image link, used as banner if reused
+    int distance;
+} BannerCheck;
+
+static BannerCheck bannerCheck = { 0 };
+static bool reuseSiteImages = false;            // Reuse site images similar to post banners (command line --reuse-images)
+
+#if defined(PLATFORM_DESKTOP)
+// Taxonomy completions (tags, categories, authors), tries built on background thread from site posts index
+// NOTE: Completions source is only changed once previous task is done, task thread reads it
+typedef struct CompletionSource {
+    char repositoryUrl[256];
+    char contentPath[256];
+} CompletionSource;
+
+static CompletionTask *completionTask = NULL;
+static CompletionSource completionSource = { 0 };
+static Rectangle completionListBounds = { 0 };  // Completion list shown on last frame, controls below are locked on hover
+#endif
+
 static bool screenSizeDouble = false; // Scale screen x2 (useful for HighDPI/4K screens)
 
 //------------------------------------------------------------------------------------
@@ -177,17 +464,16 @@ static bool screenSizeDouble = false; // Scale screen x2 (useful for HighDPI/4K
 int main(int argc, char *argv[])
 {
 #if defined(BUILD_TEMPLATE_INTO_EXE)
-    // Attach template data into generated executable on first run
-    int exeFileDataSize = 0;
-    unsigned char *exeFileData = LoadFileData(argv[0], &exeFileDataSize);
-
-    // Check if template already added to not add it again
-    char fourcc[5] = { 0 };
-    memcpy(fourcc, exeFileData + exeFileDataSize - 4, 4);
+    // Template data attached to executable is mapped, entries are decompressed when requested
+    // NOTE: Pack is found by footer at executable end, executable is not loaded
+    templatePack = LoadDataPack(argv[0]);
 
-    if ((fourcc[0] != 'r') || (fourcc[1] != 'p') || (fourcc[2] != 'c') || (fourcc[3] != 'h'))
+    if (templatePack.pack == NULL)
     {
-        // No template data attached to exe, so we attach it
+        // No template data attached to exe, so we attach it into generated executable
+        int exeFileDataSize = 0;
+        unsigned char *exeFileData = LoadFileData(argv[0], &exeFileDataSize);
+
         int packDataSize = 0;
         char *packData = PackDirectoryData(TextFormat("%s/template", GetApplicationDirectory()), &packDataSize);
 
@@ -200,6 +486,7 @@ int main(int argc, char *argv[])
 
         RL_FREE(outExeFileData);
         RL_FREE(packData);
+        UnloadFileData(exeFileData);
     }
 #endif
 
@@ -207,6 +494,33 @@ int main(int argc, char *argv[])
     SetTraceLogLevel(LOG_NONE);         // Disable raylib trace log messsages
 #endif
 
+    // Site profiles are mapped, not parsed, no startup cost
+    loadSiteProfiles();
+    workerPool = LoadWorkerPool(0);
+    outbox = LoadOutbox(OUTBOX_PATH);
+
+#if defined(PLATFORM_DESKTOP)
+    // Command-line usage mode
+    // NOTE: No window or graphic context is created, post(s) are published and program exits
+    //--------------------------------------------------------------------------------------
+    if (argc > 1)
+    {
+        int result = processCommandLine(argc, argv);
+#if defined(BUILD_TEMPLATE_INTO_EXE)
+        UnloadDataPack(&templatePack);
+#endif
+        UnloadOutbox(outbox);
+        UnloadWorkerPool(workerPool);
+        UnloadSiteProfiles(&siteProfiles);
+        unloadSiteLinks();
+        unloadSiteImages();
+        ArenaFree(&outboxArena);
+        ArenaFree(&publishArena);
+        ArenaFree(&sessionArena);
+        return result;
+    }
+#endif
+
 #if (!defined(_DEBUG) && (defined(WIN32) || defined(_WIN32) || defined(__WIN32) && !defined(__CYGWIN__)))
     // WARNING (Windows): If program is compiled as Window application (instead of console),
     // no console is available to show output info... solution is compiling a console application
@@ -225,6 +539,9 @@ int main(int argc, char *argv[])
     GuiMainToolbarState toolbarState = InitGuiMainToolbar();
     SetExitKey(0);
 
+    // Queued posts are pushed in background, posts left by a previous session are pushed first
+    StartOutboxDrainer(outbox, pushOutboxEntries, NULL, OUTBOX_RETRY_DELAY);
+
     RenderTexture2D screenTarget = LoadRenderTexture(screenWidth, screenHeight);
     SetTextureFilter(screenTarget.texture, TEXTURE_FILTER_POINT);
 
@@ -245,41 +562,27 @@ int main(int argc, char *argv[])
     }
 #endif
 
-    // Initialize project config default
-    ProjectConfig *config = (ProjectConfig *)RL_CALLOC(1, sizeof(ProjectConfig));
-    config->project.type = 2;  // Custom files
-    strcpy(config->project.title, "");
-    strcpy(config->project.author, "");
-    strcpy(config->project.description, "");
-    strcpy(config->project.tags, "");
-    strcpy(config->project.category, "");
-    strcpy(config->building.contentFolderPath, "content/blog/");
-    strcpy(config->building.gitRepositoryUrl, "https://github.com/Discovery-Data-Lab/blog.git");
-    strcpy(config->building.imageFolderPath, "static/img/");
+    // Initialize drafts workspace with one draft (project config default)
+    // NOTE: Drafts are prepared on job queue thread, while edited config is the active draft one
+    draftQueue = LoadJobQueue();
+    PostDraft *draft = addPostDraft(NULL);
+    ProjectConfig *config = &draft->config;
+    if (siteProfiles.count > 0) applySiteProfile(config, 0);
+    toolbarState.profileNames = (siteProfiles.count > 0)? siteProfilesNames : NULL;
 
     // Source file names (without path) are used for display on source textbox
-    srcFileNameList = (char **)RL_CALLOC(256, sizeof(char *)); // Max number of input source files supported
-    for (int i = 0; i < 256; i++) srcFileNameList[i] = (char *)RL_CALLOC(256, sizeof(char));
+    // NOTE: Allocated in session arena, released at once on program end
+    srcFileNameList = (char **)ArenaAlloc(&sessionArena, 256*sizeof(char *)); // Max number of input source files supported
+    for (int i = 0; i < 256; i++) srcFileNameList[i] = (char *)ArenaAlloc(&sessionArena, 256*sizeof(char));
 
     // GUI: Main Layout
     //-----------------------------------------------------------------------------------
-    Vector2 anchorProject = { 8, 64 };
-    Vector2 anchorBuilding = { 8, 258 };
-
-    bool projectNameEditMode = false;
-    strcpy(config->project.title, "");
-    bool productNameEditMode = false;
-    strcpy(config->project.author, "");
-    bool projectDeveloperEditMode = false;
-    strcpy(config->project.tags, "");
-    bool projectDeveloperWebEditMode = false;
-    strcpy(config->project.category, "");
-    bool projectDescriptionEditMode = false;
-    strcpy(config->project.description, "");
+    Vector2 anchorDrafts = { 8, 48 };
+    Vector2 anchorProject = { 8, 88 };
+    Vector2 anchorBuilding = { 8, 282 };
+
+    // NOTE: Text boxes edit mode is kept per draft
     bool projectSourceFilePathEditMode = false;
-    bool buildingRaylibPathEditMode = false;
-    bool buildingCompilerPathEditMode = false;
-    bool buildingOutputPathEditMode = false;
 
     GuiLoadStyleAmber();    // Load UI style
 
@@ -297,6 +600,10 @@ int main(int argc, char *argv[])
     infoButton = "Sure! Let's start!";
     showInfoMessagePanel = false;
 
+    // Info message measure, only updated when message or style changes
+    const char *infoMessageMeasured = NULL;
+    Vector2 infoMessageSize = { 0 };
+
     LOG("INIT: Ready to show project generation info...\n");
 
     SetTargetFPS(60);
@@ -309,13 +616,61 @@ int main(int argc, char *argv[])
     // Main game loop
     while (!closeWindow)    // Detect window close button
     {
+        draft = &drafts[activeDraft];
+        config = &draft->config;
 
         // Clicking Logic:
         if (toolbarState.btnHelpPressed) windowHelpState.windowActive = true;       // Help button logic
         if (toolbarState.btnAboutPressed) windowAboutState.windowActive = true;     // About window button logic
         if (toolbarState.btnIssuePressed) showIssueReportWindow = true;             // Issue report window button logic
+        if (toolbarState.btnExportBundlePressed) showExportBundleDialog = true;     // Export bundle button logic
         //if (toolbarState.btnIssuePressed) showIssueReportWindow = true;             // Issue report window button logic
 
+        // Site profiles logic
+        if (toolbarState.profileActive != toolbarState.prevProfileActive)
+        {
+            applySiteProfile(config, toolbarState.profileActive);
+            toolbarState.prevProfileActive = toolbarState.profileActive;
+        }
+
+        if (toolbarState.btnSaveProfilePressed && saveSiteProfile(config))
+        {
+            toolbarState.profileNames = siteProfilesNames;
+            toolbarState.profileActive = FindSiteProfile(&siteProfiles, config->building.gitRepositoryUrl);
+            toolbarState.prevProfileActive = toolbarState.profileActive;
+        }
+
+        if (toolbarState.btnExportProfilesPressed)
+        {
+            if (ExportSiteProfilesAsText(TextFormat("%s%s", GetApplicationDirectory(), SITE_PROFILES_EXPORT_PATH), &siteProfiles)) LOG("INFO: Site profiles exported: %s\n", SITE_PROFILES_EXPORT_PATH);
+        }
+
+        // Visual style logic: cached text measures are not valid after a style change
+        if (toolbarState.btnReloadStylePressed || (toolbarState.visualStyleActive != toolbarState.prevVisualStyleActive))
+        {
+            if (toolbarState.btnReloadStylePressed) GuiLoadStyleAmber();
+
+            GuiClearTextCache();
+            infoMessageMeasured = NULL;
+            toolbarState.prevVisualStyleActive = toolbarState.visualStyleActive;
+        }
+
+        // Drafts logic: changed drafts are prepared in background once not being edited
+        updatePostDrafts();
+
+        // Banner check logic: reuse of similar site image is offered if banner was not changed meanwhile
+        if (bannerCheck.pending && IsJobDone(draftQueue, bannerCheck.job))
+        {
+            bannerCheck.pending = false;
+            showBannerReusePopup = bannerCheck.found && (draft->id == bannerCheck.draftId) &&
+                (strcmp(config->project.srcBannerPath, bannerCheck.config.project.srcBannerPath) == 0);
+        }
+
+#if defined(PLATFORM_DESKTOP)
+        // Taxonomy completions logic: rebuilt once site repository is not being edited
+        if (!draft->editMode.repository && !draft->editMode.contentPath) updateTaxonomyCompletions(config);
+#endif
+
         // WARNING: ASINCIFY requires this line,
         // it contains the call to emscripten_sleep() for PLATFORM_WEB
         if (WindowShouldClose()) closeWindow = true;
@@ -363,10 +718,19 @@ int main(int argc, char *argv[])
             showLoadRaylibSourcePathDialog ||
             showLoadCompilerPathDialog ||
             showLoadOutputPathDialog ||
+            showExportBundleDialog ||
+            showBannerReusePopup ||
             showUploadProjectPopup) lockBackground = true;
         else lockBackground = false;
 
         if (lockBackground) GuiLock();
+
+        // Completion list is drawn over other controls, they are locked while it is hovered
+        bool completionListHovered = false;
+#if defined(PLATFORM_DESKTOP)
+        completionListHovered = !lockBackground && CheckCollisionPointRec(GetMousePosition(), completionListBounds);
+        if (completionListHovered) GuiLock();
+#endif
         //----------------------------------------------------------------------------------
 
         // Draw
@@ -380,42 +744,62 @@ int main(int argc, char *argv[])
             GuiWindowHelp(&windowHelpState);
             GuiWindowAbout(&windowAboutState);
 
+            // GUI: Drafts tabs, one config per draft
+            const char *draftNames[MAX_POST_DRAFTS] = { 0 };
+            for (int i = 0; i < draftCount; i++) draftNames[i] = drafts[i].tabName;
+
+            int previousDraft = activeDraft;
+            int closedDraft = GuiTabBar((Rectangle){ anchorDrafts.x, anchorDrafts.y, 0, 24 }, draftNames, draftCount, &activeDraft);
+
+            GuiSetTooltip("Add a new draft, drafts are prepared in background and uploaded together");
+            if ((draftCount < MAX_POST_DRAFTS) && GuiButton((Rectangle){ anchorDrafts.x + 164*draftCount, anchorDrafts.y, 24, 24 }, "#8#"))
+            {
+                addPostDraft(config);
+                activeDraft = draftCount - 1;
+            }
+            GuiSetTooltip(NULL);
+
+            if (activeDraft != previousDraft) memset(&drafts[previousDraft].editMode, 0, sizeof(drafts[previousDraft].editMode));
+            if ((closedDraft >= 0) && (draftCount > 1)) removePostDraft(closedDraft);
 
+            draft = &drafts[activeDraft];
+            config = &draft->config;
 
             GuiGroupBox((Rectangle){ anchorProject.x + 0, anchorProject.y + 0, 784, 190 }, "PROJECT SETTINGS");
             GuiLabel((Rectangle){ anchorProject.x + 8, anchorProject.y + 24, 104, 24 }, "POST TITLE:");
             GuiSetTooltip("Just the title");
-            if (GuiTextBox((Rectangle){ anchorProject.x + 112, anchorProject.y + 24, 280, 24 }, config->project.title, 128, projectNameEditMode)) projectNameEditMode = !projectNameEditMode;
+            if (GuiTextBox((Rectangle){ anchorProject.x + 112, anchorProject.y + 24, 280, 24 }, config->project.title, sizeof(config->project.title), draft->editMode.title)) draft->editMode.title = !draft->editMode.title;
 
             GuiSetTooltip("For multiple Authors, separate them by comma ','");
             GuiLabel((Rectangle){ anchorProject.x + 408, anchorProject.y + 24, 80, 24 }, "AUTHOR(S):");
-            if (GuiTextBox((Rectangle){ anchorProject.x + 496, anchorProject.y + 24, 280, 24 }, config->project.author, 128, productNameEditMode)) productNameEditMode = !productNameEditMode;
+            if (GuiTextBox((Rectangle){ anchorProject.x + 496, anchorProject.y + 24, 280, 24 }, config->project.author, sizeof(config->project.author), draft->editMode.author)) draft->editMode.author = !draft->editMode.author;
 
             GuiSetTooltip("A short description of the post, max 256 characters");
             GuiLabel((Rectangle){ anchorProject.x + 8, anchorProject.y + 56, 104, 24 }, "DESCRIPTION:");
-            if (GuiTextBox((Rectangle){ anchorProject.x + 112, anchorProject.y + 56, 664, 24 }, config->project.description, 128, projectDescriptionEditMode)) projectDescriptionEditMode = !projectDescriptionEditMode;
+            if (GuiTextBox((Rectangle){ anchorProject.x + 112, anchorProject.y + 56, 664, 24 }, config->project.description, sizeof(config->project.description), draft->editMode.description)) draft->editMode.description = !draft->editMode.description;
 
             GuiSetTooltip("For multiple Tags, separate them by comma ','");
             GuiLabel((Rectangle){ anchorProject.x + 8, anchorProject.y + 88, 104, 24 }, "TAG(S):");
-            if (GuiTextBox((Rectangle){ anchorProject.x + 112, anchorProject.y + 88, 280, 24 }, config->project.tags, 128, projectDeveloperEditMode)) projectDeveloperEditMode = !projectDeveloperEditMode;
+            if (GuiTextBox((Rectangle){ anchorProject.x + 112, anchorProject.y + 88, 280, 24 }, config->project.tags, sizeof(config->project.tags), draft->editMode.tags)) draft->editMode.tags = !draft->editMode.tags;
 
             GuiSetTooltip("For multiple Categories, separate them by comma ','");
             GuiLabel((Rectangle){ anchorProject.x + 408, anchorProject.y + 88, 80, 24 }, "CATEGORY:");
-            if (GuiTextBox((Rectangle){ anchorProject.x + 496, anchorProject.y + 88, 280, 24 }, config->project.category, 128, projectDeveloperWebEditMode)) projectDeveloperWebEditMode = !projectDeveloperWebEditMode;
+            if (GuiTextBox((Rectangle){ anchorProject.x + 496, anchorProject.y + 88, 280, 24 }, config->project.category, sizeof(config->project.category), draft->editMode.category)) draft->editMode.category = !draft->editMode.category;
 
             if (config->project.type != 2) GuiDisable();
 
             GuiSetTooltip("The path to the directory containing the content of the Post");
             GuiLabel((Rectangle){ anchorProject.x + 8, anchorProject.y + 128, 104, 24 }, "SOURCE (.md):");
             GuiSetStyle(TEXTBOX, TEXT_READONLY, 1);
-            GuiTextBox((Rectangle){ anchorProject.x + 112, anchorProject.y + 128, 536, 24 }, config->project.srcContentPath, 256, projectSourceFilePathEditMode);//) projectSourceFilePathEditMode = !projectSourceFilePathEditMode;
+            GuiTextBox((Rectangle){ anchorProject.x + 112, anchorProject.y + 128, 536, 24 }, config->project.srcContentPath, sizeof(config->project.srcContentPath), projectSourceFilePathEditMode);//) projectSourceFilePathEditMode = !projectSourceFilePathEditMode;
             GuiSetStyle(TEXTBOX, TEXT_READONLY, 0);
             if (GuiButton((Rectangle){ anchorProject.x + 656, anchorProject.y + 128, 120, 24 }, "#4#Browse")) showLoadMarkdownFileDialog = true;
 
-            GuiSetTooltip("The path to the directory containing the banner for the Post");
+            if (config->project.bannerLink[0] != '\0') GuiSetTooltip(TextFormat("Similar site image reused as banner: %s", config->project.bannerLink));
+            else GuiSetTooltip("The path to the directory containing the banner for the Post");
             GuiLabel((Rectangle){ anchorProject.x + 8, anchorProject.y + 160, 104, 24 }, "BANNER (.png):");
             GuiSetStyle(TEXTBOX, TEXT_READONLY, 1);
-            GuiTextBox((Rectangle){ anchorProject.x + 112, anchorProject.y + 160, 536, 24 }, config->project.srcBannerPath, 256, projectSourceFilePathEditMode);//) projectSourceFilePathEditMode = !projectSourceFilePathEditMode;
+            GuiTextBox((Rectangle){ anchorProject.x + 112, anchorProject.y + 160, 536, 24 }, config->project.srcBannerPath, sizeof(config->project.srcBannerPath), projectSourceFilePathEditMode);//) projectSourceFilePathEditMode = !projectSourceFilePathEditMode;
             GuiSetStyle(TEXTBOX, TEXT_READONLY, 0);
             if (GuiButton((Rectangle){ anchorProject.x + 656, anchorProject.y + 160, 120, 24 }, "#4#Browse")) showLoadBannerFileDialog = true;
 
@@ -425,17 +809,17 @@ int main(int argc, char *argv[])
 
             GuiGroupBox((Rectangle){ anchorBuilding.x + 0, anchorBuilding.y + 10, 784, 136 }, "BUILD SETTINGS");
             GuiLabel((Rectangle){ anchorBuilding.x + 8, anchorBuilding.y + 16, 104, 24 }, "GITHUB REPO:");
-            if (GuiTextBox((Rectangle){ anchorBuilding.x + 112, anchorBuilding.y + 16, 536, 24 }, config->building.gitRepositoryUrl, 128, buildingRaylibPathEditMode)) buildingRaylibPathEditMode = !buildingRaylibPathEditMode;
+            if (GuiTextBox((Rectangle){ anchorBuilding.x + 112, anchorBuilding.y + 16, 536, 24 }, config->building.gitRepositoryUrl, sizeof(config->building.gitRepositoryUrl), draft->editMode.repository)) draft->editMode.repository = !draft->editMode.repository;
 
             if (GuiButton((Rectangle){ anchorBuilding.x + 656, anchorBuilding.y + 16, 120, 24 }, "#4#Browse")) showLoadRaylibSourcePathDialog = true;
             GuiEnable();
 
             GuiLabel((Rectangle){ anchorBuilding.x + 8, anchorBuilding.y + 48, 104, 24 }, "CONTENT PATH:");
-            if (GuiTextBox((Rectangle){ anchorBuilding.x + 112, anchorBuilding.y + 48, 536, 24 }, config->building.contentFolderPath, 128, buildingCompilerPathEditMode)) buildingCompilerPathEditMode = !buildingCompilerPathEditMode;
+            if (GuiTextBox((Rectangle){ anchorBuilding.x + 112, anchorBuilding.y + 48, 536, 24 }, config->building.contentFolderPath, sizeof(config->building.contentFolderPath), draft->editMode.contentPath)) draft->editMode.contentPath = !draft->editMode.contentPath;
             GuiEnable();
 
             GuiLabel((Rectangle){ anchorBuilding.x + 8, anchorBuilding.y + 80, 104, 24 }, "IMAGES PATH:");
-            if (GuiTextBox((Rectangle){ anchorBuilding.x + 112, anchorBuilding.y + 80, 536, 24 }, config->building.imageFolderPath, 128, buildingOutputPathEditMode)) buildingOutputPathEditMode = !buildingOutputPathEditMode;
+            if (GuiTextBox((Rectangle){ anchorBuilding.x + 112, anchorBuilding.y + 80, 536, 24 }, config->building.imageFolderPath, sizeof(config->building.imageFolderPath), draft->editMode.imagesPath)) draft->editMode.imagesPath = !draft->editMode.imagesPath;
             if (GuiButton((Rectangle){ anchorBuilding.x + 656, anchorBuilding.y + 80, 120, 24 }, "#4#Browse")) showLoadOutputPathDialog = true;
             GuiEnable();
 
@@ -449,16 +833,26 @@ int main(int argc, char *argv[])
             GuiToggle((Rectangle){ anchorBuilding.x + 112 + 166, anchorBuilding.y + 110, 100, 32 }, "Zola", &buildSystem);
             GuiToggle((Rectangle){ anchorBuilding.x + 112 + 166*2, anchorBuilding.y + 110, 100, 32 }, "Jekyll", &buildSystem);
             GuiToggle((Rectangle){ anchorBuilding.x + 112 + 166*3, anchorBuilding.y + 110, 100, 32 }, "Eleventy", &buildSystem);
-            if (!lockBackground) GuiUnlock();
+            if (!lockBackground && !completionListHovered) GuiUnlock();
 
 
             //if (config->project.srcFileCount == 0) GuiDisable();
-            if (GuiButton((Rectangle){ 8, 450, 784, 40 }, "#7#UPLOAD POST TO YOUR SITE"))
+            int uploadCount = 0;
+            for (int i = 0; i < draftCount; i++) if (drafts[i].config.project.srcContentPath[0] != '\0') uploadCount++;
+
+            if (GuiButton((Rectangle){ 8, 450, 656, 40 }, (uploadCount > 1)? TextFormat("#7#UPLOAD %i POSTS TO YOUR SITE", uploadCount) : "#7#UPLOAD POST TO YOUR SITE"))
             {
                 showUploadProjectPopup = true;
             }
             //GuiEnable();
 
+            // Preview is available once draft is prepared (preparation result only read when job is done)
+            if (!IsJobDone(draftQueue, draft->preparation->job) || (draft->preparation->result != 0)) GuiDisable();
+            GuiSetTooltip("Open post preview in browser, refreshed every time the draft is prepared");
+            if (GuiButton((Rectangle){ 672, 450, 120, 40 }, "#44#PREVIEW")) openPostDraftPreview(draft);
+            GuiSetTooltip(NULL);
+            GuiEnable();
+
             if (!lockBackground && CheckCollisionPointRec(GetMousePosition(), (Rectangle){ 0, GetScreenHeight() - 32, screenWidth, 32 })) SetMouseCursor(MOUSE_CURSOR_POINTING_HAND);
             else SetMouseCursor(MOUSE_CURSOR_DEFAULT);
 
@@ -482,6 +876,17 @@ int main(int argc, char *argv[])
                 else if (result == 0) showIssueReportWindow = false;
             }
 
+#if defined(PLATFORM_DESKTOP)
+            // GUI: Taxonomy completions of field being edited, drawn over other controls
+            if (completionListHovered) GuiUnlock();
+            completionListBounds = (Rectangle){ 0 };
+            if (!lockBackground)
+            {
+                if (draft->editMode.author) guiCompletionList((Rectangle){ anchorProject.x + 496, anchorProject.y + 24, 280, 24 }, config->project.author, sizeof(config->project.author), POST_INDEX_AUTHORS);
+                else if (draft->editMode.tags) guiCompletionList((Rectangle){ anchorProject.x + 112, anchorProject.y + 88, 280, 24 }, config->project.tags, sizeof(config->project.tags), POST_INDEX_TAGS);
+                else if (draft->editMode.category) guiCompletionList((Rectangle){ anchorProject.x + 496, anchorProject.y + 88, 280, 24 }, config->project.category, sizeof(config->project.category), POST_INDEX_CATEGORIES);
+            }
+#endif
             //----------------------------------------------------------------------------------
 
             // NOTE: If some overlap window is open and main window is locked, we draw a background rectangle
@@ -494,7 +899,12 @@ int main(int argc, char *argv[])
             //----------------------------------------------------------------------------------------
             if (showInfoMessagePanel)
             {
-                Vector2 textSize = MeasureTextEx(GuiGetFont(), infoMessage, GuiGetFont().baseSize*2, 3);
+                if ((infoMessage != infoMessageMeasured) || (infoMessageMeasured == NULL))
+                {
+                    infoMessageSize = (infoMessage != NULL)? MeasureTextEx(GuiGetFont(), infoMessage, GuiGetFont().baseSize*2, 3) : (Vector2){ 0 };
+                    infoMessageMeasured = infoMessage;
+                }
+                Vector2 textSize = infoMessageSize;
                 GuiPanel((Rectangle){ -10, screenHeight/2 - 180, screenWidth + 20, 290 }, NULL);
 
                 GuiSetStyle(DEFAULT, TEXT_SIZE, GuiGetFont().baseSize*3);
@@ -531,13 +941,24 @@ int main(int argc, char *argv[])
                 else if (result == 1) closeWindow = true;
             }
 
+            // GUI: Banner Reuse Window
+            //----------------------------------------------------------------------------------------
+            if (showBannerReusePopup)
+            {
+                int result = GuiMessageBox((Rectangle){ (float)screenWidth/2 - 220, (float)screenHeight/2 - 60, 440, 120 }, "#12#Similar banner found",
+                    TextFormat("Banner looks like site image %s\nReuse it instead of uploading a new one?", GetFileName(bannerCheck.path)), "Reuse;Upload new");
+
+                if (result == 1) snprintf(config->project.bannerLink, sizeof(config->project.bannerLink), "%s", bannerCheck.link);
+                if (result >= 0) showBannerReusePopup = false;
+            }
+
             //----------------------------------------------------------------------------------------
 
             // GUI: Load Files Dialog
             getFilePath(config);
 
             // GUI: Upload Post Dialog
-            if (showUploadProjectPopup) uploadProject(config);
+            if (showUploadProjectPopup) uploadProject();
 
         EndTextureMode();
 
@@ -553,7 +974,25 @@ int main(int argc, char *argv[])
 
     // De-Initialization
     //--------------------------------------------------------------------------------------
-    RL_FREE(config);
+    UnloadJobQueue(draftQueue);     // Running preparation is waited, pending ones are dropped
+    draftQueue = NULL;
+    while (draftCount > 0) removePostDraft(draftCount - 1);
+    UnloadPreviewServer(previewServer);     // Connections are closed, after drafts pages removed
+    previewServer = NULL;
+#if defined(BUILD_TEMPLATE_INTO_EXE)
+    UnloadDataPack(&templatePack);
+#endif
+#if defined(PLATFORM_DESKTOP)
+    UnloadCompletionTask(completionTask);   // Waits for completions being built (repository fetch)
+#endif
+    UnloadOutbox(outbox);           // Drainer is stopped, pending posts are kept for next session
+    UnloadWorkerPool(workerPool);
+    UnloadSiteProfiles(&siteProfiles);
+    unloadSiteLinks();
+    unloadSiteImages();
+    ArenaFree(&outboxArena);
+    ArenaFree(&publishArena);
+    ArenaFree(&sessionArena);
 
     CloseWindow();        // Close window and OpenGL context
     //--------------------------------------------------------------------------------------
@@ -567,7 +1006,7 @@ static void getFilePath(ProjectConfig *config){
 
     if (showLoadMarkdownFileDialog){
         int result = GuiFileDialog(DIALOG_OPEN_FILE, "Load source file(s)...",
-                                    fileName, "*.md", "Markdown File (*.md)");
+                                    fileName, "*.md;*.zip", "Markdown File or Post Bundle (*.md;*.zip)");
         if (result == 1) {
             showLoadMarkdownFileDialog = false;
             strcpy(config->project.srcContentPath, fileName);
@@ -587,6 +1026,14 @@ static void getFilePath(ProjectConfig *config){
             showLoadBannerFileDialog = false;
             printf("%s", config->project.srcBannerPath);
             strcpy(config->project.srcBannerPath, fileName);
+            config->project.bannerLink[0] = '\0';
+
+            // Selected banner is compared with site images in background
+            if (bannerCheck.pending) WaitJob(draftQueue, bannerCheck.job);
+            bannerCheck.config = *config;
+            bannerCheck.draftId = drafts[activeDraft].id;
+            bannerCheck.job = AddJob(draftQueue, checkBanner, &bannerCheck);
+            bannerCheck.pending = (bannerCheck.job >= 0);
         }
 
         else if (result >= 0) {
@@ -594,58 +1041,2437 @@ static void getFilePath(ProjectConfig *config){
         }
     }
 
+    else if (showExportBundleDialog) {
+        strcpy(fileName, "post.zip");
+        int result = GuiFileDialog(DIALOG_SAVE_FILE, "Export post bundle...", fileName, "*.zip", "Zip Bundle (*.zip)");
+
+        if (result == 1) {
+            showExportBundleDialog = false;
+            if (!exportPostBundle(config, fileName)) fprintf(stderr, "Something went wrong");
+        }
+
+        else if (result >= 0) {
+            showExportBundleDialog = false;
+        }
+    }
+
 }
 
-#define FILE_SAVE_PATH "./index.md"
-#define BANNER_PATH     "./banner.png"
+// NOTE: Every post is prepared into its own page bundle folder, NEW_POST_PATH/<slug> (git_handler.h),
+// that folder is copied into the repository as <contentFolderPath>/<slug>
+#define POST_FILE_NAME      "index.md"
+#define BANNER_FILE_NAME    "banner.png"
+#define BANNER_PATH         "./banner.png"
+#define PREVIEW_FILE_NAME   "index.html"
 
-static int writeContent(ProjectConfig *config) {
-    FILE *indexFile = fopen(FILE_SAVE_PATH, "w+");
-    if (indexFile == NULL) {
-        perror("Error opening index.md for writing");
-        return -1;
+#define POST_SLUG_MAX_LENGTH        64      // Max length of slug generated from title
+
+#define POST_BUNDLE_MAX_ENTRIES     256     // Max number of files in post bundle
+#define POST_BUNDLE_BANNER_PATH     "banner.png"    // Banner path inside post bundle
+
+// Load project config defaults
+static void loadDefaultConfig(ProjectConfig *config) {
+    memset(config, 0, sizeof(ProjectConfig));
+    config->project.type = 2;  // Custom files
+    strcpy(config->building.contentFolderPath, "content/blog/");
+    strcpy(config->building.gitRepositoryUrl, "https://github.com/Discovery-Data-Lab/blog.git");
+    strcpy(config->building.imageFolderPath, "static/img/");
+}
+
+// Load (map) site profiles and update profiles names
+static void loadSiteProfiles(void) {
+    UnloadSiteProfiles(&siteProfiles);
+    siteProfiles = LoadSiteProfiles(TextFormat("%s%s", GetApplicationDirectory(), SITE_PROFILES_FILE_PATH));
+
+    siteProfilesNames[0] = '\0';
+    for (int i = 0, length = 0; i < siteProfiles.count; i++) {
+        int written = snprintf(siteProfilesNames + length, sizeof(siteProfilesNames) - length, (i == 0)? "%s" : ";%s", GetSiteProfile(&siteProfiles, i).name);
+        if ((written < 0) || (length + written >= (int)sizeof(siteProfilesNames))) break;
+        length += written;
+    }
+}
+
+// Set build settings from site profile
+static void applySiteProfile(ProjectConfig *config, int index) {
+    if ((index < 0) || (index >= siteProfiles.count)) return;
+
+    SiteProfile profile = GetSiteProfile(&siteProfiles, index);
+    config->building.flags = profile.flags;
+    snprintf(config->building.gitRepositoryUrl, sizeof(config->building.gitRepositoryUrl), "%s", profile.gitRepositoryUrl);
+    snprintf(config->building.contentFolderPath, sizeof(config->building.contentFolderPath), "%s", profile.contentFolderPath);
+    snprintf(config->building.imageFolderPath, sizeof(config->building.imageFolderPath), "%s", profile.imageFolderPath);
+}
+
+// Save build settings as site profile
+// NOTE: Profile is updated if repository already has one, otherwise a new profile
+// is added, named by repository (url last path element without .git)
+static bool saveSiteProfile(ProjectConfig *config) {
+    SiteProfile profiles[SITE_PROFILES_MAX_COUNT] = { 0 };
+    int count = siteProfiles.count;
+    for (int i = 0; i < count; i++) profiles[i] = GetSiteProfile(&siteProfiles, i);
+
+    int index = FindSiteProfile(&siteProfiles, config->building.gitRepositoryUrl);
+    if (index < 0) {
+        if (count >= SITE_PROFILES_MAX_COUNT) return false;
+        index = count++;
+        profiles[index].name = GetFileNameWithoutExt(config->building.gitRepositoryUrl);
+    }
+
+    profiles[index].flags = config->building.flags;
+    profiles[index].gitRepositoryUrl = config->building.gitRepositoryUrl;
+    profiles[index].contentFolderPath = config->building.contentFolderPath;
+    profiles[index].imageFolderPath = config->building.imageFolderPath;
+
+    const char *fileName = TextFormat("%s%s", GetApplicationDirectory(), SITE_PROFILES_FILE_PATH);
+    MakeDirectory(GetDirectoryPath(fileName));
+    if (!SaveSiteProfiles(fileName, profiles, count)) return false;
+
+    loadSiteProfiles();
+    LOG("INFO: Site profile saved: %s\n", GetSiteProfile(&siteProfiles, index).name);
+
+    return true;
+}
+
+// Check if file is a post bundle (.zip)
+// NOTE: IsFileExtension() uses a static buffer, this check is also used by background preparation
+static bool isPostBundleFile(const char *fileName) {
+    size_t length = strlen(fileName);
+    if (length < 4) return false;
+
+    const char *ext = fileName + length - 4;
+    return (ext[0] == '.') && ((ext[1] | 32) == 'z') && ((ext[2] | 32) == 'i') && ((ext[3] | 32) == 'p');
+}
+
+// Load post markdown, from file or post bundle (.zip)
+// NOTE: Content is allocated in provided arena, front matter of existing posts (i.e. exported bundles)
+// is skipped, as it is generated again from current config (empty fields are set from it)
+static char *loadPostContent(Arena *arena, ProjectConfig *config, size_t *contentSize) {
+    char *content = NULL;
+    *contentSize = 0;
+
+    if (isPostBundleFile(config->project.srcContentPath)) {
+        int bundleContentSize = 0;
+        char *bundleContent = LoadPostBundleMarkdown(config->project.srcContentPath, &bundleContentSize);
+        if (bundleContent == NULL) return NULL;
+
+        size_t bodyOffset = importPostFrontMatter(config, bundleContent, bundleContentSize);
+
+        *contentSize = bundleContentSize - bodyOffset;
+        content = (char *)ArenaAlloc(arena, *contentSize + 1);
+        if (content != NULL) memcpy(content, bundleContent + bodyOffset, *contentSize);
+        else *contentSize = 0;
+
+        free(bundleContent);
+        return content;
     }
 
-    FILE *contentFile = fopen(config->project.srcContentPath, "r");
+    FILE *contentFile = fopen(config->project.srcContentPath, "rb");
     if (contentFile == NULL) {
         perror("Error opening content file");
-        fclose(indexFile);
-        return -2;
+        return NULL;
+    }
+
+    fseek(contentFile, 0, SEEK_END);
+    long fileSize = ftell(contentFile);
+    fseek(contentFile, 0, SEEK_SET);
+
+    content = (char *)ArenaAlloc(arena, (fileSize > 0)? (size_t)fileSize + 1 : 1);
+    *contentSize = ((content != NULL) && (fileSize > 0))? fread(content, 1, (size_t)fileSize, contentFile) : 0;
+    fclose(contentFile);
+
+    size_t bodyOffset = importPostFrontMatter(config, content, *contentSize);
+    *contentSize -= bodyOffset;
+
+    return (content != NULL)? content + bodyOffset : NULL;
+}
+
+// Set empty config fields (title, description, author, tags, categories, slug) from post front matter
+// NOTE: Returns body offset, empty lines after front matter are skipped (0 if post has no front matter)
+static size_t importPostFrontMatter(ProjectConfig *config, const char *content, size_t contentSize) {
+    if (content == NULL) return 0;
+
+    ProjectConfig imported = { 0 };
+    FrontMatterParser parser = InitFrontMatterParser(content, (int)contentSize);
+    FrontMatterField field = { 0 };
+
+    while (NextFrontMatterField(&parser, &field)) {
+        if (field.table.length > 0) continue;
+
+        FrontMatterSlice value = field.value;
+        char *target = NULL;
+        size_t targetSize = 0;
+
+        if (IsFrontMatterKey(field.key, "title")) { target = imported.project.title; targetSize = sizeof(imported.project.title); }
+        else if (IsFrontMatterKey(field.key, "description")) { target = imported.project.description; targetSize = sizeof(imported.project.description); }
+        else if (IsFrontMatterKey(field.key, "author") || IsFrontMatterKey(field.key, "authors")) { target = imported.project.author; targetSize = sizeof(imported.project.author); }
+        else if (IsFrontMatterKey(field.key, "tags")) { target = imported.project.tags; targetSize = sizeof(imported.project.tags); }
+        else if (IsFrontMatterKey(field.key, "categories") || IsFrontMatterKey(field.key, "category")) { target = imported.project.category; targetSize = sizeof(imported.project.category); }
+        else if (IsFrontMatterKey(field.key, "slug")) { target = imported.project.slug; targetSize = sizeof(imported.project.slug); }
+        else continue;
+
+        // Tags and categories are TOML array items (quoted, escaped), author is a single name
+        // NOTE: Values are decoded (escapes, YAML quotes, block scalars), formatFrontMatter() escapes them again
+        bool array = (target == imported.project.tags) || (target == imported.project.category);
+        target[0] = '\0';
+
+        while (field.list? NextFrontMatterValue(&field, &value) : (value.length > 0)) {
+            char decoded[256] = { 0 };
+            DecodeFrontMatterString(value, decoded, sizeof(decoded));
+
+            size_t length = strlen(target);
+            if (array) {
+                char escaped[256] = { 0 };
+                escapeFrontMatterString(decoded, escaped, sizeof(escaped));
+                snprintf(target + length, targetSize - length, "%s\"%s\"", (length > 0)? ", " : "", escaped);
+            }
+            else snprintf(target, targetSize, "%s", decoded);
+
+            if (!field.list || !array) break;
+        }
+    }
+
+    if (parser.bodyOffset == 0) return 0;
+
+    if (config->project.title[0] == '\0') strcpy(config->project.title, imported.project.title);
+    if (config->project.description[0] == '\0') strcpy(config->project.description, imported.project.description);
+    if (config->project.author[0] == '\0') strcpy(config->project.author, imported.project.author);
+    if (config->project.tags[0] == '\0') strcpy(config->project.tags, imported.project.tags);
+    if (config->project.category[0] == '\0') strcpy(config->project.category, imported.project.category);
+    if (config->project.slug[0] == '\0') strcpy(config->project.slug, imported.project.slug);
+
+    size_t bodyOffset = parser.bodyOffset;
+    while ((bodyOffset < contentSize) && ((content[bodyOffset] == '\n') || (content[bodyOffset] == '\r'))) bodyOffset++;
+
+    return bodyOffset;
+}
+
+// Escape text as TOML basic string content: quotes, backslashes and line breaks escaped
+// NOTE: Escaped text is truncated at a whole character if it does not fit
+static void escapeFrontMatterString(const char *text, char *escaped, size_t size) {
+    size_t length = 0;
+
+    for (int i = 0; (text[i] != '\0') && ((length + 2) < size); i++) {
+        char escape = (text[i] == '"')? '"' : (text[i] == '\\')? '\\' : (text[i] == '\n')? 'n' : (text[i] == '\r')? 'r' : (text[i] == '\t')? 't' : 0;
+
+        if (escape != 0) {
+            escaped[length++] = '\\';
+            escaped[length++] = escape;
+        }
+        else escaped[length++] = text[i];
     }
 
+    if (size > 0) escaped[length] = '\0';
+}
+
+// Format post front matter (TOML), dated now
+// NOTE: Front matter is allocated in provided arena, string values are escaped (tags and categories are array items)
+static const char *formatFrontMatter(Arena *arena, ProjectConfig *config) {
     time_t now;
     time(&now);
     struct tm *local = localtime(&now);
     char dateStr[50];
     strftime(dateStr, sizeof(dateStr), "%Y-%m-%dT%H:%M:%S%z", local);
 
-    fprintf(indexFile, "+++\n");
-    fprintf(indexFile, "title = \"%s\"\n", config->project.title);
-    fprintf(indexFile, "date = \"%s\"\n", dateStr);
-    fprintf(indexFile, "tags = [%s]\n", config->project.tags);
-    fprintf(indexFile, "categories = [%s]\n", config->project.category);
-    fprintf(indexFile, "description = \"%s\"\n", config->project.description);
-    fprintf(indexFile, "banner = \"%s\"\n", BANNER_PATH);
-    fprintf(indexFile, "authors = [\"%s\"]\n", config->project.author);
-    fprintf(indexFile, "+++\n\n");
+    char title[2*sizeof(config->project.title)] = { 0 };
+    char description[2*sizeof(config->project.description)] = { 0 };
+    char banner[2*sizeof(config->project.bannerLink)] = { 0 };
+    char author[2*sizeof(config->project.author)] = { 0 };
+    escapeFrontMatterString(config->project.title, title, sizeof(title));
+    escapeFrontMatterString(config->project.description, description, sizeof(description));
+    escapeFrontMatterString((config->project.bannerLink[0] != '\0')? config->project.bannerLink : BANNER_PATH, banner, sizeof(banner));
+    escapeFrontMatterString(config->project.author, author, sizeof(author));
+
+    return ArenaFormat(arena,
+        "+++\n"
+        "title = \"%s\"\n"
+        "date = \"%s\"\n"
+        "tags = [%s]\n"
+        "categories = [%s]\n"
+        "description = \"%s\"\n"
+        "banner = \"%s\"\n"
+        "authors = [\"%s\"]\n"
+        "+++\n\n",
+        title, dateStr, config->project.tags, config->project.category, description, banner, author);
+}
+
+// Site slugs: page bundle folders already used in site content folder (site posts index) and by
+// posts published in this session, in a hash set for O(1) collision checks
+// NOTE: Slugs are allocated in session arena, set is reset when site changes
+typedef struct SiteSlugs {
+    char repositoryUrl[256];
+    char contentPath[256];
+    const char **slugs;             // Open addressing hash table, NULL for empty slots
+    int capacity;                   // Power of two, kept at most half full
+    int count;
+    bool indexLoaded;               // Site posts index loaded (GUI mode: index refreshed in background)
+} SiteSlugs;
+
+static SiteSlugs siteSlugs = { 0 };
+
+static unsigned int hashSlug(const char *slug, int length) {
+    unsigned int hash = 2166136261u;    // FNV-1a
+    for (int i = 0; i < length; i++) hash = (hash ^ (unsigned char)slug[i])*16777619u;
+
+    return hash;
+}
 
-    char buffer[1024];
-    while (fgets(buffer, sizeof(buffer), contentFile) != NULL) {
-        fprintf(indexFile, "%s", buffer);
+// Find slug slot in site slugs table: slot of slug, or empty slot where it would be added
+static int findSiteSlugSlot(const char *slug, int length) {
+    int slot = (int)(hashSlug(slug, length) & (siteSlugs.capacity - 1));
+    while ((siteSlugs.slugs[slot] != NULL) && ((strncmp(siteSlugs.slugs[slot], slug, length) != 0) || (siteSlugs.slugs[slot][length] != '\0'))) {
+        slot = (slot + 1) & (siteSlugs.capacity - 1);
     }
-    fclose(contentFile);
-    fclose(indexFile);
 
-    printf("Project saved successfully to %s\n", FILE_SAVE_PATH);
+    return slot;
+}
+
+// Add slug to site slugs (copied), table is grown when half full
+static void addSiteSlug(const char *slug, int length) {
+    if (length <= 0) return;
+
+    if ((siteSlugs.count + 1)*2 > siteSlugs.capacity) {
+        const char **slugs = siteSlugs.slugs;
+        int capacity = siteSlugs.capacity;
+
+        siteSlugs.capacity = capacity*2;
+        siteSlugs.slugs = (const char **)ArenaAlloc(&sessionArena, siteSlugs.capacity*sizeof(const char *));
+        for (int i = 0; i < capacity; i++) {
+            if (slugs[i] != NULL) siteSlugs.slugs[findSiteSlugSlot(slugs[i], (int)strlen(slugs[i]))] = slugs[i];
+        }
+    }
+
+    int slot = findSiteSlugSlot(slug, length);
+    if (siteSlugs.slugs[slot] != NULL) return;
+
+    siteSlugs.slugs[slot] = ArenaFormat(&sessionArena, "%.*s", length, slug);
+    siteSlugs.count++;
+}
+
+// Load slugs used in site content folder: page bundle folders, single file posts names and front
+// matter slugs of site posts index, index is refreshed first if requested (command line mode)
+// NOTE: Slugs already reserved for the same site are kept, so posts of a session never collide
+static void loadSiteSlugs(ProjectConfig *config, bool refreshIndex) {
+    if ((siteSlugs.slugs == NULL) || (strcmp(siteSlugs.repositoryUrl, config->building.gitRepositoryUrl) != 0) ||
+        (strcmp(siteSlugs.contentPath, config->building.contentFolderPath) != 0)) {
+        siteSlugs = (SiteSlugs){ 0 };
+        snprintf(siteSlugs.repositoryUrl, sizeof(siteSlugs.repositoryUrl), "%s", config->building.gitRepositoryUrl);
+        snprintf(siteSlugs.contentPath, sizeof(siteSlugs.contentPath), "%s", config->building.contentFolderPath);
+        siteSlugs.capacity = 1024;
+        siteSlugs.slugs = (const char **)ArenaAlloc(&sessionArena, siteSlugs.capacity*sizeof(const char *));
+    }
+
+    if (siteSlugs.indexLoaded) return;
+
+    GitRepository repo = newRepository(&publishArena, config->building.gitRepositoryUrl, config->building.contentFolderPath);
+    const char *indexPath = ArenaFormat(&publishArena, "%s/%s", getMirrorPath(&repo), POST_INDEX_FILE_NAME);
+#if defined(PLATFORM_DESKTOP)
+    if (refreshIndex) indexPath = refreshPostIndex(&repo, config->building.contentFolderPath);
+#endif
+
+    PostIndex index = (indexPath != NULL)? LoadPostIndex(indexPath) : (PostIndex){ 0 };
+    siteSlugs.indexLoaded = (index.data != NULL);
+
+    // Posts paths are relative to repository root
+    // NOTE: Index could have been refreshed for another content folder of same repository
+    const char *contentPath = config->building.contentFolderPath;
+    while (strncmp(contentPath, "./", 2) == 0) contentPath += 2;
+    int prefixLength = (int)strlen(contentPath);
+    while ((prefixLength > 0) && (contentPath[prefixLength - 1] == '/')) prefixLength--;
+
+    for (int i = 0; i < index.count; i++) {
+        PostIndexEntry entry = GetPostIndexEntry(&index, i);
+        if ((prefixLength > 0) && ((strncmp(entry.path, contentPath, prefixLength) != 0) || (entry.path[prefixLength] != '/'))) continue;
+
+        const char *name = entry.path + ((prefixLength > 0)? prefixLength + 1 : 0);
+        const char *separator = strchr(name, '/');
+
+        addSiteSlug(name, (separator != NULL)? (int)(separator - name) : (int)strlen(name) - 3);   // Bundle folder or file name without .md
+        addSiteSlug(entry.slug, (int)strlen(entry.slug));
+    }
+
+    UnloadPostIndex(&index);
+}
+
+// Get post slug: config slug, or generated from title (or markdown file name): lowercase ASCII
+// letters and digits, any other characters sequence is replaced by '-'
+// NOTE: Slug is allocated in publish arena
+static const char *getPostSlug(ProjectConfig *config) {
+    const char *text = (config->project.slug[0] != '\0')? config->project.slug :
+        (config->project.title[0] != '\0')? config->project.title : GetFileNameWithoutExt(config->project.srcContentPath);
+
+    char *slug = (char *)ArenaAlloc(&publishArena, POST_SLUG_MAX_LENGTH + 1);
+    int length = 0;
+
+    for (const char *ptr = text; (*ptr != '\0') && (length < POST_SLUG_MAX_LENGTH); ptr++) {
+        char c = *ptr;
+        if ((c >= 'A') && (c <= 'Z')) c += 32;
+
+        if (((c >= 'a') && (c <= 'z')) || ((c >= '0') && (c <= '9')) || ((c == '_') && (text == config->project.slug))) slug[length++] = c;
+        else if ((length > 0) && (slug[length - 1] != '-')) slug[length++] = '-';
+    }
+    while ((length > 0) && (slug[length - 1] == '-')) length--;
+    slug[length] = '\0';
+
+    return (length > 0)? slug : "post";
+}
+
+// Get post slug not used by site posts or posts of this session, reserved for post:
+// a number is appended to slug if already used ("hello", "hello-2", "hello-3"...)
+// NOTE: Slug is allocated in publish arena
+static const char *reservePostSlug(ProjectConfig *config) {
+    loadSiteSlugs(config, false);
+
+    const char *baseSlug = getPostSlug(config);
+    const char *slug = baseSlug;
+    for (int i = 2; siteSlugs.slugs[findSiteSlugSlot(slug, (int)strlen(slug))] != NULL; i++) slug = ArenaFormat(&publishArena, "%s-%i", baseSlug, i);
+
+    if (slug != baseSlug) LOG("INFO: Slug '%s' already used in site, post published as '%s'\n", baseSlug, slug);
+    addSiteSlug(slug, (int)strlen(slug));
+
+    return slug;
+}
+
+// Write post content with front matter into post folder (page bundle)
+// NOTE: Generated content is allocated in provided arena (publish arena, or draft preparation arena)
+static int writeContent(Arena *arena, ProjectConfig *config, const char *postPath) {
+    size_t contentSize = 0;
+    char *content = loadPostContent(arena, config, &contentSize);
+    if (content == NULL) return -2;
+
+    return writePostContent(arena, config, postPath, content, contentSize);
+}
+
+// Recompress PNG banner losslessly (filters and deflate of smallest output), NULL if not smaller or not PNG
+// NOTE: Filter strategies run on worker pool, called from main thread or drafts job thread
+static unsigned char *optimizeBanner(const unsigned char *data, int dataSize, int *optimizedSize) {
+    int strategy = -1;
+    unsigned char *optimized = OptimizePngData(data, dataSize, optimizedSize, &strategy, workerPool);
+
+    if (optimized != NULL) LOG("INFO: Banner optimized: %i -> %i bytes (%.1f%% smaller, %s filters)\n",
+        dataSize, *optimizedSize, 100.0 - 100.0*(*optimizedSize)/dataSize, GetPngStrategyName(strategy));
+
+    return optimized;
+}
+
+// Write post content (already loaded) with front matter into post folder (page bundle)
+// NOTE: Post files are written as a file batch, previous files are only replaced once all are on disk
+static int writePostContent(Arena *arena, ProjectConfig *config, const char *postPath, const char *content, size_t contentSize) {
+    MakeDirectory(postPath);
+
+    const char *indexPath = ArenaFormat(arena, "%s/%s", postPath, POST_FILE_NAME);
+    const char *bannerPath = ArenaFormat(arena, "%s/%s", postPath, BANNER_FILE_NAME);
+
+    FileBatch *batch = BeginFileBatch();
+    FILE *indexFile = OpenBatchFile(batch, indexPath);
+    if (indexFile == NULL) {
+        perror("Error opening index.md for writing");
+        AbortFileBatch(batch);
+        return -1;
+    }
+
+    fputs(formatFrontMatter(arena, config), indexFile);
+    if (contentSize > 0) fwrite(content, 1, contentSize, indexFile);
+    CloseBatchFile(batch, indexFile);
+
+    // Banner is copied next to index.md, as referenced by front matter, bundle banner is used if no banner provided
+    // NOTE: A banner from a previous post is removed (once post is written) to not be published again
+    bool bannerSaved = true;
+    if (config->project.bannerLink[0] != '\0') bannerSaved = false;     // Site image reused as banner
+    else if (config->project.srcBannerPath[0] == '\0') {
+        int bannerDataSize = 0;
+        unsigned char *bannerData = isPostBundleFile(config->project.srcContentPath)?
+            LoadPostBundleFileData(config->project.srcContentPath, POST_BUNDLE_BANNER_PATH, &bannerDataSize) : NULL;
+
+        if (bannerData != NULL) {
+            int optimizedSize = 0;
+            unsigned char *optimized = optimizeBanner(bannerData, bannerDataSize, &optimizedSize);
+            if (optimized != NULL) SaveBatchFileData(batch, bannerPath, optimized, optimizedSize);
+            else SaveBatchFileData(batch, bannerPath, bannerData, bannerDataSize);
+            free(optimized);
+        }
+        else bannerSaved = false;
+        free(bannerData);
+    }
+    else {
+        int bannerDataSize = 0;
+        unsigned char *bannerData = LoadFileData(config->project.srcBannerPath, &bannerDataSize);
+        if (bannerData == NULL) {
+            fprintf(stderr, "Error opening banner file: %s\n", config->project.srcBannerPath);
+            AbortFileBatch(batch);
+            return -3;
+        }
+
+        int optimizedSize = 0;
+        unsigned char *optimized = optimizeBanner(bannerData, bannerDataSize, &optimizedSize);
+        if (optimized != NULL) SaveBatchFileData(batch, bannerPath, optimized, optimizedSize);
+        else SaveBatchFileData(batch, bannerPath, bannerData, bannerDataSize);
+        free(optimized);
+        UnloadFileData(bannerData);
+    }
+
+    if (!EndFileBatch(batch)) {
+        fprintf(stderr, "Error writing post files to %s\n", postPath);
+        return -1;
+    }
+
+    if (!bannerSaved) remove(bannerPath);
+
+    printf("Project saved successfully to %s\n", indexPath);
     return 0;
 }
 
-static void uploadProject(ProjectConfig *config) {
-    if (writeContent(config) != 0){
-        fprintf(stderr, "Something went wrong");
-        // TODO: Make a popup / probably wrong user input
+// Write post content and queue it in outbox, to be pushed to site repository
+// NOTE: Shared by GUI and command line modes
+// NOTE: All transient memory is allocated in publish arena, released at once when done
+static int publishProject(ProjectConfig *config) {
+    // Content is loaded first, so a slug or title set by post front matter is used for post folder
+    size_t contentSize = 0;
+    char *content = loadPostContent(&publishArena, config, &contentSize);
+
+    // Post is prepared into its own folder, named as its slug (unique in site), so posts never share files
+    const char *slug = reservePostSlug(config);
+    const char *postPath = ArenaFormat(&publishArena, "%s/%s", NEW_POST_PATH, slug);
+    int result = (content != NULL)? writePostContent(&publishArena, config, postPath, content, contentSize) : -2;
+
+    if (result == 0) {
+        validatePostFolderLinks(config, slug, postPath);
+        result = queuePost(config, slug, postPath);
     }
 
-    showUploadProjectPopup = false;
+    if (showMemoryStats) logMemoryStats("publish");
+    ArenaReset(&publishArena);
+
+    return result;
+}
+
+// Site links: repository tree paths of site mirror, for links validation
+// NOTE: Tree is loaded again when site changes or mirror is fetched (FETCH_HEAD modified),
+// paths are allocated in site links arena
+typedef struct SiteLinks {
+    char repositoryUrl[256];
+    long fetchTime;
+    Arena arena;
+    LinkTree tree;
+} SiteLinks;
+
+static SiteLinks siteLinks = { 0 };
+
+// Load site repository tree paths from mirror, NULL if site has no mirror yet (site links are not checked)
+// NOTE: Mirror is not fetched, it is updated by posts index refresh (command line publish, GUI completions)
+static const LinkTree *loadSiteLinks(ProjectConfig *config) {
+    GitRepository repo = newRepository(&publishArena, config->building.gitRepositoryUrl, config->building.contentFolderPath);
+    const char *mirrorPath = getMirrorPath(&repo);
+    const char *fetchHeadPath = ArenaFormat(&publishArena, "%s/FETCH_HEAD", mirrorPath);
+    long fetchTime = FileExists(fetchHeadPath)? GetFileModTime(fetchHeadPath) : 0;
+
+    if ((siteLinks.tree.paths != NULL) && (siteLinks.fetchTime == fetchTime) && (strcmp(siteLinks.repositoryUrl, config->building.gitRepositoryUrl) == 0)) return &siteLinks.tree;
+
+    UnloadLinkTree(&siteLinks.tree);
+    ArenaReset(&siteLinks.arena);
+    if (!DirectoryExists(mirrorPath)) return NULL;
+
+    snprintf(siteLinks.repositoryUrl, sizeof(siteLinks.repositoryUrl), "%s", config->building.gitRepositoryUrl);
+    siteLinks.fetchTime = fetchTime;
+
+    GitRepository treeRepo = newRepository(&siteLinks.arena, config->building.gitRepositoryUrl, config->building.contentFolderPath);
+    GitTree tree = loadMirrorTree(&treeRepo, mirrorPath);
+
+    siteLinks.tree = LoadLinkTree(tree.count);
+    for (int i = 0; i < tree.count; i++) AddLinkTreePath(&siteLinks.tree, tree.entries[i].path);
+
+    return &siteLinks.tree;
+}
+
+// Unload site repository tree paths
+static void unloadSiteLinks(void) {
+    UnloadLinkTree(&siteLinks.tree);
+    ArenaFree(&siteLinks.arena);
+}
+
+// Validate post links and images against site repository tree and post files: index.md, banner
+// and bundle assets (imported with post, links rewritten on push); external URLs only by syntax
+// NOTE: Issues are reported, post is still published (site generator could resolve links differently)
+static int validatePostLinks(ProjectConfig *config, const char *slug, const char *content, bool banner) {
+    #define MAX_REPORTED_LINK_ISSUES    16
+
+    const LinkTree *site = loadSiteLinks(config);
+
+    BundleAsset *assets = NULL;
+    int assetCount = 0;
+    if (isPostBundleFile(config->project.srcContentPath)) {
+        assets = (BundleAsset *)ArenaAlloc(&publishArena, POST_BUNDLE_MAX_ENTRIES*sizeof(BundleAsset));
+        assetCount = (assets != NULL)? LoadPostBundleAssets(config->project.srcContentPath, assets, POST_BUNDLE_MAX_ENTRIES) : 0;
+        if (assetCount < 0) assetCount = 0;
+    }
+
+    LinkTree post = LoadLinkTree(assetCount + 2);
+    AddLinkTreePath(&post, POST_FILE_NAME);
+    if (banner) AddLinkTreePath(&post, BANNER_FILE_NAME);
+    for (int i = 0; i < assetCount; i++) AddLinkTreePath(&post, assets[i].archivePath);
+
+    // Post folder path in repository, as pushed
+    const char *contentPath = config->building.contentFolderPath;
+    while (strncmp(contentPath, "./", 2) == 0) contentPath += 2;
+    int length = (int)strlen(contentPath);
+    while ((length > 0) && (contentPath[length - 1] == '/')) length--;
+    const char *postPath = (length > 0)? ArenaFormat(&publishArena, "%.*s/%s", length, contentPath, slug) : slug;
+
+    LinkIssue issues[MAX_REPORTED_LINK_ISSUES] = { 0 };
+    int linkCount = 0;
+    int count = ValidatePostLinks(content, site, &post, postPath, issues, MAX_REPORTED_LINK_ISSUES, &linkCount, workerPool);
+    UnloadLinkTree(&post);
+
+    for (int i = 0; (i < count) && (i < MAX_REPORTED_LINK_ISSUES); i++) {
+        LOG("WARNING: %s/%s:%i: %s: %s\n", postPath, POST_FILE_NAME, issues[i].line,
+            (issues[i].status == LINK_MALFORMED)? "Malformed URL" : "Broken link", issues[i].target);
+    }
+    if (count > MAX_REPORTED_LINK_ISSUES) LOG("WARNING: %s/%s: %i more link issue(s)\n", postPath, POST_FILE_NAME, count - MAX_REPORTED_LINK_ISSUES);
+
+    LOG("INFO: Post links validated: %i link(s), %i issue(s)%s\n", linkCount, count, (site == NULL)? ", site links not checked (no repository mirror)" : "");
+
+    return count;
+}
 
+// Validate links of post written into post folder (index.md as published, banner if any)
+static int validatePostFolderLinks(ProjectConfig *config, const char *slug, const char *postPath) {
+    char *content = LoadFileText(ArenaFormat(&publishArena, "%s/%s", postPath, POST_FILE_NAME));
+    bool banner = FileExists(ArenaFormat(&publishArena, "%s/%s", postPath, BANNER_FILE_NAME));
+
+    int count = validatePostLinks(config, slug, content, banner);
+    UnloadFileText(content);
+
+    return count;
 }
+
+// Copy front matter value into arena, escape sequences decoded (i.e. "a \"b\"" -> a "b")
+static const char *copyFrontMatterValue(Arena *arena, FrontMatterSlice value) {
+    char *text = (char *)ArenaAlloc(arena, value.length + 1);
+    if (text != NULL) DecodeFrontMatterString(value, text, value.length + 1);
+
+    return text;
+}
+
+// Preview page output: HTML is streamed into file as rendered
+static void writePreviewData(const char *data, int size, void *userData) {
+    fwrite(data, 1, size, (FILE *)userData);
+}
+
+// Render HTML preview page of post: title, date, description and banner from front matter, markdown
+// body rendered by built-in renderer (not the site generator, so site theme and shortcodes are not applied)
+// NOTE: Markdown blocks are allocated in provided arena, only arena and output are used (any thread)
+static void renderPreviewPage(Arena *arena, const char *text, int size, MarkdownWriteFunc write, void *userData) {
+    static const char *style = "body{margin:0;background:#f4f4f4;color:#222;font:17px/1.6 sans-serif}"
+        "article{max-width:760px;margin:0 auto;padding:24px 32px;background:#fff}img{max-width:100%}"
+        ".date,.description{color:#777}pre{background:#f0f0f0;padding:12px;overflow:auto}code{font-size:90%}"
+        "blockquote{margin:0;padding-left:16px;border-left:4px solid #ddd;color:#555}"
+        "table{border-collapse:collapse}th,td{border:1px solid #ddd;padding:4px 8px}";
+
+    FrontMatterSlice title = { 0 }, date = { 0 }, description = { 0 }, banner = { 0 };
+    FrontMatterParser parser = InitFrontMatterParser(text, size);
+    FrontMatterField field = { 0 };
+
+    while (NextFrontMatterField(&parser, &field)) {
+        if ((field.table.length > 0) || field.list) continue;
+
+        FrontMatterSlice *value = IsFrontMatterKey(field.key, "title")? &title : IsFrontMatterKey(field.key, "date")? &date :
+            IsFrontMatterKey(field.key, "description")? &description : IsFrontMatterKey(field.key, "banner")? &banner : NULL;
+        if (value == NULL) continue;
+
+        // Rendered values are decoded (escape sequences), slices then point into arena
+        value->text = copyFrontMatterValue(arena, field.value);
+        value->length = (value->text != NULL)? (int)strlen(value->text) : 0;
+    }
+
+    #define WRITE_PREVIEW_TEXT(text) write(text, (int)strlen(text), userData)
+
+    WRITE_PREVIEW_TEXT("<!DOCTYPE html>\n<html>\n<head>\n<meta charset=\"utf-8\">\n"
+        "<meta name=\"viewport\" content=\"width=device-width, initial-scale=1\">\n<title>");
+    RenderMarkdownText(title.text, title.length, write, userData);
+    WRITE_PREVIEW_TEXT("</title>\n<style>");
+    WRITE_PREVIEW_TEXT(style);
+    WRITE_PREVIEW_TEXT("</style>\n</head>\n<body>\n<article>\n");
+
+    if (title.length > 0) {
+        WRITE_PREVIEW_TEXT("<h1>");
+        RenderMarkdownText(title.text, title.length, write, userData);
+        WRITE_PREVIEW_TEXT("</h1>\n");
+    }
+    if (date.length > 0) {
+        WRITE_PREVIEW_TEXT("<p class=\"date\">");
+        RenderMarkdownText(date.text, (date.length > 10)? 10 : date.length, write, userData);     // Day only (YYYY-MM-DD)
+        WRITE_PREVIEW_TEXT("</p>\n");
+    }
+    if (banner.length > 0) {
+        WRITE_PREVIEW_TEXT("<img class=\"banner\" src=\"");
+        RenderMarkdownText(banner.text, banner.length, write, userData);
+        WRITE_PREVIEW_TEXT("\" alt=\"\">\n");
+    }
+    if (description.length > 0) {
+        WRITE_PREVIEW_TEXT("<p class=\"description\">");
+        RenderMarkdownText(description.text, description.length, write, userData);
+        WRITE_PREVIEW_TEXT("</p>\n");
+    }
+
+    MarkdownDocument *document = LoadMarkdownDocument(arena, text + parser.bodyOffset, size - parser.bodyOffset);
+    RenderMarkdownHtml(document, write, userData);
+
+    WRITE_PREVIEW_TEXT("</article>\n</body>\n</html>\n");
+
+    #undef WRITE_PREVIEW_TEXT
+}
+
+// Save HTML preview page of post into file, returns false if file could not be written
+static bool savePreviewPage(Arena *arena, const char *fileName, const char *text, int size) {
+    FILE *file = fopen(fileName, "wb");
+    if (file == NULL) return false;
+
+    renderPreviewPage(arena, text, size, writePreviewData, file);
+
+    bool success = !ferror(file);
+    return (fclose(file) == 0) && success;
+}
+
+// Preview page rendered into memory, buffer grows into arena (doubled)
+typedef struct PreviewPageBuffer {
+    Arena *arena;
+    char *data;
+    int size;
+    int capacity;
+} PreviewPageBuffer;
+
+static void writePreviewPageBuffer(const char *data, int size, void *userData) {
+    PreviewPageBuffer *buffer = (PreviewPageBuffer *)userData;
+
+    if ((buffer->size + size) > buffer->capacity) {
+        int capacity = (buffer->capacity > 0)? buffer->capacity*2 : 64*1024;
+        while (capacity < (buffer->size + size)) capacity *= 2;
+
+        char *grown = (char *)ArenaAlloc(buffer->arena, capacity);
+        if (buffer->size > 0) memcpy(grown, buffer->data, buffer->size);
+        buffer->data = grown;
+        buffer->capacity = capacity;
+    }
+
+    memcpy(buffer->data + buffer->size, data, size);
+    buffer->size += size;
+}
+
+// Render preview of post prepared into post folder (index.md and banner, as published) into preview
+// folder, banner is copied next to page as front matter links it; page is also set into preview
+// server (if not NULL), so a refresh never waits for disk
+// NOTE: Preview is never written into post folder, as post folder is pushed as is
+static int renderPostPreview(Arena *arena, PreviewServer *server, const char *postPath, const char *previewPath) {
+    int textSize = 0;
+    unsigned char *text = LoadFileData(ArenaFormat(arena, "%s/%s", postPath, POST_FILE_NAME), &textSize);
+    if (text == NULL) return -2;
+
+    PreviewPageBuffer page = { .arena = arena };
+    renderPreviewPage(arena, (const char *)text, textSize, writePreviewPageBuffer, &page);
+    UnloadFileData(text);
+
+    MakeDirectory(previewPath);
+    bool saved = SaveFileData(ArenaFormat(arena, "%s/%s", previewPath, PREVIEW_FILE_NAME), page.data, page.size);
+
+    // Server pages paths are relative to PREVIEW_PATH
+    if ((server != NULL) && (strncmp(previewPath, PREVIEW_PATH, strlen(PREVIEW_PATH)) == 0)) {
+        SetPreviewServerPage(server, ArenaFormat(arena, "%s/%s", previewPath + strlen(PREVIEW_PATH), PREVIEW_FILE_NAME), page.data, page.size);
+    }
+
+    int bannerSize = 0;
+    const char *bannerPath = ArenaFormat(arena, "%s/%s", previewPath, BANNER_FILE_NAME);
+    unsigned char *banner = LoadFileData(ArenaFormat(arena, "%s/%s", postPath, BANNER_FILE_NAME), &bannerSize);
+    if (banner != NULL) saved = SaveFileData(bannerPath, banner, bannerSize) && saved;
+    else remove(bannerPath);
+    UnloadFileData(banner);
+
+    return saved? 0 : -1;
+}
+
+// Site images: perceptual hashes of repository images (mirror tree) in a BK-tree, for similar images
+// searches; hashes are cached by blob id in mirror folder, only images not hashed yet are read and decoded
+// NOTE: Used on main thread (command line) or job queue thread (GUI banner check), never both,
+// paths are allocated in site images arena
+typedef struct SiteImages {
+    char repositoryUrl[256];
+    long fetchTime;
+    Arena arena;
+    GitTree tree;                   // Mirror tree, hash tree values are tree entry indices
+    ImageHashTree hashes;
+} SiteImages;
+
+static SiteImages siteImages = { 0 };
+
+// Site image blob requested, hashed once read
+typedef struct SiteImageRequest {
+    ImageHashRecord record;
+    int entry;                      // Tree entry (path gives blob file type)
+} SiteImageRequest;
+
+// Site images hashing: blobs requested, sorted by id (blobs are read in requested order)
+typedef struct SiteImagesRefresh {
+    const GitTree *tree;
+    SiteImageRequest *requests;
+    int count;
+    int position;                   // Next request to be read
+    int decodedCount;
+} SiteImagesRefresh;
+
+// Get image file type (lowercase extension) if supported image, thread safe
+static bool getImageFileType(const char *fileName, char *type) {
+    static const char *types[] = { ".png", ".jpg", ".jpeg", ".gif", ".bmp", ".qoi" };
+
+    const char *extension = strrchr(fileName, '.');
+    if ((extension == NULL) || (strlen(extension) > 5) || (strchr(extension, '/') != NULL)) return false;
+
+    for (int i = 0; extension[i] != '\0'; i++) type[i] = ((extension[i] >= 'A') && (extension[i] <= 'Z'))? extension[i] + 32 : extension[i];
+    type[strlen(extension)] = '\0';
+
+    for (int i = 0; i < (int)(sizeof(types)/sizeof(types[0])); i++) if (strcmp(type, types[i]) == 0) return true;
+
+    return false;
+}
+
+static int compareImageHashRecords(const void *a, const void *b) {
+    return strcmp(((const ImageHashRecord *)a)->blobId, ((const ImageHashRecord *)b)->blobId);
+}
+
+static int compareSiteImageRequests(const void *a, const void *b) {
+    return compareImageHashRecords(&((const SiteImageRequest *)a)->record, &((const SiteImageRequest *)b)->record);
+}
+
+// Hash site image blob read from mirror (blobs callback)
+static void hashSiteImageBlob(const char *id, int requestIndex, const char *data, long size, void *userData) {
+    SiteImagesRefresh *refresh = (SiteImagesRefresh *)userData;
+
+    while ((refresh->position < refresh->count) && (strcmp(refresh->requests[refresh->position].record.blobId, id) != 0)) refresh->position++;
+    if (refresh->position >= refresh->count) return;
+
+    SiteImageRequest *request = &refresh->requests[refresh->position++];
+    ImageHashRecord *record = &request->record;
+    char type[8] = { 0 };
+    getImageFileType(refresh->tree->entries[request->entry].path, type);
+
+    Image image = LoadImageFromMemory(type, (const unsigned char *)data, (int)size);
+    record->decoded = (image.data != NULL);
+    record->hash = ComputeImageHash(image);
+    UnloadImage(image);
+
+    if (record->decoded) refresh->decodedCount++;
+}
+
+// Load site images hashes from mirror tree, NULL if site has no mirror yet (images are not checked)
+// NOTE: Mirror is not fetched, it is updated by posts index refresh (command line publish, GUI completions)
+static const ImageHashTree *loadSiteImages(ProjectConfig *config) {
+    Arena arena = { 0 };
+    GitRepository repo = newRepository(&arena, config->building.gitRepositoryUrl, config->building.contentFolderPath);
+    const char *mirrorPath = getMirrorPath(&repo);
+    const char *fetchHeadPath = ArenaFormat(&arena, "%s/FETCH_HEAD", mirrorPath);
+    long fetchTime = FileExists(fetchHeadPath)? GetFileModTime(fetchHeadPath) : 0;
+
+    if ((siteImages.tree.entries != NULL) && (siteImages.fetchTime == fetchTime) && (strcmp(siteImages.repositoryUrl, config->building.gitRepositoryUrl) == 0)) {
+        ArenaFree(&arena);
+        return &siteImages.hashes;
+    }
+
+    UnloadImageHashTree(&siteImages.hashes);
+    ArenaReset(&siteImages.arena);
+    siteImages.tree = (GitTree){ 0 };
+    if (!DirectoryExists(mirrorPath)) {
+        ArenaFree(&arena);
+        return NULL;
+    }
+
+    snprintf(siteImages.repositoryUrl, sizeof(siteImages.repositoryUrl), "%s", config->building.gitRepositoryUrl);
+    siteImages.fetchTime = fetchTime;
+
+    GitRepository treeRepo = newRepository(&siteImages.arena, config->building.gitRepositoryUrl, config->building.contentFolderPath);
+    siteImages.tree = loadMirrorTree(&treeRepo, mirrorPath);
+
+    // Images not in hashes cache are requested (once per blob), cached hashes of removed images are dropped
+    const char *cachePath = ArenaFormat(&arena, "%s/%s", mirrorPath, IMAGE_HASH_FILE_NAME);
+    ImageHashCache cache = LoadImageHashCache(cachePath);
+    ImageHashRecord *records = (ImageHashRecord *)ArenaAlloc(&arena, (siteImages.tree.count + 1)*sizeof(ImageHashRecord));
+    int recordCount = 0, imageCount = 0;
+
+    SiteImagesRefresh refresh = { 0 };
+    refresh.tree = &siteImages.tree;
+    refresh.requests = (SiteImageRequest *)ArenaAlloc(&arena, (siteImages.tree.count + 1)*sizeof(SiteImageRequest));
+
+    for (int i = 0; (i < siteImages.tree.count) && (refresh.requests != NULL) && (records != NULL); i++) {
+        char type[8] = { 0 };
+        if (!getImageFileType(siteImages.tree.entries[i].path, type)) continue;
+
+        imageCount++;
+        const ImageHashRecord *record = FindImageHashRecord(&cache, siteImages.tree.entries[i].id);
+        if (record != NULL) records[recordCount++] = *record;
+        else {
+            SiteImageRequest *request = &refresh.requests[refresh.count++];
+            *request = (SiteImageRequest){ 0 };
+            snprintf(request->record.blobId, sizeof(request->record.blobId), "%s", siteImages.tree.entries[i].id);
+            request->entry = i;
+        }
+    }
+
+    if (refresh.count > 0) {
+        // Requests sorted by id and duplicated blobs (same image in several paths) removed
+        qsort(refresh.requests, refresh.count, sizeof(SiteImageRequest), compareSiteImageRequests);
+
+        int uniqueCount = 0;
+        for (int i = 0; i < refresh.count; i++) {
+            if ((uniqueCount > 0) && (compareSiteImageRequests(&refresh.requests[uniqueCount - 1], &refresh.requests[i]) == 0)) continue;
+            refresh.requests[uniqueCount++] = refresh.requests[i];
+        }
+        refresh.count = uniqueCount;
+
+        const char **ids = (const char **)ArenaAlloc(&arena, refresh.count*sizeof(const char *));
+        for (int i = 0; (ids != NULL) && (i < refresh.count); i++) ids[i] = refresh.requests[i].record.blobId;
+        if (ids != NULL) loadMirrorBlobs(&repo, mirrorPath, ids, refresh.count, hashSiteImageBlob, &refresh);
+
+        for (int i = 0; i < refresh.count; i++) records[recordCount++] = refresh.requests[i].record;
+        if (!SaveImageHashCache(cachePath, records, recordCount)) fprintf(stderr, "WARNING: Site images hashes could not be saved: %s\n", cachePath);
+
+        LOG("INFO: Site images hashed: %i image(s), %i new (%i decoded)\n", imageCount, refresh.count, refresh.decodedCount);
+    }
+
+    UnloadImageHashCache(&cache);
+
+    // Records are sorted by blob id once saved, hash tree is built over tree entries (every path of an image)
+    ImageHashCache hashes = { records, recordCount };
+    if (refresh.count == 0) qsort(records, recordCount, sizeof(ImageHashRecord), compareImageHashRecords);
+
+    for (int i = 0; (i < siteImages.tree.count) && (records != NULL); i++) {
+        char type[8] = { 0 };
+        if (!getImageFileType(siteImages.tree.entries[i].path, type)) continue;
+
+        const ImageHashRecord *record = FindImageHashRecord(&hashes, siteImages.tree.entries[i].id);
+        if ((record != NULL) && record->decoded) AddImageHashTreeValue(&siteImages.hashes, record->hash, i);
+    }
+
+    ArenaFree(&arena);
+
+    return &siteImages.hashes;
+}
+
+// Unload site images hashes
+static void unloadSiteImages(void) {
+    UnloadImageHashTree(&siteImages.hashes);
+    ArenaFree(&siteImages.arena);
+    siteImages.tree = (GitTree){ 0 };
+}
+
+// Find site image similar to post banner (file or bundle banner), its repository path and site link
+// NOTE: Link is the path as served by site: "static/" and "content/" prefixes removed (page bundle resources)
+static bool findSimilarBanner(ProjectConfig *config, char *path, char *link, int *distance) {
+    if ((config->project.bannerLink[0] != '\0') || (config->building.gitRepositoryUrl[0] == '\0')) return false;
+
+    Image banner = { 0 };
+    if (config->project.srcBannerPath[0] != '\0') banner = LoadImage(config->project.srcBannerPath);
+    else if (isPostBundleFile(config->project.srcContentPath)) {
+        int dataSize = 0;
+        unsigned char *data = LoadPostBundleFileData(config->project.srcContentPath, POST_BUNDLE_BANNER_PATH, &dataSize);
+        if (data != NULL) banner = LoadImageFromMemory(".png", data, dataSize);
+        free(data);
+    }
+
+    if (banner.data == NULL) return false;
+
+    uint64_t hash = ComputeImageHash(banner);
+    UnloadImage(banner);
+
+    const ImageHashTree *hashes = loadSiteImages(config);
+    ImageHashMatch match = { 0 };
+    if ((hashes == NULL) || (SearchImageHashTree(hashes, hash, IMAGE_DUPLICATE_DISTANCE, &match, 1) == 0)) return false;
+
+    const char *imagePath = siteImages.tree.entries[match.value].path;
+    const char *sitePath = imagePath;
+    if (strncmp(sitePath, "static/", 7) == 0) sitePath += 7;
+    else if (strncmp(sitePath, "content/", 8) == 0) sitePath += 8;
+
+    snprintf(path, 256, "%s", imagePath);
+    snprintf(link, 256, "/%s", sitePath);
+    *distance = match.distance;
+
+    return true;
+}
+
+// Find site image similar to selected banner (job function), result is read by GUI once done
+static void checkBanner(void *data) {
+    BannerCheck *check = (BannerCheck *)data;
+    check->found = findSimilarBanner(&check->config, check->path, check->link, &check->distance);
+}
+
+// Queue post folder in outbox, to be pushed into site content folder as <slug>
+// NOTE: Post folder is moved into outbox, post bundle (if used) is staged with post, its assets are
+// imported into repository worktree on push
+static int queuePost(ProjectConfig *config, const char *slug, const char *postPath) {
+    bool bundle = isPostBundleFile(config->project.srcContentPath);
+    int length = (int)strlen(config->building.contentFolderPath);
+    bool separator = (length > 0) && (config->building.contentFolderPath[length - 1] != '/');
+
+    OutboxEntry entry = { 0 };
+    snprintf(entry.repositoryUrl, sizeof(entry.repositoryUrl), "%s", config->building.gitRepositoryUrl);
+    snprintf(entry.postsPath, sizeof(entry.postsPath), "%s%s%s", config->building.contentFolderPath, separator? "/" : "", slug);
+    if (bundle) snprintf(entry.assetsPath, sizeof(entry.assetsPath), "%s", config->building.imageFolderPath);
+
+    if (AddOutboxEntry(outbox, &entry, postPath, bundle? config->project.srcContentPath : NULL) < 0) return -4;
+
+    LOG("INFO: Post queued for publishing as %s (%i pending)\n", entry.postsPath, GetOutboxPendingCount(outbox));
+    return 0;
+}
+
+// Replace all occurrences of text, result is allocated in arena
+static char *replaceText(Arena *arena, const char *text, const char *search, const char *replacement) {
+    size_t searchLength = strlen(search);
+    size_t replacementLength = strlen(replacement);
+
+    int count = 0;
+    for (const char *ptr = strstr(text, search); ptr != NULL; ptr = strstr(ptr + searchLength, search)) count++;
+    if (count == 0) return (char *)text;
+
+    char *result = (char *)ArenaAlloc(arena, strlen(text) + count*replacementLength + 1);
+    char *out = result;
+
+    for (const char *ptr = strstr(text, search); ptr != NULL; ptr = strstr(text, search)) {
+        memcpy(out, text, ptr - text);
+        out += ptr - text;
+        memcpy(out, replacement, replacementLength);
+        out += replacementLength;
+        text = ptr + searchLength;
+    }
+    strcpy(out, text);
+
+    return result;
+}
+
+// Update links to bundle assets (relative to bundle root) with assets site URL, once imported into assets folder
+// NOTE: Result is allocated in arena
+static char *rewriteBundleLinks(Arena *arena, const char *content, const char *assetsPath, const BundleAsset *assets, int count) {
+    // Site URL of images folder, static files folder is served from site root (Hugo, Zola)
+    const char *imageUrl = assetsPath;
+    if (strncmp(imageUrl, "static/", 7) == 0) imageUrl += 7;
+    imageUrl = ArenaFormat(arena, "/%s%s", imageUrl, ((imageUrl[0] != '\0') && (imageUrl[strlen(imageUrl) - 1] != '/'))? "/" : "");
+
+    char *result = (char *)content;
+    for (int i = 0; i < count; i++) {
+        const char *url = ArenaFormat(arena, "%s%s", imageUrl, assets[i].fileName);
+        result = replaceText(arena, result, ArenaFormat(arena, "](%s", assets[i].archivePath), ArenaFormat(arena, "](%s", url));
+        result = replaceText(arena, result, ArenaFormat(arena, "](./%s", assets[i].archivePath), ArenaFormat(arena, "](%s", url));
+        result = replaceText(arena, result, ArenaFormat(arena, "src=\"%s", assets[i].archivePath), ArenaFormat(arena, "src=\"%s", url));
+        result = replaceText(arena, result, ArenaFormat(arena, "src=\"./%s", assets[i].archivePath), ArenaFormat(arena, "src=\"%s", url));
+    }
+
+    return result;
+}
+
+// Import post bundle (outbox entry attachment) into repository worktree: assets are extracted into
+// site images folder and links to bundle assets of post copied into worktree are updated
+// NOTE: Assets already in images folder (same git blob id) are reused, not duplicated
+// NOTE: Called from outbox drainer thread (GUI mode), only outbox arena is used
+static uint8_t importPostBundle(const char *worktreePath, void *userData) {
+    const OutboxEntry *entry = (const OutboxEntry *)userData;
+
+    const char *indexFileName = ArenaFormat(&outboxArena, "%s/%s/index.md", worktreePath, entry->postsPath);
+    char *indexText = LoadFileText(indexFileName);
+    if (indexText == NULL) return EXIT_FAILURE;
+
+    char *content = ArenaStrdup(&outboxArena, indexText);
+    UnloadFileText(indexText);
+
+    BundleAsset *assets = (BundleAsset *)ArenaAlloc(&outboxArena, POST_BUNDLE_MAX_ENTRIES*sizeof(BundleAsset));
+    const char *assetsPath = ArenaFormat(&outboxArena, "%s/%s", worktreePath, entry->assetsPath);
+    int count = ImportPostBundleAssets(entry->attachmentPath, assetsPath, computeBlobId, assets, POST_BUNDLE_MAX_ENTRIES);
+    if (count < 0) return EXIT_FAILURE;
+
+    content = rewriteBundleLinks(&outboxArena, content, entry->assetsPath, assets, count);
+
+    int reusedCount = 0;
+    for (int i = 0; i < count; i++) if (assets[i].reused) reusedCount++;
+
+    LOG("INFO: Post bundle assets imported: %i (%i reused)\n", count, reusedCount);
+
+    return SaveFileText(indexFileName, content)? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// Site files update: posts pushed in one commit (outbox entries of one repository)
+typedef struct SiteUpdate {
+    const OutboxEntry *entries;
+    int count;
+} SiteUpdate;
+
+// Get site path of post from its repository path, content folder removed ("content/blog/hello" -> "/blog/hello/")
+// NOTE: Page bundle (index.md) and post file (.md) are both served as folder
+static const char *getPostSitePath(Arena *arena, const char *path) {
+    while (strncmp(path, "./", 2) == 0) path += 2;
+    if (strncmp(path, "content/", 8) == 0) path += 8;
+
+    int length = (int)strlen(path);
+    const char *fileName = strrchr(path, '/');
+    fileName = (fileName != NULL)? fileName + 1 : path;
+
+    if ((strcmp(fileName, POST_FILE_NAME) == 0) || (strcmp(fileName, "_index.md") == 0)) length -= (int)strlen(fileName);
+    else if ((length >= 3) && (strcmp(path + length - 3, ".md") == 0)) length -= 3;
+    while ((length > 0) && (path[length - 1] == '/')) length--;
+
+    return (length > 0)? ArenaFormat(arena, "/%.*s/", length, path) : "/";
+}
+
+// Get top level value from site generator config in worktree (Hugo, Zola, Jekyll), first key found,
+// empty if not found; quoted values are decoded, unquoted values end at comment or line end
+static const char *loadSiteConfigValue(Arena *arena, const char *worktreePath, const char **keys, int keyCount) {
+    static const char *configFiles[] = { "hugo.toml", "config.toml", "hugo.yaml", "config.yaml", "_config.yml",
+        "config/_default/hugo.toml", "config/_default/config.toml" };
+
+    for (int i = 0; i < (int)(sizeof(configFiles)/sizeof(configFiles[0])); i++) {
+        const char *fileName = ArenaFormat(arena, "%s/%s", worktreePath, configFiles[i]);
+        if (!FileExists(fileName)) continue;
+
+        char *text = LoadFileText(fileName);
+        if (text == NULL) continue;
+
+        // Only top level keys (line start, before first TOML table): key = "value" (TOML) or key: value (YAML)
+        const char *value = NULL;
+        for (const char *line = text; (line != NULL) && (*line != '[') && (value == NULL); line = strchr(line, '\n'), line = (line != NULL)? line + 1 : NULL) {
+            for (int k = 0; (k < keyCount) && (value == NULL); k++) {
+                int keyLength = (int)strlen(keys[k]);
+                if (strncmp(line, keys[k], keyLength) != 0) continue;
+
+                const char *ptr = line + keyLength;
+                while ((*ptr == ' ') || (*ptr == '\t')) ptr++;
+                if ((*ptr != '=') && (*ptr != ':')) continue;
+                ptr++;
+                while ((*ptr == ' ') || (*ptr == '\t')) ptr++;
+
+                FrontMatterSlice slice = { ptr, 0, 0 };
+                if ((*ptr == '"') || (*ptr == '\'')) {
+                    slice.quote = *ptr;
+                    slice.text = ++ptr;
+                    while ((ptr[slice.length] != '\0') && (ptr[slice.length] != '\n') && (ptr[slice.length] != slice.quote)) {
+                        if ((slice.quote == '"') && (ptr[slice.length] == '\\') && (ptr[slice.length + 1] != '\0')) slice.length++;
+                        slice.length++;
+                    }
+                }
+                else {
+                    while ((ptr[slice.length] != '\0') && (ptr[slice.length] != '\n') && (ptr[slice.length] != '\r') && (ptr[slice.length] != '#')) slice.length++;
+                    while ((slice.length > 0) && ((ptr[slice.length - 1] == ' ') || (ptr[slice.length - 1] == '\t'))) slice.length--;
+                }
+
+                if (slice.length > 0) value = copyFrontMatterValue(arena, slice);
+            }
+        }
+
+        UnloadFileText(text);
+        if (value != NULL) return value;
+    }
+
+    return "";
+}
+
+// Compare feed posts by date, newest first (RFC 3339 dates compare as text)
+static int compareSiteFeedPosts(const void *a, const void *b) {
+    const char *dateA = ((const SiteFeedPost *)a)->date;
+    const char *dateB = ((const SiteFeedPost *)b)->date;
+
+    return strcmp((dateB != NULL)? dateB : "", (dateA != NULL)? dateA : "");
+}
+
+// Update site feed and sitemap in repository worktree with pushed posts (finish callback, same commit):
+// pushed posts entries are spliced into existing files, metadata read from posts front matter as pushed
+// NOTE: Missing files are created once from site posts index (mirror, as of last refresh), so later
+// updates never read all site posts. Called from outbox drainer thread (GUI mode), only outbox arena is used
+static uint8_t updateSiteFeeds(const char *worktreePath, void *userData) {
+    const SiteUpdate *update = (const SiteUpdate *)userData;
+
+    // Static folder (Hugo, Zola) is copied to site root, other generators serve repository root files
+    const char *staticPath = ArenaFormat(&outboxArena, "%s/static", worktreePath);
+    const char *folder = DirectoryExists(staticPath)? staticPath : worktreePath;
+    const char *feedPath = ArenaFormat(&outboxArena, "%s/%s", folder, SITE_FEED_FILE_NAME);
+    const char *sitemapPath = ArenaFormat(&outboxArena, "%s/%s", folder, SITE_MAP_FILE_NAME);
+
+    SiteFeedPost *posts = (SiteFeedPost *)ArenaAlloc(&outboxArena, (update->count + 1)*sizeof(SiteFeedPost));
+    int count = 0;
+
+    for (int i = 0; i < update->count; i++) {
+        const OutboxEntry *entry = &update->entries[i];
+
+        int textSize = 0;
+        const char *postFileName = ArenaFormat(&outboxArena, "%s/%s/%s", worktreePath, entry->postsPath, POST_FILE_NAME);
+        unsigned char *text = FileExists(postFileName)? LoadFileData(postFileName, &textSize) : NULL;
+        if (text == NULL) continue;
+
+        SiteFeedPost *post = &posts[count++];
+        post->path = getPostSitePath(&outboxArena, entry->postsPath);
+        post->title = post->date = post->description = "";
+
+        FrontMatterParser parser = InitFrontMatterParser((const char *)text, textSize);
+        FrontMatterField field = { 0 };
+
+        while (NextFrontMatterField(&parser, &field)) {
+            if ((field.table.length > 0) || field.list) continue;
+
+            const char *value = copyFrontMatterValue(&outboxArena, field.value);
+            if (value == NULL) continue;
+            if (IsFrontMatterKey(field.key, "title")) post->title = value;
+            else if (IsFrontMatterKey(field.key, "date")) post->date = value;
+            else if (IsFrontMatterKey(field.key, "description")) post->description = value;
+        }
+
+        UnloadFileData(text);
+    }
+
+    if (count == 0) return EXIT_SUCCESS;
+    qsort(posts, count, sizeof(SiteFeedPost), compareSiteFeedPosts);
+
+    int feedSize = 0, sitemapSize = 0;
+    unsigned char *feed = FileExists(feedPath)? LoadFileData(feedPath, &feedSize) : NULL;
+    unsigned char *sitemap = FileExists(sitemapPath)? LoadFileData(sitemapPath, &sitemapSize) : NULL;
+
+    // Site base URL (Hugo baseURL, Zola base_url, Jekyll url), empty if not found, so feed links are relative
+    static const char *linkKeys[] = { "baseURL", "baseurl", "base_url", "url" };
+    static const char *titleKeys[] = { "title" };
+
+    char siteLink[256] = { 0 };
+    if (!GetSiteFeedLink((const char *)feed, feedSize, siteLink, sizeof(siteLink))) {
+        snprintf(siteLink, sizeof(siteLink), "%s", loadSiteConfigValue(&outboxArena, worktreePath, linkKeys, 4));
+    }
+    const char *siteTitle = (feed == NULL)? loadSiteConfigValue(&outboxArena, worktreePath, titleKeys, 1) : "";
+
+    // Missing files: pushed posts first, then site posts from index (newest first), duplicates are skipped
+    SiteFeedPost *sitePosts = posts;
+    int sitePostCount = count;
+
+    if ((feed == NULL) || (sitemap == NULL)) {
+        GitRepository repo = newRepository(&outboxArena, update->entries[0].repositoryUrl, update->entries[0].postsPath);
+        PostIndex index = LoadPostIndex(ArenaFormat(&outboxArena, "%s/%s", getMirrorPath(&repo), POST_INDEX_FILE_NAME));
+
+        sitePosts = (SiteFeedPost *)ArenaAlloc(&outboxArena, (count + index.count + 1)*sizeof(SiteFeedPost));
+        memcpy(sitePosts, posts, count*sizeof(SiteFeedPost));
+
+        for (int i = 0; i < index.count; i++) {
+            PostIndexEntry entry = GetPostIndexEntry(&index, i);
+            SiteFeedPost *post = &sitePosts[count + i];
+
+            post->path = getPostSitePath(&outboxArena, entry.path);
+            post->title = ArenaStrdup(&outboxArena, (entry.title != NULL)? entry.title : "");
+            post->date = ArenaStrdup(&outboxArena, (entry.date != NULL)? entry.date : "");
+            post->description = NULL;
+        }
+
+        qsort(sitePosts + count, index.count, sizeof(SiteFeedPost), compareSiteFeedPosts);
+        sitePostCount = count + index.count;
+        UnloadPostIndex(&index);
+    }
+
+    int dataSize = 0;
+    char *data = UpdateSiteFeed(&outboxArena, (const char *)feed, feedSize, siteLink, siteTitle, (feed == NULL)? sitePosts : posts,
+        (feed == NULL)? sitePostCount : count, SITE_FEED_MAX_ITEMS, &dataSize);
+    bool saved = SaveFileData(feedPath, data, dataSize);
+
+    data = UpdateSiteMap(&outboxArena, (const char *)sitemap, sitemapSize, siteLink, (sitemap == NULL)? sitePosts : posts,
+        (sitemap == NULL)? sitePostCount : count, &dataSize);
+    saved = SaveFileData(sitemapPath, data, dataSize) && saved;
+
+    LOG("INFO: Site feed and sitemap updated: %i post(s)%s\n", count, (sitePosts != posts)? ArenaFormat(&outboxArena, ", created with %i site post(s)", sitePostCount - count) : "");
+
+    UnloadFileData(feed);
+    UnloadFileData(sitemap);
+
+    return saved? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// Store previous version of post (search index update), blob read from worktree repository
+// NOTE: Blobs are requested in posts order, request index is post index
+static void storePreviousPostText(const char *id, int requestIndex, const char *data, long size, void *userData) {
+    SearchIndexPost *post = &((SearchIndexPost *)userData)[requestIndex];
+
+    char *text = (char *)ArenaAlloc(&outboxArena, size + 1);
+    memcpy(text, data, size);
+    post->previousText = text;
+    post->previousTextLength = (int)size;
+}
+
+// Load post for search index: markdown body, title and date from front matter, false if not found
+static bool loadSearchIndexPost(const char *fileName, const char *path, SearchIndexPost *post) {
+    int textSize = 0;
+    unsigned char *text = FileExists(fileName)? LoadFileData(fileName, &textSize) : NULL;
+    if (text == NULL) return false;
+
+    post->path = getPostSitePath(&outboxArena, path);
+    post->title = post->date = "";
+
+    FrontMatterParser parser = InitFrontMatterParser((const char *)text, textSize);
+    FrontMatterField field = { 0 };
+
+    while (NextFrontMatterField(&parser, &field)) {
+        if ((field.table.length > 0) || field.list) continue;
+
+        if (IsFrontMatterKey(field.key, "title")) post->title = copyFrontMatterValue(&outboxArena, field.value);
+        else if (IsFrontMatterKey(field.key, "date")) post->date = copyFrontMatterValue(&outboxArena, field.value);
+    }
+
+    int bodyOffset = (parser.bodyOffset < textSize)? parser.bodyOffset : textSize;
+    post->textLength = textSize - bodyOffset;
+    post->text = ArenaFormat(&outboxArena, "%.*s", post->textLength, (const char *)text + bodyOffset);
+
+    UnloadFileData(text);
+
+    return true;
+}
+
+// Update site search index in repository worktree with pushed posts (finish callback, same commit):
+// only pushed posts are tokenized, their previous version (last commit) is tokenized too so their
+// outdated postings are removed, only shards of those terms are rewritten
+// NOTE: Missing index is created once from site posts index paths (posts read from worktree), so later
+// updates never read all site posts. Called from outbox drainer thread (GUI mode), only outbox arena is used
+static uint8_t updateSiteSearchIndex(const char *worktreePath, void *userData) {
+    const SiteUpdate *update = (const SiteUpdate *)userData;
+
+    const char *staticPath = ArenaFormat(&outboxArena, "%s/static", worktreePath);
+    const char *folder = ArenaFormat(&outboxArena, "%s/%s", DirectoryExists(staticPath)? staticPath : worktreePath, SEARCH_INDEX_FOLDER_NAME);
+    const char *gitPath = ArenaFormat(&outboxArena, "%s/.git", worktreePath);
+    bool created = !IsSearchIndexCurrent(folder);    // Missing or outdated (another version) index is created
+
+    GitRepository repo = newRepository(&outboxArena, update->entries[0].repositoryUrl, update->entries[0].postsPath);
+    PostIndex index = { 0 };
+    if (created) index = LoadPostIndex(ArenaFormat(&outboxArena, "%s/%s", getMirrorPath(&repo), POST_INDEX_FILE_NAME));
+
+    SearchIndexPost *posts = (SearchIndexPost *)ArenaAlloc(&outboxArena, (update->count + index.count + 1)*sizeof(SearchIndexPost));
+    const char **blobNames = (const char **)ArenaAlloc(&outboxArena, (update->count + 1)*sizeof(const char *));
+    int count = 0;
+
+    for (int i = 0; i < update->count; i++) {
+        const char *postsPath = update->entries[i].postsPath;
+        while (strncmp(postsPath, "./", 2) == 0) postsPath += 2;
+
+        const char *postFileName = ArenaFormat(&outboxArena, "%s/%s/%s", worktreePath, postsPath, POST_FILE_NAME);
+        if (!loadSearchIndexPost(postFileName, postsPath, &posts[count])) continue;
+
+        // Previous version from last commit (HEAD: worktree is not committed yet), not found for new posts
+        blobNames[count] = ArenaFormat(&outboxArena, "HEAD:%s/%s", postsPath, POST_FILE_NAME);
+        count++;
+    }
+
+    int pushedCount = count;
+
+    // Previous versions of all pushed posts are read in a single git process
+    if (!created) loadMirrorBlobs(&repo, gitPath, blobNames, pushedCount, storePreviousPostText, posts);
+
+    // Missing index: site posts from index added, pushed posts are skipped (already added)
+    for (int i = 0; i < index.count; i++) {
+        PostIndexEntry entry = GetPostIndexEntry(&index, i);
+        const char *path = getPostSitePath(&outboxArena, entry.path);
+
+        bool pushed = false;
+        for (int k = 0; (k < pushedCount) && !pushed; k++) pushed = (strcmp(posts[k].path, path) == 0);
+        if (pushed) continue;
+
+        if (loadSearchIndexPost(ArenaFormat(&outboxArena, "%s/%s", worktreePath, entry.path), entry.path, &posts[count])) count++;
+    }
+
+    UnloadPostIndex(&index);
+
+    if (count == 0) return EXIT_SUCCESS;
+
+    SearchIndexStats stats = { 0 };
+    bool saved = UpdateSearchIndex(&outboxArena, folder, posts, count, &stats);
+
+    LOG("INFO: Site search index updated: %i post(s)%s, %i postings, %i/%i shard(s) saved (%i split), %lld bytes read, %lld bytes written\n",
+        pushedCount, created? ArenaFormat(&outboxArena, ", created with %i site post(s)", count - pushedCount) : "", stats.postingCount,
+        stats.shardsSaved, stats.shardCount, stats.shardsSplit, stats.bytesRead, stats.bytesWritten);
+
+    return saved? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// Update site files in repository worktree with pushed posts (finish callback): feeds, then search index
+// NOTE: Site files are derived from posts, a failure is logged but posts are pushed anyway
+// (files are updated again on next push)
+static uint8_t updateSiteFiles(const char *worktreePath, void *userData) {
+    if (updateSiteFeeds(worktreePath, userData) != EXIT_SUCCESS) LOG("WARNING: Site feed and sitemap could not be updated, posts pushed without them\n");
+    if (updateSiteSearchIndex(worktreePath, userData) != EXIT_SUCCESS) LOG("WARNING: Site search index could not be updated, posts pushed without it\n");
+
+    return EXIT_SUCCESS;
+}
+
+// Push outbox entries of one repository: all posts are pushed in a single commit
+// NOTE: Called from outbox drainer thread (GUI mode), only outbox arena is used
+static bool pushOutboxEntries(const OutboxEntry *entries, int count, void *userData) {
+    GitRepository repo = newRepository(&outboxArena, entries[0].repositoryUrl, entries[0].postsPath);
+    GitPost *posts = (GitPost *)ArenaAlloc(&outboxArena, count*sizeof(GitPost));
+
+    for (int i = 0; i < count; i++) {
+        posts[i].sourcePath = entries[i].postPath;
+        posts[i].postsPath = entries[i].postsPath;
+        posts[i].assetsPath = (entries[i].assetsPath[0] != '\0')? entries[i].assetsPath : NULL;
+        if (entries[i].attachmentPath[0] != '\0') {
+            posts[i].prepare = importPostBundle;
+            posts[i].prepareData = (void *)&entries[i];
+        }
+    }
+
+    SiteUpdate siteUpdate = { entries, count };
+    repo.finish = updateSiteFiles;
+    repo.finishData = &siteUpdate;
+
+    bool success = (pushPostsToRepository(&repo, posts, count) == EXIT_SUCCESS);
+    if (success) LOG("INFO: %i post(s) pushed to %s\n", count, entries[0].repositoryUrl);
+
+    ArenaReset(&outboxArena);
+
+    return success;
+}
+
+// Log arenas and process memory usage
+// NOTE: Publish arena is logged before reset, so peak usage of last publish is available
+static void logMemoryStats(const char *label) {
+    LOG("MEMORY: [%s] session arena: %zu bytes used, %i allocs, %i block(s) (%zu bytes reserved)\n", label,
+        sessionArena.used, sessionArena.allocCount, sessionArena.blockCount, sessionArena.reserved);
+    LOG("MEMORY: [%s] publish arena: %zu bytes used (%zu peak), %i allocs, %i block(s) (%zu bytes reserved)\n", label,
+        publishArena.used, publishArena.peak, publishArena.allocCount, publishArena.blockCount, publishArena.reserved);
+    LOG("MEMORY: [%s] process RSS: %zu KB\n", label, GetProcessMemoryUsage()/1024);
+}
+
+// Check if a markdown link target is a local asset that can be bundled
+// NOTE: Only relative paths inside post folder are accepted, so links are still valid in bundle
+static bool isBundleAssetPath(const char *path) {
+    if ((path[0] == '\0') || (path[0] == '/') || (path[0] == '\\') || (path[0] == '#') || (path[1] == ':')) return false;
+    if ((strstr(path, "://") != NULL) || (strncmp(path, "mailto:", 7) == 0) || (strstr(path, "..") != NULL)) return false;
+
+    return true;
+}
+
+// Add local assets referenced by markdown content to bundle entries: links, images and html src attributes
+static int addBundleAssets(const char *content, const char *basePath, BundleEntry *entries, int count, int maxCount) {
+    const char *ptr = content;
+
+    while (count < maxCount) {
+        const char *mdLink = strstr(ptr, "](");
+        const char *srcAttr = strstr(ptr, "src=\"");
+        const char *link = NULL;
+        char end = '\0';
+
+        if ((mdLink != NULL) && ((srcAttr == NULL) || (mdLink < srcAttr))) { link = mdLink + 2; end = ')'; }
+        else if (srcAttr != NULL) { link = srcAttr + 5; end = '"'; }
+        else break;
+
+        while (*link == ' ') link++;
+        if (*link == '<') { link++; end = '>'; }
+
+        // Link target ends on closing char, title (markdown) or query/fragment
+        int length = 0;
+        while ((link[length] != '\0') && (link[length] != end) && (link[length] != '\n') && (link[length] != '?') &&
+               (link[length] != '#') && !((end == ')') && (link[length] == ' '))) length++;
+        ptr = link + length;
+
+        char *path = (char *)ArenaAlloc(&publishArena, length + 1);
+        memcpy(path, link, length);
+        if (strncmp(path, "./", 2) == 0) path += 2;
+        if (!isBundleAssetPath(path)) continue;
+
+        bool duplicated = false;
+        for (int i = 0; (i < count) && !duplicated; i++) duplicated = (strcmp(entries[i].archivePath, path) == 0);
+        if (duplicated) continue;
+
+        const char *filePath = ArenaFormat(&publishArena, "%s/%s", basePath, path);
+        if (!FileExists(filePath) || DirectoryExists(filePath)) {
+            fprintf(stderr, "WARNING: Referenced asset not found, not bundled: %s\n", path);
+            continue;
+        }
+
+        entries[count++] = (BundleEntry){ path, filePath };
+    }
+
+    return count;
+}
+
+// Export post and referenced assets as .zip bundle
+// NOTE: Post is generated as for publishing, bundle contains post folder files (index.md, banner)
+// and local assets referenced by markdown, with same relative paths used by links
+static bool exportPostBundle(ProjectConfig *config, const char *fileName) {
+    bool success = false;
+
+    // NOTE: Bundle does not target a site, so slug is not checked for collisions
+    const char *postPath = ArenaFormat(&publishArena, "%s/%s", NEW_POST_PATH, getPostSlug(config));
+
+    if (writeContent(&publishArena, config, postPath) == 0) {
+        BundleEntry *entries = (BundleEntry *)ArenaAlloc(&publishArena, POST_BUNDLE_MAX_ENTRIES*sizeof(BundleEntry));
+        int count = 0;
+
+        FilePathList postFiles = LoadDirectoryFilesEx(postPath, NULL, true);
+        for (unsigned int i = 0; (i < postFiles.count) && (count < POST_BUNDLE_MAX_ENTRIES); i++) {
+            entries[count].filePath = ArenaStrdup(&publishArena, postFiles.paths[i]);
+            entries[count].archivePath = ArenaStrdup(&publishArena, postFiles.paths[i] + strlen(postPath) + 1);
+            count++;
+        }
+        UnloadDirectoryFiles(postFiles);
+
+        // NOTE: Post bundle source assets are not scanned, only its markdown and banner are exported
+        char *content = isPostBundleFile(config->project.srcContentPath)? NULL : LoadFileText(config->project.srcContentPath);
+        if (content != NULL) {
+            const char *basePath = ArenaStrdup(&publishArena, GetDirectoryPath(config->project.srcContentPath));
+            count = addBundleAssets(content, basePath, entries, count, POST_BUNDLE_MAX_ENTRIES);
+            UnloadFileText(content);
+        }
+
+        // Bundle is saved as a batch temp file, an existing bundle is only replaced once complete
+        FileBatch *batch = BeginFileBatch();
+        const char *tempFileName = AddBatchFile(batch, fileName);
+        success = (tempFileName != NULL) && SavePostBundle(tempFileName, entries, count, workerPool);
+
+        if (success) success = EndFileBatch(batch);
+        else AbortFileBatch(batch);
+
+        if (success) LOG("INFO: Post bundle exported: %s (%i files)\n", fileName, count);
+    }
+
+    ArenaReset(&publishArena);
+
+    return success;
+}
+
+static void uploadProject(void) {
+    if (publishPostDrafts() == 0){
+        fprintf(stderr, "Something went wrong");
+        // TODO: Make a popup / probably wrong user input
+    }
+
+    showUploadProjectPopup = false;
+
+}
+
+// Add empty draft, build settings copied from given config (defaults if NULL)
+static PostDraft *addPostDraft(const ProjectConfig *building) {
+    if (draftCount >= MAX_POST_DRAFTS) return NULL;
+
+    PostDraft *draft = &drafts[draftCount++];
+    memset(draft, 0, sizeof(PostDraft));
+    loadDefaultConfig(&draft->config);
+    if (building != NULL) draft->config.building = building->building;
+    draft->id = nextDraftId++;
+
+    draft->preparation = (DraftPreparation *)RL_CALLOC(1, sizeof(DraftPreparation));
+    snprintf(draft->preparation->postPath, sizeof(draft->preparation->postPath), "%s/.draft-%i", NEW_POST_PATH, draft->id);
+    snprintf(draft->preparation->previewPath, sizeof(draft->preparation->previewPath), "%s/draft-%i", PREVIEW_PATH, draft->id);
+    draft->preparation->job = -1;
+    draft->preparation->result = -2;
+
+    return draft;
+}
+
+// Remove draft, its preparation is waited and scratch folder removed
+// NOTE: Scratch folder of a published draft was already moved into outbox
+static void removePostDraft(int index) {
+    if ((index < 0) || (index >= draftCount)) return;
+
+    DraftPreparation *prep = drafts[index].preparation;
+    WaitJob(draftQueue, prep->job);
+
+    remove(TextFormat("%s/%s", prep->postPath, POST_FILE_NAME));
+    remove(TextFormat("%s/%s", prep->postPath, BANNER_FILE_NAME));
+    rmdir(prep->postPath);
+    remove(TextFormat("%s/%s", prep->previewPath, PREVIEW_FILE_NAME));
+    remove(TextFormat("%s/%s", prep->previewPath, BANNER_FILE_NAME));
+    rmdir(prep->previewPath);
+    RemovePreviewServerPage(previewServer, TextFormat("%s/%s", prep->previewPath + strlen(PREVIEW_PATH), PREVIEW_FILE_NAME));
+
+    ArenaFree(&prep->arena);
+    RL_FREE(prep);
+
+    for (int i = index; i < draftCount - 1; i++) drafts[i] = drafts[i + 1];
+    draftCount--;
+
+    if ((activeDraft > index) || (activeDraft >= draftCount)) activeDraft--;
+    if (activeDraft < 0) activeDraft = 0;
+}
+
+// Check if any draft text box is in edit mode
+static bool isPostDraftEdited(const PostDraft *draft) {
+    return draft->editMode.title || draft->editMode.author || draft->editMode.description || draft->editMode.tags ||
+        draft->editMode.category || draft->editMode.repository || draft->editMode.contentPath || draft->editMode.imagesPath;
+}
+
+// Check if draft changed since prepared: config, or source files modified
+static bool isPostDraftStale(const PostDraft *draft) {
+    const DraftPreparation *prep = draft->preparation;
+
+    if (memcmp(&prep->source, &draft->config, sizeof(ProjectConfig)) != 0) return true;
+    if (GetFileModTime(draft->config.project.srcContentPath) != prep->contentModTime) return true;
+
+    return (draft->config.project.srcBannerPath[0] != '\0') && (GetFileModTime(draft->config.project.srcBannerPath) != prep->bannerModTime);
+}
+
+// Snapshot draft config, source files modification times and preview server for preparation
+// NOTE: Called on main thread, only once previous preparation is done
+static void beginPostDraftPreparation(PostDraft *draft) {
+    DraftPreparation *prep = draft->preparation;
+
+    prep->source = draft->config;
+    prep->contentModTime = GetFileModTime(draft->config.project.srcContentPath);
+    prep->bannerModTime = (draft->config.project.srcBannerPath[0] != '\0')? GetFileModTime(draft->config.project.srcBannerPath) : 0;
+    prep->server = previewServer;   // Preview server is only loaded/unloaded on main thread, job never reads global
+}
+
+// Prepare draft post into its scratch folder, as for publishing, and render its HTML preview (job function)
+// NOTE: Post front matter is dated when prepared, only preparation arena is used
+static void preparePostDraft(void *data) {
+    DraftPreparation *prep = (DraftPreparation *)data;
+
+    ArenaReset(&prep->arena);
+    prep->config = prep->source;
+    prep->result = writeContent(&prep->arena, &prep->config, prep->postPath);
+    if (prep->result == 0) renderPostPreview(&prep->arena, prep->server, prep->postPath, prep->previewPath);
+}
+
+// Open draft HTML preview in browser, served by local preview server (loaded on first preview),
+// page is served from memory once draft is prepared again; preview file is opened if no server available
+// NOTE: Draft preview folder is PREVIEW_PATH/draft-<id>, server root is PREVIEW_PATH
+static void openPostDraftPreview(const PostDraft *draft) {
+    const DraftPreparation *prep = draft->preparation;
+
+    if (previewServer == NULL) {
+        previewServer = LoadPreviewServer(PREVIEW_PATH, PREVIEW_SERVER_PORT);
+        if (previewServer == NULL) previewServer = LoadPreviewServer(PREVIEW_PATH, 0);     // Port in use
+        if (previewServer != NULL) LOG("INFO: Preview server: http://127.0.0.1:%i/\n", GetPreviewServerPort(previewServer));
+    }
+
+    if (previewServer != NULL) OpenURL(TextFormat("http://127.0.0.1:%i%s/", GetPreviewServerPort(previewServer), prep->previewPath + strlen(PREVIEW_PATH)));
+    else OpenURL(TextFormat("file://%s/%s/%s", GetWorkingDirectory(), prep->previewPath + 2, PREVIEW_FILE_NAME));  // Path without "./"
+}
+
+// Queue preparation of drafts changed since prepared, once not being edited, and update tab names
+static void updatePostDrafts(void) {
+    for (int i = 0; i < draftCount; i++) {
+        PostDraft *draft = &drafts[i];
+        const ProjectConfig *config = &draft->config;
+
+        const char *name = (config->project.title[0] != '\0')? config->project.title :
+            (config->project.srcContentPath[0] != '\0')? GetFileNameWithoutExt(config->project.srcContentPath) : TextFormat("Draft %i", draft->id + 1);
+        snprintf(draft->tabName, sizeof(draft->tabName), "%s", name);
+
+        if ((config->project.srcContentPath[0] == '\0') || isPostDraftEdited(draft)) continue;
+        if (!IsJobDone(draftQueue, draft->preparation->job) || !isPostDraftStale(draft)) continue;
+
+        beginPostDraftPreparation(draft);
+        draft->preparation->job = AddJob(draftQueue, preparePostDraft, draft->preparation);
+    }
+}
+
+// Publish all drafts with source content at once: prepared posts are queued together, so outbox
+// pushes them in a single commit per site, published drafts are removed
+// NOTE: A draft changed since prepared (or being edited) is prepared again before publishing
+static int publishPostDrafts(void) {
+    bool published[MAX_POST_DRAFTS] = { 0 };
+    int publishedCount = 0;
+
+    for (int i = 0; i < draftCount; i++) {
+        PostDraft *draft = &drafts[i];
+        DraftPreparation *prep = draft->preparation;
+        if (draft->config.project.srcContentPath[0] == '\0') continue;
+
+        WaitJob(draftQueue, prep->job);
+        if (isPostDraftStale(draft)) {
+            beginPostDraftPreparation(draft);
+            preparePostDraft(prep);
+        }
+
+        if (prep->result != 0) {
+            LOG("WARNING: Draft '%s' could not be prepared (error %i), not published\n", draft->tabName, prep->result);
+            continue;
+        }
+
+        // Slug is reserved from prepared config (front matter imported), drafts of a site never share it
+        const char *slug = reservePostSlug(&prep->config);
+        validatePostFolderLinks(&prep->config, slug, prep->postPath);
+        if (queuePost(&prep->config, slug, prep->postPath) != 0) continue;
+
+        published[i] = true;
+        publishedCount++;
+    }
+
+    ProjectConfig building = drafts[activeDraft].config;
+    for (int i = draftCount - 1; i >= 0; i--) if (published[i]) removePostDraft(i);
+    if (draftCount == 0) addPostDraft(&building);
+
+    if (showMemoryStats) logMemoryStats("publish");
+    ArenaReset(&publishArena);
+
+    return publishedCount;
+}
+
+#if defined(PLATFORM_DESKTOP)
+// Show command line usage info
+static void showCommandLineInfo(void) {
+    printf("\n//////////////////////////////////////////////////////////////////////////////////\n");
+    printf("//                                                                              //\n");
+    printf("// %-76s //\n", TextFormat("%s v%s - %s", TOOL_NAME, TOOL_VERSION, TOOL_DESCRIPTION));
+    printf("//                                                                              //\n");
+    printf("//////////////////////////////////////////////////////////////////////////////////\n\n");
+
+    printf("USAGE:\n\n");
+    printf("    > statiqpress publish [--title <text>] [--author <text>] [--description <text>]\n");
+    printf("                          [--tags <text>] [--category <text>] --md <file.md>\n");
+    printf("                          [--banner <file.png>] [--repo <url>] [--content <path>]\n");
+    printf("                          [--images <path>] [--profile <name>] [--slug <text>]\n");
+    printf("    > statiqpress publish --manifest <posts.ini> [--stats] [--dry-run] [--reuse-images]\n");
+    printf("    > statiqpress preview [publish options] [--site] [--serve] [--port <port>]\n");
+    printf("    > statiqpress bundle [publish options] --output <post.zip>\n");
+    printf("    > statiqpress outbox\n");
+    printf("    > statiqpress rewrite --rule <key>:<from>=<to> [--rule ...] [--repo <url>]\n");
+    printf("                          [--content <path>] [--profile <name>] [--path <folder>]\n");
+    printf("    > statiqpress index [--repo <url>] [--content <path>] [--profile <name>]\n");
+    printf("                        [--slug <slug>] [--path <path>] [--tag <tag>] [--category <text>]\n");
+    printf("                        [--author <text>] [--list <tags|categories|authors>]\n");
+
+    printf("\nMANIFEST (.ini):\n\n");
+    printf("    Keys before first [post] section are defaults for all posts, every [post]\n");
+    printf("    section is published in order; keys match options names (without --):\n\n");
+    printf("        profile = blog\n");
+    printf("        [post]\n");
+    printf("        title = My first post\n");
+    printf("        md = posts/first.md\n");
+    printf("        banner = posts/first.png\n");
+
+    printf("\nEXAMPLES:\n\n");
+    printf("    > statiqpress publish --title \"Hello\" --md hello.md --banner hello.png\n");
+    printf("        Publish hello.md post to default site repository\n");
+    printf("    > statiqpress publish --manifest batch.ini\n");
+    printf("        Publish all posts defined in batch.ini\n");
+    printf("    > statiqpress publish --manifest batch.ini --stats\n");
+    printf("        Publish all posts defined in batch.ini, reporting memory usage per post\n");
+    printf("    > statiqpress publish --manifest batch.ini --dry-run\n");
+    printf("        Report files changed by batch.ini posts, bytes to push and pack size\n");
+    printf("    > statiqpress publish --title \"Hello\" --md hello.md --banner hello.png --reuse-images\n");
+    printf("        Publish hello.md post, linking a site image similar to hello.png as its banner\n");
+    printf("    > statiqpress preview --title \"Hello\" --md hello.md --banner hello.png\n");
+    printf("        Render hello.md post as published into %s/hello/index.html\n", PREVIEW_PATH);
+    printf("    > statiqpress preview --md hello.md --site\n");
+    printf("        Render hello.md post and all site posts (repository mirror) into %s\n", PREVIEW_PATH);
+    printf("    > statiqpress preview --md hello.md --serve\n");
+    printf("        Render hello.md post and open it in browser, served from local preview server\n");
+    printf("    > statiqpress bundle --title \"Hello\" --md hello.md --banner hello.png --output hello.zip\n");
+    printf("        Export hello.md post, banner and referenced assets as hello.zip\n");
+    printf("    > statiqpress outbox\n");
+    printf("        Push posts kept in outbox by a failed publish (i.e. while offline)\n");
+    printf("    > statiqpress rewrite --rule tags:golang=go --rule categories:misc=\n");
+    printf("        Rename tag golang to go (merged if post has both), remove misc category\n");
+    printf("    > statiqpress index --tag go\n");
+    printf("        Refresh site posts index (changed posts only) and list posts tagged go\n\n");
+}
+
+// Set project config field by command line/manifest key, returns false if key not recognized
+static bool setConfigField(ProjectConfig *config, const char *key, const char *value) {
+    // NOTE: Config fields are fixed size (edited in place by GUI), too long values are reported
+    #define SET_CONFIG_FIELD(field) ((snprintf(field, sizeof(field), "%s", value) >= (int)sizeof(field))? \
+        (void)fprintf(stderr, "WARNING: Value for '%s' truncated to %i characters\n", key, (int)sizeof(field) - 1) : (void)0)
+
+    if (strcmp(key, "title") == 0) SET_CONFIG_FIELD(config->project.title);
+    else if (strcmp(key, "author") == 0) SET_CONFIG_FIELD(config->project.author);
+    else if (strcmp(key, "description") == 0) SET_CONFIG_FIELD(config->project.description);
+    else if (strcmp(key, "tags") == 0) SET_CONFIG_FIELD(config->project.tags);
+    else if (strcmp(key, "category") == 0) SET_CONFIG_FIELD(config->project.category);
+    else if (strcmp(key, "slug") == 0) SET_CONFIG_FIELD(config->project.slug);
+    else if (strcmp(key, "md") == 0) SET_CONFIG_FIELD(config->project.srcContentPath);
+    else if (strcmp(key, "banner") == 0) SET_CONFIG_FIELD(config->project.srcBannerPath);
+    else if (strcmp(key, "repo") == 0) SET_CONFIG_FIELD(config->building.gitRepositoryUrl);
+    else if (strcmp(key, "content") == 0) SET_CONFIG_FIELD(config->building.contentFolderPath);
+    else if (strcmp(key, "images") == 0) SET_CONFIG_FIELD(config->building.imageFolderPath);
+    else if (strcmp(key, "profile") == 0) {
+        int index = -1;
+        for (int i = 0; i < siteProfiles.count; i++) if (strcmp(GetSiteProfile(&siteProfiles, i).name, value) == 0) index = i;
+        if (index < 0) fprintf(stderr, "WARNING: Site profile not found: %s\n", value);
+        applySiteProfile(config, index);
+    }
+    else return false;
+
+    return true;
+}
+
+// Publish one post from command line, reporting result
+static int publishFromCommandLine(ProjectConfig *config) {
+    if (config->project.srcContentPath[0] == '\0') {
+        fprintf(stderr, "WARNING: No markdown file (--md) provided for post: %s\n", config->project.title);
+        return 1;
+    }
+
+    // Site posts index is refreshed (once per site) so new post slug is checked against latest site posts
+    loadSiteSlugs(config, true);
+
+    // Banner is compared with site images (mirror updated with posts index), similar image is reported or reused
+    char imagePath[256] = { 0 }, imageLink[256] = { 0 };
+    int distance = 0;
+    if (findSimilarBanner(config, imagePath, imageLink, &distance)) {
+        if (reuseSiteImages) {
+            snprintf(config->project.bannerLink, sizeof(config->project.bannerLink), "%s", imageLink);
+            LOG("INFO: Banner reused: similar site image %s (distance %i), linked as %s\n", imagePath, distance, imageLink);
+        }
+        else LOG("WARNING: Banner is similar to site image %s (distance %i of 64), --reuse-images links it instead\n", imagePath, distance);
+    }
+
+    int result = publishDryRun? dryRunPost(config) : publishProject(config);
+    if (result != 0) fprintf(stderr, "ERROR: Post could not be published (%i): %s\n", result, config->project.srcContentPath);
+    else if (!publishDryRun) LOG("INFO: Post queued: %s\n", config->project.srcContentPath);
+
+    return (result != 0)? 1 : 0;
+}
+
+// Publish all posts defined in a manifest file, returns number of failed posts
+static int publishManifest(const char *fileName) {
+    FILE *manifestFile = fopen(fileName, "r");
+    if (manifestFile == NULL) {
+        fprintf(stderr, "ERROR: Manifest file could not be opened: %s\n", fileName);
+        return 1;
+    }
+
+    ProjectConfig defaults = { 0 };
+    ProjectConfig post = { 0 };
+    loadDefaultConfig(&defaults);
+
+    bool postOpen = false;
+    int failedCount = 0;
+    int postCount = 0;
+    char line[1024] = { 0 };
+
+    while (fgets(line, sizeof(line), manifestFile) != NULL) {
+        // Trim line ending and leading spaces
+        char *start = line;
+        while ((*start == ' ') || (*start == '\t')) start++;
+        int length = (int)strlen(start);
+        while ((length > 0) && ((start[length - 1] == '\n') || (start[length - 1] == '\r') || (start[length - 1] == ' '))) start[--length] = '\0';
+
+        if ((start[0] == '\0') || (start[0] == '#') || (start[0] == ';')) continue;
+
+        if (strcmp(start, "[post]") == 0) {
+            if (postOpen) { failedCount += publishFromCommandLine(&post); postCount++; }
+            post = defaults;
+            postOpen = true;
+            continue;
+        }
+
+        char *separator = strchr(start, '=');
+        if (separator == NULL) continue;
+
+        *separator = '\0';
+        char *key = start;
+        char *value = separator + 1;
+        for (int i = (int)strlen(key) - 1; (i >= 0) && ((key[i] == ' ') || (key[i] == '\t')); i--) key[i] = '\0';
+        while ((*value == ' ') || (*value == '\t')) value++;
+
+        if (!setConfigField(postOpen? &post : &defaults, key, value)) fprintf(stderr, "WARNING: Unknown manifest key: %s\n", key);
+    }
+
+    if (postOpen) { failedCount += publishFromCommandLine(&post); postCount++; }
+
+    fclose(manifestFile);
+
+    LOG("INFO: Manifest processed: %i post(s) %s, %i failed\n", postCount - failedCount, publishDryRun? "checked" : "queued", failedCount);
+
+    return failedCount;
+}
+
+// Process command line input
+static int processCommandLine(int argc, char *argv[]) {
+    bool showUsageInfo = false;     // Toggle command line usage info
+    const char *manifestFileName = NULL;
+    const char *bundleFileName = NULL;
+
+    ProjectConfig config = { 0 };
+    loadDefaultConfig(&config);
+
+    if ((argc == 2) && (strcmp(argv[1], "outbox") == 0)) return (drainOutbox() > 0)? 1 : 0;
+    if ((argc >= 2) && (strcmp(argv[1], "rewrite") == 0)) return rewriteFromCommandLine(argc, argv);
+    if ((argc >= 2) && (strcmp(argv[1], "index") == 0)) return indexFromCommandLine(argc, argv);
+    if ((argc >= 2) && (strcmp(argv[1], "preview") == 0)) return previewFromCommandLine(argc, argv);
+
+    bool exportBundle = ((argc >= 2) && (strcmp(argv[1], "bundle") == 0));
+    if ((argc < 2) || ((strcmp(argv[1], "publish") != 0) && !exportBundle)) showUsageInfo = true;
+
+    // Process command line arguments
+    for (int i = 2; (i < argc) && !showUsageInfo; i++) {
+        if ((strcmp(argv[i], "-h") == 0) || (strcmp(argv[i], "--help") == 0)) showUsageInfo = true;
+        else if ((strcmp(argv[i], "--manifest") == 0) && ((i + 1) < argc)) manifestFileName = argv[++i];
+        else if (strcmp(argv[i], "--stats") == 0) showMemoryStats = true;
+        else if (strcmp(argv[i], "--dry-run") == 0) publishDryRun = true;
+        else if (strcmp(argv[i], "--reuse-images") == 0) reuseSiteImages = true;
+        else if ((strcmp(argv[i], "--output") == 0) && ((i + 1) < argc)) bundleFileName = argv[++i];
+        else if ((strncmp(argv[i], "--", 2) == 0) && ((i + 1) < argc) && setConfigField(&config, argv[i] + 2, argv[i + 1])) i++;
+        else {
+            fprintf(stderr, "WARNING: Unrecognized or incomplete option: %s\n", argv[i]);
+            showUsageInfo = true;
+        }
+    }
+
+    if (exportBundle && ((bundleFileName == NULL) || (config.project.srcContentPath[0] == '\0'))) {
+        fprintf(stderr, "WARNING: Bundle export requires markdown file (--md) and output file (--output)\n");
+        showUsageInfo = true;
+    }
+
+    if (showUsageInfo) {
+        showCommandLineInfo();
+        return 1;
+    }
+
+    if (exportBundle) return exportPostBundle(&config, bundleFileName)? 0 : 1;
+
+    // Queued posts are pushed at once, a single commit and push per repository
+    int failedCount = (manifestFileName != NULL)? publishManifest(manifestFileName) : publishFromCommandLine(&config);
+    if (publishDryRun) {
+        reportDryRun();
+        return (failedCount > 0)? 1 : 0;
+    }
+
+    int pendingCount = drainOutbox();
+
+    return ((failedCount > 0) || (pendingCount > 0))? 1 : 0;
+}
+
+// Push queued posts (one commit and push per repository), returns number of posts still pending
+static int drainOutbox(void) {
+    int pendingCount = GetOutboxPendingCount(outbox);
+    if (pendingCount == 0) return 0;
+
+    LOG("INFO: Pushing %i queued post(s)\n", pendingCount);
+    pendingCount = DrainOutbox(outbox, pushOutboxEntries, NULL);
+    if (pendingCount > 0) fprintf(stderr, "WARNING: %i post(s) could not be pushed, kept in outbox (%s)\n", pendingCount, OUTBOX_PATH);
+
+    return pendingCount;
+}
+
+// Get monotonic time in seconds, used by command line timings (dry run, index, preview)
+// NOTE: Window is not initialized in command line mode, so raylib GetTime() is not available
+static double getBenchmarkTime(void) {
+#if defined(_WIN32)
+    return (double)clock()/CLOCKS_PER_SEC;      // NOTE: Windows clock() measures wall time
+#else
+    struct timespec now = { 0 };
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec*1e-9;
+#endif
+}
+
+// Dry run: posts are prepared in memory and compared with the tree of a cached repository mirror
+// NOTE: Changed files are tracked by path, so a file written by several posts counts once (last version)
+typedef struct DryRunFile {
+    const char *path;               // Path in repository
+    char id[41];                    // Blob object id
+    size_t size;
+    size_t packSize;                // Deflated size, as stored in pack
+} DryRunFile;
+
+typedef struct DryRunRepository {
+    GitRepository repo;
+    const char *mirrorPath;
+    GitTree tree;                   // StatiqPress branch tree
+    const char **ids;               // Tree object ids (sorted), objects already in repository are not pushed
+    DryRunFile *files;              // Files written by posts
+    int fileCount;
+    int fileCapacity;
+    int postCount;
+} DryRunRepository;
+
+static DryRunRepository dryRunRepositories[8] = { 0 };
+static int dryRunRepositoryCount = 0;
+static double dryRunTime = 0.0;     // Time spent preparing and comparing posts
+
+static int compareIds(const void *a, const void *b) {
+    return strcmp(*(const char **)a, *(const char **)b);
+}
+
+// Get dry run repository (mirror fetched and tree loaded on first use), NULL if not available
+// NOTE: Repository data is allocated in session arena
+static DryRunRepository *getDryRunRepository(const char *url) {
+    for (int i = 0; i < dryRunRepositoryCount; i++) {
+        if (strcmp(dryRunRepositories[i].repo.url, url) == 0) return &dryRunRepositories[i];
+    }
+
+    if (dryRunRepositoryCount >= (int)(sizeof(dryRunRepositories)/sizeof(dryRunRepositories[0]))) return NULL;
+
+    DryRunRepository *repository = &dryRunRepositories[dryRunRepositoryCount];
+    repository->repo = newRepository(&sessionArena, url, "");
+    repository->mirrorPath = updateMirror(&repository->repo);
+    if (repository->mirrorPath == NULL) {
+        fprintf(stderr, "ERROR: Repository mirror not available: %s\n", url);
+        return NULL;
+    }
+
+    repository->tree = loadMirrorTree(&repository->repo, repository->mirrorPath);
+    repository->ids = (const char **)ArenaAlloc(&sessionArena, (repository->tree.count + 1)*sizeof(const char *));
+    for (int i = 0; i < repository->tree.count; i++) repository->ids[i] = repository->tree.entries[i].id;
+    qsort(repository->ids, repository->tree.count, sizeof(const char *), compareIds);
+
+    dryRunRepositoryCount++;
+
+    return repository;
+}
+
+// Get repository path: folder (config path, "./" prefix and trailing '/' removed) and file name
+// NOTE: Path is allocated in publish arena
+static const char *getRepositoryPath(const char *folder, const char *fileName) {
+    while (strncmp(folder, "./", 2) == 0) folder += 2;
+
+    int length = (int)strlen(folder);
+    while ((length > 0) && (folder[length - 1] == '/')) length--;
+
+    if (length == 0) return ArenaStrdup(&publishArena, fileName);
+    return ArenaFormat(&publishArena, "%.*s/%s", length, folder, fileName);
+}
+
+// Find dry run file by path, NULL if not written by any post
+static DryRunFile *findDryRunFile(DryRunRepository *repository, const char *path) {
+    for (int i = 0; i < repository->fileCount; i++) {
+        if (strcmp(repository->files[i].path, path) == 0) return &repository->files[i];
+    }
+
+    return NULL;
+}
+
+// Add file written by post, replaces previous version written by another post
+static void addDryRunFile(DryRunRepository *repository, const char *path, const void *data, size_t size) {
+    DryRunFile *file = findDryRunFile(repository, path);
+
+    if (file == NULL) {
+        if (repository->fileCount >= repository->fileCapacity) {
+            int capacity = (repository->fileCapacity > 0)? repository->fileCapacity*2 : 64;
+            DryRunFile *files = (DryRunFile *)realloc(repository->files, capacity*sizeof(DryRunFile));
+            if (files == NULL) return;
+
+            repository->files = files;
+            repository->fileCapacity = capacity;
+        }
+
+        file = &repository->files[repository->fileCount++];
+        file->path = ArenaStrdup(&sessionArena, path);
+    }
+
+    computeBlobId(data, size, file->id);
+    file->size = size;
+
+    // Pack stores objects deflated (zlib level 6 by default)
+    size_t compSize = 0;
+    void *compData = CompressDataParallel(data, size, &compSize, 6, workerPool);
+    file->packSize = (compData != NULL)? compSize : size;
+    mz_free(compData);
+}
+
+// Prepare bundle assets in memory as ImportPostBundleAssets() imports them into assets folder (same planning):
+// assets identical to a file in folder are reused, names used by different files get a numeric suffix
+// NOTE: Returns post content with links to assets updated, NULL if bundle could not be read
+static char *dryRunBundleAssets(DryRunRepository *repository, ProjectConfig *config, char *content) {
+    const char *assetsFolder = getRepositoryPath(config->building.imageFolderPath, "");
+    size_t folderLength = strlen(assetsFolder);
+
+    // Assets folder files (not in subfolders) after previous dry run posts: mirror tree, then files written by posts
+    BundleFolder folder = { 0 };
+    for (int i = 0; i < repository->tree.count; i++) {
+        const GitTreeEntry *entry = &repository->tree.entries[i];
+        if ((strncmp(entry->path, assetsFolder, folderLength) != 0) || (strchr(entry->path + folderLength, '/') != NULL)) continue;
+
+        if (findDryRunFile(repository, entry->path) == NULL) AddBundleFolderFile(&folder, entry->path + folderLength, entry->size, entry->id);
+    }
+    for (int i = 0; i < repository->fileCount; i++) {
+        const DryRunFile *file = &repository->files[i];
+        if ((strncmp(file->path, assetsFolder, folderLength) != 0) || (strchr(file->path + folderLength, '/') != NULL)) continue;
+
+        AddBundleFolderFile(&folder, file->path + folderLength, (long long)file->size, file->id);
+    }
+
+    BundleAsset *assets = (BundleAsset *)ArenaAlloc(&publishArena, POST_BUNDLE_MAX_ENTRIES*sizeof(BundleAsset));
+    int count = PlanPostBundleAssets(config->project.srcContentPath, &folder, computeBlobId, assets, POST_BUNDLE_MAX_ENTRIES);
+    UnloadBundleFolder(&folder);
+    if (count < 0) return NULL;
+
+    for (int i = 0; i < count; i++) {
+        if (assets[i].reused) continue;
+
+        int dataSize = 0;
+        unsigned char *data = LoadPostBundleFileData(config->project.srcContentPath, assets[i].archivePath, &dataSize);
+        if (data != NULL) addDryRunFile(repository, getRepositoryPath(assetsFolder, assets[i].fileName), data, dataSize);
+        free(data);
+    }
+
+    return rewriteBundleLinks(&publishArena, content, config->building.imageFolderPath, assets, count);
+}
+
+// Dry run of post publish: post files are generated in memory, as written by publish and prepared
+// in repository worktree (front matter, banner, bundle assets and links), and compared with mirror
+// NOTE: Nothing is written to NEW_POST_PATH or queued in outbox, changes are shown by reportDryRun()
+static int dryRunPost(ProjectConfig *config) {
+    double startTime = getBenchmarkTime();
+    int result = 0;
+
+    DryRunRepository *repository = getDryRunRepository(config->building.gitRepositoryUrl);
+    size_t contentSize = 0;
+    char *content = (repository != NULL)? loadPostContent(&publishArena, config, &contentSize) : NULL;
+
+    if (repository == NULL) result = -4;
+    else if (content == NULL) result = -2;
+    else {
+        content[contentSize] = '\0';
+
+        bool bundle = isPostBundleFile(config->project.srcContentPath);
+        if (bundle) content = dryRunBundleAssets(repository, config, content);
+
+        int bannerDataSize = 0;
+        unsigned char *bannerData = NULL;
+        bool bannerReused = (config->project.bannerLink[0] != '\0');    // Site image reused as banner, no banner file
+        if (!bannerReused && (config->project.srcBannerPath[0] != '\0')) {
+            bannerData = LoadFileData(config->project.srcBannerPath, &bannerDataSize);
+            if (bannerData == NULL) result = -3;
+        }
+        else if (!bannerReused && bundle) bannerData = LoadPostBundleFileData(config->project.srcContentPath, POST_BUNDLE_BANNER_PATH, &bannerDataSize);
+
+        // Banner is compared as published (optimized), an already published banner is not reported as modified
+        int optimizedSize = 0;
+        unsigned char *optimized = (bannerData != NULL)? optimizeBanner(bannerData, bannerDataSize, &optimizedSize) : NULL;
+        if (optimized != NULL) {
+            free(bannerData);
+            bannerData = optimized;
+            bannerDataSize = optimizedSize;
+        }
+
+        if (content == NULL) result = -2;
+        else if (result == 0) {
+            const char *text = ArenaFormat(&publishArena, "%s%s", formatFrontMatter(&publishArena, config), content);
+            const char *slug = reservePostSlug(config);
+            validatePostLinks(config, slug, text, (bannerData != NULL));
+            addDryRunFile(repository, getRepositoryPath(config->building.contentFolderPath, TextFormat("%s/%s", slug, POST_FILE_NAME)), text, strlen(text));
+            if (bannerData != NULL) addDryRunFile(repository, getRepositoryPath(config->building.contentFolderPath, TextFormat("%s/%s", slug, BANNER_FILE_NAME)), bannerData, bannerDataSize);
+            repository->postCount++;
+        }
+
+        free(bannerData);
+    }
+
+    dryRunTime += getBenchmarkTime() - startTime;
+
+    if (showMemoryStats) logMemoryStats("dry run");
+    ArenaReset(&publishArena);
+
+    return result;
+}
+
+// Estimate size of tree objects rewritten by changed paths: every folder up to root is a new tree object
+// NOTE: Tree entry is "<mode> <name>\0<20 bytes id>", tree objects hardly compress (binary ids)
+static size_t estimateTreesSize(DryRunRepository *repository, const char **changedPaths, int count) {
+    size_t size = 0;
+    const char **folders = (const char **)ArenaAlloc(&publishArena, (count*16 + 1)*sizeof(const char *));
+    int folderCount = 0;
+
+    for (int i = 0; (folders != NULL) && (i < count); i++) {
+        char folder[512] = { 0 };
+        snprintf(folder, sizeof(folder), "%s", changedPaths[i]);
+
+        while (folder[0] != '\0') {
+            char *separator = strrchr(folder, '/');
+            if (separator != NULL) *separator = '\0';
+            else folder[0] = '\0';
+
+            bool found = false;
+            for (int k = 0; (k < folderCount) && !found; k++) found = (strcmp(folders[k], folder) == 0);
+            if (!found && (folderCount < count*16)) folders[folderCount++] = ArenaStrdup(&publishArena, folder);
+        }
+    }
+
+    for (int i = 0; i < folderCount; i++) {
+        size_t prefixLength = strlen(folders[i]);
+        const char *previousChild = NULL;
+        int previousLength = 0;
+
+        // Children of folder: tree entries are sorted, so entries under one subfolder are contiguous
+        for (int k = 0; k < repository->tree.count; k++) {
+            const char *path = repository->tree.entries[k].path;
+            if ((prefixLength > 0) && ((strncmp(path, folders[i], prefixLength) != 0) || (path[prefixLength] != '/'))) continue;
+
+            const char *child = path + prefixLength + ((prefixLength > 0)? 1 : 0);
+            const char *childEnd = strchr(child, '/');
+            int childLength = (childEnd != NULL)? (int)(childEnd - child) : (int)strlen(child);
+
+            if ((previousChild != NULL) && (previousLength == childLength) && (strncmp(previousChild, child, childLength) == 0)) continue;
+
+            size += 28 + childLength;
+            previousChild = child;
+            previousLength = childLength;
+        }
+    }
+
+    // Paths added to repository are new folder entries
+    for (int i = 0; i < count; i++) if (findTreeEntry(&repository->tree, changedPaths[i]) == NULL) size += 28 + strlen(GetFileName(changedPaths[i]));
+
+    return size;
+}
+
+// Report files changed by dry run posts, per repository: files added and modified, bytes to push
+// (new objects) and estimated pack size (deflated objects, trees and commit)
+static void reportDryRun(void) {
+    for (int i = 0; i < dryRunRepositoryCount; i++) {
+        DryRunRepository *repository = &dryRunRepositories[i];
+        double startTime = getBenchmarkTime();
+
+        LOG("DRY RUN: %s (%i post(s), %i files in repository, mirror %s)\n", repository->repo.url,
+            repository->postCount, repository->tree.count, repository->mirrorPath);
+
+        int addedCount = 0, modifiedCount = 0, unchangedCount = 0, objectCount = 0;
+        size_t pushSize = 0, packSize = 12 + 20;   // Pack header and checksum
+        const char **changedPaths = (const char **)ArenaAlloc(&publishArena, (repository->fileCount + 1)*sizeof(const char *));
+        const char **newIds = (const char **)ArenaAlloc(&publishArena, (repository->fileCount + 1)*sizeof(const char *));
+
+        for (int k = 0; (changedPaths != NULL) && (newIds != NULL) && (k < repository->fileCount); k++) {
+            const DryRunFile *file = &repository->files[k];
+            const GitTreeEntry *entry = findTreeEntry(&repository->tree, file->path);
+
+            if ((entry != NULL) && (strcmp(entry->id, file->id) == 0)) {
+                unchangedCount++;
+                continue;
+            }
+
+            if (entry == NULL) addedCount++;
+            else modifiedCount++;
+            changedPaths[addedCount + modifiedCount - 1] = file->path;
+
+            LOG("    %c %s (%.1f KB)\n", (entry == NULL)? 'A' : 'M', file->path, file->size/1024.0);
+
+            // Objects already in repository (i.e. same content in another path) or in this push are not pushed again
+            const char *id = file->id;
+            bool existing = (bsearch(&id, repository->ids, repository->tree.count, sizeof(const char *), compareIds) != NULL);
+            for (int j = 0; (j < objectCount) && !existing; j++) existing = (strcmp(newIds[j], id) == 0);
+            if (existing) continue;
+
+            newIds[objectCount++] = id;
+            pushSize += file->size;
+            packSize += file->packSize + 3;         // Object header: type and size
+        }
+
+        size_t treesSize = estimateTreesSize(repository, changedPaths, addedCount + modifiedCount);
+        if ((addedCount + modifiedCount) > 0) packSize += treesSize + 250;     // Commit object
+        else packSize = 0;
+
+        LOG("DRY RUN: %i added, %i modified, %i unchanged; %.1f KB to push (%i objects), estimated pack size %.1f KB (%.2f ms)\n",
+            addedCount, modifiedCount, unchangedCount, pushSize/1024.0, objectCount, packSize/1024.0,
+            (dryRunTime + getBenchmarkTime() - startTime)*1000.0);
+
+        free(repository->files);
+        ArenaReset(&publishArena);
+    }
+}
+
+// Post index refresh state: posts changed since previous index, parsed as their blobs are read
+typedef struct PostIndexRefresh {
+    Arena *arena;                   // Memory for parsed strings (repository arena)
+    PostIndexBuilder *builder;
+    const char **paths;             // Changed posts paths, in requested blobs order
+    const char **ids;               // Changed posts blob ids
+    int count;
+    int position;                   // Next expected blob (blobs are read in requested order)
+    int parsedCount;
+} PostIndexRefresh;
+
+// Add post entry to index from post content (front matter), strings are copied into arena
+// NOTE: Taxonomies are read from root keys or [taxonomies] table (Zola), slug defaults to
+// post folder name for page bundles (index.md) or file name
+static void indexPostContent(Arena *arena, PostIndexBuilder *builder, const char *path, const char *id, const char *content, int contentSize) {
+    PostIndexEntry entry = { 0 };
+    entry.path = path;
+    snprintf(entry.blobId, sizeof(entry.blobId), "%s", id);
+
+    FrontMatterParser parser = InitFrontMatterParser(content, contentSize);
+    FrontMatterField field = { 0 };
+
+    while (NextFrontMatterField(&parser, &field)) {
+        bool root = (field.table.length == 0);
+        int list = -1;
+
+        if (root && IsFrontMatterKey(field.key, "title")) entry.title = copyFrontMatterValue(arena, field.value);
+        else if (root && IsFrontMatterKey(field.key, "slug")) entry.slug = copyFrontMatterValue(arena, field.value);
+        else if (root && IsFrontMatterKey(field.key, "date")) entry.date = copyFrontMatterValue(arena, field.value);
+        else if (!root && !IsFrontMatterKey(field.table, "taxonomies")) continue;
+        else if (IsFrontMatterKey(field.key, "tags")) list = POST_INDEX_TAGS;
+        else if (IsFrontMatterKey(field.key, "categories") || IsFrontMatterKey(field.key, "category")) list = POST_INDEX_CATEGORIES;
+        else if (IsFrontMatterKey(field.key, "authors") || IsFrontMatterKey(field.key, "author")) list = POST_INDEX_AUTHORS;
+
+        if (list < 0) continue;
+
+        FrontMatterSlice value = field.value;
+        while ((entry.valueCounts[list] < POST_INDEX_MAX_VALUES) && (field.list? NextFrontMatterValue(&field, &value) : (value.length > 0))) {
+            entry.values[list][entry.valueCounts[list]++] = copyFrontMatterValue(arena, value);
+            if (!field.list) break;
+        }
+    }
+
+    if ((entry.slug == NULL) || (entry.slug[0] == '\0')) {
+        const char *fileName = strrchr(path, '/');
+        fileName = (fileName != NULL)? fileName + 1 : path;
+
+        if ((strcmp(fileName, "index.md") == 0) && (fileName > path)) {
+            const char *folderName = fileName - 1;
+            while ((folderName > path) && (folderName[-1] != '/')) folderName--;
+            entry.slug = ArenaFormat(arena, "%.*s", (int)(fileName - 1 - folderName), folderName);
+        }
+        else entry.slug = ArenaFormat(arena, "%.*s", (int)strlen(fileName) - 3, fileName);
+    }
+
+    AddPostIndexEntry(builder, &entry);
+}
+
+// Blob read callback: index changed post
+static void indexPostBlob(const char *id, int requestIndex, const char *data, long size, void *userData) {
+    PostIndexRefresh *refresh = (PostIndexRefresh *)userData;
+
+    // NOTE: Missing blobs are skipped by git, so requested ids are matched in order
+    while ((refresh->position < refresh->count) && (strcmp(refresh->ids[refresh->position], id) != 0)) refresh->position++;
+    if (refresh->position >= refresh->count) return;
+
+    indexPostContent(refresh->arena, refresh->builder, refresh->paths[refresh->position], id, data, (int)size);
+    refresh->position++;
+    refresh->parsedCount++;
+}
+
+// Refresh site posts index from repository mirror (fetched first): posts are the markdown files
+// of content folder (section pages _index.md excluded), unchanged posts (same path and blob id)
+// are copied from previous index, only changed posts are read (one git process) and parsed
+// NOTE: Index is saved into mirror folder, path is allocated in repository arena (NULL on failure)
+// NOTE: Only repository arena is used, so index can be refreshed on a background thread
+static const char *refreshPostIndex(GitRepository *repo, const char *contentPath) {
+    double startTime = getBenchmarkTime();
+
+    const char *mirrorPath = updateMirror(repo);
+    if (mirrorPath == NULL) {
+        fprintf(stderr, "ERROR: Repository mirror not available: %s\n", repo->url);
+        return NULL;
+    }
+
+    GitTree tree = loadMirrorTree(repo, mirrorPath);
+    const char *indexPath = ArenaFormat(repo->arena, "%s/%s", mirrorPath, POST_INDEX_FILE_NAME);
+
+    // Posts folder prefix in repository paths: "./" and trailing '/' removed
+    while (strncmp(contentPath, "./", 2) == 0) contentPath += 2;
+    int prefixLength = (int)strlen(contentPath);
+    while ((prefixLength > 0) && (contentPath[prefixLength - 1] == '/')) prefixLength--;
+    const char *prefix = (prefixLength > 0)? ArenaFormat(repo->arena, "%.*s/", prefixLength, contentPath) : "";
+
+    PostIndex previous = LoadPostIndex(indexPath);
+    PostIndexRefresh refresh = { 0 };
+    refresh.arena = repo->arena;
+    refresh.builder = BeginPostIndex();
+    refresh.paths = (const char **)ArenaAlloc(repo->arena, (tree.count + 1)*sizeof(const char *));
+    refresh.ids = (const char **)ArenaAlloc(repo->arena, (tree.count + 1)*sizeof(const char *));
+    int reusedCount = 0;
+
+    for (int i = 0; (i < tree.count) && (refresh.builder != NULL); i++) {
+        const GitTreeEntry *entry = &tree.entries[i];
+        const char *fileName = strrchr(entry->path, '/');
+        fileName = (fileName != NULL)? fileName + 1 : entry->path;
+
+        int length = (int)strlen(entry->path);
+        if ((strncmp(entry->path, prefix, strlen(prefix)) != 0) || (length < 3) || (strcmp(entry->path + length - 3, ".md") != 0) ||
+            (strcmp(fileName, "_index.md") == 0)) continue;
+
+        int position = FindPostIndexPath(&previous, entry->path);
+        PostIndexEntry post = GetPostIndexEntry(&previous, position);
+
+        if ((position >= 0) && (strcmp(post.blobId, entry->id) == 0)) {
+            AddPostIndexEntry(refresh.builder, &post);
+            reusedCount++;
+        }
+        else {
+            refresh.paths[refresh.count] = entry->path;
+            refresh.ids[refresh.count] = entry->id;
+            refresh.count++;
+        }
+    }
+
+    bool success = (refresh.builder != NULL);
+    if (success && (refresh.count == 0) && (reusedCount == previous.count) && (previous.count > 0)) {
+        AbortPostIndex(refresh.builder);        // Index up to date
+    }
+    else if (success) {
+        loadMirrorBlobs(repo, mirrorPath, refresh.ids, refresh.count, indexPostBlob, &refresh);
+        success = EndPostIndex(refresh.builder, indexPath);
+    }
+
+    UnloadPostIndex(&previous);
+
+    if (!success) {
+        fprintf(stderr, "ERROR: Post index could not be saved: %s\n", indexPath);
+        return NULL;
+    }
+
+    LOG("INFO: Post index refreshed: %i post(s), %i parsed, %i reused (%.2f ms)\n", refresh.parsedCount + reusedCount,
+        refresh.parsedCount, reusedCount, (getBenchmarkTime() - startTime)*1000.0);
+
+    return indexPath;
+}
+
+// Completion task: refresh site posts index and build tags, categories and authors tries from
+// its distinct values, ranked by number of posts using them
+// NOTE: Runs on background thread, only its own arena is used
+static void loadTaxonomyCompletions(CompletionTrie **tries, int trieCount, void *userData) {
+    const CompletionSource *source = (const CompletionSource *)userData;
+    Arena arena = { 0 };
+
+    GitRepository repo = newRepository(&arena, source->repositoryUrl, source->contentPath);
+    const char *indexPath = refreshPostIndex(&repo, source->contentPath);
+    PostIndex index = (indexPath != NULL)? LoadPostIndex(indexPath) : (PostIndex){ 0 };
+
+    for (int f = 0; (f < trieCount) && (f < POST_INDEX_FIELD_COUNT); f++) {
+        int count = GetPostIndexValueCount(&index, (PostIndexField)f);
+        const char **values = (const char **)ArenaAlloc(&arena, (count + 1)*sizeof(const char *));
+        int *counts = (int *)ArenaAlloc(&arena, (count + 1)*sizeof(int));
+
+        for (int i = 0; i < count; i++) values[i] = GetPostIndexValue(&index, (PostIndexField)f, i, &counts[i]);
+        tries[f] = LoadCompletionTrie(values, counts, count);
+    }
+
+    LOG("INFO: Completions loaded: %i tags, %i categories, %i authors\n", GetCompletionTrieValueCount(tries[POST_INDEX_TAGS]),
+        GetCompletionTrieValueCount(tries[POST_INDEX_CATEGORIES]), GetCompletionTrieValueCount(tries[POST_INDEX_AUTHORS]));
+
+    UnloadPostIndex(&index);
+    ArenaFree(&arena);
+}
+
+// Start building completions of site repository (background), if repository or content path changed
+// NOTE: A new task is only started once previous one is done, previous completions are kept until then
+static void updateTaxonomyCompletions(ProjectConfig *config) {
+    if ((config->building.gitRepositoryUrl[0] == '\0') || ((completionTask != NULL) && !IsCompletionTaskDone(completionTask))) return;
+    if ((completionTask != NULL) && (strcmp(completionSource.repositoryUrl, config->building.gitRepositoryUrl) == 0) &&
+        (strcmp(completionSource.contentPath, config->building.contentFolderPath) == 0)) return;
+
+    UnloadCompletionTask(completionTask);
+
+    strcpy(completionSource.repositoryUrl, config->building.gitRepositoryUrl);
+    strcpy(completionSource.contentPath, config->building.contentFolderPath);
+    completionTask = StartCompletionTask(loadTaxonomyCompletions, &completionSource, POST_INDEX_FIELD_COUNT);
+}
+
+// GUI: Completion list for comma separated field being edited, current item (text after last comma)
+// is completed with most used values of site, chosen with mouse or TAB key
+// NOTE: Tags and categories items are quoted (TOML array items in front matter), authors are not
+static bool guiCompletionList(Rectangle bounds, char *text, int textSize, PostIndexField field) {
+    const CompletionTrie *trie = GetCompletionTaskTrie(completionTask, field);
+    if (trie == NULL) return false;
+
+    char *item = strrchr(text, ',');
+    item = (item != NULL)? item + 1 : text;
+    while (*item == ' ') item++;
+
+    bool quoted = (field != POST_INDEX_AUTHORS);
+    const char *prefix = (item[0] == '"')? item + 1 : item;
+    if (prefix[0] == '\0') return false;
+
+    const char *completions[COMPLETION_TRIE_MAX_RESULTS] = { 0 };
+    int count = GetCompletions(trie, prefix, completions, 5);   // Max 5 completions shown, fit below field
+    if ((count == 1) && (strcmp(item, TextFormat(quoted? "\"%s\"" : "%s", completions[0])) == 0)) return false;  // Item already complete
+
+    int chosen = (IsKeyPressed(KEY_TAB) && (count > 0))? 0 : -1;
+    completionListBounds = (Rectangle){ bounds.x, bounds.y + bounds.height, bounds.width, (float)count*20 };
+
+    for (int i = 0; i < count; i++) {
+        if (GuiButton((Rectangle){ bounds.x, bounds.y + bounds.height + i*20, bounds.width, 20 }, completions[i])) chosen = i;
+    }
+
+    if (chosen < 0) return false;
+
+    snprintf(item, textSize - (int)(item - text), quoted? "\"%s\"" : "%s", completions[chosen]);
+
+    return true;
+}
+
+// NOTE: Included last, site commands use app config, arenas and helpers defined above
+#include "site_commands.h"          // Site commands: Command line subcommands over site posts
+#endif
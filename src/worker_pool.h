@@ -0,0 +1,253 @@
+/*******************************************************************************************
+*
+*   Worker Pool - Persistent worker threads to run batches of independent jobs
+*
+*   MODULE USAGE:
+*       #define WORKER_POOL_IMPLEMENTATION
+*       #include "worker_pool.h"
+*
+*       WorkerPool *pool = LoadWorkerPool(0);                       // 0: One thread per CPU core
+*       RunWorkerPoolJobs(pool, CompressEntry, entries, entryCount); // Blocks until all jobs are done
+*       UnloadWorkerPool(pool);
+*
+*   NOTES:
+*       Jobs of a batch are picked in index order by workers and calling thread, so a job
+*       function just needs to process the item at given index. Only one batch is run at
+*       a time, concurrent calls to RunWorkerPoolJobs() wait for previous batch to finish
+*
+*       Threads are not available on PLATFORM_WEB, jobs are run on calling thread
+*       Define WORKER_POOL_NO_THREADS to force that behaviour on any platform
+*
+*   LICENSE: GPLv3, check LICENSE file for details
+*
+**********************************************************************************************/
+
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+//----------------------------------------------------------------------------------
+// Defines and Macros
+//----------------------------------------------------------------------------------
+#define WORKER_POOL_MAX_THREADS     64      // Max number of worker threads
+
+#if defined(__EMSCRIPTEN__) && !defined(WORKER_POOL_NO_THREADS)
+    #define WORKER_POOL_NO_THREADS
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Job function, called once for every job index of a batch
+typedef void (*WorkerJobFunc)(void *data, int index);
+
+// Worker pool, opaque type
+typedef struct WorkerPool WorkerPool;
+
+#ifdef __cplusplus
+extern "C" {            // Prevents name mangling of functions
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Declaration
+//----------------------------------------------------------------------------------
+WorkerPool *LoadWorkerPool(int threadCount);        // Load worker pool (threads are started), 0 uses CPU cores count
+void UnloadWorkerPool(WorkerPool *pool);            // Unload worker pool (threads are joined)
+void RunWorkerPoolJobs(WorkerPool *pool, WorkerJobFunc func, void *data, int jobCount); // Run jobs batch, blocks until done
+int GetWorkerPoolThreadCount(WorkerPool *pool);     // Get number of threads running jobs (including calling thread)
+int GetCpuCoreCount(void);                          // Get number of CPU cores available
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WORKER_POOL_H
+
+/***********************************************************************************
+*
+*   WORKER POOL IMPLEMENTATION
+*
+************************************************************************************/
+
+#if defined(WORKER_POOL_IMPLEMENTATION)
+
+#include <stdlib.h>         // Required for: calloc(), free(), getenv(), atoi()
+#include <stdbool.h>        // Required for: bool
+
+#if !defined(WORKER_POOL_NO_THREADS)
+    #include <pthread.h>    // Required for: pthread_create(), pthread_join(), pthread_mutex_*(), pthread_cond_*()
+    #if !defined(_WIN32)
+        #include <unistd.h> // Required for: sysconf()
+    #endif
+#endif
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+struct WorkerPool {
+    int threadCount;                // Number of worker threads (calling thread not included)
+#if !defined(WORKER_POOL_NO_THREADS)
+    pthread_t threads[WORKER_POOL_MAX_THREADS];
+    pthread_mutex_t batchMutex;     // Serializes batches from different callers
+    pthread_mutex_t mutex;          // Protects batch state
+    pthread_cond_t jobsReady;       // Signaled when a new batch is available or pool is unloaded
+    pthread_cond_t jobsDone;        // Signaled when last job of a batch is done
+#endif
+    WorkerJobFunc func;             // Current batch job function
+    void *data;                     // Current batch job data
+    int jobCount;                   // Current batch jobs count
+    int nextJob;                    // Next job index to be picked
+    int pendingJobs;                // Jobs not finished yet
+    bool quit;                      // Workers exit request
+};
+
+//----------------------------------------------------------------------------------
+// Module Internal Functions Definition
+//----------------------------------------------------------------------------------
+#if !defined(WORKER_POOL_NO_THREADS)
+// Pick and run jobs from current batch until none is left
+// NOTE: Pool mutex must be locked on call, it is locked on return
+static void RunPendingJobs(WorkerPool *pool)
+{
+    while (pool->nextJob < pool->jobCount)
+    {
+        int index = pool->nextJob++;
+        WorkerJobFunc func = pool->func;
+        void *data = pool->data;
+
+        pthread_mutex_unlock(&pool->mutex);
+        func(data, index);
+        pthread_mutex_lock(&pool->mutex);
+
+        pool->pendingJobs--;
+        if (pool->pendingJobs == 0) pthread_cond_broadcast(&pool->jobsDone);
+    }
+}
+
+// Worker thread loop
+static void *WorkerThread(void *arg)
+{
+    WorkerPool *pool = (WorkerPool *)arg;
+
+    pthread_mutex_lock(&pool->mutex);
+
+    while (!pool->quit)
+    {
+        if (pool->nextJob < pool->jobCount) RunPendingJobs(pool);
+        else pthread_cond_wait(&pool->jobsReady, &pool->mutex);
+    }
+
+    pthread_mutex_unlock(&pool->mutex);
+
+    return NULL;
+}
+#endif
+
+//----------------------------------------------------------------------------------
+// Module Functions Definition
+//----------------------------------------------------------------------------------
+// Get number of CPU cores available
+int GetCpuCoreCount(void)
+{
+    int count = 1;
+
+#if !defined(WORKER_POOL_NO_THREADS)
+  #if defined(_WIN32)
+    const char *processors = getenv("NUMBER_OF_PROCESSORS");
+    if (processors != NULL) count = atoi(processors);
+  #else
+    count = (int)sysconf(_SC_NPROCESSORS_ONLN);
+  #endif
+#endif
+
+    return (count < 1)? 1 : count;
+}
+
+// Load worker pool, threads are started and wait for jobs
+// NOTE: Calling thread also runs jobs, so (threadCount - 1) workers are created
+WorkerPool *LoadWorkerPool(int threadCount)
+{
+    WorkerPool *pool = (WorkerPool *)calloc(1, sizeof(WorkerPool));
+    if (pool == NULL) return NULL;
+
+#if !defined(WORKER_POOL_NO_THREADS)
+    if (threadCount <= 0) threadCount = GetCpuCoreCount();
+    if (threadCount > WORKER_POOL_MAX_THREADS) threadCount = WORKER_POOL_MAX_THREADS;
+
+    pthread_mutex_init(&pool->batchMutex, NULL);
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->jobsReady, NULL);
+    pthread_cond_init(&pool->jobsDone, NULL);
+
+    for (int i = 0; i < (threadCount - 1); i++)
+    {
+        if (pthread_create(&pool->threads[pool->threadCount], NULL, WorkerThread, pool) != 0) break;
+        pool->threadCount++;
+    }
+#endif
+
+    return pool;
+}
+
+// Unload worker pool, waiting for workers to exit
+void UnloadWorkerPool(WorkerPool *pool)
+{
+    if (pool == NULL) return;
+
+#if !defined(WORKER_POOL_NO_THREADS)
+    pthread_mutex_lock(&pool->mutex);
+    pool->quit = true;
+    pthread_cond_broadcast(&pool->jobsReady);
+    pthread_mutex_unlock(&pool->mutex);
+
+    for (int i = 0; i < pool->threadCount; i++) pthread_join(pool->threads[i], NULL);
+
+    pthread_cond_destroy(&pool->jobsDone);
+    pthread_cond_destroy(&pool->jobsReady);
+    pthread_mutex_destroy(&pool->mutex);
+    pthread_mutex_destroy(&pool->batchMutex);
+#endif
+
+    free(pool);
+}
+
+// Run jobs batch, calling thread runs jobs too and returns when all jobs are done
+// NOTE: If pool is NULL, jobs are run on calling thread
+void RunWorkerPoolJobs(WorkerPool *pool, WorkerJobFunc func, void *data, int jobCount)
+{
+    if (jobCount <= 0) return;
+
+#if !defined(WORKER_POOL_NO_THREADS)
+    if ((pool != NULL) && (pool->threadCount > 0) && (jobCount > 1))
+    {
+        pthread_mutex_lock(&pool->batchMutex);
+        pthread_mutex_lock(&pool->mutex);
+
+        pool->func = func;
+        pool->data = data;
+        pool->jobCount = jobCount;
+        pool->nextJob = 0;
+        pool->pendingJobs = jobCount;
+        pthread_cond_broadcast(&pool->jobsReady);
+
+        RunPendingJobs(pool);
+        while (pool->pendingJobs > 0) pthread_cond_wait(&pool->jobsDone, &pool->mutex);
+
+        pool->jobCount = 0;
+        pool->nextJob = 0;
+
+        pthread_mutex_unlock(&pool->mutex);
+        pthread_mutex_unlock(&pool->batchMutex);
+        return;
+    }
+#endif
+
+    for (int i = 0; i < jobCount; i++) func(data, i);
+}
+
+// Get number of threads running jobs (including calling thread)
+int GetWorkerPoolThreadCount(WorkerPool *pool)
+{
+    return (pool != NULL)? pool->threadCount + 1 : 1;
+}
+
+#endif // WORKER_POOL_IMPLEMENTATION